@@ -0,0 +1,52 @@
+# ==============================================================================
+# WrapWswrap.cmake — point wswrap's websocketpp clients at TalosAP::Ws::Config
+#
+#   include(cmake/WrapWswrap.cmake)
+#   talosap_wrap_wswrap(<out_var>)
+#
+# wswrap chooses its websocketpp config types internally. This copies its
+# headers into the build tree (the fetched tree is left alone) and rewrites
+# each websocketpp::client<X> in the copy as
+# websocketpp::client<::TalosAP::Ws::Config<X>>, with src/headers/WsConfig.h
+# included first. <out_var> is set to the copy's include directory, to be
+# used in place of ${wswrap_SOURCE_DIR}/include.
+#
+# A wswrap that declares no websocketpp client type fails the configure:
+# the session would otherwise build without the config overrides and lose
+# TLS session resumption without a word.
+# ==============================================================================
+
+function(talosap_wrap_wswrap out_var)
+    if(NOT wswrap_SOURCE_DIR)
+        message(FATAL_ERROR "talosap_wrap_wswrap: wswrap has not been fetched")
+    endif()
+
+    set(_src "${wswrap_SOURCE_DIR}/include")
+    set(_dst "${CMAKE_BINARY_DIR}/wswrap-talosap")
+    set(_client_re "websocketpp::client<([^<>]+)>")
+
+    file(GLOB_RECURSE _headers RELATIVE "${_src}" "${_src}/*")
+    set(_wrapped 0)
+    foreach(_h IN LISTS _headers)
+        file(READ "${_src}/${_h}" _text)
+        string(REGEX MATCHALL "${_client_re}" _clients "${_text}")
+        if(_clients)
+            list(LENGTH _clients _n)
+            math(EXPR _wrapped "${_wrapped} + ${_n}")
+            string(REGEX REPLACE "${_client_re}" "websocketpp::client<::TalosAP::Ws::Config<\\1>>" _text "${_text}")
+            set(_text "// Generated from ${_src}/${_h} by cmake/WrapWswrap.cmake\n#include \"WsConfig.h\"\n${_text}")
+        endif()
+        # Only touch the copy when it changes, so a re-configure does not
+        # rebuild the session sources.
+        file(WRITE "${_dst}/${_h}.tmp" "${_text}")
+        file(COPY_FILE "${_dst}/${_h}.tmp" "${_dst}/${_h}" ONLY_IF_DIFFERENT)
+        file(REMOVE "${_dst}/${_h}.tmp")
+    endforeach()
+
+    if(_wrapped EQUAL 0)
+        message(FATAL_ERROR "talosap_wrap_wswrap: no websocketpp::client<...> in ${_src}; "
+                            "update cmake/WrapWswrap.cmake for this wswrap version")
+    endif()
+    message(STATUS "wswrap: ${_wrapped} websocketpp client type(s) wrapped with TalosAP::Ws::Config")
+    set(${out_var} "${_dst}" PARENT_SCOPE)
+endfunction()
@@ -17,6 +17,18 @@
 #include "src/headers/SaveGameHandler.h"
 #include "src/headers/VisibilityManager.h"
 #include "src/headers/HudNotification.h"
+#include "src/headers/TraceRecorder.h"
+#include "src/headers/EngineCalls.h"
+#include "src/headers/TickArena.h"
+#include "src/headers/FunctionThunk.h"
+#include "src/headers/GameLayout.h"
+#include "src/headers/LiveMetrics.h"
+#include "src/headers/StateExport.h"
+#include "src/headers/SaveReader.h"
+#include "src/headers/GameTask.h"
+#include "src/headers/Latency.h"
+#include "src/headers/ObjectTracker.h"
+#include "src/headers/Utf.h"
 
 #include <filesystem>
 
@@ -34,6 +46,58 @@ public:
         ModAuthors = STR("Froddo");
 
         Output::send<LogLevel::Verbose>(STR("[TalosAP] Mod constructed\n"));
+
+        // Nothing below needs the engine, so the AP connection, slot auth
+        // and data package download overlap the game's boot and menu
+        // instead of waiting for on_unreal_init and the first tick.
+        m_modDir = FindModDir();
+
+        // Start the crash flight recorder as early as we know where to put it
+        if (TalosAP::FlightRecorder::Get().Open(m_modDir)) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Flight recorder active (talos_ap_flight.bin)\n"));
+        } else {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Flight recorder could not map its ring file\n"));
+        }
+
+        // Live metrics page for overlays / tools/metricsdump
+        if (TalosAP::LiveMetrics::Get().Open()) {
+            for (size_t k = 0; k < static_cast<size_t>(TalosAP::EngineCallKind::Count); ++k) {
+                TalosAP::LiveMetrics::Get().SetEngineCallName(k,
+                    TalosAP::EngineCallStats::KindName(static_cast<TalosAP::EngineCallKind>(k)));
+            }
+        } else {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Live metrics page could not be created\n"));
+        }
+
+        // Delta stream + snapshot for external trackers
+        if (!TalosAP::StateExport::Get().Open(m_modDir)) {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Tracker export files could not be created\n"));
+        }
+
+        m_config.Load(m_modDir);
+        ApplyTunables();
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Config loaded\n"));
+
+        // Collection state from the save file, before any world exists
+        SeedFromSave();
+
+        // Initialize item mapping
+        m_itemMapping = std::make_unique<TalosAP::ItemMapping>();
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Item mappings built\n"));
+
+        // Start the AP client (unless offline mode)
+        if (!m_config.offline_mode) {
+            m_apClient = std::make_unique<TalosAP::APClientWrapper>();
+            if (m_apClient->Start(m_config, m_state, *m_itemMapping, m_modDir)) {
+                Output::send<LogLevel::Verbose>(STR("[TalosAP] AP client connecting in the background\n"));
+            } else {
+                Output::send<LogLevel::Error>(STR("[TalosAP] AP client initialization failed\n"));
+                m_apClient.reset();
+            }
+        } else {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Offline mode — AP client disabled\n"));
+            m_state.APSynced = true; // Enable enforcement immediately in offline mode
+        }
     }
 
     ~TalosPrincipleArchipelagoMod() override
@@ -43,6 +107,10 @@ public:
         // is still running — any FindAllOf / FindFirstOf call will
         // crash with an access violation (SEH, not catchable by C++).
         m_shuttingDown = true;
+        TalosAP::TaskScheduler::Get().CancelAll();
+        TalosAP::StateExport::Get().Close();
+        TalosAP::LiveMetrics::Get().Close();
+        TalosAP::FlightRecorder::Get().Close();
     }
 
     // ============================================================
@@ -52,55 +120,26 @@ public:
     {
         Output::send<LogLevel::Verbose>(STR("[TalosAP] on_unreal_init — initializing...\n"));
 
-        // Load configuration
-        // Try to find the mod directory (where the DLL lives)
-        std::wstring modDir;
-        try {
-            wchar_t dllPath[MAX_PATH];
-            HMODULE hModule = nullptr;
-            // Use a static dummy variable whose address lives inside this DLL
-            static const int s_anchor = 0;
-            GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
-                               GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
-                               reinterpret_cast<LPCWSTR>(&s_anchor),
-                               &hModule);
-            if (hModule) {
-                GetModuleFileNameW(hModule, dllPath, MAX_PATH);
-                std::filesystem::path p(dllPath);
-                // DLL is in Mods/<ModName>/dlls/main.dll, config is in Mods/<ModName>/
-                modDir = p.parent_path().parent_path().wstring();
-            }
-        }
-        catch (...) {}
-
-        m_config.Load(modDir);
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Config loaded\n"));
+        // Look up every ProcessEvent target once and check its parameter
+        // layout, so a mismatch is reported here instead of corrupting memory
+        TalosAP::FunctionThunkBase::ResolveAll();
 
-        // Initialize item mapping
-        m_itemMapping = std::make_unique<TalosAP::ItemMapping>();
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Item mappings built\n"));
+        // Compare the header-dump offsets with live reflection (classes
+        // that load later are checked again from BuildFenceMap)
+        TalosAP::GameLayoutEntry::VerifyAll();
 
         // Initialize HUD notification overlay
         m_hud = std::make_unique<TalosAP::HudNotification>();
+        m_hud->ApplyTunables(m_state.Tuning);
         if (m_hud->Init()) {
             Output::send<LogLevel::Verbose>(STR("[TalosAP] HUD notification system initialized\n"));
         } else {
             Output::send<LogLevel::Warning>(STR("[TalosAP] HUD init deferred — UMG classes not yet available\n"));
         }
 
-        // Initialize AP client (unless offline mode)
-        if (!m_config.offline_mode) {
-            m_apClient = std::make_unique<TalosAP::APClientWrapper>();
-            bool ok = m_apClient->Init(m_config, m_state, *m_itemMapping, m_hud.get());
-            if (ok) {
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] AP client initialized — connection will start on poll\n"));
-            } else {
-                Output::send<LogLevel::Error>(STR("[TalosAP] AP client initialization failed\n"));
-                m_apClient.reset();
-            }
-        } else {
-            Output::send<LogLevel::Verbose>(STR("[TalosAP] Offline mode — AP client disabled\n"));
-            m_state.APSynced = true; // Enable enforcement immediately in offline mode
+        // AP events queued since construction start showing on the HUD
+        if (m_apClient) {
+            m_apClient->SetHud(m_hud.get());
         }
 
         // ============================================================
@@ -115,6 +154,11 @@ public:
             m_state.PendingHudTest.store(true);
         });
 
+        // F7: Write the in-memory trace ring to talos_ap_trace.json
+        register_keydown_event(Input::Key::F7, [this]() {
+            m_state.PendingTraceFlush.store(true);
+        });
+
         // ============================================================
         // Register hooks
         // ============================================================
@@ -136,34 +180,84 @@ public:
 
         ++m_tickCount;
 
-        // Poll AP client for network events
+        // Rewinds the tick arena on every exit path (the cooldown gate
+        // returns early). Declared first so it runs after all other
+        // tick-scoped objects are gone.
+        struct TickEnd {
+            TalosPrincipleArchipelagoMod& mod;
+            ~TickEnd() { mod.EndTick(); }
+        } tickEnd{ *this };
+        m_tickAllocStart = TalosAP::AllocCounter::Count();
+
+        TalosAP::TraceScope tickTrace("on_update", "tick");
+        TalosAP::PhaseTimer tickTimer(TalosAP::MetricPhase::Tick);
+        TalosAP::EngineCallStats::Get().Tick();
+        TalosAP::ObjectTracker::Get().Tick();
+
+        // config.json edited: re-apply tunables (checked once a second)
+        if (m_config.PollTunables()) {
+            ApplyTunables();
+        }
+        const TalosAP::Tunables& tuning = m_state.Tuning;
+
+        // Apply AP events from the session's ring. Their handlers
+        // allocate (HUD text); counted separately from the mod's own
+        // per-tick work.
         if (m_apClient) {
+            TalosAP::TraceScope t("AP.Poll", "phase");
+            TalosAP::PhaseTimer pt(TalosAP::MetricPhase::APPoll);
+            uint64_t before = TalosAP::AllocCounter::Count();
             m_apClient->Poll();
+            m_pollAllocs = TalosAP::AllocCounter::Count() - before;
+        } else {
+            m_pollAllocs = 0;
+        }
+
+        // Tick HUD notification system (hud_interval_ticks, 12 = 200ms)
+        if (m_hud && (m_tickCount % tuning.hud_interval_ticks == 0)) {
+            TalosAP::TraceScope t("HUD.Tick", "phase");
+            TalosAP::PhaseTimer pt(TalosAP::MetricPhase::HudTick);
+            m_hud->Tick(static_cast<float>(tuning.hud_interval_ticks), 60.0f);
+        }
+
+        // F7: trace flush — handled before the cooldown gate so a trace
+        // can be captured in the middle of a level transition.
+        if (m_state.PendingTraceFlush.exchange(false)) {
+            FlushTrace();
         }
 
-        // Tick HUD notification system (~12 ticks = 200ms)
-        if (m_hud && (m_tickCount % 12 == 0)) {
-            m_hud->Tick(12.0f, 60.0f);
+        // A level transition (or startup) cancels the previous level's
+        // tasks and queues the new level's entry work.
+        auto& tasks = TalosAP::TaskScheduler::Get();
+        if (m_state.WorldGeneration != m_levelTaskGeneration) {
+            m_levelTaskGeneration = m_state.WorldGeneration;
+            tasks.Cancel(TalosAP::TaskGroup::Level);
+            tasks.Spawn(EnterLevel(m_levelTaskGeneration), TalosAP::TaskGroup::Level, "EnterLevel");
         }
 
         // Decrement level transition cooldown
-        if (m_state.LevelTransitionCooldown > 0) {
+        bool coolingDown = m_state.LevelTransitionCooldown > 0;
+        if (coolingDown) {
             --m_state.LevelTransitionCooldown;
             if (m_state.LevelTransitionCooldown == 0) {
                 Output::send<LogLevel::Verbose>(STR("[TalosAP] Level transition cooldown expired — resuming\n"));
             }
-            return; // Skip all game-thread work during transitions
         }
 
-        // Deferred progress refresh
-        if (m_state.NeedsProgressRefresh) {
-            m_state.NeedsProgressRefresh = false;
-            TalosAP::InventorySync::FindProgressObject(m_state, true);
-            if (m_state.CurrentProgress) {
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] Deferred progress refresh complete\n"));
-            }
+        // Game-thread tasks: level entry, fence open retries. Timers keep
+        // running through a cooldown; WorldReady() waiters stay parked.
+        {
+            TalosAP::TraceScope t("Tasks", "phase");
+            tasks.Tick(static_cast<uint64_t>(TalosAP::LiveMetrics::NowNs() / 1'000'000), !coolingDown);
+        }
+        if (tasks.Faults() != m_taskFaults) {
+            m_taskFaults = tasks.Faults();
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Task {} ended with an exception\n"),
+                TalosAP::Utf::ToWide(tasks.LastFault() ? tasks.LastFault() : "?"));
         }
 
+        if (coolingDown) return; // Skip all game-thread work during transitions
+
         // F6: inventory dump
         if (m_state.PendingInventoryDump.exchange(false)) {
             Output::send<LogLevel::Verbose>(STR("[TalosAP] === F6 Inventory Dump ===\n"));
@@ -171,6 +265,9 @@ public:
             TalosAP::InventorySync::DumpCollectedTetrominos(m_state);
             m_visibilityManager.DumpTracked();
             m_visibilityManager.DumpFenceMap();
+            TalosAP::GameLayoutEntry::Dump();
+            TalosAP::EngineCallStats::Get().Dump();
+            DumpTickStats();
         }
 
         // F9: HUD notification test
@@ -194,21 +291,14 @@ public:
         }
 
         // ============================================================
-        // Tetromino scan — run once after level transitions
-        // ============================================================
-        if (m_state.NeedsTetrominoScan) {
-            m_state.NeedsTetrominoScan = false;
-            m_visibilityManager.ResetCache();
-            m_visibilityManager.ScanLevel(m_state);
-        }
-
-        // ============================================================
-        // Visibility enforcement + proximity pickup (every 5 ticks)
+        // Visibility enforcement + proximity pickup (enforce_interval_ticks, 5)
         // Rate-limited: EnforceVisibility calls FindAllOf + iterates
         // all actors, too expensive to run every frame. 5 ticks at
         // 60fps ≈ 12 Hz, still responsive for player proximity.
         // ============================================================
-        if (m_state.APSynced && m_itemMapping && (m_tickCount % 5 == 0)) {
+        if (m_state.APSynced && m_itemMapping && (m_tickCount % tuning.enforce_interval_ticks == 0)) {
+            TalosAP::TraceScope t("EnforceVisibility", "phase");
+            TalosAP::PhaseTimer pt(TalosAP::MetricPhase::EnforceVisibility);
             m_visibilityManager.EnforceVisibility(m_state, *m_itemMapping,
                 [this](int64_t locationId) {
                     if (m_apClient) {
@@ -218,24 +308,20 @@ public:
         }
 
         // ============================================================
-        // Periodic full visibility refresh (every ~60 ticks / ~1s)
+        // Periodic full visibility refresh (refresh_interval_ticks, 60 / ~1s)
         // Re-discovers actors, rebuilds tracked positions, reapplies
         // visibility. Keeps tracking data current after items arrive.
         // ============================================================
-        if (m_tickCount % 60 == 0) {
+        if (m_tickCount % tuning.refresh_interval_ticks == 0) {
+            TalosAP::TraceScope t("RefreshVisibility", "phase");
+            TalosAP::PhaseTimer pt(TalosAP::MetricPhase::RefreshVisibility);
             m_visibilityManager.RefreshVisibility(m_state);
         }
 
-        // ============================================================
-        // Process pending fence opens (every ~6 ticks / ~100ms)
-        // Retries ALoweringFence::Open() with 100ms spacing, up to 10x
-        // ============================================================
-        if (m_tickCount % 6 == 0) {
-            m_visibilityManager.ProcessPendingFenceOpens();
-        }
-
-        // Enforce collection state every ~60 ticks
-        if (m_tickCount % 60 == 0) {
+        // Enforce collection state (collection_interval_ticks, 60)
+        if (m_tickCount % tuning.collection_interval_ticks == 0) {
+            TalosAP::TraceScope t("EnforceCollection", "phase");
+            TalosAP::PhaseTimer pt(TalosAP::MetricPhase::EnforceCollection);
             // Always re-acquire the progress object — cached UObject* can go
             // stale at any time due to Unreal GC.
             TalosAP::InventorySync::FindProgressObject(m_state);
@@ -246,6 +332,253 @@ public:
     }
 
 private:
+    /// Work for a newly entered level, once its cooldown has passed:
+    /// re-acquire the progress object, rescan location actors. Level
+    /// group — the next transition cancels it if it hasn't run yet.
+    TalosAP::GameTask EnterLevel(uint32_t generation)
+    {
+        co_await TalosAP::WorldReady();
+
+        {
+            TalosAP::TraceScope t("ProgressRefresh", "phase");
+            TalosAP::PhaseTimer pt(TalosAP::MetricPhase::ProgressRefresh);
+            TalosAP::InventorySync::FindProgressObject(m_state, true);
+            if (m_state.CurrentProgress) {
+                Output::send<LogLevel::Verbose>(STR("[TalosAP] Deferred progress refresh complete\n"));
+            }
+        }
+
+        {
+            TalosAP::TraceScope t("ScanLevel", "phase");
+            TalosAP::PhaseTimer pt(TalosAP::MetricPhase::ScanLevel);
+            m_visibilityManager.ResetCache();
+            m_visibilityManager.ScanLevel(m_state);
+            TalosAP::StateExport::Get().LevelEntered(generation, CurrentLevelName());
+        }
+        TalosAP::LatencyStats::Get().End(TalosAP::LatencyPath::LevelScan);
+    }
+
+    /// The mod folder: the DLL is in Mods/<ModName>/dlls/main.dll, config
+    /// and the mod's output files live in Mods/<ModName>/.
+    static std::wstring FindModDir()
+    {
+        try {
+            wchar_t dllPath[MAX_PATH];
+            HMODULE hModule = nullptr;
+            // Use a static dummy variable whose address lives inside this DLL
+            static const int s_anchor = 0;
+            GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                               GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                               reinterpret_cast<LPCWSTR>(&s_anchor),
+                               &hModule);
+            if (hModule) {
+                GetModuleFileNameW(hModule, dllPath, MAX_PATH);
+                std::filesystem::path p(dllPath);
+                return p.parent_path().parent_path().wstring();
+            }
+        }
+        catch (...) {}
+        return {};
+    }
+
+    /// The game's SaveGames folder: %LOCALAPPDATA%\<Project>\Saved\SaveGames,
+    /// with <Project> taken from <Project>\Binaries\Win64\<Game>.exe.
+    static std::wstring DefaultSaveDir()
+    {
+        try {
+            wchar_t exePath[MAX_PATH];
+            wchar_t localAppData[MAX_PATH];
+            if (!GetModuleFileNameW(nullptr, exePath, MAX_PATH)) return {};
+            DWORD n = GetEnvironmentVariableW(L"LOCALAPPDATA", localAppData, MAX_PATH);
+            if (n == 0 || n >= MAX_PATH) return {};
+
+            std::filesystem::path project = std::filesystem::path(exePath).parent_path().parent_path().parent_path();
+            return (std::filesystem::path(localAppData) / project.filename() / L"Saved" / L"SaveGames").wstring();
+        }
+        catch (...) {}
+        return {};
+    }
+
+    /// Hand the loaded tunables to everything that uses them. Hooks and
+    /// the update loop read m_state.Tuning directly.
+    void ApplyTunables()
+    {
+        m_state.Tuning = m_config.tunables;
+        m_visibilityManager.ApplyTunables(m_state.Tuning);
+        if (m_hud) m_hud->ApplyTunables(m_state.Tuning);
+        TalosAP::ObjectTracker::Get().ApplyTunables(m_state.Tuning);
+    }
+
+    /// Read CollectedTetrominos from the save into m_state.SavedTetrominos.
+    /// Offline, the save is the only source of grants, so it seeds
+    /// GrantedItems too (enforcement would otherwise empty the inventory).
+    void SeedFromSave()
+    {
+        std::wstring path = m_config.save_file.empty() ? DefaultSaveDir() : m_config.save_file;
+        std::error_code ec;
+        if (!path.empty() && std::filesystem::is_directory(path, ec)) {
+            path = TalosAP::SaveReader::FindLatestSave(path);
+        }
+        if (path.empty()) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] No save file found to pre-read\n"));
+            return;
+        }
+
+        TalosAP::SaveScan scan;
+        if (!TalosAP::SaveReader::ScanFile(path, scan)) {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Could not read save {}: {}\n"),
+                path, TalosAP::Utf::ToWide(scan.error));
+            return;
+        }
+
+        for (const auto& t : scan.tetrominos) {
+            TalosAP::ItemId id(t.id);
+            if (id.empty()) continue;
+            m_state.SavedTetrominos.insert(id);
+            if (m_config.offline_mode) m_state.GrantedItems.insert(id);
+        }
+        m_state.SaveSeeded = true;
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Save {}: {} collected tetrominoes (engine {})\n"),
+            path, m_state.SavedTetrominos.size(), TalosAP::Utf::ToWide(scan.engineVersion));
+    }
+
+    /// Map name of the loaded level, from the player controller's path
+    /// ("... /Game/Maps/Foo/Bar.Bar:PersistentLevel.PC_0" -> "Bar").
+    /// Empty if there is no controller yet.
+    static std::string CurrentLevelName()
+    {
+        try {
+            auto* pc = TalosAP::Engine::FindFirstOf(STR("PlayerController"));
+            if (!pc) return {};
+            std::wstring path = TalosAP::Engine::GetFullName(pc);
+            size_t colon = path.find(L':');
+            if (colon == std::wstring::npos) return {};
+            size_t slash = path.rfind(L'/', colon);
+            size_t start = (slash == std::wstring::npos) ? 0 : slash + 1;
+            size_t dot = path.find(L'.', start);
+            size_t end = (dot == std::wstring::npos || dot > colon) ? colon : dot;
+            return TalosAP::Utf::ToUtf8(std::wstring_view(path).substr(start, end - start));
+        }
+        catch (...) {}
+        return {};
+    }
+
+    /// End-of-tick bookkeeping: rewind the arena, refill the visibility
+    /// call budget, publish live metrics and record how many global heap
+    /// allocations the tick made outside AP.Poll.
+    void EndTick()
+    {
+        TalosAP::TickArena::Get().Reset();
+        m_visibilityManager.EndTick();
+        PublishMetrics();
+        TalosAP::StateExport::Get().Tick();
+
+        if (!TalosAP::AllocCounter::Enabled()) return;
+
+        uint64_t allocs = TalosAP::AllocCounter::Count() - m_tickAllocStart - m_pollAllocs;
+        m_lastTickAllocs = allocs;
+        if (allocs > m_maxTickAllocs) m_maxTickAllocs = allocs;
+        m_zeroAllocTicks = (allocs == 0) ? m_zeroAllocTicks + 1 : 0;
+
+        // Only sample on change — a flat zero line needs no events.
+        if (allocs != m_lastTracedAllocs) {
+            TalosAP::TraceRecorder::Get().Counter("HeapAllocs/tick", static_cast<int64_t>(allocs));
+            m_lastTracedAllocs = allocs;
+        }
+    }
+
+    /// Stage this tick's state for the live metrics page and publish it.
+    /// Runs after the tick's PhaseTimers have all closed.
+    void PublishMetrics()
+    {
+        static_assert(static_cast<size_t>(TalosAP::EngineCallKind::Count) <= TalosAP::METRICS_ENGINE_CALL_SLOTS);
+        using TalosAP::MetricGauge;
+        auto& metrics = TalosAP::LiveMetrics::Get();
+        if (!metrics.IsOpen()) return;
+
+        metrics.SetGauge(MetricGauge::Tick,               m_tickCount);
+        metrics.SetGauge(MetricGauge::WorldGeneration,    m_state.WorldGeneration);
+        metrics.SetGauge(MetricGauge::CooldownTicks,      static_cast<uint64_t>(std::max(0, m_state.LevelTransitionCooldown)));
+        metrics.SetGauge(MetricGauge::APSynced,           m_state.APSynced ? 1 : 0);
+        metrics.SetGauge(MetricGauge::GrantedItems,       m_state.GrantedItems.size());
+        metrics.SetGauge(MetricGauge::CheckedLocations,   m_state.CheckedLocations.size());
+        metrics.SetGauge(MetricGauge::TrackedTetrominos,  m_visibilityManager.GetTrackedCount(TalosAP::LocationKind::Tetromino));
+        metrics.SetGauge(MetricGauge::FenceOpensPending,  m_visibilityManager.GetPendingFenceOpenCount());
+        metrics.SetGauge(MetricGauge::HudPending,         m_hud ? m_hud->GetPendingCount() : 0);
+        metrics.SetGauge(MetricGauge::ArenaBytes,         TalosAP::TickArena::Get().HighWater());
+        metrics.SetGauge(MetricGauge::HeapAllocsLastTick, m_lastTickAllocs);
+        auto& objects = TalosAP::ObjectTracker::Get();
+        metrics.SetGauge(MetricGauge::ModObjectsHeld,     objects.HeldCount());
+        metrics.SetGauge(MetricGauge::ModObjectsReleased, objects.ReleasedCount());
+        metrics.SetGauge(MetricGauge::ModObjectsFlagged,  objects.FlaggedCount());
+        metrics.SetGauge(MetricGauge::ModNameEntries,     objects.NameEntries());
+        if (m_apClient) {
+            m_apClient->PublishMetrics(metrics);
+        }
+
+        auto& calls = TalosAP::EngineCallStats::Get();
+        for (size_t k = 0; k < static_cast<size_t>(TalosAP::EngineCallKind::Count); ++k) {
+            auto kind = static_cast<TalosAP::EngineCallKind>(k);
+            metrics.SetEngineCalls(k, calls.TotalFor(kind), calls.RateFor(kind));
+        }
+        metrics.Publish();
+    }
+
+    /// F6: arena usage and per-tick heap allocation counts.
+    void DumpTickStats() const
+    {
+        auto& tasks = TalosAP::TaskScheduler::Get();
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] === Tasks ===\n"));
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   live={} timers={} pollers={} resumes={} faults={}\n"),
+            tasks.LiveCount(), tasks.TimerCount(), tasks.PollerCount(), tasks.Resumes(), tasks.Faults());
+        tasks.ForEachLive([](const char* name, TalosAP::TaskGroup group, TalosAP::TaskWait wait) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP]   {} [{}] {}\n"),
+                TalosAP::Widen(name),
+                group == TalosAP::TaskGroup::Level ? STR("level") : STR("session"),
+                TalosAP::Widen(TalosAP::TaskWaitName(wait)));
+        });
+
+        auto& latency = TalosAP::LatencyStats::Get();
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] === Latency (ms) ===\n"));
+        for (size_t i = 0; i < TalosAP::LATENCY_PATH_COUNT; ++i) {
+            auto path = static_cast<TalosAP::LatencyPath>(i);
+            const auto& h = latency.Histogram(path);
+            Output::send<LogLevel::Verbose>(STR("[TalosAP]   {:<15} n={} p50={:.2f} p90={:.2f} p99={:.2f} max={:.2f} pending={}\n"),
+                TalosAP::Widen(TalosAP::LatencyPathName(path)), h.Count(),
+                h.PercentileNs(0.50) / 1e6, h.PercentileNs(0.90) / 1e6, h.PercentileNs(0.99) / 1e6,
+                h.MaxNs() / 1e6, latency.PendingCount(path));
+        }
+
+        TalosAP::ObjectTracker::Get().Dump();
+
+        auto& arena = TalosAP::TickArena::Get();
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] === Tick arena ===\n"));
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   high-water={} / {} bytes, overflow allocations={}\n"),
+            arena.HighWater(), TalosAP::TickArena::CAPACITY, arena.OverflowCount());
+
+        if (!TalosAP::AllocCounter::Enabled()) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP]   heap allocation counter not built in (TALOSAP_ALLOC_COUNTER=OFF)\n"));
+            return;
+        }
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   heap allocs: last tick={} max={} zero-alloc streak={} ticks, AP.Poll last={}\n"),
+            m_lastTickAllocs, m_maxTickAllocs, m_zeroAllocTicks, m_pollAllocs);
+    }
+
+    /// Write the trace ring next to config.json (or the working directory).
+    void FlushTrace()
+    {
+        std::filesystem::path out = m_modDir.empty()
+            ? std::filesystem::path(L"talos_ap_trace.json")
+            : std::filesystem::path(m_modDir) / L"talos_ap_trace.json";
+        auto& trace = TalosAP::TraceRecorder::Get();
+        if (trace.Flush(out.wstring())) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Trace written ({} events): {}\n"),
+                trace.Size(), out.wstring());
+        } else {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Failed to write trace: {}\n"), out.wstring());
+        }
+    }
+
     TalosAP::Config                            m_config;
     TalosAP::ModState                          m_state;
     std::unique_ptr<TalosAP::ItemMapping>      m_itemMapping;
@@ -254,7 +587,18 @@ private:
     TalosAP::LevelTransitionHandler            m_levelTransitionHandler;
     TalosAP::SaveGameHandler                   m_saveGameHandler;
     TalosAP::VisibilityManager                 m_visibilityManager;
+    std::wstring                               m_modDir;
     uint64_t                                   m_tickCount = 0;
+    uint32_t                                   m_levelTaskGeneration = ~0u;  ///< WorldGeneration EnterLevel was spawned for
+    uint64_t                                   m_taskFaults = 0;
+
+    // ---- Per-tick heap allocation accounting (TALOSAP_ALLOC_COUNTER) ----
+    uint64_t                                   m_tickAllocStart   = 0;
+    uint64_t                                   m_pollAllocs       = 0;
+    uint64_t                                   m_lastTickAllocs   = 0;
+    uint64_t                                   m_maxTickAllocs    = 0;
+    uint64_t                                   m_zeroAllocTicks   = 0;
+    uint64_t                                   m_lastTracedAllocs = 0;
     bool                                       m_shuttingDown = false;
 };
 
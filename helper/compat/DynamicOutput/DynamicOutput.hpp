@@ -0,0 +1,74 @@
+#pragma once
+
+// Stand-in for UE4SS's DynamicOutput in TalosAPHelper, so the mod's
+// engine-free sources build unchanged outside the game. Same spelling as
+// UE4SS (RC::LogLevel::*, RC::Output::send<Level>(STR(...), args...)).
+// Lines go to stderr and to the sink installed with Output::SetSink —
+// the helper forwards them to the mod's log.
+
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#ifndef STR
+#define STR(str) L##str
+#endif
+
+namespace RC {
+
+namespace LogLevel {
+enum LogLevel : int32_t {
+    Default,
+    Normal,
+    Verbose,
+    Warning,
+    Error,
+};
+} // namespace LogLevel
+
+namespace Output {
+
+using Sink = void (*)(int32_t level, const std::wstring& line);
+
+namespace Detail {
+inline Sink       g_sink = nullptr;
+inline bool       g_echo = true;
+inline std::mutex g_mutex;
+} // namespace Detail
+
+inline void SetSink(Sink sink)
+{
+    std::lock_guard<std::mutex> lock(Detail::g_mutex);
+    Detail::g_sink = sink;
+}
+
+/// Stop copying lines to stderr (tools/wirereplay times the handlers,
+/// not the terminal). Lines are still formatted and passed to the sink.
+inline void SetEcho(bool echo)
+{
+    std::lock_guard<std::mutex> lock(Detail::g_mutex);
+    Detail::g_echo = echo;
+}
+
+template <int32_t Level = LogLevel::Default, typename... Args>
+void send(const wchar_t* fmt, const Args&... args)
+{
+    std::wstring line;
+    try {
+        line = std::vformat(std::wstring_view(fmt), std::make_wformat_args(args...));
+    }
+    catch (...) {
+        line = fmt;
+    }
+
+    std::lock_guard<std::mutex> lock(Detail::g_mutex);
+    if (Detail::g_echo) std::fputws(line.c_str(), stderr);
+    if (Detail::g_sink) Detail::g_sink(Level, line);
+}
+
+} // namespace Output
+
+} // namespace RC
@@ -0,0 +1,142 @@
+// TalosAPHelper — runs the mod's AP session outside the game process.
+//
+// Started by the mod (config.json "network_helper": true) with
+//   TalosAPHelper.exe --channel TalosAP.Channel.<game pid>
+// It attaches to the shared block the mod created, runs the same
+// APSession the mod would run on a thread, and forwards its log lines to
+// the mod. It exits when the mod sets the stop flag or the game process
+// goes away.
+
+#include "headers/APChannel.h"
+#include "headers/APSession.h"
+#include "headers/MappedRegion.h"
+
+#include <DynamicOutput/DynamicOutput.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <csignal>
+#include <unistd.h>
+#endif
+
+using namespace RC;
+using namespace TalosAP;
+
+// How often the watchdog checks that the game is still running.
+static constexpr auto WATCHDOG_INTERVAL = std::chrono::milliseconds(250);
+
+static APSession* g_session = nullptr;
+
+static void ForwardLog(int32_t level, const std::wstring& line)
+{
+    if (!g_session) return;
+    APChannel::LogKind kind = APChannel::LogKind::Verbose;
+    if (level == LogLevel::Error)        kind = APChannel::LogKind::Error;
+    else if (level == LogLevel::Warning) kind = APChannel::LogKind::Warning;
+    g_session->EmitLog(kind, line);
+}
+
+static bool ProcessAlive(uint32_t pid)
+{
+#ifdef _WIN32
+    HANDLE h = OpenProcess(SYNCHRONIZE, FALSE, pid);
+    if (!h) return false;
+    bool alive = WaitForSingleObject(h, 0) == WAIT_TIMEOUT;
+    CloseHandle(h);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0;
+#endif
+}
+
+static uint32_t CurrentPid()
+{
+#ifdef _WIN32
+    return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+    return static_cast<uint32_t>(getpid());
+#endif
+}
+
+static int wmain_impl(int argc, wchar_t** argv)
+{
+    std::wstring channelName;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::wcscmp(argv[i], L"--channel") == 0) channelName = argv[i + 1];
+    }
+    if (channelName.empty()) {
+        std::fputws(L"usage: TalosAPHelper --channel <name>\n", stderr);
+        return 2;
+    }
+
+    MappedRegion region;
+    if (!region.OpenNamed(channelName, APChannel::TOTAL_BYTES, false)) {
+        Output::send<LogLevel::Error>(STR("[TalosAP][Helper] Could not open channel {}\n"), channelName);
+        return 1;
+    }
+    APChannel::View channel = APChannel::Attach(region.Data());
+    if (!channel.Valid()) {
+        Output::send<LogLevel::Error>(STR("[TalosAP][Helper] Channel {} is from a different build\n"), channelName);
+        return 1;
+    }
+    channel.control->sessionPid.store(CurrentPid());
+    const uint32_t modPid = channel.control->modPid;
+
+    APSession session(channel);
+    g_session = &session;
+    Output::SetSink(&ForwardLog);
+
+    if (!session.Start()) {
+        Output::SetSink(nullptr);
+        g_session = nullptr;
+        return 1;
+    }
+
+    // The game can die without setting stop; don't outlive it.
+    std::atomic<bool> stop{false};
+    std::thread watchdog([&] {
+        while (!stop.load()) {
+            if (!ProcessAlive(modPid)) {
+                stop = true;
+                break;
+            }
+            std::this_thread::sleep_for(WATCHDOG_INTERVAL);
+        }
+    });
+
+    session.Run(stop);
+
+    stop = true;
+    watchdog.join();
+    Output::SetSink(nullptr);
+    g_session = nullptr;
+    return 0;
+}
+
+#ifdef _WIN32
+int wmain(int argc, wchar_t** argv)
+{
+    return wmain_impl(argc, argv);
+}
+#else
+int main(int argc, char** argv)
+{
+    std::vector<std::wstring> wide;
+    std::vector<wchar_t*> ptrs;
+    for (int i = 0; i < argc; ++i) wide.emplace_back(argv[i], argv[i] + std::strlen(argv[i]));
+    for (auto& w : wide) ptrs.push_back(w.data());
+    return wmain_impl(argc, ptrs.data());
+}
+#endif
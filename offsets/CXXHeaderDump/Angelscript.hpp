@@ -0,0 +1,27 @@
+#ifndef UE4SS_SDK_Angelscript_HPP
+#define UE4SS_SDK_Angelscript_HPP
+
+// Excerpt of the UE4SS CXX header dump for The Talos Principle 2.
+// Trimmed to the types the mod reads by raw offset; other types and
+// members are elided. Refresh from a new dump after a game patch.
+
+class ALoweringFenceWhenTetrominoIsPickedUpBaseScript : public ATalosOneScript
+{
+    class ATetrominoItem* Tetromino;                                                  // 0x0330 (size: 0x8)
+    FTalosOneScriptVariableInfo LoweringFenceInfo;                                    // 0x0338 (size: 0x50)
+    class ALoweringFence* LoweringFence;                                              // 0x0388 (size: 0x8)
+
+}; // Size: 0x390
+
+class ALoweringFenceWhenTetrominoIsPickedUpScript : public ALoweringFenceWhenTetrominoIsPickedUpBaseScript
+{
+}; // Size: 0x390
+
+class AEclipseScript : public ATalosOneScript
+{
+    class ATetrominoItem* Tetromino;                                                  // 0x02E0 (size: 0x8)
+    class ALoweringFence* Fence;                                                      // 0x02E8 (size: 0x8)
+
+}; // Size: 0x2F0
+
+#endif
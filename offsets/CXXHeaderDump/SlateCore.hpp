@@ -0,0 +1,14 @@
+#ifndef UE4SS_SDK_SlateCore_HPP
+#define UE4SS_SDK_SlateCore_HPP
+
+// Excerpt of the UE4SS CXX header dump for The Talos Principle 2.
+// Trimmed to the types the mod reads by raw offset; other types and
+// members are elided. Refresh from a new dump after a game patch.
+
+struct FSlateFontInfo
+{
+    float Size;                                                                       // 0x0050 (size: 0x4)
+
+}; // Size: 0x68
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef UE4SS_SDK_Talos_HPP
+#define UE4SS_SDK_Talos_HPP
+
+// Excerpt of the UE4SS CXX header dump for The Talos Principle 2.
+// Trimmed to the types the mod reads by raw offset; other types and
+// members are elided. Refresh from a new dump after a game patch.
+
+struct FTalosOneEntityPointerInfo
+{
+    FString ClassName;                                                                // 0x0000 (size: 0x10)
+    int32 EntityID;                                                                   // 0x0010 (size: 0x4)
+    FString EntityName;                                                               // 0x0018 (size: 0x10)
+
+}; // Size: 0x28
+
+struct FTalosOneScriptVariableInfo
+{
+    TArray<FTalosOneEntityPointerInfo> EntityPointers;                                // 0x0040 (size: 0x10)
+
+}; // Size: 0x50
+
+#endif
@@ -0,0 +1,150 @@
+# ==============================================================================
+# GenerateOffsets.cmake — build GameOffsets.h from the checked-in header dump
+#
+#   cmake -DDUMP_DIR=<dir> -DMANIFEST=<offsets.txt> -DOUTPUT=<GameOffsets.h>
+#         -P GenerateOffsets.cmake
+#
+# Every manifest entry is looked up in DUMP_DIR/<Package>.hpp (UE4SS CXX
+# header dump format: "Type Member; // 0xOFFS (size: 0xSZ)" and a trailing
+# "}; // Size: 0xSZ"). A missing type or member fails the build, so a
+# refreshed dump that dropped a field is caught here rather than in game.
+# ==============================================================================
+
+cmake_minimum_required(VERSION 3.22)
+
+foreach(_var DUMP_DIR MANIFEST OUTPUT)
+    if(NOT DEFINED ${_var})
+        message(FATAL_ERROR "GenerateOffsets: ${_var} is not set")
+    endif()
+endforeach()
+
+# Dump lines are turned into CMake list elements, so the characters that
+# are special in lists (';' and '[' ']') are replaced first. Nothing the
+# parser matches depends on them.
+function(load_dump package out_var)
+    set(_path "${DUMP_DIR}/${package}.hpp")
+    if(NOT EXISTS "${_path}")
+        message(FATAL_ERROR "GenerateOffsets: no dump file ${_path}")
+    endif()
+    file(READ "${_path}" _content)
+    string(REPLACE ";" "," _content "${_content}")
+    string(REPLACE "[" "(" _content "${_content}")
+    string(REPLACE "]" ")" _content "${_content}")
+    string(REPLACE "\r" "" _content "${_content}")
+    string(REPLACE "\n" ";" _content "${_content}")
+    set(${out_var} "${_content}" PARENT_SCOPE)
+endfunction()
+
+# Find `member` (or the struct size, when member is "sizeof") of `type`.
+# Sets <out>_OFFSET and <out>_SIZE as hex strings without the 0x prefix.
+function(find_member package type member out)
+    load_dump(${package} _lines)
+    set(_in_block FALSE)
+    foreach(_line IN LISTS _lines)
+        if(NOT _in_block)
+            if(_line MATCHES "^(class|struct) [AUF]?${type}( |$)")
+                set(_in_block TRUE)
+            endif()
+            continue()
+        endif()
+
+        if(_line MATCHES "^}")
+            if(member STREQUAL "sizeof" AND _line MATCHES "// Size: 0x([0-9A-Fa-f]+)")
+                set(${out}_OFFSET "0" PARENT_SCOPE)
+                set(${out}_SIZE "${CMAKE_MATCH_1}" PARENT_SCOPE)
+                return()
+            endif()
+            break()
+        endif()
+
+        if(NOT member STREQUAL "sizeof" AND
+           _line MATCHES "[ *&]${member},[ \t]*// 0x([0-9A-Fa-f]+) \\(size: 0x([0-9A-Fa-f]+)\\)")
+            set(${out}_OFFSET "${CMAKE_MATCH_1}" PARENT_SCOPE)
+            set(${out}_SIZE "${CMAKE_MATCH_2}" PARENT_SCOPE)
+            return()
+        endif()
+    endforeach()
+
+    if(_in_block)
+        message(FATAL_ERROR "GenerateOffsets: ${package}.hpp: ${type} has no ${member}")
+    else()
+        message(FATAL_ERROR "GenerateOffsets: ${package}.hpp: type ${type} not found")
+    endif()
+endfunction()
+
+# ------------------------------------------------------------------------------
+# Walk the manifest, grouping entries by type in first-seen order
+# ------------------------------------------------------------------------------
+file(STRINGS "${MANIFEST}" _manifest)
+set(_types "")
+
+foreach(_entry IN LISTS _manifest)
+    string(STRIP "${_entry}" _entry)
+    if(_entry STREQUAL "" OR _entry MATCHES "^#")
+        continue()
+    endif()
+
+    string(REGEX REPLACE "[ \t]+" ";" _parts "${_entry}")
+    list(LENGTH _parts _count)
+    if(_count LESS 3)
+        message(FATAL_ERROR "GenerateOffsets: bad manifest line: ${_entry}")
+    endif()
+    list(GET _parts 0 _package)
+    list(GET _parts 1 _type)
+    list(GET _parts 2 _member)
+
+    if(NOT _type IN_LIST _types)
+        list(APPEND _types ${_type})
+        set(_package_${_type} ${_package})
+        set(_body_${_type} "")
+    endif()
+
+    find_member(${_package} ${_type} ${_member} _m)
+
+    if(_member STREQUAL "sizeof")
+        string(APPEND _body_${_type}
+            "    static constexpr size_t STATIC_SIZE = 0x${_m_SIZE};\n"
+            "    static inline GameStructSize SIZE{ PATH, 0x${_m_SIZE} };\n")
+    else()
+        if(_count LESS 4)
+            message(FATAL_ERROR "GenerateOffsets: ${_type}.${_member} needs a C++ type")
+        endif()
+        list(GET _parts 3 _cxx)
+        if(_cxx STREQUAL "UObject*")
+            set(_cxx "RC::Unreal::UObject*")
+        elseif(_cxx STREQUAL "Bytes")
+            set(_cxx "uint8_t")
+        endif()
+        string(APPEND _body_${_type}
+            "    static inline GameField<${_cxx}> ${_member}{ PATH, L\"${_member}\", 0x${_m_OFFSET}, 0x${_m_SIZE} };\n")
+    endif()
+endforeach()
+
+# ------------------------------------------------------------------------------
+# Emit
+# ------------------------------------------------------------------------------
+string(CONCAT _out "// Generated by offsets/GenerateOffsets.cmake from offsets/CXXHeaderDump.\n"
+                  "// Do not edit: change offsets/offsets.txt or refresh the dump instead.\n"
+                  "#pragma once\n\n"
+                  "#include \"GameLayout.h\"\n\n"
+                  "namespace TalosAP::GameOffsets {\n")
+
+foreach(_type IN LISTS _types)
+    string(APPEND _out
+        "\n/// /Script/${_package_${_type}}.${_type}\n"
+        "struct ${_type} {\n"
+        "    static constexpr const wchar_t* PATH = L\"/Script/${_package_${_type}}.${_type}\";\n"
+        "${_body_${_type}}"
+        "};\n")
+endforeach()
+
+string(APPEND _out "\n} // namespace TalosAP::GameOffsets\n")
+
+# Only touch the file when it changes, so unrelated builds stay incremental.
+set(_old "")
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" _old)
+endif()
+if(NOT _old STREQUAL _out)
+    file(WRITE "${OUTPUT}" "${_out}")
+endif()
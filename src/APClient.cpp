@@ -1,49 +1,55 @@
-// Include wswrap + websocketpp backend before apclientpp
-#include <wswrap.hpp>
-
-// apclientpp (header-only Archipelago client)
-#include <apclient.hpp>
-#include <apuuid.hpp>
-
 #include "headers/APClient.h"
+#include "headers/APSession.h"
+#include "headers/Latency.h"
+#include "headers/StateExport.h"
+#include "headers/TraceRecorder.h"
+#include "headers/Utf.h"
 
 #include <DynamicOutput/DynamicOutput.hpp>
-#include <nlohmann/json.hpp>
 
-#include <list>
-#include <set>
-#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <vector>
 
-using namespace RC;
-using json = nlohmann::json;
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
-// ============================================================
-// Map AP named-color strings to HUD LinearColors
-// (mirrors the Lua AP_NAMED_COLORS table)
-// ============================================================
-static const std::unordered_map<std::string, TalosAP::LinearColor> AP_NAMED_COLORS = {
-    {"red",       TalosAP::HudColors::TRAP},
-    {"green",     TalosAP::HudColors::ITEM},
-    {"blue",      TalosAP::HudColors::USEFUL},
-    {"slateblue", TalosAP::HudColors::USEFUL},
-    {"magenta",   TalosAP::HudColors::PROGRESSION},
-    {"purple",    TalosAP::HudColors::PROGRESSION},
-    {"plum",      TalosAP::HudColors::PROGRESSION},
-    {"yellow",    TalosAP::HudColors::LOCATION},
-    {"cyan",      TalosAP::HudColors::PLAYER},
-    {"salmon",    TalosAP::HudColors::TRAP},
-    {"white",     TalosAP::HudColors::WHITE},
-    {"black",     TalosAP::HudColors::WHITE},  // don't render invisible text
-};
+using namespace RC;
 
 namespace TalosAP {
 
-// ============================================================
-// Impl — hides the APClient (from apclientpp) from the header
-// ============================================================
-struct APClientWrapper::Impl {
-    std::unique_ptr<APClient> ap;
-};
+using APChannel::Event;
+using APChannel::Writer;
+
+// Events applied per Poll(). A reconnect's item replay or a PrintJSON burst
+// is spread over a few ticks instead of landing in one.
+static constexpr size_t MAX_EVENTS_PER_POLL = 256;
+
+// How long shutdown waits for the helper to see the stop flag.
+static constexpr uint32_t HELPER_EXIT_WAIT_MS = 500;
+
+static constexpr const wchar_t* HELPER_EXE = L"TalosAPHelper.exe";
+
+static uint32_t CurrentPid()
+{
+#ifdef _WIN32
+    return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+    return static_cast<uint32_t>(getpid());
+#endif
+}
+
+static void CopyField(char* dst, size_t cap, const std::string& src)
+{
+    size_t n = std::min(src.size(), cap - 1);
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
 
 // ============================================================
 // Construction / Destruction
@@ -53,430 +59,441 @@ APClientWrapper::APClientWrapper() = default;
 
 APClientWrapper::~APClientWrapper()
 {
-    // Impl destructor destroys the APClient, cleaning up the socket
-    m_impl.reset();
+    StopSession();
+    m_region.Close();
+}
+
+void APClientWrapper::StopSession()
+{
+    if (m_channel.control) {
+        m_channel.control->stop.store(1);
+    }
+    m_stop = true;
+    if (m_sessionThread.joinable()) {
+        m_sessionThread.join();
+    }
+    m_session.reset();
+
+#ifdef _WIN32
+    if (m_helperProcess) {
+        HANDLE process = static_cast<HANDLE>(m_helperProcess);
+        if (WaitForSingleObject(process, HELPER_EXIT_WAIT_MS) != WAIT_OBJECT_0) {
+            TerminateProcess(process, 1);
+        }
+        CloseHandle(process);
+    }
+#endif
+    m_helperProcess = nullptr;
 }
 
 // ============================================================
-// Init
+// Start
 // ============================================================
 
-bool APClientWrapper::Init(const Config& config, ModState& state, ItemMapping& itemMapping,
-                          HudNotification* hud)
+bool APClientWrapper::Start(const Config& config, ModState& state, ItemMapping& itemMapping,
+                            const std::wstring& modDir)
 {
-    m_config      = config;
     m_state       = &state;
     m_itemMapping = &itemMapping;
-    m_hud         = hud;
 
-    m_impl = std::make_unique<Impl>();
+    const uint32_t pid = CurrentPid();
+    if (!m_region.OpenNamed(APChannel::NameFor(pid), APChannel::TOTAL_BYTES, true)) {
+        Output::send<LogLevel::Error>(STR("[TalosAP] Could not create the AP channel\n"));
+        return false;
+    }
+    m_channel = APChannel::Create(m_region.Data(), pid);
+
+    auto& info = m_channel.control->connect;
+    CopyField(info.server,   sizeof(info.server),   config.server_str);
+    CopyField(info.slot,     sizeof(info.slot),     config.slot_name_str);
+    CopyField(info.password, sizeof(info.password), config.password_str);
+    CopyField(info.game,     sizeof(info.game),     config.game_str);
+    info.flags = config.wire_capture ? APChannel::CONNECT_WIRE_CAPTURE : 0;
+
+    if (config.network_helper) {
+        if (StartHelper(modDir)) return true;
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Network helper unavailable — running the AP session in-process\n"));
+    }
+    return StartInProcess();
+}
 
-    try {
-        // Generate or load a persistent UUID for this client
-        std::string uuid = ap_get_uuid("talos_ap_uuid.txt");
+bool APClientWrapper::StartInProcess()
+{
+    m_stop = false;
+    m_channel.control->stop.store(0);
+    m_channel.control->sessionPid.store(0);
 
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Creating AP client: game='{}', server='{}'\n"),
-            std::wstring(config.game_str.begin(), config.game_str.end()),
-            std::wstring(config.server_str.begin(), config.server_str.end()));
+    m_session = std::make_unique<APSession>(m_channel);
+    if (!m_session->Start()) {
+        m_session.reset();
+        return false;
+    }
+    m_sessionThread = std::thread([this] { m_session->Run(m_stop); });
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] AP session started on its network thread\n"));
+    return true;
+}
 
-        m_impl->ap = std::make_unique<APClient>(uuid, config.game_str, config.server_str);
+bool APClientWrapper::StartHelper(const std::wstring& modDir)
+{
+#ifdef _WIN32
+    std::filesystem::path exe = std::filesystem::path(modDir) / L"dlls" / HELPER_EXE;
+    std::error_code ec;
+    if (modDir.empty() || !std::filesystem::exists(exe, ec)) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] {} not found\n"), exe.wstring());
+        return false;
     }
-    catch (const std::exception& e) {
-        Output::send<LogLevel::Error>(STR("[TalosAP] Failed to create AP client: {}\n"),
-            std::wstring(e.what(), e.what() + strlen(e.what())));
-        m_impl.reset();
+
+    // CreateProcessW may write to the command line buffer
+    std::wstring cmd = L"\"" + exe.wstring() + L"\" --channel " + APChannel::NameFor(m_channel.control->modPid);
+    std::vector<wchar_t> cmdBuf(cmd.begin(), cmd.end());
+    cmdBuf.push_back(L'\0');
+
+    STARTUPINFOW si{};
+    si.cb = sizeof(si);
+    PROCESS_INFORMATION pi{};
+    // Inherits the game's working directory, where the UUID and data
+    // package cache live.
+    if (!CreateProcessW(exe.c_str(), cmdBuf.data(), nullptr, nullptr, FALSE,
+                        CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi)) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Could not start {} (error {})\n"),
+            exe.wstring(), static_cast<uint32_t>(GetLastError()));
         return false;
     }
+    CloseHandle(pi.hThread);
+    m_helperProcess = pi.hProcess;
 
-    auto& ap = *m_impl->ap;
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] AP session started in {} (pid {})\n"),
+        HELPER_EXE, static_cast<uint32_t>(pi.dwProcessId));
+    return true;
+#else
+    (void)modDir;
+    return false;
+#endif
+}
 
-    // ============================================================
-    // Register event handlers
-    // All callbacks fire from within poll() on the game thread.
-    // ============================================================
+bool APClientWrapper::HelperExited() const
+{
+#ifdef _WIN32
+    return m_helperProcess
+        && WaitForSingleObject(static_cast<HANDLE>(m_helperProcess), 0) == WAIT_OBJECT_0;
+#else
+    return false;
+#endif
+}
 
-    ap.set_socket_connected_handler([this]() {
-        m_connected = true;
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Socket connected to server\n"));
-        if (m_hud) {
-            m_hud->NotifySimple(L"Connected to AP server", HudColors::SERVER);
-        }
-    });
+void APClientWrapper::SetHud(HudNotification* hud)
+{
+    m_hud = hud;
+}
 
-    ap.set_socket_disconnected_handler([this]() {
-        m_connected = false;
-        m_slotConnected = false;
-        Output::send<LogLevel::Warning>(STR("[TalosAP] Socket disconnected\n"));
-        if (m_hud) {
-            m_hud->NotifySimple(L"Disconnected from AP server", HudColors::TRAP);
-        }
-    });
-
-    ap.set_socket_error_handler([this](const std::string& msg) {
-        Output::send<LogLevel::Error>(STR("[TalosAP] Socket error: {}\n"),
-            std::wstring(msg.begin(), msg.end()));
-    });
-
-    ap.set_room_info_handler([this]() {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Room info received, connecting slot '{}'\n"),
-            m_config.slot_name);
-
-        if (m_impl && m_impl->ap) {
-            m_impl->ap->ConnectSlot(
-                m_config.slot_name_str,
-                m_config.password_str,
-                7,  // items_handling: receive from all sources (0b111)
-                {"AP"},
-                {0, 5, 1}  // AP protocol version
-            );
-        }
-    });
+// ============================================================
+// Poll — apply session events on the game thread
+// ============================================================
 
-    ap.set_slot_connected_handler([this](const json& slotData) {
-        m_slotConnected = true;
+void APClientWrapper::Poll()
+{
+    if (!m_channel.Valid()) return;
 
-        if (m_impl && m_impl->ap) {
-            m_playerSlot = m_impl->ap->get_player_number();
-            m_teamNumber = m_impl->ap->get_team_number();
+    m_channel.toMod.Drain([this](uint16_t type, const uint8_t* data, uint32_t size) {
+        APChannel::Reader r(data, size);
+        try {
+            ApplyEvent(static_cast<Event>(type), r);
         }
-
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Slot connected! player={} team={}\n"),
-            m_playerSlot, m_teamNumber);
-
-        // Reset item counters for a clean replay of items
-        m_itemMapping->ResetItemCounters();
-        m_state->GrantedItems.clear();
-
-        // Restore checked locations from the server
-        if (m_impl && m_impl->ap) {
-            auto serverChecked = m_impl->ap->get_checked_locations();
-            int restoredCount = 0;
-            for (int64_t locId : serverChecked) {
-                std::string tetId = m_itemMapping->GetLocationName(locId);
-                if (!tetId.empty()) {
-                    m_state->MarkLocationChecked(tetId);
-                    ++restoredCount;
-                }
-            }
-            if (restoredCount > 0) {
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] Restored {} checked locations from server\n"),
-                    restoredCount);
-            }
-
-            // Send locally-checked locations the server doesn't know about
-            auto serverCheckedSet = m_impl->ap->get_checked_locations();
-            std::list<int64_t> toSend;
-            for (const auto& tetId : m_state->CheckedLocations) {
-                int64_t locId = m_itemMapping->GetLocationId(tetId);
-                if (locId >= 0 && serverCheckedSet.count(locId) == 0) {
-                    toSend.push_back(locId);
-                }
-            }
-            if (!toSend.empty()) {
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] Sending {} locally checked locations to server\n"),
-                    toSend.size());
-                m_impl->ap->LocationChecks(toSend);
-            }
+        catch (const std::exception& e) {
+            Output::send<LogLevel::Error>(STR("[TalosAP] AP event exception: {}\n"),
+                Utf::ToWide(e.what()));
         }
-
-        // Read slot_data settings
-        if (slotData.contains("reusable_tetrominos")) {
-            int reusable = slotData["reusable_tetrominos"].get<int>();
-            m_state->ReusableTetrominos = (reusable != 0);
-            Output::send<LogLevel::Verbose>(STR("[TalosAP] reusable_tetrominos = {}\n"),
-                m_state->ReusableTetrominos ? L"true" : L"false");
+    }, MAX_EVENTS_PER_POLL);
+
+    // The helper is gone (crashed, killed): everything it sent has been
+    // applied above, so pick up the connection on a thread here.
+    if (HelperExited()) {
+#ifdef _WIN32
+        CloseHandle(static_cast<HANDLE>(m_helperProcess));
+#endif
+        m_helperProcess = nullptr;
+        m_connected     = false;
+        m_slotConnected = false;
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Network helper exited — restarting the AP session in-process\n"));
+        if (m_hud) {
+            m_hud->NotifySimple(L"Network helper stopped — reconnecting", HudColors::TRAP);
         }
+        StartInProcess();
+    }
+}
 
-        // Mark AP as synced — enforcement can now begin
-        m_state->APSynced = true;
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] APSynced = true — enforcement enabled\n"));
-
-        // Send playing status
-        if (m_impl && m_impl->ap) {
-            m_impl->ap->StatusUpdate(APClient::ClientStatus::PLAYING);
+void APClientWrapper::ApplyEvent(Event type, APChannel::Reader& r)
+{
+    switch (type) {
+        case Event::Log: {
+            auto kind = static_cast<APChannel::LogKind>(r.Get<uint8_t>());
+            std::wstring text = r.GetText();
+            switch (kind) {
+                case APChannel::LogKind::Error:   Output::send<LogLevel::Error>(STR("{}"), text);   break;
+                case APChannel::LogKind::Warning: Output::send<LogLevel::Warning>(STR("{}"), text); break;
+                default:                          Output::send<LogLevel::Verbose>(STR("{}"), text); break;
+            }
+            break;
         }
 
-        // HUD notification
-        if (m_hud) {
-            m_hud->NotifySimple(L"Slot connected — game synced!", HudColors::SERVER);
+        case Event::SocketConnected: {
+            TraceScope trace("AP.SocketConnected", "ap");
+            int64_t connectedNs = r.Get<int64_t>();
+            m_connected = true;
+            auto& latency = LatencyStats::Get();
+            latency.Record(LatencyPath::EventDelivery, MonoNs() - connectedNs);
+            latency.Begin(LatencyPath::ConnectSynced, connectedNs);
+            // Checks picked up offline or on the last socket are resent
+            // on slot connect; their confirmations would time the outage.
+            latency.ClearPending(LatencyPath::CheckConfirm);
+            if (m_hud) {
+                m_hud->NotifySimple(L"Connected to AP server", HudColors::SERVER);
+            }
+            break;
         }
-    });
 
-    ap.set_slot_refused_handler([this](const std::list<std::string>& reasons) {
-        m_slotConnected = false;
-        std::string msg;
-        for (const auto& r : reasons) {
-            if (!msg.empty()) msg += ", ";
-            msg += r;
-        }
-        Output::send<LogLevel::Error>(STR("[TalosAP] Connection refused: {}\n"),
-            std::wstring(msg.begin(), msg.end()));
-        if (m_hud) {
-            std::wstring wMsg(msg.begin(), msg.end());
-            m_hud->Notify({
-                { L"Connection refused: ", HudColors::TRAP },
-                { wMsg,                    HudColors::WHITE },
-            });
+        case Event::SocketDisconnected: {
+            TraceScope trace("AP.SocketDisconnected", "ap");
+            // Enforcement keeps running on the current GrantedItems
+            m_connected = false;
+            m_slotConnected = false;
+            if (m_hud) {
+                m_hud->NotifySimple(L"Disconnected from AP server", HudColors::TRAP);
+            }
+            break;
         }
-    });
 
-    ap.set_items_received_handler([this](const std::list<APClient::NetworkItem>& items) {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Received {} items\n"), items.size());
+        case Event::SlotConnected: {
+            TraceScope trace("AP.SlotConnected", "ap");
+            m_playerSlot = r.Get<int32_t>();
+            m_teamNumber = r.Get<int32_t>();
+            int8_t  reusable = r.Get<int8_t>();
+            uint8_t resumed  = r.Get<uint8_t>();
+            r.Get<int32_t>();  // keptItems — logged by the session
+            m_slotConnected = true;
+
+            // A fresh session replays every item; a resumed one only sends
+            // what is new, so the current grants stay.
+            if (!resumed) {
+                m_state->GrantedItems.clear();
+                StateExport::Get().GrantsReset();
+            }
 
-        int grantedCount = 0;
-        int nonTetrominoCount = 0;
+            if (reusable >= 0) {
+                m_state->ReusableTetrominos = (reusable != 0);
+                Output::send<LogLevel::Verbose>(STR("[TalosAP] reusable_tetrominos = {}\n"),
+                    m_state->ReusableTetrominos ? L"true" : L"false");
+            }
 
-        for (const auto& item : items) {
-            auto tetId = m_itemMapping->ResolveNextItem(item.item);
+            // Locally checked locations the server may not know about
+            SendCheckedLocations();
+            m_saveDiffDue = !resumed && m_state->SaveSeeded;
 
-            // Resolve display name: prefer our local mapping, fall back to AP data package
-            std::string displayName;
-            if (tetId.has_value()) {
-                displayName = m_itemMapping->GetDisplayName(item.item);
-                if (displayName.empty()) displayName = tetId.value();
-            }
-            if (displayName.empty() && m_impl && m_impl->ap) {
-                // Use AP library to look up item name from the data package
-                try {
-                    std::string game = m_impl->ap->get_player_game(m_impl->ap->get_player_number());
-                    displayName = m_impl->ap->get_item_name(item.item, game);
-                    if (displayName == "Unknown") displayName.clear();
-                } catch (...) {}
-            }
-            if (displayName.empty()) {
-                displayName = "Item #" + std::to_string(item.item);
-            }
+            // Mark AP as synced — enforcement can now begin
+            m_state->APSynced = true;
+            LatencyStats::Get().End(LatencyPath::ConnectSynced);
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] APSynced = true — enforcement enabled\n"));
 
-            if (tetId.has_value()) {
-                // Grant the tetromino — add to GrantedItems set.
-                m_state->GrantedItems.insert(tetId.value());
-                ++grantedCount;
-            } else {
-                // Non-tetromino item (e.g. trap, filler, progression unlock)
-                ++nonTetrominoCount;
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] Non-tetromino item received: {} (0x{:X}) = {}\n"),
-                    item.item, item.item,
-                    std::wstring(displayName.begin(), displayName.end()));
+            if (m_hud) {
+                m_hud->NotifySimple(L"Slot connected — game synced!", HudColors::SERVER);
             }
+            break;
+        }
 
-            // Notifications are shown for ALL items, not just tetrominoes
-            bool isSelf = (item.player == m_playerSlot);
-            if (!isSelf) {
-                std::string senderName = GetPlayerName(item.player);
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] {} sent you {}\n"),
-                    std::wstring(senderName.begin(), senderName.end()),
-                    std::wstring(displayName.begin(), displayName.end()));
-
-                if (m_hud) {
-                    int flags = item.flags;
-                    LinearColor itemColor = ColorForFlags(flags);
-                    std::wstring wSender(senderName.begin(), senderName.end());
-                    std::wstring wDisplay(displayName.begin(), displayName.end());
-                    m_hud->Notify({
-                        { wSender,          HudColors::PLAYER },
-                        { L" sent you ",    HudColors::WHITE  },
-                        { wDisplay,         itemColor         },
-                    });
-                }
-            } else {
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] You found {}\n"),
-                    std::wstring(displayName.begin(), displayName.end()));
-
-                if (m_hud) {
-                    int flags = item.flags;
-                    LinearColor itemColor = ColorForFlags(flags);
-                    std::wstring wDisplay(displayName.begin(), displayName.end());
-                    m_hud->Notify({
-                        { L"You found ",  HudColors::WHITE },
-                        { wDisplay,       itemColor        },
-                    });
-                }
+        case Event::SlotRefused: {
+            TraceScope trace("AP.SlotRefused", "ap");
+            m_slotConnected = false;
+            std::wstring msg = r.GetText();
+            if (m_hud) {
+                m_hud->Notify({
+                    { L"Connection refused: ", HudColors::TRAP },
+                    { msg,                     HudColors::WHITE },
+                });
             }
+            break;
         }
 
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Processed items: {} tetrominoes, {} other\n"),
-            grantedCount, nonTetrominoCount);
-
-        // Ensure APSynced is set
-        m_state->APSynced = true;
-    });
-
-    ap.set_location_checked_handler([this](const std::list<int64_t>& locations) {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Server confirmed {} location checks\n"),
-            locations.size());
-
-        for (int64_t locId : locations) {
-            std::string tetId = m_itemMapping->GetLocationName(locId);
-            if (!tetId.empty()) {
+        case Event::LocationConfirmed: {
+            ItemId tetId = r.GetId();
+            int64_t confirmedNs = r.Get<int64_t>();
+            if (!r.Failed() && !tetId.empty()) {
+                auto& latency = LatencyStats::Get();
+                latency.Record(LatencyPath::EventDelivery, MonoNs() - confirmedNs);
+                latency.Finish(LatencyPath::CheckConfirm, tetId, confirmedNs);
                 m_state->MarkLocationChecked(tetId);
+                StateExport::Get().Checked(tetId);
             }
+            break;
         }
-    });
-
-    // ============================================================
-    // PrintJSON — other-player activity, hints, chat, countdown, etc.
-    // This is how we see messages like "PlayerX found ItemY at LocationZ"
-    // for other players in the multiworld session.
-    // ============================================================
-    ap.set_print_json_handler([this](const APClient::PrintJSONArgs& args) {
-        if (!m_impl || !m_impl->ap) return;
-
-        // Suppress self-to-self ItemSend — our items_received_handler
-        // already shows "You found ..." for those.
-        if (args.type == "ItemSend"
-            && args.receiving && *args.receiving == m_playerSlot
-            && args.item && args.item->player == m_playerSlot) {
-            return;
-        }
-
-        // Build colored segments from the TextNode list
-        std::vector<TextSegment> segments;
-        std::string plainText;
 
-        for (const auto& node : args.data) {
-            std::string text;
-            LinearColor color = HudColors::WHITE;
-
-            if (node.type == "player_id") {
-                int slot = 0;
-                try { slot = std::stoi(node.text); } catch (...) {}
-                text = GetPlayerName(slot);
-                color = HudColors::PLAYER;
-            }
-            else if (node.type == "item_id") {
-                int64_t id = 0;
-                try { id = std::stoll(node.text); } catch (...) {}
-                try {
-                    std::string game = m_impl->ap->get_player_game(node.player);
-                    text = m_impl->ap->get_item_name(id, game);
-                } catch (...) { text = "Unknown Item"; }
-                color = ColorForFlags(node.flags);
-            }
-            else if (node.type == "item_name") {
-                text = node.text;
-                color = ColorForFlags(node.flags);
-            }
-            else if (node.type == "location_id") {
-                int64_t id = 0;
-                try { id = std::stoll(node.text); } catch (...) {}
-                try {
-                    std::string game = m_impl->ap->get_player_game(node.player);
-                    text = m_impl->ap->get_location_name(id, game);
-                } catch (...) { text = "Unknown Location"; }
-                color = HudColors::LOCATION;
+        case Event::Grant: {
+            ItemId tetId = r.GetId();
+            int64_t receivedNs = r.Get<int64_t>();
+            if (!r.Failed() && !tetId.empty()) {
+                auto& latency = LatencyStats::Get();
+                latency.Record(LatencyPath::EventDelivery, MonoNs() - receivedNs);
+                // InventorySync finishes it, or cancels it if already held
+                latency.Start(LatencyPath::ItemCollected, tetId, receivedNs);
+                m_state->GrantedItems.insert(tetId);
+                TraceRecorder::Get().Instant("Grant", "item", tetId.c_str());
+                StateExport::Get().Granted(tetId);
             }
-            else if (node.type == "location_name") {
-                text = node.text;
-                color = HudColors::LOCATION;
-            }
-            else if (node.type == "entrance_name") {
-                text = node.text;
-                color = HudColors::ENTRANCE;
+            break;
+        }
+
+        case Event::ItemsDone:
+            // Ensure APSynced is set
+            m_state->APSynced = true;
+            if (m_saveDiffDue) {
+                m_saveDiffDue = false;
+                LogSaveDiff();
             }
-            else if (node.type == "color") {
-                text = node.text;
-                auto it = AP_NAMED_COLORS.find(node.color);
-                color = (it != AP_NAMED_COLORS.end()) ? it->second : HudColors::WHITE;
+            break;
+
+        case Event::Notify: {
+            TraceScope trace("AP.Notify", "ap");
+            bool chat = r.Get<uint8_t>() != 0;
+            HudLine line;
+            r.GetLine(line);
+            if (line.Empty()) break;
+
+            if (chat) {
+                // Log the plain text
+                Output::send<LogLevel::Verbose>(STR("[TalosAP][Chat] {}\n"), line.Text());
             }
-            else {
-                // "text" type or unknown — plain white
-                text = node.text;
+            if (m_hud) {
+                m_hud->Notify(std::move(line));
             }
+            break;
+        }
 
-            if (!text.empty()) {
-                plainText += text;
-                std::wstring wText(text.begin(), text.end());
-                segments.push_back({ wText, color });
+        case Event::Scouted: {
+            ItemId tetId = r.GetId();
+            int32_t flags = r.Get<int32_t>();
+            std::wstring item   = r.GetText();
+            std::wstring player = r.GetText();
+            if (!r.Failed() && !tetId.empty()) {
+                StateExport::Get().Scouted(tetId, Utf::ToUtf8(item), Utf::ToUtf8(player), flags);
             }
+            break;
         }
 
-        if (segments.empty()) return;
-
-        // Log the plain text
-        Output::send<LogLevel::Verbose>(STR("[TalosAP][Chat] {}\n"),
-            std::wstring(plainText.begin(), plainText.end()));
-
-        // Show on HUD
-        if (m_hud) {
-            m_hud->Notify(segments);
+        case Event::ServerRtt: {
+            int64_t rttNs = r.Get<int64_t>();
+            if (!r.Failed()) {
+                LatencyStats::Get().Record(LatencyPath::ServerRtt, rttNs);
+            }
+            break;
         }
-    });
+    }
+}
 
-    Output::send<LogLevel::Verbose>(STR("[TalosAP] AP client initialized, connection will start on poll()\n"));
-    return true;
+/// What enforcement is about to change in the save's collection: the
+/// save was read at startup, the grants are the server's full replay.
+void APClientWrapper::LogSaveDiff() const
+{
+    size_t onlySaved = 0, onlyGranted = 0;
+    for (const auto& id : m_state->SavedTetrominos) {
+        if (!m_state->GrantedItems.contains(id)) ++onlySaved;
+    }
+    for (const auto& id : m_state->GrantedItems) {
+        if (!m_state->SavedTetrominos.contains(id)) ++onlyGranted;
+    }
+    Output::send<LogLevel::Verbose>(
+        STR("[TalosAP] Save vs server: {} in save, {} granted — {} to remove, {} to add\n"),
+        m_state->SavedTetrominos.size(), m_state->GrantedItems.size(), onlySaved, onlyGranted);
 }
 
 // ============================================================
-// Poll
+// Send actions
 // ============================================================
 
-void APClientWrapper::Poll()
+bool APClientWrapper::SendCommand(APChannel::Command type, const Writer& payload)
 {
-    if (!m_impl || !m_impl->ap) return;
+    if (!m_channel.Valid()) return false;
+    if (!m_channel.toSession.TryWrite(static_cast<uint16_t>(type), payload.Data(), payload.Size())) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] AP command queue full — dropped\n"));
+        return false;
+    }
+    return true;
+}
 
-    try {
-        m_impl->ap->poll();
+void APClientWrapper::SendCheckedLocations()
+{
+    // The session filters out what the server already has. Split so each
+    // record stays under MAX_RECORD.
+    constexpr uint32_t PER_RECORD = (APChannel::MAX_RECORD - sizeof(uint32_t)) / sizeof(int64_t);
+    std::vector<int64_t> ids;
+    ids.reserve(m_state->CheckedLocations.size());
+    for (const auto& tetId : m_state->CheckedLocations) {
+        int64_t locId = m_itemMapping->GetLocationId(tetId);
+        if (locId >= 0) ids.push_back(locId);
     }
-    catch (const std::exception& e) {
-        Output::send<LogLevel::Error>(STR("[TalosAP] Poll exception: {}\n"),
-            std::wstring(e.what(), e.what() + strlen(e.what())));
+    for (size_t i = 0; i < ids.size(); i += PER_RECORD) {
+        uint32_t n = static_cast<uint32_t>(std::min<size_t>(PER_RECORD, ids.size() - i));
+        Writer w;
+        w.Put(n);
+        for (uint32_t k = 0; k < n; ++k) w.Put(ids[i + k]);
+        SendCommand(APChannel::Command::LocationChecks, w);
     }
 }
 
-// ============================================================
-// Send actions
-// ============================================================
-
 void APClientWrapper::SendLocationCheck(int64_t locationId)
 {
-    if (!m_impl || !m_impl->ap || !m_slotConnected) {
+    if (!m_slotConnected) {
+        // Not lost: the full checked list is sent on the next slot connect
         Output::send<LogLevel::Warning>(STR("[TalosAP] Cannot send location check — not connected\n"));
         return;
     }
 
-    m_impl->ap->LocationChecks({locationId});
-    Output::send<LogLevel::Verbose>(STR("[TalosAP] Sent location check: {}\n"), locationId);
+    Writer w;
+    w.Put(uint32_t{1});
+    w.Put(locationId);
+    if (SendCommand(APChannel::Command::LocationChecks, w)) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Sent location check: {}\n"), locationId);
+    }
 }
 
 void APClientWrapper::SendGoalComplete()
 {
-    if (!m_impl || !m_impl->ap || !m_slotConnected) {
+    if (!m_slotConnected) {
         Output::send<LogLevel::Warning>(STR("[TalosAP] Cannot send goal — not connected\n"));
         return;
     }
-
-    m_impl->ap->StatusUpdate(APClient::ClientStatus::GOAL);
-    Output::send<LogLevel::Verbose>(STR("[TalosAP] Sent goal completion!\n"));
+    Writer w;
+    SendCommand(APChannel::Command::Goal, w);
 }
 
 // ============================================================
 // Status
 // ============================================================
 
-std::string APClientWrapper::GetStatusString() const
+void APClientWrapper::PublishMetrics(LiveMetrics& metrics) const
 {
-    if (!m_impl || !m_impl->ap) return "not initialized";
-    auto state = m_impl->ap->get_state();
-    switch (state) {
-        case APClient::State::DISCONNECTED:       return "disconnected";
-        case APClient::State::SOCKET_CONNECTING:  return "connecting";
-        case APClient::State::SOCKET_CONNECTED:   return "socket connected";
-        case APClient::State::ROOM_INFO:          return "room info received";
-        case APClient::State::SLOT_CONNECTED:     return "slot connected";
-        default:                                  return "unknown";
-    }
+    if (!m_channel.Valid()) return;
+    const auto& c = *m_channel.control;
+    metrics.SetGauge(MetricGauge::LinkState,        c.linkState.load(std::memory_order_relaxed));
+    metrics.SetGauge(MetricGauge::SlotConnected,    m_slotConnected ? 1 : 0);
+    metrics.SetGauge(MetricGauge::SessionPid,       c.sessionPid.load(std::memory_order_relaxed));
+    metrics.SetGauge(MetricGauge::SessionHeartbeat, c.heartbeat.load(std::memory_order_relaxed));
+    metrics.SetGauge(MetricGauge::NextItemIndex,
+        static_cast<uint64_t>(std::max(0, c.nextItemIndex.load(std::memory_order_relaxed))));
+    metrics.SetGauge(MetricGauge::ToModBytes,       m_channel.toMod.UsedBytes());
+    metrics.SetGauge(MetricGauge::ToSessionBytes,   m_channel.toSession.UsedBytes());
 }
 
-std::string APClientWrapper::GetPlayerName(int slot) const
+std::string APClientWrapper::GetStatusString() const
 {
-    if (slot == 0) return "Server";
-    if (m_impl && m_impl->ap) {
-        try {
-            std::string alias = m_impl->ap->get_player_alias(slot);
-            if (!alias.empty()) return alias;
-        } catch (...) {}
+    if (!m_channel.Valid()) return "not initialized";
+    auto state = static_cast<APChannel::LinkState>(m_channel.control->linkState.load(std::memory_order_relaxed));
+    switch (state) {
+        case APChannel::LinkState::Disconnected:      return "disconnected";
+        case APChannel::LinkState::SocketConnecting:  return "connecting";
+        case APChannel::LinkState::SocketConnected:   return "socket connected";
+        case APChannel::LinkState::RoomInfo:          return "room info received";
+        case APChannel::LinkState::SlotConnected:     return "slot connected";
+        default:                                      return "unknown";
     }
-    return "Player " + std::to_string(slot);
 }
 
 } // namespace TalosAP
@@ -0,0 +1,1002 @@
+// Include wswrap + websocketpp backend before apclientpp
+#include <wswrap.hpp>
+
+// apclientpp (header-only Archipelago client)
+#include <apclient.hpp>
+#include <apuuid.hpp>
+
+#include "headers/APSession.h"
+#include "headers/Latency.h"
+#include "headers/TlsSessionCache.h"
+#include "headers/TraceRecorder.h"
+#include "headers/Utf.h"
+#include "headers/WireCapture.h"
+#include "headers/WsStats.h"
+
+#include <DynamicOutput/DynamicOutput.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <thread>
+#include <unordered_map>
+
+using namespace RC;
+using json = nlohmann::json;
+
+// ============================================================
+// Map AP named-color strings to HUD LinearColors
+// (mirrors the Lua AP_NAMED_COLORS table)
+// ============================================================
+static const std::unordered_map<std::string, TalosAP::LinearColor> AP_NAMED_COLORS = {
+    {"red",       TalosAP::HudColors::TRAP},
+    {"green",     TalosAP::HudColors::ITEM},
+    {"blue",      TalosAP::HudColors::USEFUL},
+    {"slateblue", TalosAP::HudColors::USEFUL},
+    {"magenta",   TalosAP::HudColors::PROGRESSION},
+    {"purple",    TalosAP::HudColors::PROGRESSION},
+    {"plum",      TalosAP::HudColors::PROGRESSION},
+    {"yellow",    TalosAP::HudColors::LOCATION},
+    {"cyan",      TalosAP::HudColors::PLAYER},
+    {"salmon",    TalosAP::HudColors::TRAP},
+    {"white",     TalosAP::HudColors::WHITE},
+    {"black",     TalosAP::HudColors::WHITE},  // don't render invisible text
+};
+
+// ============================================================
+// apclientpp types back to AP packet JSON (wire capture / replay)
+// ============================================================
+static json ItemToJson(const APClient::NetworkItem& item)
+{
+    return { {"item", item.item}, {"location", item.location}, {"player", item.player}, {"flags", item.flags} };
+}
+
+static APClient::NetworkItem ItemFromJson(const json& j)
+{
+    APClient::NetworkItem item{};
+    item.item     = j.value("item", int64_t(0));
+    item.location = j.value("location", int64_t(0));
+    item.player   = j.value("player", 0);
+    item.flags    = j.value("flags", 0u);
+    item.index    = -1;
+    return item;
+}
+
+static json PrintJsonToJson(const APClient::PrintJSONArgs& args)
+{
+    json packet = { {"cmd", "PrintJSON"}, {"type", args.type}, {"data", json::array()} };
+    for (const auto& node : args.data) {
+        json n = { {"type", node.type}, {"text", node.text} };
+        if (!node.color.empty()) n["color"] = node.color;
+        if (node.player) n["player"] = node.player;
+        if (node.flags) n["flags"] = node.flags;
+        packet["data"].push_back(std::move(n));
+    }
+    if (args.receiving) packet["receiving"] = *args.receiving;
+    if (args.item)      packet["item"] = ItemToJson(*args.item);
+    if (args.found)     packet["found"] = *args.found;
+    if (args.team)      packet["team"] = *args.team;
+    if (args.slot)      packet["slot"] = *args.slot;
+    if (args.message)   packet["message"] = *args.message;
+    if (args.countdown) packet["countdown"] = *args.countdown;
+    return packet;
+}
+
+namespace TalosAP {
+
+using APChannel::Event;
+using APChannel::Writer;
+
+// How often the session polls the socket and the command ring.
+static constexpr auto NET_POLL_INTERVAL = std::chrono::milliseconds(5);
+
+// Data package cache, next to talos_ap_uuid.txt. With a matching checksum
+// in RoomInfo, apclientpp skips GetDataPackage entirely.
+static constexpr const char* DATA_PACKAGE_CACHE = "talos_ap_datapackage.json";
+
+// How often the server round trip is sampled with a Bounce to our own
+// slot while connected.
+static constexpr auto RTT_SAMPLE_INTERVAL = std::chrono::seconds(10);
+static constexpr const char* RTT_KEY = "talos_rtt";
+
+// How often an open wire capture is flushed to disk.
+static constexpr auto CAPTURE_FLUSH_INTERVAL = std::chrono::seconds(1);
+
+// How often the WsDeflate.* trace counters are sampled.
+static constexpr auto DEFLATE_SAMPLE_INTERVAL = std::chrono::seconds(1);
+
+// Events held while toMod is full. Past this the game thread has stopped
+// draining (paused in a debugger, or gone), and new Log, Notify and
+// ServerRtt events are dropped. State events — grants, confirmations,
+// slot and socket changes, scouts — are never dropped: m_nextItemIndex
+// has already moved past a grant, so a resumed session would not resend
+// it. They queue past the limit until the game thread drains again.
+static constexpr size_t MAX_BACKLOG = 4096;
+
+/// Events the game thread can miss without diverging from the server.
+static bool IsDroppable(APChannel::Event type)
+{
+    switch (type) {
+        case APChannel::Event::Log:
+        case APChannel::Event::Notify:
+        case APChannel::Event::ServerRtt:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// ============================================================
+// Impl — hides the APClient (from apclientpp) from the header
+// ============================================================
+struct APSession::Impl {
+    std::unique_ptr<APClient> ap;
+    std::string slot;
+    std::string password;
+
+    // Packet handlers. Start() registers them with the client (behind the
+    // wire capture); Replay() calls them directly.
+    std::function<void(int slot, int team, const json& slotData)>  onConnected;
+    std::function<void(const std::list<APClient::NetworkItem>&)>  onItemsReceived;
+    std::function<void(const std::list<int64_t>&)>                  onLocationChecked;
+    std::function<void(const std::list<APClient::NetworkItem>&)>  onLocationInfo;
+    std::function<void(const APClient::PrintJSONArgs&)>             onPrintJSON;
+
+    WireCapture capture;
+    std::chrono::steady_clock::time_point lastCaptureFlush;
+    std::chrono::steady_clock::time_point lastDeflateSample;
+    std::chrono::steady_clock::time_point lastRttSample;
+
+    HudLine line;   ///< notification being built; reused so its buffers stay warm
+
+    void Capture(WireDirection direction, const json& packet)
+    {
+        if (capture.Active()) capture.Record(direction, packet.dump());
+    }
+};
+
+// ============================================================
+// Construction / Destruction
+// ============================================================
+
+APSession::APSession(APChannel::View channel)
+    : m_impl(std::make_unique<Impl>())
+    , m_channel(channel)
+{
+}
+
+APSession::~APSession()
+{
+    // Impl destructor destroys the APClient, cleaning up the socket
+    m_impl.reset();
+    if (m_channel.control) {
+        m_channel.control->linkState.store(static_cast<uint32_t>(APChannel::LinkState::Disconnected));
+    }
+}
+
+// ============================================================
+// Emitting events
+// ============================================================
+
+void APSession::Emit(Event type, const Writer& payload)
+{
+    std::lock_guard<std::mutex> lock(m_emitMutex);
+    if (m_backlog.empty() && m_channel.toMod.TryWrite(static_cast<uint16_t>(type), payload.Data(), payload.Size())) {
+        return;
+    }
+    // Keep order: once anything is waiting, everything waits behind it.
+    if (m_backlog.size() >= MAX_BACKLOG && IsDroppable(type)) {
+        ++m_droppedEvents;
+        return;
+    }
+    std::vector<uint8_t> rec(sizeof(uint16_t) + payload.Size());
+    const uint16_t t = static_cast<uint16_t>(type);
+    std::memcpy(rec.data(), &t, sizeof(t));
+    if (payload.Size()) std::memcpy(rec.data() + sizeof(t), payload.Data(), payload.Size());
+    m_backlog.push_back(std::move(rec));
+}
+
+void APSession::Emit(Event type)
+{
+    Writer empty;
+    Emit(type, empty);
+}
+
+void APSession::FlushBacklog()
+{
+    std::lock_guard<std::mutex> lock(m_emitMutex);
+    while (!m_backlog.empty()) {
+        const auto& rec = m_backlog.front();
+        uint16_t t;
+        std::memcpy(&t, rec.data(), sizeof(t));
+        if (!m_channel.toMod.TryWrite(t, rec.data() + sizeof(t), static_cast<uint32_t>(rec.size() - sizeof(t)))) {
+            return;
+        }
+        m_backlog.pop_front();
+    }
+}
+
+void APSession::EmitLog(APChannel::LogKind kind, std::wstring_view text)
+{
+    Writer w;
+    w.Put(static_cast<uint8_t>(kind));
+    w.PutText(text);
+    Emit(Event::Log, w);
+}
+
+uint64_t APSession::DroppedEvents()
+{
+    std::lock_guard<std::mutex> lock(m_emitMutex);
+    return m_droppedEvents;
+}
+
+size_t APSession::BacklogDepth()
+{
+    std::lock_guard<std::mutex> lock(m_emitMutex);
+    return m_backlog.size();
+}
+
+void APSession::EmitNotify(const HudLine& line, bool chat)
+{
+    Writer w;
+    w.Put(static_cast<uint8_t>(chat ? 1 : 0));
+    w.PutLine(line);
+    Emit(Event::Notify, w);
+}
+
+std::string APSession::PlayerName(int slot) const
+{
+    if (slot == 0) return "Server";
+    if (m_impl->ap) {
+        try {
+            std::string alias = m_impl->ap->get_player_alias(slot);
+            if (!alias.empty()) return alias;
+        } catch (...) {}
+    }
+    return "Player " + std::to_string(slot);
+}
+
+// ============================================================
+// Start
+// ============================================================
+
+bool APSession::Start()
+{
+    if (!m_channel.Valid()) return false;
+
+    // ConnectInfo is written once by the mod before the session starts
+    const auto& info = m_channel.control->connect;
+    auto field = [](const char* s, size_t cap) { return std::string(s, strnlen(s, cap)); };
+    const std::string server = field(info.server, sizeof(info.server));
+    const std::string game   = field(info.game, sizeof(info.game));
+    m_impl->slot     = field(info.slot, sizeof(info.slot));
+    m_impl->password = field(info.password, sizeof(info.password));
+
+    try {
+        // Generate or load a persistent UUID for this client
+        std::string uuid = ap_get_uuid("talos_ap_uuid.txt");
+
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Creating AP client: game='{}', server='{}'\n"),
+            Utf::ToWide(game),
+            Utf::ToWide(server));
+
+        m_impl->ap = std::make_unique<APClient>(uuid, game, server);
+
+#ifdef TALOSAP_WS_DEFLATE_WINDOW_BITS
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Offering permessage-deflate (server window {} bits)\n"),
+            TALOSAP_WS_DEFLATE_WINDOW_BITS);
+#else
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Websocket compression disabled at build time\n"));
+#endif
+    }
+    catch (const std::exception& e) {
+        Output::send<LogLevel::Error>(STR("[TalosAP] Failed to create AP client: {}\n"),
+            Utf::ToWide(e.what()));
+        m_impl->ap.reset();
+        return false;
+    }
+
+    auto& ap = *m_impl->ap;
+
+    // Start resolving the server while the game is still loading
+    m_endpoint.SetServer(server);
+    m_endpoint.Warm();
+
+    try {
+        if (ap.set_data_package_from_file(DATA_PACKAGE_CACHE)) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Loaded cached data package\n"));
+        }
+    }
+    catch (...) {}
+
+    ap.set_data_package_changed_handler([this](const json&) {
+        TraceScope trace("AP.DataPackageSave", "ap");
+        if (m_impl->ap && !m_impl->ap->save_data_package(DATA_PACKAGE_CACHE)) {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Could not write data package cache\n"));
+        }
+    });
+
+    // ============================================================
+    // Register event handlers
+    // All callbacks fire from within poll() on the session thread.
+    // Everything the game thread needs is resolved here and sent as
+    // an event; RoomInfo answers immediately so authentication never
+    // waits for a game tick.
+    // ============================================================
+
+    ap.set_socket_connected_handler([this]() {
+        TraceScope trace("AP.SocketConnected", "ap");
+        WsDeflateStats::Get().Reset();
+        auto& tls = TlsSessionCache::Get();
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Socket connected to server (TLS resumed {}, full {})\n"),
+            tls.Resumed(), tls.FullHandshakes());
+        Writer w;
+        w.Put(MonoNs());
+        Emit(Event::SocketConnected, w);
+    });
+
+    ap.set_socket_disconnected_handler([this]() {
+        TraceScope trace("AP.SocketDisconnected", "ap");
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Socket disconnected\n"));
+        LogDeflateStats();
+        // Enforcement keeps running on the current GrantedItems; refresh
+        // the resolver cache before apclientpp's reconnect needs it.
+        m_endpoint.Warm();
+        Emit(Event::SocketDisconnected);
+    });
+
+    ap.set_socket_error_handler([this](const std::string& msg) {
+        TraceScope trace("AP.SocketError", "ap");
+        Output::send<LogLevel::Error>(STR("[TalosAP] Socket error: {}\n"),
+            Utf::ToWide(msg));
+    });
+
+    ap.set_room_info_handler([this]() {
+        TraceScope trace("AP.RoomInfo", "ap");
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Room info received, connecting slot '{}'\n"),
+            Utf::ToWide(m_impl->slot));
+
+        m_impl->ap->ConnectSlot(
+            m_impl->slot,
+            m_impl->password,
+            7,  // items_handling: receive from all sources (0b111)
+            {"AP"},
+            {0, 5, 1}  // AP protocol version
+        );
+        // Never the password
+        m_impl->Capture(WireDirection::Outbound, { {"cmd", "Connect"}, {"name", m_impl->slot}, {"items_handling", 7}, {"tags", {"AP"}} });
+    });
+
+    ap.set_slot_refused_handler([this](const std::list<std::string>& reasons) {
+        TraceScope trace("AP.SlotRefused", "ap");
+        std::string msg;
+        for (const auto& r : reasons) {
+            if (!msg.empty()) msg += ", ";
+            msg += r;
+        }
+        std::wstring wMsg = Utf::ToWide(msg);
+        Output::send<LogLevel::Error>(STR("[TalosAP] Connection refused: {}\n"), wMsg);
+
+        Writer w;
+        w.PutText(wMsg);
+        Emit(Event::SlotRefused, w);
+    });
+
+    // Packet handlers, each behind the wire capture. The capture stores
+    // the packet as the handler saw it, so a replay drives the same code.
+    InstallHandlers();
+
+    ap.set_slot_connected_handler([this](const json& slotData) {
+        auto& ap = *m_impl->ap;
+        const int slot = ap.get_player_number();
+        const int team = ap.get_team_number();
+        if (m_impl->capture.Active()) {
+            m_impl->Capture(WireDirection::Inbound, {
+                {"cmd", "Connected"}, {"team", team}, {"slot", slot}, {"slot_data", slotData},
+                {"checked_locations", ap.get_checked_locations()},
+                {"missing_locations", ap.get_missing_locations()},
+            });
+        }
+        m_impl->onConnected(slot, team, slotData);
+    });
+
+    ap.set_items_received_handler([this](const std::list<APClient::NetworkItem>& items) {
+        if (m_impl->capture.Active()) {
+            json packet = { {"cmd", "ReceivedItems"}, {"index", items.empty() ? 0 : items.front().index},
+                            {"items", json::array()} };
+            for (const auto& item : items) packet["items"].push_back(ItemToJson(item));
+            m_impl->Capture(WireDirection::Inbound, packet);
+        }
+        m_impl->onItemsReceived(items);
+    });
+
+    ap.set_location_checked_handler([this](const std::list<int64_t>& locations) {
+        if (m_impl->capture.Active()) {
+            m_impl->Capture(WireDirection::Inbound, { {"cmd", "RoomUpdate"}, {"checked_locations", locations} });
+        }
+        m_impl->onLocationChecked(locations);
+    });
+
+    ap.set_location_info_handler([this](const std::list<APClient::NetworkItem>& items) {
+        if (m_impl->capture.Active()) {
+            json packet = { {"cmd", "LocationInfo"}, {"locations", json::array()} };
+            for (const auto& item : items) packet["locations"].push_back(ItemToJson(item));
+            m_impl->Capture(WireDirection::Inbound, packet);
+        }
+        m_impl->onLocationInfo(items);
+    });
+
+    ap.set_print_json_handler([this](const APClient::PrintJSONArgs& args) {
+        if (m_impl->capture.Active()) {
+            m_impl->Capture(WireDirection::Inbound, PrintJsonToJson(args));
+        }
+        m_impl->onPrintJSON(args);
+    });
+
+    // Our own RTT probes come back here; other Bounces are not ours to handle.
+    ap.set_bounced_handler([this](const json& packet) {
+        m_impl->Capture(WireDirection::Inbound, packet);
+        const json& data = packet.contains("data") ? packet["data"] : packet;
+        if (!data.is_object() || !data.contains(RTT_KEY) || !data[RTT_KEY].is_number_integer()) return;
+        Writer w;
+        w.Put(MonoNs() - data[RTT_KEY].get<int64_t>());
+        Emit(Event::ServerRtt, w);
+    });
+
+    if (info.flags & APChannel::CONNECT_WIRE_CAPTURE) {
+        if (m_impl->capture.Open(WireCapture::FILE_NAME)) {
+            m_impl->lastCaptureFlush = std::chrono::steady_clock::now();
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Capturing AP traffic to {}\n"),
+                Utf::ToWide(WireCapture::FILE_NAME));
+        } else {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Could not open {} — wire capture off\n"),
+                Utf::ToWide(WireCapture::FILE_NAME));
+        }
+    }
+
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] AP session started\n"));
+    return true;
+}
+
+// ============================================================
+// Packet handlers
+// All of them run from within poll() on the session thread (or from
+// Replay()). Everything the game thread needs is resolved here and
+// sent as an event.
+// ============================================================
+
+void APSession::InstallHandlers()
+{
+    m_impl->onConnected = [this](int slot, int team, const json& slotData) {
+        TraceScope trace("AP.SlotConnected", "ap");
+        auto& ap = *m_impl->ap;
+
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Slot connected! player={} team={}\n"),
+            slot, team);
+        m_backoff.Succeeded();
+
+        // Same room and slot as before the drop: everything up to
+        // m_nextItemIndex is already granted, so keep it and let the
+        // items handler skip the replayed prefix. Otherwise start clean.
+        std::string seed = ap.get_seed();
+        bool resumed = m_nextItemIndex > 0 && !seed.empty() && seed == m_sessionSeed
+            && slot == m_sessionSlot && team == m_sessionTeam;
+
+        if (resumed) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Resumed session — keeping {} received items\n"),
+                m_nextItemIndex);
+        } else {
+            m_sessionSeed   = seed;
+            m_sessionSlot   = slot;
+            m_sessionTeam   = team;
+            m_nextItemIndex = 0;
+
+            // Reset item counters for a clean replay of items
+            m_itemMapping.ResetItemCounters();
+        }
+
+        // Read slot_data settings
+        int8_t reusable = -1;
+        if (slotData.contains("reusable_tetrominos")) {
+            reusable = slotData["reusable_tetrominos"].get<int>() != 0 ? 1 : 0;
+        }
+
+        Writer w;
+        w.Put(static_cast<int32_t>(slot));
+        w.Put(static_cast<int32_t>(team));
+        w.Put(reusable);
+        w.Put(static_cast<uint8_t>(resumed ? 1 : 0));
+        w.Put(static_cast<int32_t>(m_nextItemIndex));
+        Emit(Event::SlotConnected, w);
+
+        // Restore checked locations from the server. The mod answers
+        // SlotConnected with its own checked list, which the command
+        // handler filters against this same set.
+        int restoredCount = 0;
+        const int64_t connectedNs = MonoNs();
+        for (int64_t locId : ap.get_checked_locations()) {
+            ItemId tetId = m_itemMapping.GetLocationName(locId);
+            if (!tetId.empty()) {
+                Writer loc;
+                loc.PutId(tetId);
+                loc.Put(connectedNs);
+                Emit(Event::LocationConfirmed, loc);
+                ++restoredCount;
+            }
+        }
+        if (restoredCount > 0) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Restored {} checked locations from server\n"),
+                restoredCount);
+        }
+
+        // Ask what our remaining locations hold, for trackers (StateExport)
+        std::list<int64_t> scouts;
+        for (int64_t locId : ap.get_missing_locations()) {
+            if (!m_itemMapping.GetLocationName(locId).empty()) scouts.push_back(locId);
+        }
+        if (!scouts.empty()) {
+            ap.LocationScouts(scouts);
+            m_impl->Capture(WireDirection::Outbound, { {"cmd", "LocationScouts"}, {"locations", scouts} });
+        }
+
+        // Send playing status
+        ap.StatusUpdate(APClient::ClientStatus::PLAYING);
+        m_impl->Capture(WireDirection::Outbound,
+            { {"cmd", "StatusUpdate"}, {"status", static_cast<int>(APClient::ClientStatus::PLAYING)} });
+    };
+
+    m_impl->onItemsReceived = [this](const std::list<APClient::NetworkItem>& items) {
+        TraceScope trace("AP.ItemsReceived", "ap");
+        auto& ap = *m_impl->ap;
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Received {} items\n"), items.size());
+
+        const int self = m_sessionSlot;
+        const int64_t receivedNs = MonoNs();
+        int grantedCount = 0;
+        int nonTetrominoCount = 0;
+        int replayedCount = 0;
+
+        for (const auto& item : items) {
+            // Already applied before a reconnect — no grant, no notification
+            if (item.index >= 0 && item.index < m_nextItemIndex) {
+                ++replayedCount;
+                continue;
+            }
+            if (item.index >= 0) m_nextItemIndex = item.index + 1;
+
+            auto tetId = m_itemMapping.ResolveNextItem(item.item);
+
+            // Resolve display name: prefer our local mapping, fall back to AP data package
+            std::string displayName;
+            if (tetId.has_value()) {
+                displayName = m_itemMapping.GetDisplayName(item.item);
+                if (displayName.empty()) displayName = tetId->str();
+            }
+            if (displayName.empty()) {
+                // Use AP library to look up item name from the data package
+                try {
+                    std::string game = ap.get_player_game(self);
+                    displayName = ap.get_item_name(item.item, game);
+                    if (displayName == "Unknown") displayName.clear();
+                } catch (...) {}
+            }
+            if (displayName.empty()) {
+                displayName = "Item #" + std::to_string(item.item);
+            }
+
+            if (tetId.has_value()) {
+                Writer w;
+                w.PutId(tetId.value());
+                w.Put(receivedNs);
+                Emit(Event::Grant, w);
+                ++grantedCount;
+            } else {
+                // Non-tetromino item (e.g. trap, filler, progression unlock)
+                ++nonTetrominoCount;
+                Output::send<LogLevel::Verbose>(STR("[TalosAP] Non-tetromino item received: {} (0x{:X}) = {}\n"),
+                    item.item, item.item,
+                    Utf::ToWide(displayName));
+            }
+
+            // Notifications are shown for ALL items, not just tetrominoes
+            LinearColor itemColor = ColorForFlags(static_cast<int>(item.flags));
+            HudLine& line = m_impl->line;
+            line.Clear();
+            if (item.player != self) {
+                line.AppendUtf8(PlayerName(item.player), HudColors::PLAYER);
+                line.Append(L" sent you ", HudColors::WHITE);
+            } else {
+                line.Append(L"You found ", HudColors::WHITE);
+            }
+            line.AppendUtf8(displayName, itemColor);
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] {}\n"), line.Text());
+            EmitNotify(line, false);
+        }
+
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Processed items: {} tetrominoes, {} other, {} already applied\n"),
+            grantedCount, nonTetrominoCount, replayedCount);
+
+        Writer done;
+        done.Put(static_cast<int32_t>(grantedCount));
+        done.Put(static_cast<int32_t>(nonTetrominoCount));
+        done.Put(static_cast<int32_t>(replayedCount));
+        Emit(Event::ItemsDone, done);
+    };
+
+    m_impl->onLocationChecked = [this](const std::list<int64_t>& locations) {
+        TraceScope trace("AP.LocationChecked", "ap");
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Server confirmed {} location checks\n"),
+            locations.size());
+
+        const int64_t confirmedNs = MonoNs();
+        for (int64_t locId : locations) {
+            ItemId tetId = m_itemMapping.GetLocationName(locId);
+            if (!tetId.empty()) {
+                Writer w;
+                w.PutId(tetId);
+                w.Put(confirmedNs);
+                Emit(Event::LocationConfirmed, w);
+            }
+        }
+    };
+
+    m_impl->onLocationInfo = [this](const std::list<APClient::NetworkItem>& items) {
+        TraceScope trace("AP.LocationInfo", "ap");
+        auto& ap = *m_impl->ap;
+        for (const auto& item : items) {
+            ItemId tetId = m_itemMapping.GetLocationName(item.location);
+            if (tetId.empty()) continue;
+
+            std::string itemName;
+            try {
+                itemName = ap.get_item_name(item.item, ap.get_player_game(item.player));
+            } catch (...) {}
+            if (itemName.empty() || itemName == "Unknown") {
+                itemName = "Item #" + std::to_string(item.item);
+            }
+
+            Writer w;
+            w.PutId(tetId);
+            w.Put(static_cast<int32_t>(item.flags));
+            w.PutText(Utf::ToWide(itemName));
+            w.PutText(Utf::ToWide(PlayerName(item.player)));
+            Emit(Event::Scouted, w);
+        }
+    };
+
+    // ============================================================
+    // PrintJSON — other-player activity, hints, chat, countdown, etc.
+    // This is how we see messages like "PlayerX found ItemY at LocationZ"
+    // for other players in the multiworld session.
+    // ============================================================
+    m_impl->onPrintJSON = [this](const APClient::PrintJSONArgs& args) {
+        TraceScope trace("AP.PrintJSON", "ap");
+        auto& ap = *m_impl->ap;
+
+        // Suppress self-to-self ItemSend — our items_received_handler
+        // already shows "You found ..." for those.
+        const int self = m_sessionSlot;
+        if (args.type == "ItemSend"
+            && args.receiving && *args.receiving == self
+            && args.item && args.item->player == self) {
+            return;
+        }
+
+        // Build colored segments from the TextNode list, widening each
+        // node's text straight into the line
+        HudLine& line = m_impl->line;
+        line.Clear();
+
+        for (const auto& node : args.data) {
+            if (node.type == "player_id") {
+                int slot = 0;
+                try { slot = std::stoi(node.text); } catch (...) {}
+                line.AppendUtf8(PlayerName(slot), HudColors::PLAYER);
+            }
+            else if (node.type == "item_id") {
+                int64_t id = 0;
+                try { id = std::stoll(node.text); } catch (...) {}
+                std::string name;
+                try {
+                    std::string game = ap.get_player_game(node.player);
+                    name = ap.get_item_name(id, game);
+                } catch (...) { name = "Unknown Item"; }
+                line.AppendUtf8(name, ColorForFlags(node.flags));
+            }
+            else if (node.type == "item_name") {
+                line.AppendUtf8(node.text, ColorForFlags(node.flags));
+            }
+            else if (node.type == "location_id") {
+                int64_t id = 0;
+                try { id = std::stoll(node.text); } catch (...) {}
+                std::string name;
+                try {
+                    std::string game = ap.get_player_game(node.player);
+                    name = ap.get_location_name(id, game);
+                } catch (...) { name = "Unknown Location"; }
+                line.AppendUtf8(name, HudColors::LOCATION);
+            }
+            else if (node.type == "location_name") {
+                line.AppendUtf8(node.text, HudColors::LOCATION);
+            }
+            else if (node.type == "entrance_name") {
+                line.AppendUtf8(node.text, HudColors::ENTRANCE);
+            }
+            else if (node.type == "color") {
+                auto it = AP_NAMED_COLORS.find(node.color);
+                line.AppendUtf8(node.text, (it != AP_NAMED_COLORS.end()) ? it->second : HudColors::WHITE);
+            }
+            else {
+                // "text" type or unknown — plain white
+                line.AppendUtf8(node.text, HudColors::WHITE);
+            }
+        }
+
+        if (line.Empty()) return;
+        EmitNotify(line, true);
+    };
+}
+
+// ============================================================
+// Commands from the game thread
+// ============================================================
+
+void APSession::HandleCommands()
+{
+    auto& ap = *m_impl->ap;
+    m_channel.toSession.Drain([&](uint16_t type, const uint8_t* data, uint32_t size) {
+        APChannel::Reader r(data, size);
+        switch (static_cast<APChannel::Command>(type)) {
+            case APChannel::Command::LocationChecks: {
+                // Only what the server does not already have; the mod sends
+                // its whole checked list after every slot connect.
+                const auto& serverChecked = ap.get_checked_locations();
+                std::list<int64_t> toSend;
+                uint32_t count = r.Get<uint32_t>();
+                for (uint32_t i = 0; i < count && !r.Failed(); ++i) {
+                    int64_t locId = r.Get<int64_t>();
+                    if (locId >= 0 && serverChecked.count(locId) == 0) toSend.push_back(locId);
+                }
+                if (!toSend.empty()) {
+                    Output::send<LogLevel::Verbose>(STR("[TalosAP] Sending {} location checks to server\n"),
+                        toSend.size());
+                    ap.LocationChecks(toSend);
+                    m_impl->Capture(WireDirection::Outbound, { {"cmd", "LocationChecks"}, {"locations", toSend} });
+                }
+                break;
+            }
+            case APChannel::Command::Goal:
+                ap.StatusUpdate(APClient::ClientStatus::GOAL);
+                m_impl->Capture(WireDirection::Outbound,
+                    { {"cmd", "StatusUpdate"}, {"status", static_cast<int>(APClient::ClientStatus::GOAL)} });
+                Output::send<LogLevel::Verbose>(STR("[TalosAP] Sent goal completion!\n"));
+                break;
+        }
+    });
+}
+
+void APSession::SampleRtt()
+{
+    auto& ap = *m_impl->ap;
+    if (ap.get_state() != APClient::State::SLOT_CONNECTED) return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - m_impl->lastRttSample < RTT_SAMPLE_INTERVAL) return;
+    m_impl->lastRttSample = now;
+
+    // Only to our own slot: the server echoes it to every client on it
+    json data = { {RTT_KEY, MonoNs()} };
+    ap.Bounce(data, {}, { m_sessionSlot });
+    m_impl->Capture(WireDirection::Outbound, { {"cmd", "Bounce"}, {"slots", { m_sessionSlot }}, {"data", data} });
+}
+
+// Per-connection permessage-deflate counts (WsStats.h). The ratios are
+// ×100: 550 = the JSON was 5.5 times the bytes on the wire.
+void APSession::SampleDeflate()
+{
+    const auto& ws = WsDeflateStats::Get();
+    uint64_t wireIn = ws.wireIn.load(std::memory_order_relaxed);
+    uint64_t payloadIn = ws.payloadIn.load(std::memory_order_relaxed);
+    uint64_t wireOut = ws.wireOut.load(std::memory_order_relaxed);
+    uint64_t payloadOut = ws.payloadOut.load(std::memory_order_relaxed);
+
+    auto& trace = TraceRecorder::Get();
+    trace.Counter("WsDeflate.wireIn", static_cast<int64_t>(wireIn));
+    trace.Counter("WsDeflate.payloadIn", static_cast<int64_t>(payloadIn));
+    trace.Counter("WsDeflate.ratioIn", WsDeflateStats::RatioX100(payloadIn, wireIn));
+    trace.Counter("WsDeflate.wireOut", static_cast<int64_t>(wireOut));
+    trace.Counter("WsDeflate.payloadOut", static_cast<int64_t>(payloadOut));
+    trace.Counter("WsDeflate.ratioOut", WsDeflateStats::RatioX100(payloadOut, wireOut));
+}
+
+void APSession::LogDeflateStats()
+{
+    const auto& ws = WsDeflateStats::Get();
+    if (!ws.negotiated.load(std::memory_order_relaxed)) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Connection ran uncompressed (permessage-deflate not negotiated)\n"));
+        return;
+    }
+    uint64_t wireIn = ws.wireIn.load(std::memory_order_relaxed);
+    uint64_t payloadIn = ws.payloadIn.load(std::memory_order_relaxed);
+    uint64_t wireOut = ws.wireOut.load(std::memory_order_relaxed);
+    uint64_t payloadOut = ws.payloadOut.load(std::memory_order_relaxed);
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] Connection deflate: in {} -> {} bytes ({:.1f}x), out {} -> {} bytes ({:.1f}x)\n"),
+        wireIn, payloadIn, WsDeflateStats::RatioX100(payloadIn, wireIn) / 100.0,
+        payloadOut, wireOut, WsDeflateStats::RatioX100(payloadOut, wireOut) / 100.0);
+}
+
+void APSession::PublishState()
+{
+    APChannel::LinkState s = APChannel::LinkState::Disconnected;
+    switch (m_impl->ap->get_state()) {
+        case APClient::State::DISCONNECTED:       s = APChannel::LinkState::Disconnected;     break;
+        case APClient::State::SOCKET_CONNECTING:  s = APChannel::LinkState::SocketConnecting; break;
+        case APClient::State::SOCKET_CONNECTED:   s = APChannel::LinkState::SocketConnected;  break;
+        case APClient::State::ROOM_INFO:          s = APChannel::LinkState::RoomInfo;         break;
+        case APClient::State::SLOT_CONNECTED:     s = APChannel::LinkState::SlotConnected;    break;
+    }
+    m_channel.control->linkState.store(static_cast<uint32_t>(s), std::memory_order_relaxed);
+    m_channel.control->nextItemIndex.store(m_nextItemIndex, std::memory_order_relaxed);
+    m_channel.control->heartbeat.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================
+// Session loop
+// ============================================================
+
+void APSession::Step()
+{
+    try {
+        // While disconnected, poll() is what starts apclientpp's next
+        // attempt, so it waits for the backoff (ReconnectBackoff.h).
+        auto& ap = *m_impl->ap;
+        const auto now = ReconnectBackoff::Clock::now();
+        if (ap.get_state() != APClient::State::DISCONNECTED || m_backoff.Ready(now)) {
+            ap.poll();
+        }
+        bool up = ap.get_state() != APClient::State::DISCONNECTED;
+        if (m_socketUp && !up) {
+            auto delay = m_backoff.Failed(now);
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Next connection attempt in {} ms (failures: {})\n"),
+                delay.count(), m_backoff.Failures());
+        }
+        m_socketUp = up;
+
+        HandleCommands();
+        SampleRtt();
+    }
+    catch (const std::exception& e) {
+        Output::send<LogLevel::Error>(STR("[TalosAP] Poll exception: {}\n"),
+            Utf::ToWide(e.what()));
+    }
+    FlushBacklog();
+    PublishState();
+
+    // Reported here, outside m_emitMutex (the helper's log sink re-enters
+    // Emit), and only once there is room again — while full, the warning
+    // would itself be dropped.
+    if (uint64_t dropped = DroppedEvents(); dropped != m_droppedReported && BacklogDepth() < MAX_BACKLOG) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] toMod backlog full: dropped {} log/notify events\n"),
+            dropped - m_droppedReported);
+        m_droppedReported = dropped;
+    }
+
+    if (auto now = std::chrono::steady_clock::now(); now - m_impl->lastDeflateSample >= DEFLATE_SAMPLE_INTERVAL) {
+        SampleDeflate();
+        m_impl->lastDeflateSample = now;
+    }
+
+    if (m_impl->capture.Active()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_impl->lastCaptureFlush >= CAPTURE_FLUSH_INTERVAL) {
+            m_impl->capture.Flush();
+            m_impl->lastCaptureFlush = now;
+        }
+    }
+}
+
+void APSession::Run(const std::atomic<bool>& stop)
+{
+    if (!m_impl->ap) return;
+    while (!stop.load(std::memory_order_relaxed)
+           && m_channel.control->stop.load(std::memory_order_relaxed) == 0) {
+        Step();
+        std::this_thread::sleep_for(NET_POLL_INTERVAL);
+    }
+}
+
+// ============================================================
+// Offline replay (tools/wirereplay)
+// ============================================================
+
+bool APSession::StartReplay()
+{
+    if (!m_channel.Valid()) return false;
+
+    const auto& info = m_channel.control->connect;
+    const std::string game(info.game, strnlen(info.game, sizeof(info.game)));
+
+    try {
+        // No URI: the client never opens a socket. Item and location
+        // names still resolve through the data package cache.
+        m_impl->ap = std::make_unique<APClient>("wirereplay", game, "");
+        m_impl->ap->set_data_package_from_file(DATA_PACKAGE_CACHE);
+    }
+    catch (const std::exception& e) {
+        Output::send<LogLevel::Error>(STR("[TalosAP] Failed to create replay client: {}\n"),
+            Utf::ToWide(e.what()));
+        m_impl->ap.reset();
+        return false;
+    }
+
+    InstallHandlers();
+    return true;
+}
+
+bool APSession::Replay(std::string_view packet)
+{
+    if (!m_impl->ap) return false;
+
+    json j = json::parse(packet, nullptr, false);
+    if (!j.is_object()) return false;
+    const std::string cmd = j.value("cmd", "");
+
+    try {
+        if (cmd == "Connected") {
+            m_impl->onConnected(j.value("slot", 0), j.value("team", 0), j.value("slot_data", json::object()));
+        }
+        else if (cmd == "ReceivedItems") {
+            // apclientpp numbers items from the packet's index
+            std::list<APClient::NetworkItem> items;
+            int index = j.value("index", 0);
+            for (const auto& e : j.at("items")) {
+                items.push_back(ItemFromJson(e));
+                items.back().index = index++;
+            }
+            m_impl->onItemsReceived(items);
+        }
+        else if (cmd == "RoomUpdate") {
+            if (!j.contains("checked_locations")) return false;
+            m_impl->onLocationChecked(j["checked_locations"].get<std::list<int64_t>>());
+        }
+        else if (cmd == "LocationInfo") {
+            std::list<APClient::NetworkItem> items;
+            for (const auto& e : j.at("locations")) items.push_back(ItemFromJson(e));
+            m_impl->onLocationInfo(items);
+        }
+        else if (cmd == "PrintJSON") {
+            APClient::PrintJSONArgs args;
+            args.type = j.value("type", "");
+            for (const auto& e : j.at("data")) {
+                APClient::TextNode node;
+                node.type   = e.value("type", "text");
+                node.text   = e.value("text", "");
+                node.color  = e.value("color", "");
+                node.player = e.value("player", 0);
+                node.flags  = e.value("flags", 0u);
+                args.data.push_back(std::move(node));
+            }
+            int receiving = j.value("receiving", 0);
+            APClient::NetworkItem item{};
+            if (j.contains("receiving")) args.receiving = &receiving;
+            if (j.contains("item")) {
+                item = ItemFromJson(j["item"]);
+                args.item = &item;
+            }
+            m_impl->onPrintJSON(args);
+        }
+        else {
+            return false;
+        }
+    }
+    catch (const json::exception&) {
+        return false;
+    }
+
+    FlushBacklog();
+    return true;
+}
+
+} // namespace TalosAP
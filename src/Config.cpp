@@ -1,4 +1,6 @@
 #include "headers/Config.h"
+#include "headers/Utf.h"
+#include "headers/Latency.h"
 
 #include <fstream>
 #include <filesystem>
@@ -10,63 +12,92 @@ namespace fs = std::filesystem;
 
 namespace TalosAP {
 
-// Convert wide string to narrow UTF-8 string
-static std::string WideToNarrow(const std::wstring& wide)
+// ============================================================
+// Tunables — config.json keys and accepted ranges
+// ============================================================
+
+namespace {
+
+struct TunableSpec {
+    const char* key;
+    int   Tunables::* i;    ///< exactly one of i / f is set
+    float Tunables::* f;
+    double lo, hi;
+};
+
+constexpr TunableSpec TUNABLE_SPECS[] = {
+    { "enforce_interval_ticks",        &Tunables::enforce_interval_ticks,        nullptr, 1, 60 },
+    { "refresh_interval_ticks",        &Tunables::refresh_interval_ticks,        nullptr, 10, 3600 },
+    { "collection_interval_ticks",     &Tunables::collection_interval_ticks,     nullptr, 10, 3600 },
+    { "hud_interval_ticks",            &Tunables::hud_interval_ticks,            nullptr, 1, 60 },
+    { "visibility_call_budget",        &Tunables::visibility_call_budget,        nullptr, 2, 512 },
+    { "scan_visibility_retries",       &Tunables::scan_visibility_retries,       nullptr, 0, 600 },
+    { "refresh_visibility_retries",    &Tunables::refresh_visibility_retries,    nullptr, 0, 600 },
+    { "pickup_radius_scale",           nullptr, &Tunables::pickup_radius_scale,           0.25, 4.0 },
+    { "fence_open_attempts",           &Tunables::fence_open_attempts,           nullptr, 1, 100 },
+    { "fence_retry_ms",                &Tunables::fence_retry_ms,                nullptr, 16, 5000 },
+    { "hud_max_visible",               &Tunables::hud_max_visible,               nullptr, 1, 30 },
+    { "hud_duration_s",                nullptr, &Tunables::hud_duration_s,                1.0, 60.0 },
+    { "cooldown_client_restart_ticks", &Tunables::cooldown_client_restart_ticks, nullptr, 5, 600 },
+    { "cooldown_save_loaded_ticks",    &Tunables::cooldown_save_loaded_ticks,    nullptr, 5, 600 },
+    { "cooldown_save_reload_ticks",    &Tunables::cooldown_save_reload_ticks,    nullptr, 5, 600 },
+    { "cooldown_open_level_ticks",     &Tunables::cooldown_open_level_ticks,     nullptr, 5, 600 },
+};
+
+double TunableValue(const Tunables& t, const TunableSpec& spec)
 {
-    if (wide.empty()) return {};
-    std::string result;
-    result.reserve(wide.size());
-    for (wchar_t ch : wide) {
-        if (ch < 0x80) {
-            result.push_back(static_cast<char>(ch));
-        } else if (ch < 0x800) {
-            result.push_back(static_cast<char>(0xC0 | (ch >> 6)));
-            result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
-        } else {
-            result.push_back(static_cast<char>(0xE0 | (ch >> 12)));
-            result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
-            result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
-        }
-    }
-    return result;
+    return spec.i ? static_cast<double>(t.*spec.i) : static_cast<double>(t.*spec.f);
 }
 
-// Convert narrow UTF-8 string to wide string
-static std::wstring NarrowToWide(const std::string& narrow)
+/// Build the tunables `block` describes. Missing keys take their
+/// default; a mistyped or out-of-range value keeps the one in `current`.
+Tunables ReadTunables(const json& block, const Tunables& current)
 {
-    if (narrow.empty()) return {};
-    std::wstring result;
-    result.reserve(narrow.size());
-    for (size_t i = 0; i < narrow.size(); ) {
-        unsigned char c = narrow[i];
-        if (c < 0x80) {
-            result.push_back(static_cast<wchar_t>(c));
-            i += 1;
-        } else if ((c >> 5) == 0x6) {
-            wchar_t wc = (c & 0x1F) << 6;
-            if (i + 1 < narrow.size()) wc |= (narrow[i + 1] & 0x3F);
-            result.push_back(wc);
-            i += 2;
-        } else if ((c >> 4) == 0xE) {
-            wchar_t wc = (c & 0x0F) << 12;
-            if (i + 1 < narrow.size()) wc |= (narrow[i + 1] & 0x3F) << 6;
-            if (i + 2 < narrow.size()) wc |= (narrow[i + 2] & 0x3F);
-            result.push_back(wc);
-            i += 3;
-        } else {
-            result.push_back(L'?');
-            i += 1;
+    using namespace RC;
+
+    Tunables out;
+    if (!block.is_object()) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] config.json \"tunables\" is not an object — ignored\n"));
+        return current;
+    }
+
+    for (const auto& spec : TUNABLE_SPECS) {
+        auto it = block.find(spec.key);
+        if (it == block.end()) continue;
+
+        bool typed = spec.i ? it->is_number_integer() : it->is_number();
+        double val = typed ? it->get<double>() : 0.0;
+        if (!typed || val < spec.lo || val > spec.hi) {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] tunable {} = {} is not {} in {}..{} — keeping {}\n"),
+                Utf::ToWide(spec.key), Utf::ToWide(it->dump()), spec.i ? STR("an integer") : STR("a number"),
+                spec.lo, spec.hi, TunableValue(current, spec));
+            if (spec.i) out.*spec.i = current.*spec.i;
+            else        out.*spec.f = current.*spec.f;
+            continue;
         }
+        if (spec.i) out.*spec.i = it->get<int>();
+        else        out.*spec.f = it->get<float>();
     }
-    return result;
+
+    // A misspelt key would otherwise fall back to its default silently
+    for (const auto& [key, value] : block.items()) {
+        bool known = false;
+        for (const auto& spec : TUNABLE_SPECS) known = known || key == spec.key;
+        if (!known) {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] unknown tunable \"{}\" — ignored\n"), Utf::ToWide(key));
+        }
+    }
+    return out;
 }
 
+} // namespace
+
 void Config::SyncNarrowStrings()
 {
-    server_str    = WideToNarrow(server);
-    slot_name_str = WideToNarrow(slot_name);
-    password_str  = WideToNarrow(password);
-    game_str      = WideToNarrow(game);
+    server_str    = Utf::ToUtf8(server);
+    slot_name_str = Utf::ToUtf8(slot_name);
+    password_str  = Utf::ToUtf8(password);
+    game_str      = Utf::ToUtf8(game);
 }
 
 void Config::Load(const std::wstring& modDir)
@@ -105,27 +136,43 @@ void Config::Load(const std::wstring& modDir)
 
         if (j.contains("server") && j["server"].is_string()) {
             auto val = j["server"].get<std::string>();
-            if (!val.empty()) server = NarrowToWide(val);
+            if (!val.empty()) server = Utf::ToWide(val);
         }
         if (j.contains("slot_name") && j["slot_name"].is_string()) {
             auto val = j["slot_name"].get<std::string>();
-            if (!val.empty()) slot_name = NarrowToWide(val);
+            if (!val.empty()) slot_name = Utf::ToWide(val);
         }
         if (j.contains("password") && j["password"].is_string()) {
-            password = NarrowToWide(j["password"].get<std::string>());
+            password = Utf::ToWide(j["password"].get<std::string>());
         }
         if (j.contains("game") && j["game"].is_string()) {
             auto val = j["game"].get<std::string>();
-            if (!val.empty()) game = NarrowToWide(val);
+            if (!val.empty()) game = Utf::ToWide(val);
         }
         if (j.contains("offline_mode") && j["offline_mode"].is_string()) {
             auto val = j["offline_mode"].get<std::string>();
             offline_mode = (val == "true" || val == "1");
         }
+        if (j.contains("network_helper")) {
+            const auto& v = j["network_helper"];
+            if (v.is_boolean()) network_helper = v.get<bool>();
+            else if (v.is_string()) network_helper = (v.get<std::string>() == "true" || v.get<std::string>() == "1");
+        }
+        if (j.contains("wire_capture")) {
+            const auto& v = j["wire_capture"];
+            if (v.is_boolean()) wire_capture = v.get<bool>();
+            else if (v.is_string()) wire_capture = (v.get<std::string>() == "true" || v.get<std::string>() == "1");
+        }
+        if (j.contains("save_file") && j["save_file"].is_string()) {
+            save_file = Utf::ToWide(j["save_file"].get<std::string>());
+        }
+        if (j.contains("tunables")) {
+            tunables = ReadTunables(j["tunables"], tunables);
+        }
     }
     catch (const json::exception& e) {
         Output::send<LogLevel::Warning>(STR("[TalosAP] config.json parse error: {}\n"),
-                                        NarrowToWide(e.what()));
+                                        Utf::ToWide(e.what()));
     }
 
     SyncNarrowStrings();
@@ -139,6 +186,74 @@ void Config::Load(const std::wstring& modDir)
     if (offline_mode) {
         Output::send<LogLevel::Verbose>(STR("[TalosAP]   offline_mode = true\n"));
     }
+    if (network_helper) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   network_helper = true\n"));
+    }
+    if (wire_capture) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   wire_capture = true\n"));
+    }
+    if (!save_file.empty()) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   save_file = {}\n"), save_file);
+    }
+    for (const auto& spec : TUNABLE_SPECS) {
+        double val = TunableValue(tunables, spec);
+        if (val != TunableValue(DEFAULT_TUNABLES, spec)) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP]   tunable {} = {}\n"), Utf::ToWide(spec.key), val);
+        }
+    }
+
+    // Watch the file we read for tunable edits
+    std::error_code ec;
+    m_path  = foundPath;
+    m_mtime = fs::last_write_time(m_path, ec);
+    m_lastPollNs = MonoNs();
+}
+
+bool Config::PollTunables()
+{
+    using namespace RC;
+
+    if (m_path.empty()) return false;
+    int64_t now = MonoNs();
+    if (now - m_lastPollNs < 1'000'000'000) return false;
+    m_lastPollNs = now;
+
+    std::error_code ec;
+    auto mtime = fs::last_write_time(m_path, ec);
+    if (ec || mtime == m_mtime) return false;
+    // Recorded even if the parse below fails: the warning is logged once
+    // and the next save of the file tries again.
+    m_mtime = mtime;
+
+    std::string fileContent;
+    {
+        std::ifstream file(m_path);
+        if (!file.is_open()) return false;
+        fileContent.assign(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+    }
+
+    Tunables next;
+    try {
+        auto j = json::parse(fileContent);
+        if (j.contains("tunables")) next = ReadTunables(j["tunables"], tunables);
+    }
+    catch (const json::exception& e) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] config.json changed but did not parse ({}) — tunables unchanged\n"),
+                                        Utf::ToWide(e.what()));
+        return false;
+    }
+
+    int changed = 0;
+    for (const auto& spec : TUNABLE_SPECS) {
+        double before = TunableValue(tunables, spec);
+        double after  = TunableValue(next, spec);
+        if (before == after) continue;
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] tunable {}: {} -> {}\n"), Utf::ToWide(spec.key), before, after);
+        ++changed;
+    }
+    tunables = next;
+    return changed > 0;
 }
 
 } // namespace TalosAP
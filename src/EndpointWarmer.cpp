@@ -0,0 +1,126 @@
+#include "headers/EndpointWarmer.h"
+#include "headers/TraceRecorder.h"
+#include "headers/Utf.h"
+
+#include <DynamicOutput/DynamicOutput.hpp>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#endif
+
+#include <chrono>
+
+using namespace RC;
+
+namespace TalosAP {
+
+EndpointWarmer::~EndpointWarmer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+// ============================================================
+// Server string
+// ============================================================
+
+void EndpointWarmer::SetServer(const std::string& server)
+{
+    std::string rest = server;
+    std::string scheme;
+    if (auto p = rest.find("://"); p != std::string::npos) {
+        scheme = rest.substr(0, p);
+        rest = rest.substr(p + 3);
+    }
+    if (auto p = rest.find('/'); p != std::string::npos) rest.resize(p);
+
+    // [v6]:port, host:port or bare host
+    m_port.clear();
+    if (!rest.empty() && rest.front() == '[') {
+        auto close = rest.find(']');
+        m_host = rest.substr(1, close == std::string::npos ? std::string::npos : close - 1);
+        if (close != std::string::npos && close + 1 < rest.size() && rest[close + 1] == ':') {
+            m_port = rest.substr(close + 2);
+        }
+    } else if (auto colon = rest.rfind(':'); colon != std::string::npos) {
+        m_host = rest.substr(0, colon);
+        m_port = rest.substr(colon + 1);
+    } else {
+        m_host = rest;
+    }
+    if (m_port.empty()) m_port = (scheme == "wss") ? "443" : (scheme == "ws") ? "80" : "38281";
+}
+
+// ============================================================
+// Worker
+// ============================================================
+
+void EndpointWarmer::Warm()
+{
+    if (m_host.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending) return;
+        m_pending = true;
+        if (!m_thread.joinable()) m_thread = std::thread([this] { Run(); });
+    }
+    m_cv.notify_one();
+}
+
+void EndpointWarmer::Run()
+{
+#ifdef _WIN32
+    WSADATA wsa;
+    const bool wsaOk = WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+#endif
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_pending || m_stop; });
+            if (m_stop) break;
+        }
+
+        TraceScope trace("AP.Resolve", "net");
+        auto start = std::chrono::steady_clock::now();
+
+        addrinfo hints{};
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = nullptr;
+        int rc = getaddrinfo(m_host.c_str(), m_port.c_str(), &hints, &result);
+
+        int count = 0;
+        for (addrinfo* ai = result; ai; ai = ai->ai_next) ++count;
+        if (result) freeaddrinfo(result);
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        m_lastCount.store(rc == 0 ? count : 0, std::memory_order_relaxed);
+        m_lastMs.store(ms, std::memory_order_relaxed);
+
+        if (rc == 0) {
+            Output::send<LogLevel::Verbose>(STR("[TalosAP] Resolved {} ({} addresses) in {:.1f} ms\n"),
+                Utf::ToWide(m_host), count, ms);
+        } else {
+            Output::send<LogLevel::Warning>(STR("[TalosAP] Could not resolve {} (error {}) after {:.1f} ms\n"),
+                Utf::ToWide(m_host), rc, ms);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = false;
+    }
+
+#ifdef _WIN32
+    if (wsaOk) WSACleanup();
+#endif
+}
+
+} // namespace TalosAP
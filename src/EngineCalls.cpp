@@ -0,0 +1,209 @@
+#include "headers/EngineCalls.h"
+#include "headers/TraceRecorder.h"
+#include "headers/FlightRecorder.h"
+#include "headers/Utf.h"
+
+#include <DynamicOutput/DynamicOutput.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+using namespace RC;
+using namespace RC::Unreal;
+
+namespace TalosAP {
+
+// ============================================================
+// Helpers
+// ============================================================
+
+const char* EngineCallStats::KindName(EngineCallKind kind)
+{
+    switch (kind) {
+        case EngineCallKind::FindAllOf:        return "FindAllOf";
+        case EngineCallKind::FindFirstOf:      return "FindFirstOf";
+        case EngineCallKind::StaticFindObject: return "StaticFindObject";
+        case EngineCallKind::GetValuePtr:      return "GetValuePtr";
+        case EngineCallKind::GetFunction:      return "GetFunction";
+        case EngineCallKind::ProcessEvent:     return "ProcessEvent";
+        case EngineCallKind::GetFullName:      return "GetFullName";
+        default:                               return "?";
+    }
+}
+
+// Per-second counter track names for the trace stream (must be static).
+static const char* KindRateName(EngineCallKind kind)
+{
+    switch (kind) {
+        case EngineCallKind::FindAllOf:        return "FindAllOf/s";
+        case EngineCallKind::FindFirstOf:      return "FindFirstOf/s";
+        case EngineCallKind::StaticFindObject: return "StaticFindObject/s";
+        case EngineCallKind::GetValuePtr:      return "GetValuePtr/s";
+        case EngineCallKind::GetFunction:      return "GetFunction/s";
+        case EngineCallKind::ProcessEvent:     return "ProcessEvent/s";
+        case EngineCallKind::GetFullName:      return "GetFullName/s";
+        default:                               return "?/s";
+    }
+}
+
+// "C:\\src\\VisibilityManager.cpp" → "VisibilityManager.cpp"
+static const char* BaseName(const char* path)
+{
+    const char* base = path;
+    for (const char* p = path; *p; ++p) {
+        if (*p == '/' || *p == '\\') base = p + 1;
+    }
+    return base;
+}
+
+// MSVC's function_name() is a full signature; keep just "Class::Method".
+static std::string ShortFunctionName(const char* fn)
+{
+    std::string s(fn);
+    auto paren = s.find('(');
+    if (paren != std::string::npos) s.resize(paren);
+    auto space = s.find_last_of(' ');
+    if (space != std::string::npos) s = s.substr(space + 1);
+    if (s.rfind("TalosAP::", 0) == 0) s = s.substr(9);
+    return s;
+}
+
+size_t EngineCallStats::KeyHash::operator()(const Key& k) const
+{
+    size_t h = std::hash<const void*>{}(k.file);
+    h ^= std::hash<const void*>{}(k.label) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    h ^= (static_cast<size_t>(k.line) << 8) | static_cast<size_t>(k.kind);
+    return h;
+}
+
+// ============================================================
+// EngineCallStats
+// ============================================================
+
+EngineCallStats& EngineCallStats::Get()
+{
+    static EngineCallStats s_instance;
+    return s_instance;
+}
+
+void EngineCallStats::Count(EngineCallKind kind, const void* label, bool wideLabel,
+                            const std::source_location& loc)
+{
+    ++m_kindTotals[static_cast<size_t>(kind)];
+
+    // ProcessEvent already leaves SpanBegin/SpanEnd via its TraceScope.
+    if (kind != EngineCallKind::ProcessEvent) {
+        if (wideLabel) {
+            FlightRecorder::Get().RecordWide(FlightEventKind::EngineCall, KindName(kind),
+                                             static_cast<const wchar_t*>(label));
+        } else {
+            FlightRecorder::Get().Record(FlightEventKind::EngineCall, KindName(kind),
+                                         static_cast<const char*>(label));
+        }
+    }
+
+    Key key{ loc.file_name(), loc.line(), kind, label };
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        ++it->second->total;
+        return;
+    }
+
+    // First call from this site — build its display name once.
+    std::string name = BaseName(loc.file_name());
+    name += ':';
+    name += ShortFunctionName(loc.function_name());
+    name += ' ';
+    name += KindName(kind);
+    if (label) {
+        name += '(';
+        if (wideLabel) {
+            for (const wchar_t* w = static_cast<const wchar_t*>(label); *w; ++w) {
+                name += (*w < 0x80) ? static_cast<char>(*w) : '?';
+            }
+        } else {
+            name += static_cast<const char*>(label);
+        }
+        name += ')';
+    }
+
+    Site& site = m_sites.emplace_back();
+    site.name  = std::move(name);
+    site.kind  = kind;
+    site.total = 1;
+    m_index.emplace(key, &site);
+}
+
+void EngineCallStats::Tick()
+{
+    int64_t now = TraceRecorder::NowNs();
+    if (m_lastSampleNs == 0) { m_lastSampleNs = now; return; }
+
+    int64_t elapsed = now - m_lastSampleNs;
+    if (elapsed < 1'000'000'000) return;
+
+    double seconds = elapsed / 1e9;
+    m_lastSampleNs = now;
+
+    auto& trace = TraceRecorder::Get();
+
+    for (size_t k = 0; k < KIND_COUNT; ++k) {
+        m_kindRates[k] = (m_kindTotals[k] - m_kindLastTotals[k]) / seconds;
+        m_kindLastTotals[k] = m_kindTotals[k];
+        trace.Counter(KindRateName(static_cast<EngineCallKind>(k)),
+                      static_cast<int64_t>(m_kindRates[k]));
+    }
+
+    for (auto& site : m_sites) {
+        uint64_t delta = site.total - site.lastTotal;
+        site.perSecond = delta / seconds;
+        site.lastTotal = site.total;
+        // Only active sites get a sample; idle tracks stay flat in the viewer.
+        if (delta > 0) {
+            trace.Counter(site.name.c_str(), static_cast<int64_t>(site.perSecond));
+        }
+    }
+}
+
+void EngineCallStats::Dump() const
+{
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] === Engine calls ({} sites) ===\n"), m_sites.size());
+
+    for (size_t k = 0; k < KIND_COUNT; ++k) {
+        std::string kn = KindName(static_cast<EngineCallKind>(k));
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {:<17} {:>8.1f}/s  total={}\n"),
+            Utf::ToWide(kn), m_kindRates[k], m_kindTotals[k]);
+    }
+
+    std::vector<const Site*> sorted;
+    sorted.reserve(m_sites.size());
+    for (const auto& site : m_sites) sorted.push_back(&site);
+    std::sort(sorted.begin(), sorted.end(), [](const Site* a, const Site* b) {
+        if (a->perSecond != b->perSecond) return a->perSecond > b->perSecond;
+        return a->total > b->total;
+    });
+
+    for (const Site* site : sorted) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {:>8.1f}/s  total={:<8} {}\n"),
+            site->perSecond, site->total, Utf::ToWide(site->name));
+    }
+}
+
+// ============================================================
+// Engine::ProcessEvent
+// ============================================================
+
+namespace Engine {
+
+void ProcessEvent(UObject* target, UFunction* func, void* params, const char* label,
+                  const std::source_location& loc)
+{
+    EngineCallStats::Get().Count(EngineCallKind::ProcessEvent, label, false, loc);
+    TraceScope trace("ProcessEvent", "engine", label);
+    target->ProcessEvent(func, params);
+}
+
+} // namespace Engine
+
+} // namespace TalosAP
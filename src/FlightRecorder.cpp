@@ -0,0 +1,136 @@
+#include "headers/FlightRecorder.h"
+#include "headers/TraceRecorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#define TALOSAP_GETPID _getpid
+#else
+#include <unistd.h>
+#define TALOSAP_GETPID getpid
+#endif
+
+namespace fs = std::filesystem;
+
+namespace TalosAP {
+
+static constexpr size_t FLIGHT_FILE_SIZE =
+    FLIGHT_HEADER_SIZE + sizeof(FlightRecord) * FlightRecorder::CAPACITY;
+
+FlightRecorder& FlightRecorder::Get()
+{
+    static FlightRecorder s_instance;
+    return s_instance;
+}
+
+bool FlightRecorder::Open(const std::wstring& dir)
+{
+    if (IsOpen()) return true;
+
+    fs::path base = dir.empty() ? fs::path(L".") : fs::path(dir);
+    fs::path current  = base / L"talos_ap_flight.bin";
+    fs::path previous = base / L"talos_ap_flight.prev.bin";
+
+    // Keep the last session's ring — if it ended in a crash, that's the
+    // file someone is going to want to decode.
+    std::error_code ec;
+    if (fs::exists(current, ec)) {
+        fs::remove(previous, ec);
+        fs::rename(current, previous, ec);
+        if (ec) fs::remove(current, ec);
+    }
+
+    if (!m_region.OpenFile(current.wstring(), FLIGHT_FILE_SIZE)) return false;
+
+    auto* bytes = static_cast<uint8_t*>(m_region.Data());
+    std::memset(bytes, 0, FLIGHT_FILE_SIZE);
+
+    m_header = reinterpret_cast<FlightHeader*>(bytes);
+    m_header->magic       = FLIGHT_MAGIC;
+    m_header->version     = FLIGHT_VERSION;
+    m_header->recordSize  = sizeof(FlightRecord);
+    m_header->capacity    = CAPACITY;
+    m_header->writeIndex  = 0;
+    m_header->startUnixNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    m_header->startMonoNs = TraceRecorder::NowNs();
+    m_header->processId   = static_cast<uint32_t>(TALOSAP_GETPID());
+
+    // Publish the records pointer last: Record() keys off it.
+    std::atomic_thread_fence(std::memory_order_release);
+    m_records = reinterpret_cast<FlightRecord*>(bytes + FLIGHT_HEADER_SIZE);
+
+    Record(FlightEventKind::Note, "session-start");
+    return true;
+}
+
+void FlightRecorder::Close()
+{
+    if (!IsOpen()) return;
+    Record(FlightEventKind::Note, "session-end");
+    m_records = nullptr;
+    m_header  = nullptr;
+    m_region.Close();
+}
+
+static void CopyField(char (&dst)[32], const char* src)
+{
+    size_t n = 0;
+    if (src) {
+        while (n < sizeof(dst) - 1 && src[n]) { dst[n] = src[n]; ++n; }
+    }
+    dst[n] = '\0';
+}
+
+static void CopyFieldWide(char (&dst)[32], const wchar_t* src)
+{
+    size_t n = 0;
+    if (src) {
+        while (n < sizeof(dst) - 1 && src[n]) {
+            dst[n] = (src[n] < 0x80) ? static_cast<char>(src[n]) : '?';
+            ++n;
+        }
+    }
+    dst[n] = '\0';
+}
+
+void FlightRecorder::Record(FlightEventKind kind, const char* name, const char* detail,
+                            int64_t a, uint32_t b)
+{
+    FlightRecord* records = m_records;
+    if (!records) return;
+
+    uint64_t index = std::atomic_ref<uint64_t>(m_header->writeIndex)
+                         .fetch_add(1, std::memory_order_relaxed);
+    FlightRecord& rec = records[index % CAPACITY];
+
+    // Invalidate first so a half-written slot never looks like a valid
+    // record from a previous lap.
+    std::atomic_ref<uint64_t>(rec.seq).store(0, std::memory_order_relaxed);
+    rec.tsNs = TraceRecorder::NowNs();
+    rec.a    = a;
+    rec.b    = b;
+    rec.kind = static_cast<uint16_t>(kind);
+    rec.tid  = static_cast<uint16_t>(TraceRecorder::CurrentTid());
+    CopyField(rec.name, name);
+    CopyField(rec.detail, detail);
+    std::atomic_ref<uint64_t>(rec.seq).store(index + 1, std::memory_order_release);
+}
+
+void FlightRecorder::RecordWide(FlightEventKind kind, const char* name, const wchar_t* detail,
+                                int64_t a, uint32_t b)
+{
+    FlightRecord* records = m_records;
+    if (!records) return;
+
+    char narrow[32];
+    CopyFieldWide(narrow, detail);
+    Record(kind, name, narrow, a, b);
+}
+
+} // namespace TalosAP
@@ -0,0 +1,142 @@
+#include "headers/FunctionThunk.h"
+#include "headers/FixedString.h"
+
+#include <Unreal/UObjectGlobals.hpp>
+#include <Unreal/UFunction.hpp>
+#include <Unreal/FProperty.hpp>
+#include <DynamicOutput/DynamicOutput.hpp>
+
+#include <string>
+
+using namespace RC;
+using namespace RC::Unreal;
+
+namespace TalosAP {
+
+// Registry head. Constant-initialised, so thunks defined in other
+// translation units can link themselves in during static init.
+static FunctionThunkBase* s_thunkHead = nullptr;
+
+// EPropertyFlags::CPF_Parm — set on every parameter (including the return
+// value) of a UFunction.
+static constexpr uint64_t CPF_PARM = 0x80;
+
+FunctionThunkBase::FunctionThunkBase(const wchar_t* path, const char* label,
+                                     size_t paramsSize, size_t paramsAlign, bool noParams,
+                                     const ThunkField* fields, size_t fieldCount)
+    : m_path(path)
+    , m_label(label)
+    , m_paramsSize(paramsSize)
+    , m_paramsAlign(paramsAlign)
+    , m_noParams(noParams)
+{
+    for (size_t i = 0; i < fieldCount; ++i) {
+        m_fields[m_fieldCount++] = fields[i];
+    }
+    m_next = s_thunkHead;
+    s_thunkHead = this;
+}
+
+// ============================================================
+// Resolve
+// ============================================================
+
+bool FunctionThunkBase::Resolve(bool retryMissing)
+{
+    if (m_state == State::Ready) return true;
+    if (m_state == State::Missing && retryMissing) m_state = State::Unresolved;
+    if (m_state != State::Unresolved) return false;
+
+    UFunction* func = nullptr;
+    try {
+        func = Engine::StaticFindObject<UFunction*>(m_path);
+    }
+    catch (...) {}
+
+    if (!func) {
+        m_state = State::Missing;
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Thunk {}: UFunction {} not found\n"),
+            Widen(m_label), m_path);
+        return false;
+    }
+
+    if (!Validate(func)) {
+        m_state = State::BadLayout;
+        return false;
+    }
+
+    m_func = func;
+    m_state = State::Ready;
+    return true;
+}
+
+void FunctionThunkBase::ResolveAll()
+{
+    int ready = 0, failed = 0;
+    for (auto* t = s_thunkHead; t; t = t->m_next) {
+        if (t->Resolve(true)) ++ready; else ++failed;
+    }
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] Function thunks: {} ready, {} unavailable\n"),
+        ready, failed);
+}
+
+// ============================================================
+// Validate — compare the C++ Params struct with the UFunction
+// ============================================================
+
+bool FunctionThunkBase::Validate(UFunction* func)
+{
+    const size_t parmsSize = static_cast<size_t>(func->GetParmsSize());
+
+    // ProcessEvent copies ParmsSize bytes in and out of our buffer. The
+    // C++ struct may only be larger by its own tail padding.
+    if (m_noParams) {
+        if (parmsSize != 0) {
+            Output::send<LogLevel::Error>(STR("[TalosAP] Thunk {}: declared with no params but ParmsSize={}\n"),
+                Widen(m_label), parmsSize);
+            return false;
+        }
+        return true;
+    }
+    if (m_paramsSize < parmsSize || m_paramsSize - parmsSize >= m_paramsAlign) {
+        Output::send<LogLevel::Error>(STR("[TalosAP] Thunk {}: sizeof(Params)={} but ParmsSize={}\n"),
+            Widen(m_label), m_paramsSize, parmsSize);
+        return false;
+    }
+
+    bool ok = true;
+    bool matched[MAX_FIELDS] = {};
+
+    for (FProperty* prop : func->ForEachProperty()) {
+        if (!prop) continue;
+        if (!(static_cast<uint64_t>(prop->GetPropertyFlags()) & CPF_PARM)) continue;
+
+        std::wstring name = prop->GetName();
+        const size_t offset = static_cast<size_t>(prop->GetOffset_Internal());
+        const size_t size   = static_cast<size_t>(prop->GetSize());
+
+        for (size_t i = 0; i < m_fieldCount; ++i) {
+            if (name != m_fields[i].name) continue;
+            matched[i] = true;
+            if (m_fields[i].offset != offset || m_fields[i].size != size) {
+                Output::send<LogLevel::Error>(
+                    STR("[TalosAP] Thunk {}: field {} is at +0x{:X} ({} bytes), engine has +0x{:X} ({} bytes)\n"),
+                    Widen(m_label), name, m_fields[i].offset, m_fields[i].size, offset, size);
+                ok = false;
+            }
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < m_fieldCount; ++i) {
+        if (!matched[i]) {
+            Output::send<LogLevel::Error>(STR("[TalosAP] Thunk {}: no parameter named {}\n"),
+                Widen(m_label), m_fields[i].name);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+} // namespace TalosAP
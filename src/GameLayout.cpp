@@ -0,0 +1,113 @@
+#include "headers/GameLayout.h"
+#include "headers/EngineCalls.h"
+
+#include <Unreal/UObjectGlobals.hpp>
+#include <Unreal/FProperty.hpp>
+#include <Unreal/CoreUObject/UObject/Class.hpp>
+#include <DynamicOutput/DynamicOutput.hpp>
+
+using namespace RC;
+using namespace RC::Unreal;
+
+namespace TalosAP {
+
+// Registry head — constant-initialised so generated entries in any
+// translation unit can link in during static init.
+static GameLayoutEntry* s_layoutHead = nullptr;
+
+GameLayoutEntry::GameLayoutEntry(const wchar_t* ownerPath, const wchar_t* member, size_t value, size_t size)
+    : m_ownerPath(ownerPath)
+    , m_member(member)
+    , m_value(value)
+    , m_dumpValue(value)
+    , m_size(size)
+{
+    m_next = s_layoutHead;
+    s_layoutHead = this;
+}
+
+// ============================================================
+// Verify — compare one entry with live reflection
+// ============================================================
+
+bool GameLayoutEntry::Verify()
+{
+    if (m_source != Source::Dump) return true;
+
+    UStruct* owner = nullptr;
+    try {
+        owner = Engine::StaticFindObject<UStruct*>(m_ownerPath);
+    }
+    catch (...) {}
+    if (!owner) return false;   // not loaded yet — try again next time
+
+    size_t live = 0;
+    size_t liveSize = m_size;
+    try {
+        if (!m_member) {
+            live = static_cast<size_t>(owner->GetPropertiesSize());
+            liveSize = live;
+        } else {
+            FProperty* prop = owner->GetPropertyByNameInChain(m_member);
+            if (!prop) {
+                m_source = Source::Unreflected;
+                Output::send<LogLevel::Warning>(STR("[TalosAP] Layout: {}.{} not in reflection — keeping dump offset 0x{:X}\n"),
+                    m_ownerPath, m_member, m_value);
+                return true;
+            }
+            live = static_cast<size_t>(prop->GetOffset_Internal());
+            liveSize = static_cast<size_t>(prop->GetSize());
+        }
+    }
+    catch (...) {
+        return false;
+    }
+
+    if (live == m_dumpValue) {
+        m_source = Source::Verified;
+    } else {
+        m_value = live;
+        m_source = Source::Reflection;
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Layout: {}.{} is 0x{:X} in the dump but 0x{:X} live — using live value; regenerate offsets\n"),
+            m_ownerPath, m_member ? m_member : STR("sizeof"), m_dumpValue, live);
+    }
+
+    if (m_member && liveSize != m_size) {
+        Output::send<LogLevel::Error>(STR("[TalosAP] Layout: {}.{} changed size (dump 0x{:X}, live 0x{:X}) — type may have changed\n"),
+            m_ownerPath, m_member, m_size, liveSize);
+    }
+    return true;
+}
+
+void GameLayoutEntry::VerifyAll()
+{
+    int checked = 0, fallback = 0, pending = 0;
+    for (auto* e = s_layoutHead; e; e = e->m_next) {
+        if (e->m_source != Source::Dump) continue;
+        if (!e->Verify()) { ++pending; continue; }
+        ++checked;
+        if (e->m_source == Source::Reflection) ++fallback;
+    }
+    if (checked > 0) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Layout: verified {} offsets ({} from reflection), {} owners not loaded yet\n"),
+            checked, fallback, pending);
+    }
+}
+
+void GameLayoutEntry::Dump()
+{
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] === Game Layout ===\n"));
+    for (auto* e = s_layoutHead; e; e = e->m_next) {
+        const wchar_t* source = STR("dump (unchecked)");
+        switch (e->m_source) {
+            case Source::Dump:        break;
+            case Source::Verified:    source = STR("dump = live"); break;
+            case Source::Reflection:  source = STR("LIVE (dump stale)"); break;
+            case Source::Unreflected: source = STR("dump (not reflected)"); break;
+        }
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {}.{} = 0x{:X}  [{}]\n"),
+            e->m_ownerPath, e->m_member ? e->m_member : STR("sizeof"), e->m_value, source);
+    }
+}
+
+} // namespace TalosAP
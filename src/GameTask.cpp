@@ -0,0 +1,239 @@
+#include "headers/GameTask.h"
+
+namespace TalosAP {
+
+// ============================================================
+// promise_type
+// ============================================================
+
+std::suspend_never GameTask::promise_type::final_suspend() noexcept
+{
+    // The frame is destroyed as soon as this returns.
+    TaskScheduler::Get().OnFinished(slot);
+    return {};
+}
+
+void GameTask::promise_type::unhandled_exception() noexcept
+{
+    TaskScheduler::Get().OnFault(slot);
+}
+
+// ============================================================
+// Lifecycle
+// ============================================================
+
+TaskScheduler& TaskScheduler::Get()
+{
+    static TaskScheduler instance;
+    return instance;
+}
+
+void TaskScheduler::Spawn(GameTask task, TaskGroup group, const char* name)
+{
+    GameTask::Handle h = std::exchange(task.m_handle, {});
+    if (!h) return;
+
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Slot& s = m_slots[slot];
+    s.handle = h;
+    s.name = name;
+    s.group = group;
+    s.wait = TaskWait::Start;
+    s.live = true;
+    s.cancelPending = false;
+    h.promise().slot = slot;
+    ++m_live;
+
+    m_nextTick.push_back(RefOf(slot));
+}
+
+void TaskScheduler::Free(uint32_t slot)
+{
+    Slot& s = m_slots[slot];
+    s.handle = {};
+    s.live = false;
+    ++s.gen;            // every queued Ref to this slot is now stale
+    --m_live;
+    m_freeSlots.push_back(slot);
+}
+
+size_t TaskScheduler::Cancel(TaskGroup group)
+{
+    size_t n = 0;
+    for (uint32_t i = 0; i < m_slots.size(); ++i) {
+        Slot& s = m_slots[i];
+        if (!s.live || s.group != group) continue;
+        if (i == m_running) {
+            s.cancelPending = true;
+        } else {
+            GameTask::Handle h = s.handle;
+            Free(i);
+            h.destroy();    // runs the frame's destructors; no final_suspend
+        }
+        ++n;
+    }
+    return n;
+}
+
+void TaskScheduler::CancelAll()
+{
+    Cancel(TaskGroup::Session);
+    Cancel(TaskGroup::Level);
+}
+
+void TaskScheduler::OnFinished(uint32_t slot)
+{
+    if (slot < m_slots.size() && m_slots[slot].live) Free(slot);
+}
+
+void TaskScheduler::OnFault(uint32_t slot)
+{
+    ++m_faults;
+    if (slot < m_slots.size()) m_lastFault = m_slots[slot].name;
+}
+
+// ============================================================
+// Waits
+// ============================================================
+
+void TaskScheduler::WaitNextTick(uint32_t slot)
+{
+    m_slots[slot].wait = TaskWait::NextTick;
+    m_nextTick.push_back(RefOf(slot));
+}
+
+void TaskScheduler::WaitAfter(uint32_t slot, uint64_t ms)
+{
+    if (ms == 0 || !m_started) {
+        WaitNextTick(slot);
+        return;
+    }
+    m_slots[slot].wait = TaskWait::Timer;
+
+    // Whole wheel steps from the current slot's time to the deadline,
+    // rounded up: a timer never fires early, and late by at most one
+    // granule plus the frame time.
+    uint64_t span  = m_nowMs + ms - m_wheelMs;
+    uint64_t steps = (span + WHEEL_GRANULARITY_MS - 1) / WHEEL_GRANULARITY_MS;
+    if (steps == 0) steps = 1;
+
+    uint32_t target = static_cast<uint32_t>((m_wheelPos + steps) % WHEEL_SLOTS);
+    uint32_t rounds = static_cast<uint32_t>((steps - 1) / WHEEL_SLOTS);
+    m_wheel[target].push_back({ RefOf(slot), rounds });
+    ++m_timers;
+}
+
+void TaskScheduler::WaitWorldReady(uint32_t slot)
+{
+    m_slots[slot].wait = TaskWait::WorldReady;
+    m_worldWaiters.push_back(RefOf(slot));
+}
+
+void TaskScheduler::WaitUntil(uint32_t slot, std::function<bool()> pred)
+{
+    m_slots[slot].wait = TaskWait::Until;
+    m_pollers.push_back({ RefOf(slot), std::move(pred) });
+}
+
+// ============================================================
+// Tick
+// ============================================================
+
+void TaskScheduler::AdvanceWheel(uint64_t nowMs)
+{
+    if (!m_started) {
+        m_started = true;
+        m_wheelMs = nowMs;
+        return;
+    }
+
+    while (m_wheelMs + WHEEL_GRANULARITY_MS <= nowMs) {
+        m_wheelPos = (m_wheelPos + 1) % WHEEL_SLOTS;
+        m_wheelMs += WHEEL_GRANULARITY_MS;
+
+        auto& bucket = m_wheel[m_wheelPos];
+        if (bucket.empty()) continue;
+
+        size_t keep = 0;
+        for (auto& t : bucket) {
+            if (!Valid(t.ref)) {
+                --m_timers;                 // cancelled while waiting
+            } else if (t.rounds == 0) {
+                --m_timers;
+                m_run.push_back(t.ref);
+            } else {
+                --t.rounds;
+                bucket[keep++] = t;
+            }
+        }
+        bucket.resize(keep);
+    }
+}
+
+void TaskScheduler::Resume(const Ref& r)
+{
+    if (!Valid(r)) return;
+
+    m_slots[r.slot].wait = TaskWait::Running;
+    m_running = r.slot;
+    ++m_resumes;
+    m_slots[r.slot].handle.resume();     // may finish and free the slot
+    m_running = GameTask::NO_SLOT;
+
+    // Cancelled itself (or its group) while running: now suspended, so
+    // it can be destroyed.
+    if (Valid(r) && m_slots[r.slot].cancelPending) {
+        GameTask::Handle h = m_slots[r.slot].handle;
+        Free(r.slot);
+        h.destroy();
+    }
+}
+
+void TaskScheduler::Tick(uint64_t nowMs, bool worldReady)
+{
+    m_nowMs = nowMs;
+    m_worldReady = worldReady;
+    ++m_ticks;
+
+    // Collect everything due before resuming anything: a task that
+    // waits again while running lands in next tick's lists.
+    m_run.clear();
+    m_run.swap(m_nextTick);
+
+    AdvanceWheel(nowMs);
+
+    if (worldReady && !m_worldWaiters.empty()) {
+        m_run.insert(m_run.end(), m_worldWaiters.begin(), m_worldWaiters.end());
+        m_worldWaiters.clear();
+    }
+
+    if (!m_pollers.empty()) {
+        size_t keep = 0;
+        for (auto& p : m_pollers) {
+            if (!Valid(p.ref)) continue;
+            if (p.pred()) {
+                m_run.push_back(p.ref);
+            } else {
+                if (&m_pollers[keep] != &p) m_pollers[keep] = std::move(p);
+                ++keep;
+            }
+        }
+        m_pollers.resize(keep);
+    }
+
+    // Index loop: a resumed task may Spawn, which only touches m_nextTick.
+    for (size_t i = 0; i < m_run.size(); ++i) {
+        Resume(m_run[i]);
+    }
+    m_run.clear();
+}
+
+} // namespace TalosAP
@@ -1,4 +1,8 @@
 #include "headers/HudNotification.h"
+#include "headers/EngineCalls.h"
+#include "headers/FunctionThunk.h"
+#include "headers/ObjectTracker.h"
+#include "GameOffsets.h"
 
 #include <Unreal/UObjectGlobals.hpp>
 #include <Unreal/UObject.hpp>
@@ -103,6 +107,76 @@ struct Params_GetIsVisible {
     bool ReturnValue;
 };
 
+// FSlateFontInfo is opaque to us: SetFont takes it by value, and we only
+// change Size on a copy of the TextBlock's current Font. Size and offset
+// come from the header dump (GameOffsets.h).
+struct alignas(8) FSlateFontInfoBlob {
+    uint8_t Bytes[GameOffsets::SlateFontInfo::STATIC_SIZE];
+};
+
+// UTextBlock::SetFont(FSlateFontInfo InFontInfo)
+struct Params_SetFont {
+    FSlateFontInfoBlob InFontInfo;
+};
+
+// ============================================================
+// UMG function thunks — looked up and layout-checked once
+// ============================================================
+static FunctionThunk<Params_AddToViewport> s_addToViewport{
+    STR("/Script/UMG.UserWidget:AddToViewport"), "AddToViewport",
+    { THUNK_FIELD(Params_AddToViewport, ZOrder) } };
+
+static FunctionThunk<Params_GetIsVisible> s_getIsVisible{
+    STR("/Script/UMG.UserWidget:GetIsVisible"), "GetIsVisible",
+    { THUNK_FIELD(Params_GetIsVisible, ReturnValue) } };
+
+static FunctionThunk<NoParams> s_removeFromParent{
+    STR("/Script/UMG.Widget:RemoveFromParent"), "RemoveFromParent" };
+
+static FunctionThunk<Params_AddChildToCanvas> s_addChildToCanvas{
+    STR("/Script/UMG.CanvasPanel:AddChildToCanvas"), "AddChildToCanvas",
+    { THUNK_FIELD(Params_AddChildToCanvas, Content), THUNK_FIELD(Params_AddChildToCanvas, ReturnValue) } };
+
+static FunctionThunk<Params_RemoveChild> s_removeChild{
+    STR("/Script/UMG.PanelWidget:RemoveChild"), "RemoveChild",
+    { THUNK_FIELD(Params_RemoveChild, Content), THUNK_FIELD(Params_RemoveChild, ReturnValue) } };
+
+static FunctionThunk<Params_AddChildToHBox> s_addChildToHBox{
+    STR("/Script/UMG.HorizontalBox:AddChildToHorizontalBox"), "AddChildToHBox",
+    { THUNK_FIELD(Params_AddChildToHBox, Content), THUNK_FIELD(Params_AddChildToHBox, ReturnValue) } };
+
+static FunctionThunk<Params_SetText> s_setText{
+    STR("/Script/UMG.TextBlock:SetText"), "SetText",
+    { THUNK_FIELD(Params_SetText, InText) } };
+
+static FunctionThunk<Params_SetColorAndOpacity> s_setColorAndOpacity{
+    STR("/Script/UMG.TextBlock:SetColorAndOpacity"), "SetColorAndOpacity",
+    { THUNK_FIELD(Params_SetColorAndOpacity, InColorAndOpacity) } };
+
+static FunctionThunk<Params_SetShadowOffset> s_setShadowOffset{
+    STR("/Script/UMG.TextBlock:SetShadowOffset"), "SetShadowOffset",
+    { THUNK_FIELD(Params_SetShadowOffset, InShadowOffset) } };
+
+static FunctionThunk<Params_SetShadowColorAndOpacity> s_setShadowColorAndOpacity{
+    STR("/Script/UMG.TextBlock:SetShadowColorAndOpacity"), "SetShadowColorAndOpacity",
+    { THUNK_FIELD(Params_SetShadowColorAndOpacity, InShadowColorAndOpacity) } };
+
+static FunctionThunk<Params_SetPosition> s_setPosition{
+    STR("/Script/UMG.CanvasPanelSlot:SetPosition"), "SetPosition",
+    { THUNK_FIELD(Params_SetPosition, InPosition) } };
+
+static FunctionThunk<Params_SetAutoSize> s_setAutoSize{
+    STR("/Script/UMG.CanvasPanelSlot:SetAutoSize"), "SetAutoSize",
+    { THUNK_FIELD(Params_SetAutoSize, bInAutoSize) } };
+
+static FunctionThunk<Params_SetFont> s_setFont{
+    STR("/Script/UMG.TextBlock:SetFont"), "SetFont",
+    { THUNK_FIELD(Params_SetFont, InFontInfo) } };
+
+static FunctionThunk<Params_SetVisibility> s_setVisibility{
+    STR("/Script/UMG.Widget:SetVisibility"), "SetVisibility",
+    { THUNK_FIELD(Params_SetVisibility, InVisibility) } };
+
 // ============================================================
 // ESlateVisibility values (from UMG_enums.hpp)
 // ============================================================
@@ -117,11 +191,11 @@ bool HudNotification::CacheClasses()
 
     try {
         // UClass objects for UMG widgets live at /Script/UMG.<ClassName>
-        m_userWidgetClass  = UObjectGlobals::StaticFindObject<UObject*>(nullptr, nullptr, STR("/Script/UMG.UserWidget"));
-        m_widgetTreeClass  = UObjectGlobals::StaticFindObject<UObject*>(nullptr, nullptr, STR("/Script/UMG.WidgetTree"));
-        m_canvasPanelClass = UObjectGlobals::StaticFindObject<UObject*>(nullptr, nullptr, STR("/Script/UMG.CanvasPanel"));
-        m_textBlockClass   = UObjectGlobals::StaticFindObject<UObject*>(nullptr, nullptr, STR("/Script/UMG.TextBlock"));
-        m_hboxClass        = UObjectGlobals::StaticFindObject<UObject*>(nullptr, nullptr, STR("/Script/UMG.HorizontalBox"));
+        m_userWidgetClass  = Engine::StaticFindObject<UObject*>(STR("/Script/UMG.UserWidget"));
+        m_widgetTreeClass  = Engine::StaticFindObject<UObject*>(STR("/Script/UMG.WidgetTree"));
+        m_canvasPanelClass = Engine::StaticFindObject<UObject*>(STR("/Script/UMG.CanvasPanel"));
+        m_textBlockClass   = Engine::StaticFindObject<UObject*>(STR("/Script/UMG.TextBlock"));
+        m_hboxClass        = Engine::StaticFindObject<UObject*>(STR("/Script/UMG.HorizontalBox"));
     }
     catch (...) {
         Output::send<LogLevel::Error>(STR("[TalosAP-HUD] Exception finding UMG classes\n"));
@@ -140,55 +214,49 @@ bool HudNotification::CacheClasses()
 }
 
 // ============================================================
-// CacheFunctions — find UFunction* for all UMG methods we call
+// CacheFunctions — resolve and validate the UMG function thunks
 // ============================================================
 bool HudNotification::CacheFunctions()
 {
-    if (m_fnAddToViewport) return true; // already cached
-
-    try {
-        m_fnAddToViewport    = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.UserWidget:AddToViewport"));
-        m_fnGetIsVisible     = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.UserWidget:GetIsVisible"));
-        m_fnRemoveFromParent = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.Widget:RemoveFromParent"));
-        m_fnAddChildToCanvas = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.CanvasPanel:AddChildToCanvas"));
-        m_fnRemoveChild      = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.PanelWidget:RemoveChild"));
-        m_fnAddChildToHBox   = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.HorizontalBox:AddChildToHorizontalBox"));
-        m_fnSetText          = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.TextBlock:SetText"));
-        m_fnSetColorAndOpacity = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.TextBlock:SetColorAndOpacity"));
-        m_fnSetShadowOffset  = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.TextBlock:SetShadowOffset"));
-        m_fnSetShadowColorAndOpacity = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.TextBlock:SetShadowColorAndOpacity"));
-        m_fnSetPosition      = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.CanvasPanelSlot:SetPosition"));
-        m_fnSetAutoSize      = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.CanvasPanelSlot:SetAutoSize"));
-        m_fnSetFont          = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.TextBlock:SetFont"));
-        m_fnSetVisibility    = UObjectGlobals::StaticFindObject<UFunction*>(nullptr, nullptr, STR("/Script/UMG.Widget:SetVisibility"));
-    }
-    catch (...) {
-        Output::send<LogLevel::Error>(STR("[TalosAP-HUD] Exception finding UMG functions\n"));
-        return false;
+    if (m_functionsReady) return true;
+
+    // Optional ones (SetFont, shadows, GetIsVisible) are checked at
+    // each call site; a layout mismatch there only costs the styling.
+    FunctionThunkBase* critical[] = {
+        &s_addToViewport, &s_addChildToCanvas, &s_addChildToHBox, &s_setText,
+        &s_setColorAndOpacity, &s_setPosition, &s_removeChild, &s_setVisibility,
+    };
+
+    bool ok = true;
+    for (auto* thunk : critical) {
+        if (!thunk->Resolve(true)) ok = false;
     }
 
-    // Validate critical functions
-    if (!m_fnAddToViewport || !m_fnAddChildToCanvas || !m_fnAddChildToHBox ||
-        !m_fnSetText || !m_fnSetColorAndOpacity || !m_fnSetPosition ||
-        !m_fnRemoveChild || !m_fnSetVisibility) {
-        Output::send<LogLevel::Warning>(STR("[TalosAP-HUD] One or more UMG functions not found\n"));
+    if (!ok) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP-HUD] One or more UMG functions not available\n"));
         return false;
     }
 
+    m_functionsReady = true;
     Output::send<LogLevel::Verbose>(STR("[TalosAP-HUD] UMG functions cached\n"));
     return true;
 }
 
 // ============================================================
-// Helper: construct a UObject of a given UClass with a given outer
+// Helper: construct a UObject of a given UClass with a given outer,
+// registered with the ObjectTracker (owned by, and released with, the
+// outer)
 // ============================================================
-static UObject* ConstructWidget(UObject* classObj, UObject* outer, const wchar_t* name)
+static UObject* ConstructWidget(UObject* classObj, UObject* outer, const wchar_t* name, ModObjectKind kind,
+                                const std::source_location& loc = std::source_location::current())
 {
     auto* cls = static_cast<UClass*>(classObj);
     FStaticConstructObjectParameters params(cls);
     params.Outer = outer;
     params.Name  = FName(name, FNAME_Add);
-    return UObjectGlobals::StaticConstructObject(params);
+    UObject* obj = UObjectGlobals::StaticConstructObject(params);
+    ObjectTracker::Get().Track(obj, kind, outer, name, loc);
+    return obj;
 }
 
 // ============================================================
@@ -201,7 +269,7 @@ bool HudNotification::CreateWidget()
 
     // Find a suitable outer — use the GameInstance or transient package
     // In Lua the outer was GameInstance; in C++ we can get it via FindFirstOf.
-    UObject* outer = UObjectGlobals::FindFirstOf(STR("GameInstance"));
+    UObject* outer = Engine::FindFirstOf(STR("GameInstance"));
     if (!outer) {
         Output::send<LogLevel::Warning>(STR("[TalosAP-HUD] GameInstance not found\n"));
         return false;
@@ -210,44 +278,48 @@ bool HudNotification::CreateWidget()
     DestroyWidget();
 
     // 1. UserWidget
-    m_hudWidget = ConstructWidget(m_userWidgetClass, outer, STR("APNotifWidget"));
+    m_hudWidget = ConstructWidget(m_userWidgetClass, outer, STR("APNotifWidget"), ModObjectKind::HudWidget);
     if (!m_hudWidget) {
         Output::send<LogLevel::Error>(STR("[TalosAP-HUD] Failed to construct UserWidget\n"));
         return false;
     }
 
     // 2. WidgetTree (must be set as the WidgetTree property on the UserWidget)
-    UObject* widgetTree = ConstructWidget(m_widgetTreeClass, m_hudWidget, STR("APNotifTree"));
+    UObject* widgetTree = ConstructWidget(m_widgetTreeClass, m_hudWidget, STR("APNotifTree"), ModObjectKind::HudWidgetTree);
     if (!widgetTree) {
         Output::send<LogLevel::Error>(STR("[TalosAP-HUD] Failed to construct WidgetTree\n"));
+        ObjectTracker::Get().Release(m_hudWidget);
         m_hudWidget = nullptr;
         return false;
     }
 
     // Set UserWidget.WidgetTree = widgetTree
-    auto* wtPtr = m_hudWidget->GetValuePtrByPropertyNameInChain<UObject*>(STR("WidgetTree"));
+    auto* wtPtr = Engine::GetValuePtr<UObject*>(m_hudWidget, STR("WidgetTree"));
     if (wtPtr) {
         *wtPtr = widgetTree;
     } else {
         Output::send<LogLevel::Error>(STR("[TalosAP-HUD] Could not find WidgetTree property\n"));
+        ObjectTracker::Get().Release(m_hudWidget);
         m_hudWidget = nullptr;
         return false;
     }
 
     // 3. CanvasPanel (root widget of the tree)
-    m_canvas = ConstructWidget(m_canvasPanelClass, widgetTree, STR("APNotifCanvas"));
+    m_canvas = ConstructWidget(m_canvasPanelClass, widgetTree, STR("APNotifCanvas"), ModObjectKind::HudCanvas);
     if (!m_canvas) {
         Output::send<LogLevel::Error>(STR("[TalosAP-HUD] Failed to construct CanvasPanel\n"));
+        ObjectTracker::Get().Release(m_hudWidget);
         m_hudWidget = nullptr;
         return false;
     }
 
     // Set WidgetTree.RootWidget = canvas
-    auto* rwPtr = widgetTree->GetValuePtrByPropertyNameInChain<UObject*>(STR("RootWidget"));
+    auto* rwPtr = Engine::GetValuePtr<UObject*>(widgetTree, STR("RootWidget"));
     if (rwPtr) {
         *rwPtr = m_canvas;
     } else {
         Output::send<LogLevel::Error>(STR("[TalosAP-HUD] Could not find RootWidget property\n"));
+        ObjectTracker::Get().Release(m_hudWidget);
         m_hudWidget = nullptr;
         m_canvas = nullptr;
         return false;
@@ -266,10 +338,12 @@ bool HudNotification::CreateWidget()
 // ============================================================
 void HudNotification::DestroyWidget()
 {
-    if (m_hudWidget && m_fnRemoveFromParent) {
+    if (m_hudWidget) {
         try {
-            m_hudWidget->ProcessEvent(m_fnRemoveFromParent, nullptr);
+            s_removeFromParent.Call(m_hudWidget);
         } catch (...) {}
+        // Its tree, canvas and lines go with it
+        ObjectTracker::Get().Release(m_hudWidget);
     }
 
     m_hudWidget   = nullptr;
@@ -291,20 +365,20 @@ bool HudNotification::EnsureWidgetVisible()
     // Check if widget is still valid and visible
     if (m_hudWidget) {
         try {
-            if (m_fnGetIsVisible) {
+            if (s_getIsVisible.Resolve()) {
                 Params_GetIsVisible params{};
-                m_hudWidget->ProcessEvent(m_fnGetIsVisible, &params);
+                s_getIsVisible.Call(m_hudWidget, params);
                 if (!params.ReturnValue) {
                     // Re-add to viewport
                     Params_AddToViewport vp{};
                     vp.ZOrder = WIDGET_ZORDER;
-                    m_hudWidget->ProcessEvent(m_fnAddToViewport, &vp);
+                    s_addToViewport.Call(m_hudWidget, vp);
                 }
             } else {
                 // Can't check, just add
                 Params_AddToViewport vp{};
                 vp.ZOrder = WIDGET_ZORDER;
-                m_hudWidget->ProcessEvent(m_fnAddToViewport, &vp);
+                s_addToViewport.Call(m_hudWidget, vp);
             }
         }
         catch (...) {
@@ -316,14 +390,14 @@ bool HudNotification::EnsureWidgetVisible()
             // Add new widget to viewport
             Params_AddToViewport vp{};
             vp.ZOrder = WIDGET_ZORDER;
-            m_hudWidget->ProcessEvent(m_fnAddToViewport, &vp);
+            s_addToViewport.Call(m_hudWidget, vp);
         }
     } else {
         m_widgetReady = false;
         if (!CreateWidget()) return false;
         Params_AddToViewport vp{};
         vp.ZOrder = WIDGET_ZORDER;
-        m_hudWidget->ProcessEvent(m_fnAddToViewport, &vp);
+        s_addToViewport.Call(m_hudWidget, vp);
     }
 
     return true;
@@ -332,15 +406,18 @@ bool HudNotification::EnsureWidgetVisible()
 // ============================================================
 // AddEntry — create a HorizontalBox with TextBlock per segment
 // ============================================================
-void HudNotification::AddEntry(const std::vector<TextSegment>& segments, float duration)
+void HudNotification::AddEntry(const HudLine& line, float duration)
 {
-    if (!m_canvas || !m_fnAddChildToCanvas || !m_fnAddChildToHBox) return;
+    if (!m_canvas || !m_functionsReady) return;
 
+    // The counter goes in the FName number ("APNotifHBox_12"), not the
+    // string: FNames are never freed, and "APNotif_12_HBox" added a new
+    // name table entry for every notification of a long session.
     ++m_entryCounter;
-    std::wstring baseName = STR("APNotif_") + std::to_wstring(m_entryCounter);
+    std::wstring hboxName = STR("APNotifHBox_") + std::to_wstring(m_entryCounter);
 
     // 1. Construct HorizontalBox
-    UObject* hbox = ConstructWidget(m_hboxClass, m_canvas, (baseName + STR("_HBox")).c_str());
+    UObject* hbox = ConstructWidget(m_hboxClass, m_canvas, hboxName.c_str(), ModObjectKind::HudLine);
     if (!hbox) {
         Output::send<LogLevel::Warning>(STR("[TalosAP-HUD] Failed to construct HorizontalBox\n"));
         return;
@@ -350,55 +427,52 @@ void HudNotification::AddEntry(const std::vector<TextSegment>& segments, float d
     Params_AddChildToCanvas canvasParams{};
     canvasParams.Content = hbox;
     canvasParams.ReturnValue = nullptr;
-    m_canvas->ProcessEvent(m_fnAddChildToCanvas, &canvasParams);
+    s_addChildToCanvas.Call(m_canvas, canvasParams);
     UObject* canvasSlot = canvasParams.ReturnValue;
+    ObjectTracker::Get().Track(canvasSlot, ModObjectKind::HudSlot, hbox, {});
 
-    if (canvasSlot && m_fnSetAutoSize) {
+    if (canvasSlot) {
         Params_SetAutoSize autoParams{};
         autoParams.bInAutoSize = true;
-        canvasSlot->ProcessEvent(m_fnSetAutoSize, &autoParams);
+        s_setAutoSize.Call(canvasSlot, autoParams);
     }
 
     // Set HBox visibility to SelfHitTestInvisible
-    if (m_fnSetVisibility) {
+    {
         Params_SetVisibility visParams{};
         visParams.InVisibility = ESV_SelfHitTestInvisible;
-        hbox->ProcessEvent(m_fnSetVisibility, &visParams);
+        s_setVisibility.Call(hbox, visParams);
     }
 
     // 2. For each segment, create a TextBlock
     int segIdx = 0;
-    for (const auto& seg : segments) {
+    for (const auto& seg : line.Segments()) {
         ++segIdx;
-        std::wstring tbName = baseName + STR("_Seg") + std::to_wstring(segIdx);
+        // Unique within the HBox, which is all UE needs
+        std::wstring tbName = STR("APNotifSeg_") + std::to_wstring(segIdx);
 
-        UObject* tb = ConstructWidget(m_textBlockClass, hbox, tbName.c_str());
+        UObject* tb = ConstructWidget(m_textBlockClass, hbox, tbName.c_str(), ModObjectKind::HudText);
         if (!tb) continue;
 
         // Parent TextBlock to HBox
         Params_AddChildToHBox hboxParams{};
         hboxParams.Content = tb;
         hboxParams.ReturnValue = nullptr;
-        hbox->ProcessEvent(m_fnAddChildToHBox, &hboxParams);
+        s_addChildToHBox.Call(hbox, hboxParams);
+        ObjectTracker::Get().Track(hboxParams.ReturnValue, ModObjectKind::HudSlot, hbox, {});
 
         // Set font size by reading existing Font struct, modifying Size, writing it back
-        if (m_fnSetFont) {
+        if (s_setFont.Resolve()) {
             try {
-                // FSlateFontInfo is at a known offset in UTextBlock (0x01E8, size 0x68)
-                // We can read it via property name, modify Size at offset 0x50, and call SetFont
-                auto* fontPtr = tb->GetValuePtrByPropertyNameInChain<uint8_t>(STR("Font"));
+                // Copy the TextBlock's current Font, change Size, and pass
+                // the copy back by value. The thunk has already checked
+                // that InFontInfo is sizeof(FSlateFontInfoBlob) bytes.
+                auto* fontPtr = Engine::GetValuePtr<uint8_t>(tb, STR("Font"));
                 if (fontPtr) {
-                    // FSlateFontInfo.Size is a float at offset 0x50 within the struct
-                    float* sizePtr = reinterpret_cast<float*>(fontPtr + 0x50);
-                    *sizePtr = 16.0f;  // Font size 16
-
-                    // Now call SetFont with the modified font
-                    // FSlateFontInfo is 0x68 bytes — we pass the whole struct as the param
-                    // The SetFont function takes FSlateFontInfo by value.
-                    // We need to allocate the param buffer containing the struct.
-                    uint8_t fontParamBuf[0x68];
-                    std::memcpy(fontParamBuf, fontPtr, 0x68);
-                    tb->ProcessEvent(m_fnSetFont, fontParamBuf);
+                    Params_SetFont fontParams;
+                    std::memcpy(&fontParams.InFontInfo, fontPtr, sizeof(FSlateFontInfoBlob));
+                    GameOffsets::SlateFontInfo::Size.In(fontParams.InFontInfo.Bytes) = 16.0f;  // Font size 16
+                    s_setFont.Call(tb, fontParams);
                 }
             }
             catch (...) {
@@ -407,55 +481,52 @@ void HudNotification::AddEntry(const std::vector<TextSegment>& segments, float d
         }
 
         // SetText
-        if (m_fnSetText) {
-            try {
-                Params_SetText textParams{};
-                textParams.InText = FText(seg.text.c_str());
-                tb->ProcessEvent(m_fnSetText, &textParams);
-            }
-            catch (...) {}
+        try {
+            Params_SetText textParams{};
+            m_segmentText.assign(line.Text(seg));
+            textParams.InText = FText(m_segmentText.c_str());
+            s_setText.Call(tb, textParams);
         }
+        catch (...) {}
 
         // SetShadowOffset
-        if (m_fnSetShadowOffset) {
+        if (s_setShadowOffset.Resolve()) {
             try {
                 Params_SetShadowOffset shadowParams{};
                 shadowParams.InShadowOffset.X = SHADOW_OFFSET;
                 shadowParams.InShadowOffset.Y = SHADOW_OFFSET;
-                tb->ProcessEvent(m_fnSetShadowOffset, &shadowParams);
+                s_setShadowOffset.Call(tb, shadowParams);
             }
             catch (...) {}
         }
 
         // SetShadowColorAndOpacity (black with 0.9 alpha)
-        if (m_fnSetShadowColorAndOpacity) {
+        if (s_setShadowColorAndOpacity.Resolve()) {
             try {
                 Params_SetShadowColorAndOpacity shadowColorParams{};
                 shadowColorParams.InShadowColorAndOpacity = { 0.0f, 0.0f, 0.0f, 0.9f };
-                tb->ProcessEvent(m_fnSetShadowColorAndOpacity, &shadowColorParams);
+                s_setShadowColorAndOpacity.Call(tb, shadowColorParams);
             }
             catch (...) {}
         }
 
         // SetColorAndOpacity (segment color)
-        if (m_fnSetColorAndOpacity) {
-            try {
-                Params_SetColorAndOpacity colorParams{};
-                colorParams.InColorAndOpacity.R = seg.color.R;
-                colorParams.InColorAndOpacity.G = seg.color.G;
-                colorParams.InColorAndOpacity.B = seg.color.B;
-                colorParams.InColorAndOpacity.A = seg.color.A;
-                colorParams.InColorAndOpacity.ColorUseRule = 0; // UseColor_Specified
-                tb->ProcessEvent(m_fnSetColorAndOpacity, &colorParams);
-            }
-            catch (...) {}
+        try {
+            Params_SetColorAndOpacity colorParams{};
+            colorParams.InColorAndOpacity.R = seg.color.R;
+            colorParams.InColorAndOpacity.G = seg.color.G;
+            colorParams.InColorAndOpacity.B = seg.color.B;
+            colorParams.InColorAndOpacity.A = seg.color.A;
+            colorParams.InColorAndOpacity.ColorUseRule = 0; // UseColor_Specified
+            s_setColorAndOpacity.Call(tb, colorParams);
         }
+        catch (...) {}
 
         // SetVisibility to SelfHitTestInvisible
-        if (m_fnSetVisibility) {
+        {
             Params_SetVisibility visParams{};
             visParams.InVisibility = ESV_SelfHitTestInvisible;
-            tb->ProcessEvent(m_fnSetVisibility, &visParams);
+            s_setVisibility.Call(tb, visParams);
         }
     }
 
@@ -465,30 +536,40 @@ void HudNotification::AddEntry(const std::vector<TextSegment>& segments, float d
     entry.expireTime = m_timeAccum + duration;
     m_entries.push_back(entry);
 
-    // If we exceed MAX_VISIBLE, remove the oldest
-    while (static_cast<int>(m_entries.size()) > MAX_VISIBLE) {
-        RemoveEntry(m_entries.front());
-        m_entries.pop_front();
-    }
+    // Over the line limit: remove the oldest
+    TrimEntries();
 
     // Update all entry positions
     RepositionEntries();
 }
 
+// ============================================================
+// TrimEntries — drop the oldest lines beyond m_maxVisible
+// ============================================================
+void HudNotification::TrimEntries()
+{
+    while (static_cast<int>(m_entries.size()) > m_maxVisible) {
+        RemoveEntry(m_entries.front());
+        m_entries.pop_front();
+    }
+}
+
 // ============================================================
 // RemoveEntry — detach a HorizontalBox from the canvas
 // ============================================================
 void HudNotification::RemoveEntry(const Entry& entry)
 {
-    if (!entry.hbox || !m_canvas || !m_fnRemoveChild) return;
+    if (!entry.hbox || !m_canvas) return;
 
     try {
         Params_RemoveChild params{};
         params.Content = entry.hbox;
         params.ReturnValue = false;
-        m_canvas->ProcessEvent(m_fnRemoveChild, &params);
+        s_removeChild.Call(m_canvas, params);
     }
     catch (...) {}
+    // Its TextBlocks and slots go with it
+    ObjectTracker::Get().Release(entry.hbox);
 }
 
 // ============================================================
@@ -496,7 +577,7 @@ void HudNotification::RemoveEntry(const Entry& entry)
 // ============================================================
 void HudNotification::RepositionEntries()
 {
-    if (!m_fnSetPosition) return;
+    if (!s_setPosition.Resolve()) return;
 
     int i = 0;
     for (auto& entry : m_entries) {
@@ -505,12 +586,12 @@ void HudNotification::RepositionEntries()
         // Get the canvas slot for this hbox. The slot is stored as the
         // "Slot" property on the widget itself (UWidget.Slot -> UPanelSlot).
         try {
-            auto* slotPtr = entry.hbox->GetValuePtrByPropertyNameInChain<UObject*>(STR("Slot"));
+            auto* slotPtr = Engine::GetValuePtr<UObject*>(entry.hbox, STR("Slot"));
             if (slotPtr && *slotPtr) {
                 Params_SetPosition posParams{};
                 posParams.InPosition.X = START_X;
                 posParams.InPosition.Y = START_Y + i * LINE_SPACING;
-                (*slotPtr)->ProcessEvent(m_fnSetPosition, &posParams);
+                s_setPosition.Call(*slotPtr, posParams);
             }
         }
         catch (...) {}
@@ -552,22 +633,32 @@ bool HudNotification::Init()
     return ok;
 }
 
+// ============================================================
+// ApplyTunables — line limit and default duration
+// ============================================================
+void HudNotification::ApplyTunables(const Tunables& t)
+{
+    m_maxVisible      = t.hud_max_visible;
+    m_defaultDuration = t.hud_duration_s;
+    while (static_cast<int>(m_pendingQueue.size()) > m_maxVisible) {
+        m_pendingQueue.pop_front();
+    }
+}
+
 // ============================================================
 // Notify — queue a multi-color notification
 // ============================================================
-void HudNotification::Notify(const std::vector<TextSegment>& segments, float duration)
+void HudNotification::Notify(HudLine line, float duration)
 {
-    if (segments.empty()) return;
+    if (line.Empty()) return;
 
     // Log the full text
-    std::wstring fullText;
-    for (const auto& seg : segments) fullText += seg.text;
-    Output::send<LogLevel::Verbose>(STR("[TalosAP-HUD] Notify: {}\n"), fullText);
+    Output::send<LogLevel::Verbose>(STR("[TalosAP-HUD] Notify: {}\n"), line.Text());
 
-    m_pendingQueue.push_back({ segments, duration });
+    m_pendingQueue.push_back({ std::move(line), duration > 0.0f ? duration : m_defaultDuration });
 
     // Cap the pending queue
-    while (static_cast<int>(m_pendingQueue.size()) > MAX_VISIBLE) {
+    while (static_cast<int>(m_pendingQueue.size()) > m_maxVisible) {
         m_pendingQueue.pop_front();
     }
 }
@@ -575,7 +666,7 @@ void HudNotification::Notify(const std::vector<TextSegment>& segments, float dur
 // ============================================================
 // NotifySimple — queue a single-color notification
 // ============================================================
-void HudNotification::NotifySimple(const std::wstring& text, const LinearColor& color, float duration)
+void HudNotification::NotifySimple(std::wstring_view text, const LinearColor& color, float duration)
 {
     Notify({ { text, color } }, duration);
 }
@@ -600,7 +691,7 @@ void HudNotification::Tick(float deltaTicks, float ticksPerSecond)
     while (!m_pendingQueue.empty()) {
         auto& notif = m_pendingQueue.front();
         try {
-            AddEntry(notif.segments, notif.duration);
+            AddEntry(notif.line, notif.duration);
         }
         catch (...) {
             Output::send<LogLevel::Error>(STR("[TalosAP-HUD] AddEntry failed\n"));
@@ -608,6 +699,12 @@ void HudNotification::Tick(float deltaTicks, float ticksPerSecond)
         m_pendingQueue.pop_front();
     }
 
+    // Limit lowered by a config reload
+    if (static_cast<int>(m_entries.size()) > m_maxVisible) {
+        TrimEntries();
+        RepositionEntries();
+    }
+
     // Expire old entries
     try {
         ExpireTick();
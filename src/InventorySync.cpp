@@ -1,4 +1,9 @@
 #include "headers/InventorySync.h"
+#include "headers/EngineCalls.h"
+#include "headers/FunctionThunk.h"
+#include "headers/Latency.h"
+#include "headers/TickArena.h"
+#include "headers/Utf.h"
 
 #include <Unreal/UObjectGlobals.hpp>
 #include <Unreal/UObject.hpp>
@@ -17,25 +22,41 @@ using namespace RC::Unreal;
 namespace TalosAP {
 
 // ============================================================
-// Helper: Convert narrow string to FString (wide)
+// UTalosProgress::Get(UObject* WorldContextObject) -> UTalosProgress*
 // ============================================================
-static FString ToFString(const std::string& s)
+struct Params_TalosProgressGet {
+    UObject* WorldContextObject;
+    UObject* ReturnValue;
+};
+
+static FunctionThunk<Params_TalosProgressGet> s_talosProgressGet{
+    STR("/Script/Talos.TalosProgress:Get"), "TalosProgress.Get",
+    { THUNK_FIELD(Params_TalosProgressGet, WorldContextObject),
+      THUNK_FIELD(Params_TalosProgressGet, ReturnValue) } };
+
+// ============================================================
+// Helper: Convert an item ID to FString (wide)
+// ============================================================
+static FString ToFString(const ItemId& id)
 {
-    std::wstring wide(s.begin(), s.end());
-    return FString(wide.c_str());
+    wchar_t wide[ItemId::CAPACITY + 1];
+    size_t n = Utf::DecodeTo(id.view(), wide, ItemId::CAPACITY);
+    if (n == Utf::NO_FIT) n = 0;
+    wide[n] = L'\0';
+    return FString(wide);
 }
 
-// Convert FString to narrow std::string
-static std::string FromFString(const FString& fs)
+// Convert an FString TMap key back to an item ID. Keys whose UTF-8 form
+// is longer than an ItemId can hold come back empty so they are never
+// mistaken for a truncated real ID.
+static ItemId FromFString(const FString& fs)
 {
     const wchar_t* wstr = *fs;
-    if (!wstr) return "";
-    std::string result;
-    while (*wstr) {
-        result.push_back(static_cast<char>(*wstr));
-        ++wstr;
-    }
-    return result;
+    if (!wstr) return {};
+    char narrow[ItemId::CAPACITY];
+    size_t n = Utf::EncodeTo(std::wstring_view(wstr), narrow, ItemId::CAPACITY);
+    if (n == Utf::NO_FIT) return {};
+    return ItemId(std::string_view(narrow, n));
 }
 
 // ============================================================
@@ -52,7 +73,7 @@ static TetrominoMap* GetCollectedTetrominosMap(UObject* progress)
     if (!progress) return nullptr;
 
     try {
-        auto* ptr = progress->GetValuePtrByPropertyNameInChain<TetrominoMap>(STR("CollectedTetrominos"));
+        auto* ptr = Engine::GetValuePtr<TetrominoMap>(progress, STR("CollectedTetrominos"));
         return ptr;
     }
     catch (...) {
@@ -73,38 +94,29 @@ void InventorySync::FindProgressObject(ModState& state, bool /*forceRefresh*/)
     state.CurrentProgress = nullptr;
 
     try {
-        auto* cdo = UObjectGlobals::StaticFindObject<UObject*>(
-            nullptr, nullptr, STR("/Script/Talos.Default__TalosProgress"));
+        auto* cdo = Engine::StaticFindObject<UObject*>(STR("/Script/Talos.Default__TalosProgress"));
 
         UObject* worldCtx = nullptr;
 
         // Try PlayerController as world context
-        worldCtx = UObjectGlobals::FindFirstOf(STR("PlayerController"));
+        worldCtx = Engine::FindFirstOf(STR("PlayerController"));
         if (!worldCtx) {
             // Fallback: GameInstance
-            worldCtx = UObjectGlobals::FindFirstOf(STR("TalosGameInstance"));
+            worldCtx = Engine::FindFirstOf(STR("TalosGameInstance"));
         }
 
         if (cdo && worldCtx) {
             // Call UTalosProgress::Get(WorldContextObject)
-            auto* getFunc = cdo->GetFunctionByNameInChain(STR("Get"));
-            if (getFunc) {
-                struct {
-                    UObject* WorldContextObject;
-                    UObject* ReturnValue;
-                } params{};
-                params.WorldContextObject = worldCtx;
-                params.ReturnValue = nullptr;
-
-                cdo->ProcessEvent(getFunc, &params);
-
-                if (params.ReturnValue) {
-                    // Verify we can read the TMap
-                    auto* tmap = GetCollectedTetrominosMap(params.ReturnValue);
-                    if (tmap) {
-                        state.CurrentProgress = params.ReturnValue;
-                        return;
-                    }
+            Params_TalosProgressGet params{};
+            params.WorldContextObject = worldCtx;
+            params.ReturnValue = nullptr;
+
+            if (s_talosProgressGet.Call(cdo, params) && params.ReturnValue) {
+                // Verify we can read the TMap
+                auto* tmap = GetCollectedTetrominosMap(params.ReturnValue);
+                if (tmap) {
+                    state.CurrentProgress = params.ReturnValue;
+                    return;
                 }
             }
         }
@@ -121,13 +133,12 @@ void InventorySync::FindProgressObject(ModState& state, bool /*forceRefresh*/)
 // GrantItem
 // ============================================================
 
-void InventorySync::GrantItem(ModState& state, const std::string& tetrominoId)
+void InventorySync::GrantItem(ModState& state, const ItemId& tetrominoId)
 {
     bool wasNew = (state.GrantedItems.insert(tetrominoId).second);
 
     if (wasNew) {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Item granted: {}\n"),
-            std::wstring(tetrominoId.begin(), tetrominoId.end()));
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Item granted: {}\n"), Utf::ToWide(tetrominoId));
     }
 
     // Don't touch the TMap here — EnforceCollectionState will sync it
@@ -143,13 +154,12 @@ void InventorySync::GrantItem(ModState& state, const std::string& tetrominoId)
 // RevokeItem
 // ============================================================
 
-void InventorySync::RevokeItem(ModState& state, const std::string& tetrominoId)
+void InventorySync::RevokeItem(ModState& state, const ItemId& tetrominoId)
 {
     state.GrantedItems.erase(tetrominoId);
     state.CheckedLocations.erase(tetrominoId);
 
-    Output::send<LogLevel::Verbose>(STR("[TalosAP] Item revoked: {}\n"),
-        std::wstring(tetrominoId.begin(), tetrominoId.end()));
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] Item revoked: {}\n"), Utf::ToWide(tetrominoId));
 
     // Don't touch the TMap here — EnforceCollectionState will sync it
     // on the next periodic pass.
@@ -168,10 +178,10 @@ void InventorySync::EnforceCollectionState(ModState& state)
     if (!tmap) return;
 
     // Phase 1: Find items in TMap that are NOT granted — these must be removed
-    std::vector<std::string> toRemove;
+    TickVector<ItemId> toRemove(&TickArena::Get());
     try {
         for (auto& pair : *tmap) {
-            std::string key = FromFString(pair.Key);
+            ItemId key = FromFString(pair.Key);
             if (!key.empty() && state.GrantedItems.count(key) == 0) {
                 toRemove.push_back(key);
             }
@@ -202,12 +212,19 @@ void InventorySync::EnforceCollectionState(ModState& state)
     }
 
     // Phase 2: Ensure all granted items are in TMap
+    auto& latency = LatencyStats::Get();
+    bool timing = latency.HasPending(LatencyPath::ItemCollected);
     for (const auto& id : state.GrantedItems) {
         try {
             FString key = ToFString(id);
             bool* existing = tmap->Find(key);
             if (!existing) {
                 tmap->Add(key, false);
+                if (timing) latency.Finish(LatencyPath::ItemCollected, id);
+            }
+            else if (timing) {
+                // Replayed grant for a tetromino already held
+                latency.Cancel(LatencyPath::ItemCollected, id);
             }
         }
         catch (...) {
@@ -264,10 +281,10 @@ void InventorySync::DumpCollectedTetrominos(ModState& state)
 
     try {
         for (auto& pair : *tmap) {
-            std::string key = FromFString(pair.Key);
+            ItemId key = FromFString(pair.Key);
             bool used = pair.Value;
             Output::send<LogLevel::Verbose>(STR("[TalosAP]   {} = {}\n"),
-                std::wstring(key.begin(), key.end()),
+                Utf::ToWide(key),
                 used ? STR("true (used)") : STR("false (unused)"));
         }
     }
@@ -277,12 +294,12 @@ void InventorySync::DumpCollectedTetrominos(ModState& state)
 
     Output::send<LogLevel::Verbose>(STR("[TalosAP] === Granted items ({}) ===\n"), state.GrantedItems.size());
     for (const auto& id : state.GrantedItems) {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {}\n"), std::wstring(id.begin(), id.end()));
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {}\n"), Utf::ToWide(id));
     }
 
     Output::send<LogLevel::Verbose>(STR("[TalosAP] === Checked locations ({}) ===\n"), state.CheckedLocations.size());
     for (const auto& id : state.CheckedLocations) {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {}\n"), std::wstring(id.begin(), id.end()));
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {}\n"), Utf::ToWide(id));
     }
 }
 
@@ -1,6 +1,8 @@
 #include "headers/ItemMapping.h"
+#include "headers/Utf.h"
 
 #include <algorithm>
+#include <cctype>
 #include <regex>
 #include <DynamicOutput/DynamicOutput.hpp>
 
@@ -12,7 +14,7 @@ namespace TalosAP {
 // All tetrominoes in the game (from BotPuzzleDatabase.csv)
 // Order matters — location IDs are assigned sequentially.
 // ============================================================
-static const std::vector<std::string> ALL_TETROMINOES = {
+static constexpr ItemId ALL_TETROMINOES[] = {
     // World A1 (7)
     "DJ3",  "MT1",  "DZ1",  "DJ2",  "DJ1",  "ML1",  "DI1",
     // World A2 (3)
@@ -61,11 +63,11 @@ static const std::vector<std::string> ALL_TETROMINOES = {
 // Stars (puzzle code → star ID)
 // ============================================================
 struct StarEntry {
-    std::string puzzleCode;
-    std::string starId;
+    const char* puzzleCode;
+    ItemId      starId;
 };
 
-static const std::vector<StarEntry> ALL_STARS = {
+static constexpr StarEntry ALL_STARS[] = {
     {"SCentralArea_Chapter", "Star5"},
     {"SCloud_1_02",          "Star2"},
     {"S015",                 "Star1"},
@@ -101,26 +103,27 @@ static const std::vector<StarEntry> ALL_STARS = {
 // ============================================================
 // Extract the letter prefix from a tetromino ID (e.g. "DJ3" → "DJ")
 // ============================================================
-static std::string ExtractPrefix(const std::string& tetId)
+static ItemId ExtractPrefix(const ItemId& tetId)
 {
     size_t i = 0;
     while (i < tetId.size() && std::isalpha(static_cast<unsigned char>(tetId[i]))) {
         ++i;
     }
-    return tetId.substr(0, i);
+    return ItemId(tetId.view().substr(0, i));
 }
 
 // Extract the numeric suffix from a tetromino ID (e.g. "DJ3" → 3)
-static int ExtractNumber(const std::string& tetId)
+static int ExtractNumber(const ItemId& tetId)
 {
     size_t i = 0;
     while (i < tetId.size() && std::isalpha(static_cast<unsigned char>(tetId[i]))) {
         ++i;
     }
-    if (i < tetId.size()) {
-        return std::stoi(tetId.substr(i));
+    int n = 0;
+    for (; i < tetId.size() && std::isdigit(static_cast<unsigned char>(tetId[i])); ++i) {
+        n = n * 10 + (tetId[i] - '0');
     }
-    return 0;
+    return n;
 }
 
 // ============================================================
@@ -171,7 +174,7 @@ void ItemMapping::BuildSequences()
     m_tetrominoSequences.clear();
 
     for (const auto& tetId : ALL_TETROMINOES) {
-        std::string prefix = ExtractPrefix(tetId);
+        ItemId prefix = ExtractPrefix(tetId);
         if (!prefix.empty()) {
             m_tetrominoSequences[prefix].push_back(tetId);
         }
@@ -179,7 +182,7 @@ void ItemMapping::BuildSequences()
 
     // Sort each sequence by embedded number
     for (auto& [prefix, seq] : m_tetrominoSequences) {
-        std::sort(seq.begin(), seq.end(), [](const std::string& a, const std::string& b) {
+        std::sort(seq.begin(), seq.end(), [](const ItemId& a, const ItemId& b) {
             return ExtractNumber(a) < ExtractNumber(b);
         });
     }
@@ -215,7 +218,7 @@ void ItemMapping::BuildTables()
 // Item resolution
 // ============================================================
 
-std::optional<std::string> ItemMapping::ResolveNextItem(int64_t apItemId)
+std::optional<ItemId> ItemMapping::ResolveNextItem(int64_t apItemId)
 {
     auto it = m_apItemIdToPrefix.find(apItemId);
     if (it == m_apItemIdToPrefix.end()) {
@@ -224,11 +227,11 @@ std::optional<std::string> ItemMapping::ResolveNextItem(int64_t apItemId)
         return std::nullopt;
     }
 
-    const std::string& prefix = it->second;
+    const ItemId prefix = it->second;
     auto seqIt = m_tetrominoSequences.find(prefix);
     if (seqIt == m_tetrominoSequences.end() || seqIt->second.empty()) {
         Output::send<LogLevel::Warning>(STR("[TalosAP] No tetromino sequence for prefix: {}\n"),
-                                        std::wstring(prefix.begin(), prefix.end()));
+                                        Utf::ToWide(prefix));
         return std::nullopt;
     }
 
@@ -238,16 +241,13 @@ std::optional<std::string> ItemMapping::ResolveNextItem(int64_t apItemId)
 
     if (count > static_cast<int>(seq.size())) {
         Output::send<LogLevel::Warning>(STR("[TalosAP] Received more {} items ({}) than exist ({}) — ignoring\n"),
-                                        std::wstring(prefix.begin(), prefix.end()),
-                                        count, seq.size());
+                                        Utf::ToWide(prefix), count, seq.size());
         return std::nullopt;
     }
 
-    const std::string& tetId = seq[count - 1];
+    const ItemId tetId = seq[count - 1];
     Output::send<LogLevel::Verbose>(STR("[TalosAP] Resolved AP item {} (0x{:X}) -> {} [{} {}/{}]\n"),
-                                    apItemId, apItemId,
-                                    std::wstring(tetId.begin(), tetId.end()),
-                                    std::wstring(prefix.begin(), prefix.end()),
+                                    apItemId, apItemId, Utf::ToWide(tetId), Utf::ToWide(prefix),
                                     count, seq.size());
     return tetId;
 }
@@ -262,16 +262,26 @@ void ItemMapping::ResetItemCounters()
 // Location queries
 // ============================================================
 
-int64_t ItemMapping::GetLocationId(const std::string& tetrominoId) const
+int64_t ItemMapping::GetLocationId(const ItemId& tetrominoId) const
 {
     auto it = m_locationNameToId.find(tetrominoId);
     return (it != m_locationNameToId.end()) ? it->second : -1;
 }
 
-std::string ItemMapping::GetLocationName(int64_t locationId) const
+ItemId ItemMapping::GetLocationName(int64_t locationId) const
 {
     auto it = m_locationIdToName.find(locationId);
-    return (it != m_locationIdToName.end()) ? it->second : "";
+    return (it != m_locationIdToName.end()) ? it->second : ItemId();
+}
+
+ItemId ItemMapping::StarForPuzzle(std::string_view puzzleCode)
+{
+    // 30 entries — a scan is cheaper than building a map for a lookup
+    // made once per star actor per refresh.
+    for (const auto& entry : ALL_STARS) {
+        if (puzzleCode == entry.puzzleCode) return entry.starId;
+    }
+    return {};
 }
 
 std::string ItemMapping::GetDisplayName(int64_t apItemId) const
@@ -282,17 +292,17 @@ std::string ItemMapping::GetDisplayName(int64_t apItemId) const
     return (nameIt != m_prefixDisplayNames.end()) ? nameIt->second : "";
 }
 
-std::string ItemMapping::GetDisplayNameForTetromino(const std::string& tetrominoId) const
+std::string ItemMapping::GetDisplayNameForTetromino(const ItemId& tetrominoId) const
 {
-    std::string prefix = ExtractPrefix(tetrominoId);
+    ItemId prefix = ExtractPrefix(tetrominoId);
     auto nameIt = m_prefixDisplayNames.find(prefix);
     return (nameIt != m_prefixDisplayNames.end()) ? nameIt->second : "";
 }
 
-std::string ItemMapping::GetItemPrefix(int64_t apItemId) const
+ItemId ItemMapping::GetItemPrefix(int64_t apItemId) const
 {
     auto it = m_apItemIdToPrefix.find(apItemId);
-    return (it != m_apItemIdToPrefix.end()) ? it->second : "";
+    return (it != m_apItemIdToPrefix.end()) ? it->second : ItemId();
 }
 
 std::vector<int64_t> ItemMapping::GetAllLocationIds() const
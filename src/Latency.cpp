@@ -0,0 +1,66 @@
+#include "headers/Latency.h"
+
+namespace TalosAP {
+
+LatencyStats& LatencyStats::Get()
+{
+    static LatencyStats instance;
+    return instance;
+}
+
+void LatencyStats::Start(LatencyPath path, const ItemId& key, int64_t ns)
+{
+    auto& pending = m_pending[Index(path)];
+    if (pending.size() >= MAX_PENDING && !pending.contains(key)) {
+        // Unbounded only if Finish never comes; drop the oldest start.
+        auto oldest = pending.begin();
+        for (auto it = pending.begin(); it != pending.end(); ++it) {
+            if (it->second < oldest->second) oldest = it;
+        }
+        pending.erase(oldest);
+    }
+    pending[key] = ns;
+}
+
+bool LatencyStats::Finish(LatencyPath path, const ItemId& key, int64_t ns)
+{
+    auto& pending = m_pending[Index(path)];
+    auto it = pending.find(key);
+    if (it == pending.end()) return false;
+    m_hist[Index(path)].Add(ns - it->second);
+    pending.erase(it);
+    return true;
+}
+
+void LatencyStats::Cancel(LatencyPath path, const ItemId& key)
+{
+    m_pending[Index(path)].erase(key);
+}
+
+void LatencyStats::Begin(LatencyPath path, int64_t ns)
+{
+    m_begin[Index(path)] = ns;
+}
+
+bool LatencyStats::End(LatencyPath path, int64_t ns)
+{
+    int64_t& begin = m_begin[Index(path)];
+    if (begin == 0) return false;
+    m_hist[Index(path)].Add(ns - begin);
+    begin = 0;
+    return true;
+}
+
+void LatencyStats::ClearPending(LatencyPath path)
+{
+    m_pending[Index(path)].clear();
+    m_begin[Index(path)] = 0;
+}
+
+void LatencyStats::ClearPending()
+{
+    for (auto& p : m_pending) p.clear();
+    m_begin.fill(0);
+}
+
+} // namespace TalosAP
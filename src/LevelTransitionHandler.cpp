@@ -1,4 +1,6 @@
 #include "headers/LevelTransitionHandler.h"
+#include "headers/TraceRecorder.h"
+#include "headers/Latency.h"
 
 #include <Unreal/UObjectGlobals.hpp>
 #include <DynamicOutput/DynamicOutput.hpp>
@@ -15,9 +17,10 @@ void LevelTransitionHandler::RegisterHooks(ModState& state)
         auto hookId = UObjectGlobals::RegisterHook(
             STR("/Script/Engine.PlayerController:ClientRestart"),
             [](UnrealScriptFunctionCallableContext& ctx, void* data) {
+                TraceScope trace("Hook", "hook", "ClientRestart");
                 auto* st = static_cast<ModState*>(data);
                 Output::send<LogLevel::Verbose>(STR("[TalosAP] Hook: ClientRestart\n"));
-                st->ResetForLevelTransition(15);
+                st->ResetForLevelTransition(st->Tuning.cooldown_client_restart_ticks);
             },
             {},
             &state
@@ -34,9 +37,11 @@ void LevelTransitionHandler::RegisterHooks(ModState& state)
         auto hookId = UObjectGlobals::RegisterHook(
             STR("/Script/Talos.TalosGameInstance:OpenLevel"),
             [](UnrealScriptFunctionCallableContext& ctx, void* data) {
+                TraceScope trace("Hook", "hook", "OpenLevel");
                 auto* st = static_cast<ModState*>(data);
                 Output::send<LogLevel::Verbose>(STR("[TalosAP] Hook: OpenLevel\n"));
-                st->ResetForLevelTransition(50);
+                LatencyStats::Get().Begin(LatencyPath::LevelScan);
+                st->ResetForLevelTransition(st->Tuning.cooldown_open_level_ticks);
             },
             {},
             &state
@@ -53,9 +58,11 @@ void LevelTransitionHandler::RegisterHooks(ModState& state)
         auto hookId = UObjectGlobals::RegisterHook(
             STR("/Script/Talos.TalosGameInstance:OpenLevelBySoftObjectPtr"),
             [](UnrealScriptFunctionCallableContext& ctx, void* data) {
+                TraceScope trace("Hook", "hook", "OpenLevelBySoftObjectPtr");
                 auto* st = static_cast<ModState*>(data);
                 Output::send<LogLevel::Verbose>(STR("[TalosAP] Hook: OpenLevelBySoftObjectPtr\n"));
-                st->ResetForLevelTransition(50);
+                LatencyStats::Get().Begin(LatencyPath::LevelScan);
+                st->ResetForLevelTransition(st->Tuning.cooldown_open_level_ticks);
             },
             {},
             &state
@@ -0,0 +1,116 @@
+#include "headers/LiveMetrics.h"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <process.h>
+#define TALOSAP_GETPID _getpid
+#else
+#include <unistd.h>
+#define TALOSAP_GETPID getpid
+#endif
+
+namespace TalosAP {
+
+// Phase maxima cover the current and the previous window of this length,
+// so a phase that runs once a second always has a max on the page.
+static constexpr int64_t MAX_WINDOW_NS = 1'000'000'000;
+
+LiveMetrics& LiveMetrics::Get()
+{
+    static LiveMetrics instance;
+    return instance;
+}
+
+int64_t LiveMetrics::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool LiveMetrics::Open()
+{
+    uint32_t pid = static_cast<uint32_t>(TALOSAP_GETPID());
+    return Open(MetricsNameFor(pid), pid);
+}
+
+bool LiveMetrics::Open(const std::wstring& name, uint32_t processId)
+{
+    Close();
+    if (!m_region.OpenNamed(name, sizeof(MetricsPage), true)) return false;
+
+    auto* page = new (m_region.Data()) MetricsPage{};
+    page->magic     = METRICS_MAGIC;
+    page->version   = METRICS_VERSION;
+    page->pageBytes = static_cast<uint32_t>(sizeof(MetricsPage));
+    page->processId = processId;
+    page->seq.store(0, std::memory_order_relaxed);
+
+    m_staging = {};
+    for (auto& w : m_windowMax) w = 0;
+    m_windowStartNs = NowNs();
+    m_page = page;
+    return true;
+}
+
+void LiveMetrics::Close()
+{
+    m_page = nullptr;
+    m_region.Close();
+}
+
+void LiveMetrics::AddPhase(MetricPhase phase, int64_t ns)
+{
+    auto& slot = m_staging.phases[static_cast<size_t>(phase)];
+    uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+    ++slot.runs;
+    slot.totalNs += v;
+    slot.lastNs = v;
+    auto& windowMax = m_windowMax[static_cast<size_t>(phase)];
+    if (v > windowMax) windowMax = v;
+    if (v > slot.maxNs) slot.maxNs = v;
+}
+
+void LiveMetrics::SetEngineCallName(size_t slot, const char* name)
+{
+    if (!m_page || slot >= METRICS_ENGINE_CALL_SLOTS || !name) return;
+    char* dst = m_page->engineCallNames[slot];
+    std::strncpy(dst, name, sizeof(m_page->engineCallNames[slot]) - 1);
+}
+
+void LiveMetrics::SetEngineCalls(size_t slot, uint64_t total, double perSecond)
+{
+    if (slot >= METRICS_ENGINE_CALL_SLOTS) return;
+    m_staging.engineCallTotals[slot] = total;
+    m_staging.engineCallRates[slot]  = perSecond > 0 ? static_cast<uint64_t>(perSecond + 0.5) : 0;
+}
+
+void LiveMetrics::Publish()
+{
+    if (!m_page) return;
+
+    const int64_t now = NowNs();
+    m_staging.monoNs = static_cast<uint64_t>(now);
+
+    constexpr size_t N = sizeof(MetricSnapshot) / sizeof(uint64_t);
+    const auto* src = reinterpret_cast<const uint64_t*>(&m_staging);
+    auto* dst = reinterpret_cast<std::atomic<uint64_t>*>(&m_page->values);
+
+    const uint64_t seq = m_page->seq.load(std::memory_order_relaxed);
+    m_page->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t k = 0; k < N; ++k) dst[k].store(src[k], std::memory_order_relaxed);
+    m_page->seq.store(seq + 2, std::memory_order_release);
+
+    if (now - m_windowStartNs >= MAX_WINDOW_NS) {
+        for (size_t p = 0; p < METRIC_PHASE_COUNT; ++p) {
+            m_staging.phases[p].maxNs = m_windowMax[p];   // previous window carries over
+            m_windowMax[p] = 0;
+        }
+        m_windowStartNs = now;
+    }
+}
+
+} // namespace TalosAP
@@ -0,0 +1,141 @@
+#include "headers/LocationTracker.h"
+#include "headers/ItemMapping.h"
+#include "headers/EngineCalls.h"
+#include "headers/Utf.h"
+
+#include <Unreal/UObject.hpp>
+#include <Unreal/Core/Containers/FString.hpp>
+
+#include <string_view>
+
+using namespace RC;
+using namespace RC::Unreal;
+
+namespace TalosAP {
+
+// ============================================================
+// Tetromino: Type/Shape → Letter lookups
+// ============================================================
+
+static char TypeToLetter(uint8_t type)
+{
+    switch (type) {
+        case 1:  return 'D'; // Door
+        case 2:  return 'M'; // Mechanic
+        case 4:  return 'N'; // Nexus
+        case 8:  return 'S'; // Secret
+        case 16: return 'E'; // AlternativeEnding
+        case 32: return 'A'; // Arcade
+        case 64: return 'H'; // Help
+        default: return '?';
+    }
+}
+
+static char ShapeToLetter(uint8_t shape)
+{
+    switch (shape) {
+        case 1:  return 'I';
+        case 2:  return 'J';
+        case 4:  return 'L';
+        case 8:  return 'O';
+        case 16: return 'S';
+        case 32: return 'T';
+        case 64: return 'Z';
+        default: return '?';
+    }
+}
+
+static ItemId FormatTetrominoId(uint8_t typeVal, uint8_t shapeVal, int32_t number)
+{
+    char tl = TypeToLetter(typeVal);
+    char sl = ShapeToLetter(shapeVal);
+    if (tl == '?' || sl == '?' || number < 0) return {};
+    ItemId id;
+    id.push_back(tl);
+    id.push_back(sl);
+    id.AppendNumber(static_cast<uint32_t>(number));
+    return id;
+}
+
+// ============================================================
+// Tetromino: InstanceInfo reading
+// ============================================================
+
+// FTetrominoInstanceInfo layout (from CXX header dump):
+//   struct FTetrominoInstanceInfo {
+//       ETetrominoPieceType  Type;    // offset 0x0, size 0x1
+//       ETetrominoPieceShape Shape;   // offset 0x1, size 0x1
+//       int32                Number;  // offset 0x4, size 0x4
+//   };                               // total size: 0x8
+
+ItemId TetrominoTraits::ReadId(UObject* actor)
+{
+    if (!actor) return {};
+
+    try {
+        // InstanceInfo is a struct property on BP_TetrominoItem_C.
+        // In the Talos header dump, "class ATetrominoItem" doesn't exist directly—
+        // BP_TetrominoItem_C is an Angelscript-generated Blueprint class.
+        // The InstanceInfo property holds FTetrominoInstanceInfo which is:
+        //   Type (uint8), Shape (uint8), padding, Number (int32) = 8 bytes total.
+        //
+        // GetValuePtrByPropertyNameInChain returns a pointer to the first byte
+        // of the struct's storage.
+        auto* infoPtr = Engine::GetValuePtr<uint8_t>(actor, STR("InstanceInfo"));
+        if (!infoPtr) return {};
+
+        // Read the fields at their known offsets within the struct
+        uint8_t type  = infoPtr[0];   // offset 0x0
+        uint8_t shape = infoPtr[1];   // offset 0x1
+        // offset 0x4 (int32, after 2 bytes of padding)
+        int32_t number = *reinterpret_cast<int32_t*>(infoPtr + 4);
+
+        if (type == 0 || shape == 0 || number <= 0) return {};
+        return FormatTetrominoId(type, shape, number);
+    }
+    catch (...) {
+        return {};
+    }
+}
+
+// ============================================================
+// Star: puzzle code → star ID
+// ============================================================
+
+// BP_Star_C carries the code of the puzzle it belongs to as an FString
+// ("S015", "SCloud_1_02"). Neither name is in the header dump excerpt,
+// so both are unverified. The property is looked up by reflection — a
+// wrong name reads nothing rather than bad memory — and the probe
+// counts each outcome so ScanLevel can say which name is at fault.
+
+static StarTraits::Probe s_starProbe;
+
+const StarTraits::Probe& StarTraits::LastProbe() { return s_starProbe; }
+void StarTraits::ResetProbe() { s_starProbe = {}; }
+
+ItemId StarTraits::ReadId(UObject* actor)
+{
+    if (!actor) return {};
+    ++s_starProbe.actors;
+
+    try {
+        auto* code = Engine::GetValuePtr<FString>(actor, STR("PuzzleCode"));
+        const wchar_t* wstr = code ? **code : nullptr;
+        if (!wstr) {
+            ++s_starProbe.noCode;
+            return {};
+        }
+
+        char narrow[64];
+        size_t n = Utf::EncodeTo(std::wstring_view(wstr), narrow, sizeof(narrow));
+        ItemId id = (n == Utf::NO_FIT || n == 0) ? ItemId{} : ItemMapping::StarForPuzzle(std::string_view(narrow, n));
+        if (id.empty()) ++s_starProbe.unknownCode;
+        return id;
+    }
+    catch (...) {
+        ++s_starProbe.noCode;
+        return {};
+    }
+}
+
+} // namespace TalosAP
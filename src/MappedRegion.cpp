@@ -0,0 +1,175 @@
+#include "headers/MappedRegion.h"
+
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <filesystem>
+#endif
+
+namespace TalosAP {
+
+MappedRegion::~MappedRegion()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+// ============================================================
+// Windows
+// ============================================================
+
+bool MappedRegion::OpenFile(const std::wstring& path, size_t size)
+{
+    Close();
+
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                        static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file    = file;
+    m_mapping = mapping;
+    m_data    = view;
+    m_size    = size;
+    return true;
+}
+
+bool MappedRegion::OpenNamed(const std::wstring& name, size_t size, bool create)
+{
+    Close();
+
+    HANDLE mapping = create
+        ? CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                             static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                             static_cast<DWORD>(size & 0xFFFFFFFFu), name.c_str())
+        : OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+    if (!mapping) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_data    = view;
+    m_size    = size;
+    return true;
+}
+
+void MappedRegion::Close()
+{
+    if (m_data) {
+        FlushViewOfFile(m_data, 0);
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file)    CloseHandle(static_cast<HANDLE>(m_file));
+    m_data    = nullptr;
+    m_mapping = nullptr;
+    m_file    = nullptr;
+    m_size    = 0;
+}
+
+#else
+
+// ============================================================
+// POSIX
+// ============================================================
+
+static bool MapFd(int fd, size_t size, bool grow, void*& outData)
+{
+    if (grow) {
+        struct stat st{};
+        if (fstat(fd, &st) != 0) return false;
+        if (static_cast<size_t>(st.st_size) < size && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            return false;
+        }
+    }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) return false;
+    outData = p;
+    return true;
+}
+
+// shm_open wants "/name"; strip Windows-style "Local\" prefixes.
+static std::string ShmName(const std::wstring& name)
+{
+    std::string out = "/";
+    for (wchar_t c : name) {
+        if (c == L'\\' || c == L'/') { out = "/"; continue; }
+        out += (c < 0x80) ? static_cast<char>(c) : '_';
+    }
+    return out;
+}
+
+bool MappedRegion::OpenFile(const std::wstring& path, size_t size)
+{
+    Close();
+
+    int fd = ::open(std::filesystem::path(path).c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    if (!MapFd(fd, size, true, m_data)) {
+        ::close(fd);
+        return false;
+    }
+    m_fd   = fd;
+    m_size = size;
+    return true;
+}
+
+bool MappedRegion::OpenNamed(const std::wstring& name, size_t size, bool create)
+{
+    Close();
+
+    int fd = shm_open(ShmName(name).c_str(), create ? (O_RDWR | O_CREAT) : O_RDWR, 0644);
+    if (fd < 0) return false;
+    if (!MapFd(fd, size, create, m_data)) {
+        ::close(fd);
+        return false;
+    }
+    m_fd   = fd;
+    m_size = size;
+    return true;
+}
+
+void MappedRegion::Close()
+{
+    if (m_data) {
+        msync(m_data, m_size, MS_ASYNC);
+        munmap(m_data, m_size);
+    }
+    if (m_fd >= 0) ::close(m_fd);
+    m_data = nullptr;
+    m_fd   = -1;
+    m_size = 0;
+}
+
+#endif
+
+} // namespace TalosAP
@@ -0,0 +1,260 @@
+#include "headers/ObjectTracker.h"
+#include "headers/TraceRecorder.h"
+#include "headers/Utf.h"
+
+#include <DynamicOutput/DynamicOutput.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace RC;
+using namespace RC::Unreal;
+
+namespace TalosAP {
+
+// ============================================================
+// Helpers
+// ============================================================
+
+/// How long the mod is expected to hold each kind; 0 = for the session.
+/// The HUD kinds are filled in by ApplyTunables from the line duration.
+static constexpr int64_t EXPECTED_HOLD_NS[] = {
+    0,                  // HudWidget
+    0,                  // HudWidgetTree
+    0,                  // HudCanvas
+    0,                  // HudLine (ApplyTunables)
+    0,                  // HudText (ApplyTunables)
+    0,                  // HudSlot (ApplyTunables)
+};
+static_assert(sizeof(EXPECTED_HOLD_NS) / sizeof(EXPECTED_HOLD_NS[0]) == MOD_OBJECT_KIND_COUNT);
+
+/// The check relies on this bound: a HUD line (with its text blocks and
+/// slots) is created when it reaches the screen and released by
+/// RemoveEntry at most hud_duration_s plus one HUD tick later, in HUD
+/// time. HUD time counts game ticks at an assumed 60 per second, so at
+/// 15 fps that is four times as long in wall time; HUD_HOLD_FACTOR covers
+/// that, HUD_MIN_HOLD_NS keeps short durations from flagging on a hitch.
+/// Held past the result means RemoveEntry never ran for it.
+static constexpr double  HUD_TICKS_PER_SECOND = 60.0;
+static constexpr double  HUD_HOLD_FACTOR      = 4.0;
+static constexpr int64_t HUD_MIN_HOLD_NS      = 60'000'000'000;
+
+/// The name-table entry UE stores for `name`: a trailing "_<digits>" is
+/// kept in the FName's number instead (no leading zero, as UE parses it).
+static std::wstring_view NameEntry(std::wstring_view name)
+{
+    size_t end = name.size();
+    size_t digits = end;
+    while (digits > 0 && name[digits - 1] >= L'0' && name[digits - 1] <= L'9') --digits;
+    if (digits == end || digits == 0 || name[digits - 1] != L'_') return name;
+    if (end - digits > 1 && name[digits] == L'0') return name;
+    if (end - digits > 10) return name;
+    return name.substr(0, digits - 1);
+}
+
+// "C:\\src\\HudNotification.cpp" → "HudNotification.cpp"
+static const char* BaseName(const char* path)
+{
+    const char* base = path;
+    for (const char* p = path; *p; ++p) {
+        if (*p == '/' || *p == '\\') base = p + 1;
+    }
+    return base;
+}
+
+// ============================================================
+// ObjectTracker
+// ============================================================
+
+ObjectTracker& ObjectTracker::Get()
+{
+    static ObjectTracker s_instance;
+    return s_instance;
+}
+
+ObjectTracker::ObjectTracker()
+{
+    std::copy(std::begin(EXPECTED_HOLD_NS), std::end(EXPECTED_HOLD_NS), m_expectedHoldNs.begin());
+    ApplyTunables(DEFAULT_TUNABLES);
+}
+
+void ObjectTracker::ApplyTunables(const Tunables& t)
+{
+    double lineSeconds = t.hud_duration_s + t.hud_interval_ticks / HUD_TICKS_PER_SECOND;
+    int64_t hold = std::max(HUD_MIN_HOLD_NS, static_cast<int64_t>(HUD_HOLD_FACTOR * lineSeconds * 1e9));
+    for (ModObjectKind k : { ModObjectKind::HudLine, ModObjectKind::HudText, ModObjectKind::HudSlot }) {
+        m_expectedHoldNs[static_cast<size_t>(k)] = hold;
+    }
+}
+
+uint16_t ObjectTracker::SiteFor(const std::source_location& loc)
+{
+    for (size_t i = 0; i < m_sites.size(); ++i) {
+        if (m_sites[i].file == loc.file_name() && m_sites[i].line == loc.line()) {
+            return static_cast<uint16_t>(i);
+        }
+    }
+
+    // First object from this site — build its display name once.
+    std::string fn = loc.function_name();
+    auto paren = fn.find('(');
+    if (paren != std::string::npos) fn.resize(paren);
+    auto colon = fn.rfind("::");
+    if (colon != std::string::npos) fn = fn.substr(colon + 2);
+
+    Site& site = m_sites.emplace_back();
+    site.file = loc.file_name();
+    site.line = loc.line();
+    site.name = std::string(BaseName(loc.file_name())) + ':' + fn + ':' + std::to_string(loc.line());
+    return static_cast<uint16_t>(m_sites.size() - 1);
+}
+
+void ObjectTracker::Track(UObject* obj, ModObjectKind kind, UObject* owner,
+                          std::wstring_view name, const std::source_location& loc)
+{
+    if (!obj) return;
+    int64_t now = MonoNs();
+
+    // Same address as a tracked object: that one was collected and its
+    // memory reused before the poll saw it.
+    auto it = m_records.find(obj);
+    if (it != m_records.end()) {
+        Collected(it->second, now);
+        m_records.erase(it);
+    }
+
+    Record rec;
+    rec.weak      = FWeakObjectPtr(obj);
+    rec.owner     = owner;
+    rec.kind      = kind;
+    rec.site      = SiteFor(loc);
+    rec.createdNs = now;
+    m_records.try_emplace(obj, rec);
+
+    ++m_sites[rec.site].created;
+    auto& stats = m_stats[static_cast<size_t>(kind)];
+    ++stats.created;
+    ++stats.held;
+    stats.peakLive = std::max(stats.peakLive, stats.held + stats.released);
+
+    if (!name.empty()) m_names.insert(std::wstring(NameEntry(name)));
+}
+
+void ObjectTracker::Release(UObject* obj)
+{
+    if (!obj) return;
+    auto it = m_records.find(obj);
+    if (it == m_records.end() || it->second.releasedNs != 0) return;
+
+    Record& rec = it->second;
+    rec.releasedNs = MonoNs();
+    auto& stats = m_stats[static_cast<size_t>(rec.kind)];
+    --stats.held;
+    ++stats.released;
+
+    // Owned objects go with it. A few dozen records at most, so a scan
+    // beats keeping child lists in step.
+    std::vector<UObject*> owned;
+    for (const auto& [child, r] : m_records) {
+        if (r.owner == obj && r.releasedNs == 0) owned.push_back(child);
+    }
+    for (UObject* child : owned) Release(child);
+}
+
+void ObjectTracker::Collected(const Record& rec, int64_t now)
+{
+    auto& stats = m_stats[static_cast<size_t>(rec.kind)];
+    if (rec.releasedNs != 0) {
+        --stats.released;
+        ++stats.reclaimed;
+        stats.reclaim.Add(now - rec.releasedNs);
+    } else {
+        --stats.held;
+        ++stats.lost;
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Engine destroyed a {} the mod still held (created at {})\n"),
+            Utf::ToWide(ModObjectKindName(rec.kind)), Utf::ToWide(m_sites[rec.site].name));
+    }
+}
+
+void ObjectTracker::Flag(Record& rec, UObject* obj, const wchar_t* why)
+{
+    rec.flagged = true;
+    ++m_stats[static_cast<size_t>(rec.kind)].flagged;
+    ++m_sites[rec.site].flagged;
+    Output::send<LogLevel::Warning>(STR("[TalosAP] {} {:p} {} (created at {})\n"),
+        Utf::ToWide(ModObjectKindName(rec.kind)), static_cast<const void*>(obj), why,
+        Utf::ToWide(m_sites[rec.site].name));
+}
+
+void ObjectTracker::Tick()
+{
+    int64_t now = MonoNs();
+    if (now - m_lastPollNs < 1'000'000'000) return;
+    m_lastPollNs = now;
+
+    for (auto it = m_records.begin(); it != m_records.end();) {
+        Record& rec = it->second;
+        if (!rec.weak.Get()) {
+            Collected(rec, now);
+            it = m_records.erase(it);
+            continue;
+        }
+        if (!rec.flagged) {
+            int64_t expected = m_expectedHoldNs[static_cast<size_t>(rec.kind)];
+            if (rec.releasedNs == 0 && expected > 0 && now - rec.createdNs > expected) {
+                Flag(rec, it->first, STR("held past its expected lifetime"));
+            } else if (rec.releasedNs != 0 && now - rec.releasedNs > LINGER_NS) {
+                Flag(rec, it->first, STR("released but not collected"));
+            }
+        }
+        ++it;
+    }
+
+    auto& trace = TraceRecorder::Get();
+    trace.Counter("ModObjects.held", static_cast<int64_t>(HeldCount()));
+    trace.Counter("ModObjects.released", static_cast<int64_t>(ReleasedCount()));
+}
+
+size_t ObjectTracker::HeldCount() const
+{
+    size_t n = 0;
+    for (const auto& s : m_stats) n += s.held;
+    return n;
+}
+
+size_t ObjectTracker::ReleasedCount() const
+{
+    size_t n = 0;
+    for (const auto& s : m_stats) n += s.released;
+    return n;
+}
+
+uint64_t ObjectTracker::FlaggedCount() const
+{
+    uint64_t n = 0;
+    for (const auto& s : m_stats) n += s.flagged;
+    return n;
+}
+
+void ObjectTracker::Dump() const
+{
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] === Mod objects (held={} awaiting GC={} name entries={}) ===\n"),
+        HeldCount(), ReleasedCount(), m_names.size());
+    for (size_t k = 0; k < MOD_OBJECT_KIND_COUNT; ++k) {
+        const auto& s = m_stats[k];
+        if (s.created == 0) continue;
+        const auto& h = s.reclaim;
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {:<15} created={} held={} released={} peak={} reclaimed={} lost={} flagged={} "
+                                            "reclaim s p50={:.1f} p99={:.1f} max={:.1f}\n"),
+            Utf::ToWide(ModObjectKindName(static_cast<ModObjectKind>(k))),
+            s.created, s.held, s.released, s.peakLive, s.reclaimed, s.lost, s.flagged,
+            h.PercentileNs(0.50) / 1e9, h.PercentileNs(0.99) / 1e9, h.MaxNs() / 1e9);
+    }
+    for (const auto& site : m_sites) {
+        if (site.flagged == 0) continue;
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   flagged {} of {} from {}\n"),
+            site.flagged, site.created, Utf::ToWide(site.name));
+    }
+}
+
+} // namespace TalosAP
@@ -1,4 +1,5 @@
 #include "headers/SaveGameHandler.h"
+#include "headers/TraceRecorder.h"
 
 #include <Unreal/UObjectGlobals.hpp>
 #include <DynamicOutput/DynamicOutput.hpp>
@@ -15,9 +16,10 @@ void SaveGameHandler::RegisterHooks(ModState& state)
         auto hookId = UObjectGlobals::RegisterHook(
             STR("/Script/Talos.TalosGameInstance:SetTalosSaveGameInstance"),
             [](UnrealScriptFunctionCallableContext& ctx, void* data) {
+                TraceScope trace("Hook", "hook", "SetTalosSaveGameInstance");
                 auto* st = static_cast<ModState*>(data);
                 Output::send<LogLevel::Verbose>(STR("[TalosAP] Hook: SetTalosSaveGameInstance\n"));
-                st->ResetForLevelTransition(15);
+                st->ResetForLevelTransition(st->Tuning.cooldown_save_loaded_ticks);
                 st->CheckedLocations.clear();
             },
             {},
@@ -35,9 +37,10 @@ void SaveGameHandler::RegisterHooks(ModState& state)
         auto hookId = UObjectGlobals::RegisterHook(
             STR("/Script/Talos.TalosGameInstance:ReloadSaveGame"),
             [](UnrealScriptFunctionCallableContext& ctx, void* data) {
+                TraceScope trace("Hook", "hook", "ReloadSaveGame");
                 auto* st = static_cast<ModState*>(data);
                 Output::send<LogLevel::Verbose>(STR("[TalosAP] Hook: ReloadSaveGame\n"));
-                st->ResetForLevelTransition(20);
+                st->ResetForLevelTransition(st->Tuning.cooldown_save_reload_ticks);
                 st->CheckedLocations.clear();
             },
             {},
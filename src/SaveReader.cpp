@@ -0,0 +1,481 @@
+#include "headers/SaveReader.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace TalosAP {
+
+// ============================================================
+// Format constants
+// ============================================================
+
+static constexpr uint32_t GVAS_MAGIC = 0x53415647;   // "GVAS"
+
+// SaveGameFileVersion that added the UE5 package version to the header.
+static constexpr int32_t SAVE_VERSION_UE5 = 3;
+
+// EUnrealEngineObjectUE5Version::PROPERTY_TAG_COMPLETE_TYPE_NAME (5.4):
+// tags carry a type tree and a flags byte instead of per-type extras.
+static constexpr int32_t UE5_COMPLETE_TYPE_NAME = 1012;
+
+// EPropertyTagFlags / EPropertyTagExtension (5.4+)
+static constexpr uint8_t TAG_HAS_ARRAY_INDEX    = 0x01;
+static constexpr uint8_t TAG_HAS_GUID           = 0x02;
+static constexpr uint8_t TAG_HAS_EXTENSIONS     = 0x04;
+static constexpr uint8_t TAG_NATIVE_SERIALIZE   = 0x08;
+static constexpr uint8_t TAG_BOOL_TRUE          = 0x10;
+static constexpr uint8_t TAG_EXT_OVERRIDABLE    = 0x02;
+
+static constexpr int     MAX_DEPTH           = 24;
+static constexpr int32_t MAX_STRING_UNITS    = 1 << 16;
+static constexpr int32_t MAX_CUSTOM_VERSIONS = 4096;
+static constexpr size_t  MAX_FILE_BYTES      = 256u << 20;
+
+// ============================================================
+// Cursor — bounds-checked forward reader
+// ============================================================
+
+namespace {
+
+class Cursor {
+public:
+    Cursor() = default;
+    Cursor(const uint8_t* data, size_t size) : m_begin(data), m_pos(data), m_end(data + size) {}
+
+    template <typename T>
+    bool Read(T& v)
+    {
+        if (Remaining() < sizeof(T)) return false;
+        std::memcpy(&v, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool Skip(size_t n)
+    {
+        if (Remaining() < n) return false;
+        m_pos += n;
+        return true;
+    }
+
+    /// Split off the next n bytes as their own cursor.
+    bool Take(size_t n, Cursor& out)
+    {
+        if (Remaining() < n) return false;
+        out = Cursor(m_pos, n);
+        m_pos += n;
+        return true;
+    }
+
+    /// FString: i32 length including the terminator; negative = UTF-16.
+    bool String(std::string& out)
+    {
+        int32_t len = 0;
+        if (!Read(len)) return false;
+        out.clear();
+        if (len == 0) return true;
+
+        if (len > 0) {
+            if (len > MAX_STRING_UNITS || Remaining() < static_cast<size_t>(len)) return false;
+            out.assign(reinterpret_cast<const char*>(m_pos), static_cast<size_t>(len - 1));
+            m_pos += len;
+            return true;
+        }
+
+        if (len < -MAX_STRING_UNITS) return false;
+        size_t units = static_cast<size_t>(-len);
+        if (Remaining() < units * 2) return false;
+        AppendUtf16(m_pos, units - 1, out);
+        m_pos += units * 2;
+        return true;
+    }
+
+    size_t Remaining() const { return static_cast<size_t>(m_end - m_pos); }
+    size_t Offset() const { return static_cast<size_t>(m_pos - m_begin); }
+
+private:
+    static void AppendUtf16(const uint8_t* p, size_t units, std::string& out)
+    {
+        out.reserve(units);
+        for (size_t i = 0; i < units; ++i) {
+            uint32_t c = p[i * 2] | (p[i * 2 + 1] << 8);
+            if (c >= 0xD800 && c < 0xDC00 && i + 1 < units) {
+                uint32_t lo = p[(i + 1) * 2] | (p[(i + 1) * 2 + 1] << 8);
+                if (lo >= 0xDC00 && lo < 0xE000) {
+                    c = 0x10000 + ((c - 0xD800) << 10) + (lo - 0xDC00);
+                    ++i;
+                }
+            }
+            if (c >= 0xD800 && c < 0xE000) c = 0xFFFD;
+            if (c < 0x80) {
+                out += static_cast<char>(c);
+            } else if (c < 0x800) {
+                out += static_cast<char>(0xC0 | (c >> 6));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            } else if (c < 0x10000) {
+                out += static_cast<char>(0xE0 | (c >> 12));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (c >> 18));
+                out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+    }
+
+    const uint8_t* m_begin = nullptr;
+    const uint8_t* m_pos = nullptr;
+    const uint8_t* m_end = nullptr;
+};
+
+// ============================================================
+// Property tags
+// ============================================================
+
+/// A tag's type with the parameters we care about: the struct name for
+/// StructProperty, the element type for arrays/sets, key and value types
+/// for maps.
+struct Tag {
+    std::string name;
+    std::string type;
+    std::string param0;
+    std::string param1;
+    int32_t     size = 0;
+    bool        boolValue = false;
+    bool        native = false;   ///< struct written by native serializer, not as tags
+};
+
+/// Structs that pre-5.4 saves write with their native serializer (no
+/// tags, and nothing for us inside).
+bool IsNativeStruct(const std::string& name)
+{
+    static const char* const NATIVE[] = {
+        "Vector", "Vector2D", "Vector4", "Rotator", "Quat", "Guid", "DateTime", "Timespan",
+        "LinearColor", "Color", "IntPoint", "IntVector", "Box", "Box2D", "SoftObjectPath",
+        "SoftClassPath", "GameplayTagContainer", "FrameNumber",
+    };
+    for (const char* n : NATIVE) {
+        if (name == n) return true;
+    }
+    return false;
+}
+
+/// 5.4+ type tree: (name, inner count, inner...) depth-first. Level 0 is
+/// the property type, level 1 its parameters.
+bool ReadTypeNode(Cursor& c, Tag& tag, int level, int& paramIndex, int depth)
+{
+    if (depth > MAX_DEPTH) return false;
+    std::string name;
+    int32_t inner = 0;
+    if (!c.String(name) || !c.Read(inner) || inner < 0 || inner > 64) return false;
+
+    if (level == 0) {
+        tag.type = std::move(name);
+    } else if (level == 1) {
+        if (paramIndex == 0) tag.param0 = std::move(name);
+        else if (paramIndex == 1) tag.param1 = std::move(name);
+        ++paramIndex;
+    }
+
+    int childIndex = 0;
+    for (int32_t i = 0; i < inner; ++i) {
+        if (!ReadTypeNode(c, tag, level + 1, level == 0 ? paramIndex : childIndex, depth + 1)) return false;
+    }
+    return true;
+}
+
+/// Read one tag. `end` is set at the "None" terminator.
+bool ReadTag(Cursor& c, bool completeTypeNames, Tag& tag, bool& end)
+{
+    tag = Tag{};
+    end = false;
+    if (!c.String(tag.name)) return false;
+    if (tag.name == "None") {
+        end = true;
+        return true;
+    }
+
+    if (completeTypeNames) {
+        int paramIndex = 0;
+        uint8_t flags = 0;
+        if (!ReadTypeNode(c, tag, 0, paramIndex, 0)) return false;
+        if (!c.Read(tag.size) || !c.Read(flags)) return false;
+        if ((flags & TAG_HAS_ARRAY_INDEX) && !c.Skip(sizeof(int32_t))) return false;
+        if ((flags & TAG_HAS_GUID) && !c.Skip(16)) return false;
+        if (flags & TAG_HAS_EXTENSIONS) {
+            uint8_t ext = 0;
+            if (!c.Read(ext)) return false;
+            if ((ext & TAG_EXT_OVERRIDABLE) && !c.Skip(2)) return false;
+        }
+        tag.boolValue = (flags & TAG_BOOL_TRUE) != 0;
+        tag.native    = (flags & TAG_NATIVE_SERIALIZE) != 0;
+    } else {
+        int32_t arrayIndex = 0;
+        if (!c.String(tag.type) || !c.Read(tag.size) || !c.Read(arrayIndex)) return false;
+
+        const std::string& t = tag.type;
+        if (t == "StructProperty") {
+            if (!c.String(tag.param0) || !c.Skip(16)) return false;
+        } else if (t == "BoolProperty") {
+            uint8_t b = 0;
+            if (!c.Read(b)) return false;
+            tag.boolValue = b != 0;
+        } else if (t == "ByteProperty" || t == "EnumProperty") {
+            if (!c.String(tag.param0)) return false;
+        } else if (t == "ArrayProperty" || t == "SetProperty" || t == "OptionalProperty") {
+            if (!c.String(tag.param0)) return false;
+        } else if (t == "MapProperty") {
+            if (!c.String(tag.param0) || !c.String(tag.param1)) return false;
+        }
+
+        uint8_t hasGuid = 0;
+        if (!c.Read(hasGuid)) return false;
+        if (hasGuid && !c.Skip(16)) return false;
+        tag.native = t == "StructProperty" && IsNativeStruct(tag.param0);
+    }
+    return tag.size >= 0;
+}
+
+// ============================================================
+// Walker
+// ============================================================
+
+class Walker {
+public:
+    Walker(bool completeTypeNames, const char* target, SaveScan& out)
+        : m_complete(completeTypeNames), m_target(target), m_out(out) {}
+
+    /// Tags until "None". False if the stream is malformed.
+    bool Properties(Cursor& c, int depth)
+    {
+        if (depth > MAX_DEPTH) return false;
+        Tag tag;
+        bool end = false;
+        while (!m_done) {
+            if (!ReadTag(c, m_complete, tag, end)) return false;
+            if (end) return true;
+            ++m_out.properties;
+
+            Cursor value;
+            if (!c.Take(static_cast<size_t>(tag.size), value)) return false;
+            Value(tag, value, depth);
+        }
+        return true;
+    }
+
+    bool Done() const { return m_done; }
+
+private:
+    /// Look inside one value. Failures here are contained: the tag's size
+    /// already moved the outer cursor past it.
+    void Value(const Tag& tag, Cursor& v, int depth)
+    {
+        if (tag.type == "MapProperty" && tag.name == m_target) {
+            TargetMap(tag, v);
+            return;
+        }
+        if (tag.type == "StructProperty") {
+            if (!tag.native) Properties(v, depth + 1);
+        } else if (tag.type == "ArrayProperty" || tag.type == "SetProperty") {
+            if (tag.param0 == "StructProperty") StructElements(tag.type == "SetProperty", v, depth);
+        } else if (tag.type == "MapProperty") {
+            if (tag.param0 == "StructProperty" || tag.param1 == "StructProperty") StructMap(tag, v, depth);
+        }
+    }
+
+    void StructElements(bool isSet, Cursor& v, int depth)
+    {
+        int32_t removed = 0, count = 0;
+        if (isSet && (!v.Read(removed) || removed != 0)) return;
+        if (!v.Read(count) || count < 0) return;
+
+        // Before 5.4 struct arrays repeat a tag for the element type
+        if (!isSet && !m_complete) {
+            Tag inner;
+            bool end = false;
+            if (!ReadTag(v, false, inner, end) || end) return;
+        }
+        for (int32_t i = 0; i < count && !m_done; ++i) {
+            if (!Properties(v, depth + 1)) return;
+        }
+    }
+
+    void StructMap(const Tag& tag, Cursor& v, int depth)
+    {
+        int32_t removed = 0, count = 0;
+        if (!v.Read(removed) || removed < 0) return;
+        for (int32_t i = 0; i < removed; ++i) {
+            if (!Element(tag.param0, v, depth)) return;
+        }
+        if (!v.Read(count) || count < 0) return;
+        for (int32_t i = 0; i < count && !m_done; ++i) {
+            if (!Element(tag.param0, v, depth) || !Element(tag.param1, v, depth)) return;
+        }
+    }
+
+    /// One untagged container element. False for types whose size can't
+    /// be known without more metadata than the tag carries.
+    bool Element(const std::string& type, Cursor& v, int depth)
+    {
+        if (type == "StructProperty") return Properties(v, depth + 1);
+        if (type == "StrProperty" || type == "NameProperty" || type == "EnumProperty" || type == "ObjectProperty") {
+            std::string s;
+            return v.String(s);
+        }
+        if (type == "BoolProperty" || type == "Int8Property")       return v.Skip(1);
+        if (type == "Int16Property" || type == "UInt16Property")    return v.Skip(2);
+        if (type == "IntProperty" || type == "UInt32Property" || type == "FloatProperty") return v.Skip(4);
+        if (type == "Int64Property" || type == "UInt64Property" || type == "DoubleProperty") return v.Skip(8);
+        return false;
+    }
+
+    /// CollectedTetrominos: TMap<FString, bool>.
+    void TargetMap(const Tag& tag, Cursor& v)
+    {
+        const bool keyIsString = tag.param0 == "StrProperty" || tag.param0 == "NameProperty";
+        if (!keyIsString) {
+            m_out.error = std::string(m_target) + " has key type " + tag.param0 + ", expected StrProperty";
+            m_done = true;
+            return;
+        }
+
+        int32_t removed = 0, count = 0;
+        std::string key;
+        bool ok = v.Read(removed) && removed >= 0;
+        for (int32_t i = 0; ok && i < removed; ++i) ok = v.String(key);
+        ok = ok && v.Read(count) && count >= 0;
+
+        std::vector<SavedTetromino> entries;
+        for (int32_t i = 0; ok && i < count; ++i) {
+            SavedTetromino entry{};
+            if (!v.String(entry.id)) { ok = false; break; }
+            if (tag.param1 == "BoolProperty") {
+                uint8_t b = 0;
+                ok = v.Read(b);
+                entry.used = b != 0;
+            } else {
+                ok = Element(tag.param1, v, 0);
+            }
+            entries.push_back(std::move(entry));
+        }
+
+        if (!ok) {
+            m_out.error = std::string(m_target) + " is truncated or malformed";
+        } else {
+            m_out.found = true;
+            m_out.tetrominos = std::move(entries);
+        }
+        m_done = true;
+    }
+
+    bool        m_complete;
+    const char* m_target;
+    SaveScan&   m_out;
+    bool        m_done = false;
+};
+
+bool ReadHeader(Cursor& c, SaveScan& out)
+{
+    uint32_t magic = 0;
+    if (!c.Read(magic)) { out.error = "file is empty"; return false; }
+    if (magic != GVAS_MAGIC) {
+        out.error = "not a GVAS save (compressed, or another format)";
+        return false;
+    }
+
+    uint16_t major = 0, minor = 0, patch = 0;
+    uint32_t changelist = 0;
+    std::string branch;
+    int32_t customFormat = 0, customCount = 0;
+
+    bool ok = c.Read(out.saveGameVersion) && c.Read(out.ue4Version);
+    if (ok && out.saveGameVersion >= SAVE_VERSION_UE5) ok = c.Read(out.ue5Version);
+    ok = ok && c.Read(major) && c.Read(minor) && c.Read(patch) && c.Read(changelist) && c.String(branch);
+    ok = ok && c.Read(customFormat) && c.Read(customCount)
+            && customCount >= 0 && customCount <= MAX_CUSTOM_VERSIONS
+            && c.Skip(static_cast<size_t>(customCount) * 20);   // FGuid + i32
+    ok = ok && c.String(out.saveClass);
+    if (!ok) {
+        out.error = "header is truncated";
+        return false;
+    }
+
+    out.engineVersion = std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch)
+        + "-" + std::to_string(changelist) + "+" + branch;
+    out.completeTypeNames = out.ue5Version >= UE5_COMPLETE_TYPE_NAME;
+    return true;
+}
+
+} // namespace
+
+// ============================================================
+// SaveReader
+// ============================================================
+
+bool SaveReader::Scan(const uint8_t* data, size_t size, SaveScan& out, const char* mapName)
+{
+    out = SaveScan{};
+    Cursor c(data, size);
+    if (!ReadHeader(c, out)) return false;
+
+    Walker walker(out.completeTypeNames, mapName, out);
+    bool streamOk = walker.Properties(c, 0);
+
+    if (!out.error.empty()) return false;
+    if (!out.found) {
+        out.error = streamOk
+            ? std::string("no ") + mapName + " in the save"
+            : "property stream is malformed near byte " + std::to_string(c.Offset());
+        return false;
+    }
+    return true;
+}
+
+bool SaveReader::ScanFile(const std::wstring& path, SaveScan& out, const char* mapName)
+{
+    std::ifstream file(fs::path(path), std::ios::binary);
+    if (!file.is_open()) {
+        out = SaveScan{};
+        out.error = "cannot open the file";
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    std::error_code ec;
+    auto size = fs::file_size(fs::path(path), ec);
+    if (!ec && size <= MAX_FILE_BYTES) bytes.reserve(static_cast<size_t>(size));
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (bytes.size() > MAX_FILE_BYTES) {
+        out = SaveScan{};
+        out.error = "file is too large for a save";
+        return false;
+    }
+    return Scan(bytes.data(), bytes.size(), out, mapName);
+}
+
+std::wstring SaveReader::FindLatestSave(const std::wstring& dir)
+{
+    std::error_code ec;
+    fs::path best;
+    fs::file_time_type bestTime{};
+
+    fs::recursive_directory_iterator it(fs::path(dir), fs::directory_options::skip_permission_denied, ec);
+    for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->path().extension() != L".sav") continue;
+        auto t = it->last_write_time(ec);
+        if (ec) { ec.clear(); continue; }
+        if (best.empty() || t > bestTime) {
+            best = it->path();
+            bestTime = t;
+        }
+    }
+    return best.wstring();
+}
+
+} // namespace TalosAP
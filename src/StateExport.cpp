@@ -0,0 +1,274 @@
+#include "headers/StateExport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define TALOSAP_GETPID _getpid
+#else
+#include <unistd.h>
+#define TALOSAP_GETPID getpid
+#endif
+
+namespace fs = std::filesystem;
+
+namespace TalosAP {
+
+static constexpr int STATE_EXPORT_VERSION = 1;
+
+// The snapshot only matters to trackers that start late; a few seconds of
+// lag is fine and keeps rewrites rare.
+static constexpr int64_t SNAPSHOT_INTERVAL_MS = 5000;
+
+StateExport& StateExport::Get()
+{
+    static StateExport s_instance;
+    return s_instance;
+}
+
+static int64_t SteadyNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t StateExport::NowMs() const
+{
+    return (SteadyNs() - m_startNs) / 1'000'000;
+}
+
+static void AppendJsonString(std::string& out, const char* s, size_t len)
+{
+    out += '"';
+    for (size_t i = 0; i < len; ++i) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+static void AppendJsonString(std::string& out, const std::string& s) { AppendJsonString(out, s.data(), s.size()); }
+static void AppendJsonString(std::string& out, const ItemId& s)      { AppendJsonString(out, s.data(), s.size()); }
+
+// ============================================================
+// Session
+// ============================================================
+
+bool StateExport::Open(const std::wstring& dir)
+{
+    if (IsOpen()) return true;
+
+    fs::path base = dir.empty() ? fs::path(L".") : fs::path(dir);
+    m_events.open(base / L"talos_ap_events.ndjson", std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!m_events.is_open()) return false;
+    m_snapshotPath = (base / L"talos_ap_state.json").wstring();
+
+    m_buffer.clear();
+    m_seq = 0;
+    m_startNs = SteadyNs();
+    m_lastSnapshotMs = 0;
+    m_dirty = true;
+    m_granted.clear();
+    m_checked.clear();
+    m_fences.clear();
+    m_scouts.clear();
+    m_generation = 0;
+    m_level.clear();
+
+    char fields[96];
+    std::snprintf(fields, sizeof(fields), ",\"version\":%d,\"pid\":%d",
+                  STATE_EXPORT_VERSION, static_cast<int>(TALOSAP_GETPID()));
+    Append("session", fields);
+    Tick();
+    WriteSnapshot();   // replace the previous session's snapshot right away
+    return true;
+}
+
+void StateExport::Close()
+{
+    if (!IsOpen()) return;
+    Tick();
+    WriteSnapshot();
+    m_events.close();
+}
+
+// ============================================================
+// Deltas
+// ============================================================
+
+void StateExport::Append(const char* type, const std::string& fields)
+{
+    char head[96];
+    std::snprintf(head, sizeof(head), "{\"seq\":%" PRIu64 ",\"t\":%" PRId64 ",\"type\":\"%s\"",
+                  ++m_seq, NowMs(), type);
+    m_buffer += head;
+    m_buffer += fields;
+    m_buffer += "}\n";
+    m_dirty = true;
+}
+
+static std::string IdField(const ItemId& tetId)
+{
+    std::string f = ",\"id\":";
+    AppendJsonString(f, tetId);
+    return f;
+}
+
+void StateExport::Granted(const ItemId& tetId)
+{
+    if (!IsOpen() || !m_granted.insert(tetId).second) return;
+    Append("granted", IdField(tetId));
+}
+
+void StateExport::Checked(const ItemId& tetId)
+{
+    if (!IsOpen() || !m_checked.insert(tetId).second) return;
+    Append("checked", IdField(tetId));
+}
+
+void StateExport::FenceOpened(const ItemId& tetId)
+{
+    if (!IsOpen() || !m_fences.insert(tetId).second) return;
+    Append("fence_opened", IdField(tetId));
+}
+
+void StateExport::LevelEntered(uint32_t generation, const std::string& level)
+{
+    if (!IsOpen() || generation == m_generation) return;
+    m_generation = generation;
+    m_level = level;
+
+    std::string f = ",\"generation\":" + std::to_string(generation) + ",\"level\":";
+    AppendJsonString(f, level);
+    Append("level_entered", f);
+}
+
+void StateExport::Scouted(const ItemId& tetId, const std::string& item, const std::string& player, int flags)
+{
+    if (!IsOpen()) return;
+    auto it = m_scouts.find(tetId);
+    if (it != m_scouts.end() && it->second.item == item && it->second.player == player && it->second.flags == flags) {
+        return;
+    }
+    m_scouts[tetId] = Scout{item, player, flags};
+
+    std::string f = IdField(tetId);
+    f += ",\"item\":";
+    AppendJsonString(f, item);
+    f += ",\"player\":";
+    AppendJsonString(f, player);
+    f += ",\"flags\":" + std::to_string(flags);
+    Append("scouted", f);
+}
+
+void StateExport::GrantsReset()
+{
+    if (!IsOpen() || m_granted.empty()) return;
+    m_granted.clear();
+    Append("granted_reset", std::string());
+}
+
+// ============================================================
+// Output
+// ============================================================
+
+void StateExport::Tick()
+{
+    if (!IsOpen()) return;
+
+    if (!m_buffer.empty()) {
+        m_events.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_events.flush();
+        m_buffer.clear();
+    }
+
+    if (m_dirty && NowMs() - m_lastSnapshotMs >= SNAPSHOT_INTERVAL_MS) {
+        WriteSnapshot();
+    }
+}
+
+/// Sorted, so unchanged state produces an identical file.
+template <typename Set>
+static void AppendIdArray(std::string& out, const char* key, const Set& set)
+{
+    std::vector<const ItemId*> ids;
+    ids.reserve(set.size());
+    for (const auto& id : set) ids.push_back(&id);
+    std::sort(ids.begin(), ids.end(), [](const ItemId* a, const ItemId* b) { return a->view() < b->view(); });
+
+    out += ",\"";
+    out += key;
+    out += "\":[";
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (i) out += ',';
+        AppendJsonString(out, *ids[i]);
+    }
+    out += ']';
+}
+
+void StateExport::WriteSnapshot()
+{
+    std::string out;
+    out.reserve(4096);
+
+    char head[160];
+    std::snprintf(head, sizeof(head), "{\"version\":%d,\"seq\":%" PRIu64 ",\"t\":%" PRId64 ",\"generation\":%u,\"level\":",
+                  STATE_EXPORT_VERSION, m_seq, NowMs(), m_generation);
+    out += head;
+    AppendJsonString(out, m_level);
+    AppendIdArray(out, "granted", m_granted);
+    AppendIdArray(out, "checked", m_checked);
+    AppendIdArray(out, "fences_opened", m_fences);
+
+    std::vector<std::pair<const ItemId*, const Scout*>> scouts;
+    scouts.reserve(m_scouts.size());
+    for (const auto& [id, scout] : m_scouts) scouts.emplace_back(&id, &scout);
+    std::sort(scouts.begin(), scouts.end(), [](const auto& a, const auto& b) { return a.first->view() < b.first->view(); });
+
+    out += ",\"scouted\":{";
+    for (size_t i = 0; i < scouts.size(); ++i) {
+        if (i) out += ',';
+        AppendJsonString(out, *scouts[i].first);
+        out += ":{\"item\":";
+        AppendJsonString(out, scouts[i].second->item);
+        out += ",\"player\":";
+        AppendJsonString(out, scouts[i].second->player);
+        out += ",\"flags\":" + std::to_string(scouts[i].second->flags) + '}';
+    }
+    out += "}}\n";
+
+    // Readers must never see a half-written snapshot: write beside it,
+    // then replace it in one rename.
+    fs::path target(m_snapshotPath);
+    fs::path temp = target;
+    temp += L".tmp";
+    {
+        std::ofstream f(temp, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!f.is_open()) return;
+        f.write(out.data(), static_cast<std::streamsize>(out.size()));
+        if (!f) return;
+    }
+    std::error_code ec;
+    fs::rename(temp, target, ec);
+    if (ec) return;
+
+    m_lastSnapshotMs = NowMs();
+    m_dirty = false;
+}
+
+} // namespace TalosAP
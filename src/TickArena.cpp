@@ -0,0 +1,141 @@
+#include "headers/TickArena.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace TalosAP {
+
+// ============================================================
+// TickArena
+// ============================================================
+
+TickArena& TickArena::Get()
+{
+    static TickArena s_instance;
+    return s_instance;
+}
+
+void* TickArena::do_allocate(size_t bytes, size_t alignment)
+{
+    auto base    = reinterpret_cast<uintptr_t>(m_buffer);
+    auto current = base + m_offset;
+    auto aligned = (current + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    size_t offset = static_cast<size_t>(aligned - base);
+
+    if (offset + bytes <= CAPACITY) {
+        m_offset = offset + bytes;
+        return m_buffer + offset;
+    }
+
+    // Out of room — fall back to the heap for the rest of this tick.
+    void* p = ::operator new(bytes, std::align_val_t(alignment));
+    m_overflow.push_back({ p, bytes, alignment });
+    ++m_overflowCount;
+    return p;
+}
+
+void TickArena::do_deallocate(void*, size_t, size_t)
+{
+    // Bump allocator: everything is released together in Reset().
+}
+
+bool TickArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void TickArena::Reset()
+{
+    if (m_offset > m_highWater) m_highWater = m_offset;
+    m_offset = 0;
+
+    for (const auto& block : m_overflow) {
+        ::operator delete(block.ptr, block.bytes, std::align_val_t(block.alignment));
+    }
+    m_overflow.clear();
+}
+
+// ============================================================
+// AllocCounter
+// ============================================================
+
+// Per thread: the AP network thread allocates continuously and must not
+// land in the game thread's per-tick numbers.
+static thread_local uint64_t t_allocCount = 0;
+
+namespace AllocCounter {
+
+bool Enabled()
+{
+#ifdef TALOSAP_ALLOC_COUNTER
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t Count()
+{
+    return t_allocCount;
+}
+
+} // namespace AllocCounter
+
+} // namespace TalosAP
+
+// ============================================================
+// Global operator new/delete replacement (TALOSAP_ALLOC_COUNTER)
+//
+// Only the four base forms are replaced; the standard routes the
+// array, sized and nothrow variants through these. Storage comes from
+// the same CRT heap the default operators use, so memory can still
+// cross the DLL boundary in either direction.
+// ============================================================
+#ifdef TALOSAP_ALLOC_COUNTER
+
+static void* CountedAlloc(size_t size)
+{
+    ++TalosAP::t_allocCount;
+    if (size == 0) size = 1;
+    return std::malloc(size);
+}
+
+static void* CountedAlignedAlloc(size_t size, size_t alignment)
+{
+    ++TalosAP::t_allocCount;
+    if (size == 0) size = 1;
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    size = (size + alignment - 1) & ~(alignment - 1);
+    return std::aligned_alloc(alignment, size);
+#endif
+}
+
+void* operator new(size_t size)
+{
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    if (void* p = CountedAlignedAlloc(size, static_cast<size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+#endif // TALOSAP_ALLOC_COUNTER
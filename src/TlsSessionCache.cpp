@@ -0,0 +1,102 @@
+#include "headers/TlsSessionCache.h"
+
+#include <openssl/ssl.h>
+
+namespace TalosAP {
+
+// ============================================================
+// Per-SSL key
+//
+// The new-session callback only gets the SSL, so Prime() leaves a copy
+// of the host:port key on it; OpenSSL frees it with the SSL.
+// ============================================================
+
+static void FreeKey(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*)
+{
+    delete static_cast<std::string*>(ptr);
+}
+
+static int KeyIndex()
+{
+    static const int s_index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, FreeKey);
+    return s_index;
+}
+
+TlsSessionCache& TlsSessionCache::Get()
+{
+    // Never destroyed: a cached session is simply left to process exit,
+    // which may come after OpenSSL's own atexit cleanup.
+    static TlsSessionCache* s_instance = new TlsSessionCache();
+    return *s_instance;
+}
+
+// ============================================================
+// Handshake hooks
+// ============================================================
+
+void TlsSessionCache::Prime(SSL* ssl, const std::string& key)
+{
+    if (!ssl || KeyIndex() < 0) return;
+
+    // Client cache mode is what makes OpenSSL report new sessions (and
+    // TLS 1.3 tickets, which arrive after the handshake) at all. No
+    // internal store: the context dies with this connection.
+    SSL_CTX* ctx = SSL_get_SSL_CTX(ssl);
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, &TlsSessionCache::OnNewSession);
+    SSL_set_ex_data(ssl, KeyIndex(), new std::string(key));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_session || m_key != key) return;
+    if (!SSL_SESSION_is_resumable(m_session)) {
+        SSL_SESSION_free(m_session);
+        m_session = nullptr;
+        return;
+    }
+    // SSL_set_session takes its own reference. A server that no longer
+    // knows the session just falls back to a full handshake.
+    SSL_set_session(ssl, m_session);
+}
+
+void TlsSessionCache::Finished(SSL* ssl)
+{
+    if (!ssl) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (SSL_session_reused(ssl)) ++m_resumed;
+    else ++m_full;
+}
+
+int TlsSessionCache::OnNewSession(SSL* ssl, SSL_SESSION* session)
+{
+    auto* key = static_cast<std::string*>(SSL_get_ex_data(ssl, KeyIndex()));
+    if (!key) return 0;  // not one of ours; OpenSSL keeps ownership
+
+    auto& self = Get();
+    std::lock_guard<std::mutex> lock(self.m_mutex);
+    if (self.m_session) SSL_SESSION_free(self.m_session);
+    self.m_session = session;
+    self.m_key = *key;
+    return 1;
+}
+
+void TlsSessionCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_session) SSL_SESSION_free(m_session);
+    m_session = nullptr;
+    m_key.clear();
+}
+
+uint64_t TlsSessionCache::Resumed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_resumed;
+}
+
+uint64_t TlsSessionCache::FullHandshakes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_full;
+}
+
+} // namespace TalosAP
@@ -0,0 +1,197 @@
+#include "headers/TraceRecorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+namespace TalosAP {
+
+// ============================================================
+// Clock / thread IDs
+// ============================================================
+
+static const auto s_traceEpoch = std::chrono::steady_clock::now();
+
+int64_t TraceRecorder::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_traceEpoch).count();
+}
+
+// Small sequential IDs read better in the viewer than OS thread IDs.
+uint32_t TraceRecorder::CurrentTid()
+{
+    static std::atomic<uint32_t> s_nextTid{1};
+    thread_local uint32_t tid = s_nextTid.fetch_add(1, std::memory_order_relaxed);
+    return tid;
+}
+
+// ============================================================
+// Construction
+// ============================================================
+
+TraceRecorder& TraceRecorder::Get()
+{
+    static TraceRecorder s_instance;
+    return s_instance;
+}
+
+TraceRecorder::TraceRecorder()
+{
+    m_ring.resize(CAPACITY);
+}
+
+// ============================================================
+// Recording
+// ============================================================
+
+static void CopyDetail(char (&dst)[TraceRecorder::DETAIL_LEN + 1], const char* src)
+{
+    if (!src) { dst[0] = '\0'; return; }
+    size_t n = std::strlen(src);
+    if (n > TraceRecorder::DETAIL_LEN) n = TraceRecorder::DETAIL_LEN;
+    std::memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+void TraceRecorder::Push(const Event& ev)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ring[m_head] = ev;
+    m_head = (m_head + 1) % CAPACITY;
+    if (m_count < CAPACITY) ++m_count;
+}
+
+void TraceRecorder::Complete(const char* name, const char* category, int64_t startNs, int64_t endNs,
+                             const char* detail)
+{
+    if (!m_enabled) return;
+    Event ev;
+    ev.name     = name;
+    ev.category = category;
+    ev.tsNs     = startNs;
+    ev.durNs    = endNs - startNs;
+    ev.tid      = CurrentTid();
+    ev.phase    = Phase::Complete;
+    CopyDetail(ev.detail, detail);
+    Push(ev);
+}
+
+void TraceRecorder::Instant(const char* name, const char* category, const char* detail)
+{
+    FlightRecorder::Get().Record(FlightEventKind::Instant, name, detail);
+    if (!m_enabled) return;
+    Event ev;
+    ev.name     = name;
+    ev.category = category;
+    ev.tsNs     = NowNs();
+    ev.tid      = CurrentTid();
+    ev.phase    = Phase::Instant;
+    CopyDetail(ev.detail, detail);
+    Push(ev);
+}
+
+void TraceRecorder::Counter(const char* name, int64_t value)
+{
+    if (!m_enabled) return;
+    Event ev;
+    ev.name     = name;
+    ev.category = "counter";
+    ev.tsNs     = NowNs();
+    ev.value    = value;
+    ev.tid      = CurrentTid();
+    ev.phase    = Phase::Counter;
+    Push(ev);
+}
+
+size_t TraceRecorder::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
+}
+
+// ============================================================
+// Flush — Chrome JSON trace format
+// ============================================================
+
+static void WriteJsonString(std::ofstream& out, const char* s)
+{
+    out << '"';
+    for (; s && *s; ++s) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') {
+            out << '\\' << static_cast<char>(c);
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out << buf;
+        } else {
+            out << static_cast<char>(c);
+        }
+    }
+    out << '"';
+}
+
+bool TraceRecorder::Flush(const std::wstring& path)
+{
+    // Snapshot under the lock, write without it — file I/O must not
+    // stall other threads that are still recording.
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        events.reserve(m_count);
+        size_t start = (m_head + CAPACITY - m_count) % CAPACITY;
+        for (size_t i = 0; i < m_count; ++i) {
+            events.push_back(m_ring[(start + i) % CAPACITY]);
+        }
+    }
+
+    std::ofstream out{std::filesystem::path(path), std::ios::trunc};
+    if (!out.is_open()) return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":\"TalosAP\"}}";
+
+    char num[64];
+    for (const auto& ev : events) {
+        if (!ev.name) continue;
+        out << ",\n{\"name\":";
+        WriteJsonString(out, ev.name);
+        out << ",\"cat\":";
+        WriteJsonString(out, ev.category ? ev.category : "mod");
+        out << ",\"ph\":\"" << static_cast<char>(ev.phase) << '"';
+
+        // Chrome expects microseconds; keep sub-µs precision.
+        std::snprintf(num, sizeof(num), "%.3f", ev.tsNs / 1000.0);
+        out << ",\"ts\":" << num << ",\"pid\":1,\"tid\":" << ev.tid;
+
+        switch (ev.phase) {
+            case Phase::Complete:
+                std::snprintf(num, sizeof(num), "%.3f", ev.durNs / 1000.0);
+                out << ",\"dur\":" << num;
+                break;
+            case Phase::Instant:
+                out << ",\"s\":\"t\"";
+                break;
+            case Phase::Counter:
+                out << ",\"args\":{\"value\":" << ev.value << '}';
+                break;
+        }
+
+        if (ev.phase != Phase::Counter && ev.detail[0]) {
+            out << ",\"args\":{\"detail\":";
+            WriteJsonString(out, ev.detail);
+            out << '}';
+        }
+        out << '}';
+    }
+
+    out << "\n]}\n";
+    return out.good();
+}
+
+} // namespace TalosAP
@@ -0,0 +1,283 @@
+#include "headers/Utf.h"
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TALOSAP_UTF_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace TalosAP::Utf {
+
+static constexpr uint32_t REPLACEMENT = 0xFFFD;
+static constexpr bool WIDE_IS_UTF16 = sizeof(wchar_t) == 2;
+
+// Worst-case output units per input unit.
+//   UTF-8 -> wide: one unit per byte at most (a 4-byte sequence is a pair).
+//   wide -> UTF-8: 3 bytes per UTF-16 unit (a pair is 4 bytes for 2 units),
+//                  4 bytes per UTF-32 unit.
+static constexpr size_t MAX_UTF8_PER_WIDE = WIDE_IS_UTF16 ? 3 : 4;
+
+// ============================================================
+// SSE2 ASCII blocks
+// ============================================================
+#ifdef TALOSAP_UTF_SSE2
+
+// 16 ASCII bytes -> 16 wchar_t.
+static inline void WidenBlock(__m128i bytes, wchar_t* out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+    if constexpr (WIDE_IS_UTF16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), hi);
+    } else {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),      _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4),  _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8),  _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+}
+
+// 16 wchar_t -> 16 ASCII bytes. Returns false (writing nothing) if any
+// unit is >= 0x80.
+static inline bool NarrowBlock(const wchar_t* in, char* out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i packed;
+    if constexpr (WIDE_IS_UTF16) {
+        const __m128i high = _mm_set1_epi16(static_cast<short>(0xFF80));
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+        __m128i any = _mm_and_si128(_mm_or_si128(a, b), high);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(any, zero)) != 0xFFFF) return false;
+        packed = _mm_packus_epi16(a, b);
+    } else {
+        const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFFFF80u));
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12));
+        __m128i any = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), high);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(any, zero)) != 0xFFFF) return false;
+        packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+    return true;
+}
+
+#endif // TALOSAP_UTF_SSE2
+
+// ============================================================
+// UTF-8 -> wide
+// ============================================================
+
+// True if every byte is < 0x80 (the common case for AP text).
+static bool IsAscii(const unsigned char* s, size_t n)
+{
+    size_t i = 0;
+#ifdef TALOSAP_UTF_SSE2
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        acc = _mm_or_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+    }
+    if (_mm_movemask_epi8(acc) != 0) return false;
+#endif
+    unsigned char tail = 0;
+    for (; i < n; ++i) tail |= s[i];
+    return tail < 0x80;
+}
+
+// Decode one non-ASCII sequence starting at s[0]. Returns bytes consumed
+// (always >= 1). Malformed input yields U+FFFD and consumes only the
+// maximal valid prefix, so the next byte is re-examined — the same
+// recovery as the WHATWG / Unicode "maximal subpart" rule.
+static size_t DecodeOne(const unsigned char* s, size_t n, uint32_t& cp)
+{
+    const unsigned c = s[0];
+    size_t need;
+    unsigned lower = 0x80, upper = 0xBF;
+
+    if (c >= 0xC2 && c <= 0xDF) {
+        need = 1; cp = c & 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        need = 2; cp = c & 0x0F;
+        if (c == 0xE0) lower = 0xA0;        // overlong
+        if (c == 0xED) upper = 0x9F;        // surrogates
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        need = 3; cp = c & 0x07;
+        if (c == 0xF0) lower = 0x90;        // overlong
+        if (c == 0xF4) upper = 0x8F;        // > U+10FFFF
+    } else {
+        cp = REPLACEMENT;
+        return 1;
+    }
+
+    size_t i = 1;
+    for (; i <= need; ++i) {
+        if (i >= n) { cp = REPLACEMENT; return i; }
+        const unsigned b = s[i];
+        if (b < lower || b > upper) { cp = REPLACEMENT; return i; }
+        lower = 0x80; upper = 0xBF;
+        cp = (cp << 6) | (b & 0x3F);
+    }
+    return i;
+}
+
+static size_t DecodeCore(const unsigned char* s, size_t n, wchar_t* out, size_t cap)
+{
+    size_t i = 0, o = 0;
+    while (i < n) {
+#ifdef TALOSAP_UTF_SSE2
+        while (i + 16 <= n && o + 16 <= cap) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            if (_mm_movemask_epi8(v) != 0) break;
+            WidenBlock(v, out + o);
+            i += 16;
+            o += 16;
+        }
+        if (i >= n) break;
+#endif
+        if (s[i] < 0x80) {
+            if (o >= cap) return NO_FIT;
+            out[o++] = static_cast<wchar_t>(s[i++]);
+            continue;
+        }
+
+        uint32_t cp;
+        i += DecodeOne(s + i, n - i, cp);
+
+        if (WIDE_IS_UTF16 && cp >= 0x10000) {
+            if (o + 2 > cap) return NO_FIT;
+            cp -= 0x10000;
+            out[o++] = static_cast<wchar_t>(0xD800 + (cp >> 10));
+            out[o++] = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+        } else {
+            if (o >= cap) return NO_FIT;
+            out[o++] = static_cast<wchar_t>(cp);
+        }
+    }
+    return o;
+}
+
+// ============================================================
+// wide -> UTF-8
+// ============================================================
+
+static size_t EncodeCore(const wchar_t* s, size_t n, char* out, size_t cap)
+{
+    size_t i = 0, o = 0;
+    while (i < n) {
+#ifdef TALOSAP_UTF_SSE2
+        while (i + 16 <= n && o + 16 <= cap && NarrowBlock(s + i, out + o)) {
+            i += 16;
+            o += 16;
+        }
+        if (i >= n) break;
+#endif
+        uint32_t cp = static_cast<uint32_t>(s[i++]);
+
+        if (cp < 0x80) {
+            if (o >= cap) return NO_FIT;
+            out[o++] = static_cast<char>(cp);
+            continue;
+        }
+
+        if (cp >= 0xD800 && cp <= 0xDFFF) {
+            // Combine a well-formed pair; anything else is a lone surrogate.
+            if (WIDE_IS_UTF16 && cp <= 0xDBFF && i < n) {
+                const uint32_t lo = static_cast<uint32_t>(s[i]);
+                if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    ++i;
+                } else {
+                    cp = REPLACEMENT;
+                }
+            } else {
+                cp = REPLACEMENT;
+            }
+        } else if (cp > 0x10FFFF) {
+            cp = REPLACEMENT;
+        }
+
+        if (cp < 0x800) {
+            if (o + 2 > cap) return NO_FIT;
+            out[o++] = static_cast<char>(0xC0 | (cp >> 6));
+            out[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            if (o + 3 > cap) return NO_FIT;
+            out[o++] = static_cast<char>(0xE0 | (cp >> 12));
+            out[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            if (o + 4 > cap) return NO_FIT;
+            out[o++] = static_cast<char>(0xF0 | (cp >> 18));
+            out[o++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+    return o;
+}
+
+// ============================================================
+// Public API
+// ============================================================
+
+void AppendWide(std::string_view utf8, std::wstring& out)
+{
+    if (utf8.empty()) return;
+    auto* bytes = reinterpret_cast<const unsigned char*>(utf8.data());
+
+    // Pure ASCII widens 1:1; the range append compiles to a vector loop
+    // and skips the zero-fill of resize().
+    if (IsAscii(bytes, utf8.size())) {
+        out.append(bytes, bytes + utf8.size());
+        return;
+    }
+
+    const size_t start = out.size();
+    out.resize(start + utf8.size());
+    size_t n = DecodeCore(bytes, utf8.size(), out.data() + start, utf8.size());
+    out.resize(start + n);
+}
+
+void AppendUtf8(std::wstring_view wide, std::string& out)
+{
+    if (wide.empty()) return;
+    const size_t start = out.size();
+    const size_t cap = wide.size() * MAX_UTF8_PER_WIDE;
+    out.resize(start + cap);
+    size_t n = EncodeCore(wide.data(), wide.size(), out.data() + start, cap);
+    out.resize(start + n);
+}
+
+std::wstring ToWide(std::string_view utf8)
+{
+    auto* bytes = reinterpret_cast<const unsigned char*>(utf8.data());
+    if (IsAscii(bytes, utf8.size())) return std::wstring(bytes, bytes + utf8.size());
+
+    std::wstring out;
+    AppendWide(utf8, out);
+    return out;
+}
+
+std::string ToUtf8(std::wstring_view wide)
+{
+    std::string out;
+    AppendUtf8(wide, out);
+    return out;
+}
+
+size_t DecodeTo(std::string_view utf8, wchar_t* out, size_t capacity)
+{
+    return DecodeCore(reinterpret_cast<const unsigned char*>(utf8.data()), utf8.size(), out, capacity);
+}
+
+size_t EncodeTo(std::wstring_view wide, char* out, size_t capacity)
+{
+    return EncodeCore(wide.data(), wide.size(), out, capacity);
+}
+
+} // namespace TalosAP::Utf
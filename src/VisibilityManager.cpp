@@ -1,4 +1,12 @@
 #include "headers/VisibilityManager.h"
+#include "headers/TraceRecorder.h"
+#include "headers/StateExport.h"
+#include "headers/EngineCalls.h"
+#include "headers/FunctionThunk.h"
+#include "headers/LiveMetrics.h"
+#include "headers/Latency.h"
+#include "headers/Utf.h"
+#include "GameOffsets.h"
 
 #include <Unreal/UObjectGlobals.hpp>
 #include <Unreal/UObject.hpp>
@@ -10,6 +18,7 @@
 
 #include <vector>
 #include <cmath>
+#include <limits>
 #include <excpt.h>   // EXCEPTION_EXECUTE_HANDLER (SEH)
 
 using namespace RC;
@@ -26,7 +35,7 @@ using namespace RC::Unreal;
 // This function MUST remain free of C++ objects with non-trivial
 // destructors on the stack — MSVC forbids mixing __try with them.
 // ============================================================
-static bool SafeProcessEvent(UObject* target, UFunction* func, void* params)
+static bool SafeProcessEventRaw(UObject* target, UFunction* func, void* params)
 {
     if (!target || !func) return false;
     __try {
@@ -38,87 +47,48 @@ static bool SafeProcessEvent(UObject* target, UFunction* func, void* params)
     }
 }
 
-namespace TalosAP {
-
-// ============================================================
-// Type/Shape → Letter lookups
-// ============================================================
-
-char VisibilityManager::TypeToLetter(uint8_t type)
+// Counted + traced front end — the span lives out here because the SEH
+// frame above cannot hold objects with destructors.
+static bool SafeProcessEvent(UObject* target, UFunction* func, void* params, const char* label,
+                             const std::source_location& loc = std::source_location::current())
 {
-    switch (type) {
-        case 1:  return 'D'; // Door
-        case 2:  return 'M'; // Mechanic
-        case 4:  return 'N'; // Nexus
-        case 8:  return 'S'; // Secret
-        case 16: return 'E'; // AlternativeEnding
-        case 32: return 'A'; // Arcade
-        case 64: return 'H'; // Help
-        default: return '?';
-    }
-}
-
-char VisibilityManager::ShapeToLetter(uint8_t shape)
-{
-    switch (shape) {
-        case 1:  return 'I';
-        case 2:  return 'J';
-        case 4:  return 'L';
-        case 8:  return 'O';
-        case 16: return 'S';
-        case 32: return 'T';
-        case 64: return 'Z';
-        default: return '?';
-    }
+    TalosAP::EngineCallStats::Get().Count(TalosAP::EngineCallKind::ProcessEvent, label, false, loc);
+    TalosAP::TraceScope trace("ProcessEvent", "engine", label);
+    return SafeProcessEventRaw(target, func, params);
 }
 
-std::string VisibilityManager::FormatTetrominoId(uint8_t typeVal, uint8_t shapeVal, int32_t number)
-{
-    char tl = TypeToLetter(typeVal);
-    char sl = ShapeToLetter(shapeVal);
-    if (tl == '?' || sl == '?') return "";
-    return std::string(1, tl) + std::string(1, sl) + std::to_string(number);
-}
+namespace TalosAP {
 
 // ============================================================
-// InstanceInfo reading
+// Function thunks (see FunctionThunk.h)
 // ============================================================
 
-// FTetrominoInstanceInfo layout (from CXX header dump):
-//   struct FTetrominoInstanceInfo {
-//       ETetrominoPieceType  Type;    // offset 0x0, size 0x1
-//       ETetrominoPieceShape Shape;   // offset 0x1, size 0x1
-//       int32                Number;  // offset 0x4, size 0x4
-//   };                               // total size: 0x8
+// USceneComponent::SetVisibility(bool bNewVisibility, bool bPropagateToChildren)
+struct Params_SetComponentVisibility {
+    bool bNewVisibility;
+    bool bPropagateToChildren;
+};
 
-bool VisibilityManager::ReadInstanceInfo(UObject* actor, uint8_t& outType, uint8_t& outShape, int32_t& outNumber)
-{
-    if (!actor) return false;
+// USceneComponent::SetHiddenInGame(bool NewHidden, bool bPropagateToChildren)
+struct Params_SetHiddenInGame {
+    bool NewHidden;
+    bool bPropagateToChildren;
+};
 
-    try {
-        // InstanceInfo is a struct property on BP_TetrominoItem_C.
-        // In the Talos header dump, "class ATetrominoItem" doesn't exist directly—
-        // BP_TetrominoItem_C is an Angelscript-generated Blueprint class.
-        // The InstanceInfo property holds FTetrominoInstanceInfo which is:
-        //   Type (uint8), Shape (uint8), padding, Number (int32) = 8 bytes total.
-        //
-        // GetValuePtrByPropertyNameInChain returns a pointer to the first byte
-        // of the struct's storage.
-        auto* infoPtr = actor->GetValuePtrByPropertyNameInChain<uint8_t>(STR("InstanceInfo"));
-        if (!infoPtr) return false;
-
-        // Read the fields at their known offsets within the struct
-        outType  = infoPtr[0];   // offset 0x0
-        outShape = infoPtr[1];   // offset 0x1
-        // offset 0x4 (int32, after 2 bytes of padding)
-        outNumber = *reinterpret_cast<int32_t*>(infoPtr + 4);
-
-        return (outType != 0 && outShape != 0 && outNumber > 0);
-    }
-    catch (...) {
-        return false;
-    }
-}
+static FunctionThunk<Params_SetComponentVisibility> s_setComponentVisibility{
+    STR("/Script/Engine.SceneComponent:SetVisibility"), "SetVisibility",
+    { THUNK_FIELD(Params_SetComponentVisibility, bNewVisibility),
+      THUNK_FIELD(Params_SetComponentVisibility, bPropagateToChildren) } };
+
+static FunctionThunk<Params_SetHiddenInGame> s_setHiddenInGame{
+    STR("/Script/Engine.SceneComponent:SetHiddenInGame"), "SetHiddenInGame",
+    { THUNK_FIELD(Params_SetHiddenInGame, NewHidden),
+      THUNK_FIELD(Params_SetHiddenInGame, bPropagateToChildren) } };
+
+// Angelscript class — the UFunction is rebuilt on level load, so the
+// thunk is Reset() from ResetCache().
+static FunctionThunk<NoParams> s_fenceOpen{
+    STR("/Script/Angelscript.LoweringFence:Open"), "LoweringFence.Open" };
 
 // ============================================================
 // Actor position reading
@@ -131,14 +101,14 @@ bool VisibilityManager::ReadActorPosition(UObject* actor, float& outX, float& ou
     try {
         // AActor has a RootComponent (USceneComponent*) which has RelativeLocation (FVector).
         // In UE4SS, we can chain through the property names.
-        auto* rootCompPtr = actor->GetValuePtrByPropertyNameInChain<UObject*>(STR("RootComponent"));
+        auto* rootCompPtr = Engine::GetValuePtr<UObject*>(actor, STR("RootComponent"));
         if (!rootCompPtr || !*rootCompPtr) return false;
 
         UObject* rootComp = *rootCompPtr;
 
         // RelativeLocation is an FVector — in UE5 this is 3 doubles (24 bytes),
         // NOT 3 floats. Reading as float gives garbage from misaligned half-values.
-        auto* locPtr = rootComp->GetValuePtrByPropertyNameInChain<double>(STR("RelativeLocation"));
+        auto* locPtr = Engine::GetValuePtr<double>(rootComp, STR("RelativeLocation"));
         if (!locPtr) return false;
 
         outX = static_cast<float>(locPtr[0]);
@@ -158,10 +128,10 @@ bool VisibilityManager::ReadActorPosition(UObject* actor, float& outX, float& ou
 bool VisibilityManager::GetPlayerPosition(float& outX, float& outY, float& outZ)
 {
     try {
-        auto* pc = UObjectGlobals::FindFirstOf(STR("PlayerController"));
+        auto* pc = Engine::FindFirstOf(STR("PlayerController"));
         if (!pc) return false;
 
-        auto* pawnPtr = pc->GetValuePtrByPropertyNameInChain<UObject*>(STR("Pawn"));
+        auto* pawnPtr = Engine::GetValuePtr<UObject*>(pc, STR("Pawn"));
         if (!pawnPtr || !*pawnPtr) return false;
 
         UObject* pawn = *pawnPtr;
@@ -183,10 +153,10 @@ bool VisibilityManager::IsWorldValid()
         // nullptr (or the controller loses its Pawn).  Checking both is a
         // lightweight signal that the world is still alive without relying
         // on engine-internal members like UWorld* (not a UPROPERTY).
-        auto* pc = UObjectGlobals::FindFirstOf(STR("PlayerController"));
+        auto* pc = Engine::FindFirstOf(STR("PlayerController"));
         if (!pc) return false;
 
-        auto* pawnPtr = pc->GetValuePtrByPropertyNameInChain<UObject*>(STR("Pawn"));
+        auto* pawnPtr = Engine::GetValuePtr<UObject*>(pc, STR("Pawn"));
         return pawnPtr && *pawnPtr;
     }
     catch (...) {
@@ -202,30 +172,28 @@ bool VisibilityManager::SetActorVisible(UObject* actor)
 {
     if (!actor) return false;
 
-    auto* rootCompPtr = actor->GetValuePtrByPropertyNameInChain<UObject*>(STR("RootComponent"));
+    auto* rootCompPtr = Engine::GetValuePtr<UObject*>(actor, STR("RootComponent"));
     if (!rootCompPtr || !*rootCompPtr) return false;
     UObject* rootComp = *rootCompPtr;
 
     // Propagation interferes with the game's animation system and
     // collection sequence (mesh fade, particle despawn).
-    auto* setVisFunc = rootComp->GetFunctionByNameInChain(STR("SetVisibility"));
-    if (setVisFunc) {
-        struct { bool bNewVisibility; bool bPropagateToChildren; } params{};
+    if (auto* setVisFunc = s_setComponentVisibility.Function()) {
+        Params_SetComponentVisibility params{};
         params.bNewVisibility = true;
         params.bPropagateToChildren = true;
-        if (!SafeProcessEvent(rootComp, setVisFunc, &params)) {
+        if (!SafeProcessEvent(rootComp, setVisFunc, &params, s_setComponentVisibility.Label())) {
             Output::send<LogLevel::Warning>(STR("[TalosAP] SetActorVisible: ProcessEvent(SetVisibility) caught stale object — aborting\n"));
             return false;
         }
     }
 
     // SetHiddenInGame(false) — root only, do NOT propagate.
-    auto* setHiddenFunc = rootComp->GetFunctionByNameInChain(STR("SetHiddenInGame"));
-    if (setHiddenFunc) {
-        struct { bool NewHidden; bool bPropagateToChildren; } params{};
+    if (auto* setHiddenFunc = s_setHiddenInGame.Function()) {
+        Params_SetHiddenInGame params{};
         params.NewHidden = false;
         params.bPropagateToChildren = true;
-        if (!SafeProcessEvent(rootComp, setHiddenFunc, &params)) {
+        if (!SafeProcessEvent(rootComp, setHiddenFunc, &params, s_setHiddenInGame.Label())) {
             Output::send<LogLevel::Warning>(STR("[TalosAP] SetActorVisible: ProcessEvent(SetHiddenInGame) caught stale object — aborting\n"));
             return false;
         }
@@ -238,27 +206,25 @@ bool VisibilityManager::SetActorHidden(UObject* actor)
 {
     if (!actor) return false;
 
-    auto* rootCompPtr = actor->GetValuePtrByPropertyNameInChain<UObject*>(STR("RootComponent"));
+    auto* rootCompPtr = Engine::GetValuePtr<UObject*>(actor, STR("RootComponent"));
     if (!rootCompPtr || !*rootCompPtr) return false;
     UObject* rootComp = *rootCompPtr;
 
-    auto* setVisFunc = rootComp->GetFunctionByNameInChain(STR("SetVisibility"));
-    if (setVisFunc) {
-        struct { bool bNewVisibility; bool bPropagateToChildren; } params{};
+    if (auto* setVisFunc = s_setComponentVisibility.Function()) {
+        Params_SetComponentVisibility params{};
         params.bNewVisibility = false;
         params.bPropagateToChildren = true;
-        if (!SafeProcessEvent(rootComp, setVisFunc, &params)) {
+        if (!SafeProcessEvent(rootComp, setVisFunc, &params, s_setComponentVisibility.Label())) {
             Output::send<LogLevel::Warning>(STR("[TalosAP] SetActorHidden: ProcessEvent(SetVisibility) caught stale object — aborting\n"));
             return false;
         }
     }
 
-    auto* setHiddenFunc = rootComp->GetFunctionByNameInChain(STR("SetHiddenInGame"));
-    if (setHiddenFunc) {
-        struct { bool NewHidden; bool bPropagateToChildren; } params{};
+    if (auto* setHiddenFunc = s_setHiddenInGame.Function()) {
+        Params_SetHiddenInGame params{};
         params.NewHidden = true;
         params.bPropagateToChildren = true;
-        if (!SafeProcessEvent(rootComp, setHiddenFunc, &params)) {
+        if (!SafeProcessEvent(rootComp, setHiddenFunc, &params, s_setHiddenInGame.Label())) {
             Output::send<LogLevel::Warning>(STR("[TalosAP] SetActorHidden: ProcessEvent(SetHiddenInGame) caught stale object — aborting\n"));
             return false;
         }
@@ -272,83 +238,83 @@ bool VisibilityManager::IsActorHidden(UObject* actor)
 
     // Check Root SceneComponent visibility state (matches our SetActorVisible/Hidden).
     // bVisible=false or bHiddenInGame=true means the item is hidden.
-    auto* rootCompPtr = actor->GetValuePtrByPropertyNameInChain<UObject*>(STR("RootComponent"));
+    auto* rootCompPtr = Engine::GetValuePtr<UObject*>(actor, STR("RootComponent"));
     if (!rootCompPtr || !*rootCompPtr) return false;
     UObject* rootComp = *rootCompPtr;
 
-    auto* visiblePtr = rootComp->GetValuePtrByPropertyNameInChain<bool>(STR("bVisible"));
+    auto* visiblePtr = Engine::GetValuePtr<bool>(rootComp, STR("bVisible"));
     if (visiblePtr && !*visiblePtr) return true;
 
-    auto* hiddenPtr = rootComp->GetValuePtrByPropertyNameInChain<bool>(STR("bHiddenInGame"));
+    auto* hiddenPtr = Engine::GetValuePtr<bool>(rootComp, STR("bHiddenInGame"));
     if (hiddenPtr && *hiddenPtr) return true;
 
     return false;
 }
 
 // ============================================================
-// ScanLevel — full discovery of tetrominos
+// ScanLevel — full discovery of location actors
 // ============================================================
 
 void VisibilityManager::ScanLevel(ModState& state)
 {
-    m_tracked.clear();
-
-    std::vector<UObject*> items;
-    try {
-        UObjectGlobals::FindAllOf(STR("BP_TetrominoItem_C"), items);
-    }
-    catch (...) {
-        Output::send<LogLevel::Warning>(STR("[TalosAP] Visibility: FindAllOf BP_TetrominoItem_C failed\n"));
-        return;
-    }
-
-    if (items.empty()) {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP] Visibility: no tetromino items found in level\n"));
-        return;
-    }
+    m_tracked.Clear();
+    StarTraits::ResetProbe();
 
     int count = 0;
-    for (auto* item : items) {
-        if (!item) continue;
-
-        uint8_t type = 0, shape = 0;
-        int32_t number = 0;
-        if (!ReadInstanceInfo(item, type, shape, number)) continue;
-
-        std::string tetId = FormatTetrominoId(type, shape, number);
-        if (tetId.empty()) continue;
-
-        TrackedTetromino tt;
-        tt.id = tetId;
-        tt.hasPosition = ReadActorPosition(item, tt.x, tt.y, tt.z);
-
-        // Apply initial visibility
-        if (state.ShouldBeCollectable(tetId)) {
-            SetActorVisible(item);
-            tt.visRetries = VISIBILITY_RETRY_COUNT;
-        } else if (state.IsLocationChecked(tetId)) {
-            SetActorHidden(item);
+    TickMap<ItemId, UObject*> idToActor(&TickArena::Get());
+    m_tracked.Discover(m_scratchActors, [&](const LocationKindInfo& info, UObject* actor, const ItemId& id) {
+        TrackedLocation& loc = m_tracked.Track(id, info.kind);
+        loc.hasPosition = ReadActorPosition(actor, loc.x, loc.y, loc.z);
+        idToActor[id] = actor;
+
+        // Queue initial visibility; the first budget's worth runs below,
+        // the rest with the next enforcement passes
+        if (state.ShouldBeCollectable(id)) {
+            if (info.forceVisible) {
+                m_commands.Push(id, VisibilityOp::Show);
+                loc.visRetries = m_scanRetries;
+            }
+        } else if (state.IsLocationChecked(id) && info.hideWhenChecked) {
+            m_commands.Push(id, VisibilityOp::Hide);
         }
 
-        m_tracked[tetId] = tt;
         ++count;
+        return true;
+    });
+    m_tracked.RebuildIndex();
+
+    // The star class and property names are not in the header dump; say
+    // plainly when this level's star actors don't yield IDs.
+    if (const auto& probe = StarTraits::LastProbe(); probe.noCode > 0 || probe.unknownCode > 0) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] Visibility: {} {} actors, {} without a PuzzleCode, {} with an unmapped code\n"),
+            probe.actors, StarTraits::CLASS_NAME, probe.noCode, probe.unknownCode);
     }
 
-    Output::send<LogLevel::Verbose>(STR("[TalosAP] Visibility: scanned {} tetromino items\n"), count);
+    if (count == 0) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Visibility: no location actors found in level\n"));
+        return;
+    }
+
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] Visibility: scanned {} location actors ({} tetrominos, {} stars)\n"),
+        count, m_tracked.CountOf(LocationKind::Tetromino), m_tracked.CountOf(LocationKind::Star));
 
     // Log tracked items
-    for (const auto& [id, tt] : m_tracked) {
-        if (tt.hasPosition) {
+    for (const auto& [id, loc] : m_tracked) {
+        if (loc.hasPosition) {
             Output::send<LogLevel::Verbose>(STR("[TalosAP]   {} @ ({:.1f}, {:.1f}, {:.1f})\n"),
-                std::wstring(id.begin(), id.end()), tt.x, tt.y, tt.z);
+                Utf::ToWide(id), loc.x, loc.y, loc.z);
         } else {
             Output::send<LogLevel::Verbose>(STR("[TalosAP]   {} (no position)\n"),
-                std::wstring(id.begin(), id.end()));
+                Utf::ToWide(id));
         }
     }
 
     // Build fence map (tetId → LoweringFence actor) for this level
     BuildFenceMap();
+
+    float playerX = 0, playerY = 0, playerZ = 0;
+    bool havePlayer = GetPlayerPosition(playerX, playerY, playerZ);
+    ExecuteCommands(idToActor, havePlayer, playerX, playerY, playerZ);
 }
 
 // ============================================================
@@ -360,65 +326,52 @@ void VisibilityManager::RefreshVisibility(ModState& state)
     // Abort if the world is being torn down — UObjects may be zombies.
     if (!IsWorldValid()) return;
 
-    std::vector<UObject*> items;
-    try {
-        UObjectGlobals::FindAllOf(STR("BP_TetrominoItem_C"), items);
-    }
-    catch (...) {
-        return;
-    }
-
-    if (items.empty()) return;
-
-    // Rebuild tracked data, preserving reported state
-    std::unordered_map<std::string, TrackedTetromino> newTracked;
-
-    for (auto* item : items) {
-        if (!item) continue;
-
-        uint8_t type = 0, shape = 0;
-        int32_t number = 0;
-        if (!ReadInstanceInfo(item, type, shape, number)) continue;
-
-        std::string tetId = FormatTetrominoId(type, shape, number);
-        if (tetId.empty()) continue;
-
-        TrackedTetromino tt;
-        tt.id = tetId;
-        tt.hasPosition = ReadActorPosition(item, tt.x, tt.y, tt.z);
-
-        // Preserve existing tracking state
-        auto it = m_tracked.find(tetId);
-        if (it != m_tracked.end()) {
-            tt.reported = it->second.reported;
-            // If we failed to read position this time, keep old position
-            if (!tt.hasPosition && it->second.hasPosition) {
-                tt.x = it->second.x;
-                tt.y = it->second.y;
-                tt.z = it->second.z;
-                tt.hasPosition = true;
-            }
+    // Update tracked data in place, preserving reported state. Entries
+    // whose actor has gone are dropped after the pass.
+    TickMap<ItemId, UObject*> seen(&TickArena::Get());
+    seen.reserve(m_tracked.size());
+
+    m_tracked.Discover(m_scratchActors, [&](const LocationKindInfo& info, UObject* actor, const ItemId& id) {
+        TrackedLocation& loc = m_tracked.Track(id, info.kind);
+
+        // If we fail to read position this time, keep the old one
+        float x = 0, y = 0, z = 0;
+        if (ReadActorPosition(actor, x, y, z)) {
+            loc.x = x;
+            loc.y = y;
+            loc.z = z;
+            loc.hasPosition = true;
         }
+        loc.visRetries = 0;
 
-        // Apply visibility
-        if (state.ShouldBeCollectable(tetId)) {
-            if (!SetActorVisible(item)) {
-                Output::send<LogLevel::Warning>(STR("[TalosAP] RefreshVisibility: stale object detected, aborting pass\n"));
-                return; // World is tearing down — stop immediately
+        // Re-apply visibility where the actor has drifted from it, so a
+        // steady-state refresh queues nothing
+        if (state.ShouldBeCollectable(id)) {
+            if (info.forceVisible) {
+                if (IsActorHidden(actor)) m_commands.Push(id, VisibilityOp::Show);
+                loc.visRetries = m_refreshRetries;
             }
-            tt.visRetries = 10; // lighter retries on refresh (~0.17s)
-        } else if (state.IsLocationChecked(tetId)) {
+        } else if (state.IsLocationChecked(id) && info.hideWhenChecked) {
             // Already checked — hide regardless of grant state
-            if (!SetActorHidden(item)) {
-                Output::send<LogLevel::Warning>(STR("[TalosAP] RefreshVisibility: stale object detected, aborting pass\n"));
-                return;
-            }
+            if (!IsActorHidden(actor)) m_commands.Push(id, VisibilityOp::Hide);
         }
 
-        newTracked[tetId] = tt;
-    }
+        seen[id] = actor;
+        return true;
+    });
+
+    // Nothing found at all: keep the cache rather than emptying it.
+    if (seen.empty()) return;
+
+    m_tracked.EraseIf([&seen](const TrackedLocation& loc) {
+        return seen.find(loc.id) == seen.end();
+    });
+    m_tracked.RebuildIndex();
 
-    m_tracked = std::move(newTracked);
+    // This pass's actors are fresh; spend the tick's budget on them
+    float playerX = 0, playerY = 0, playerZ = 0;
+    bool havePlayer = GetPlayerPosition(playerX, playerY, playerZ);
+    ExecuteCommands(seen, havePlayer, playerX, playerY, playerZ);
 }
 
 // ============================================================
@@ -439,35 +392,17 @@ void VisibilityManager::EnforceVisibility(
 
     // Re-discover actors each enforcement tick so we have fresh UObject*.
     // This is necessary because Unreal GC can invalidate any cached pointer.
-    std::vector<UObject*> items;
-    try {
-        UObjectGlobals::FindAllOf(STR("BP_TetrominoItem_C"), items);
-    }
-    catch (...) {
-        return;
-    }
-
-    // Build a temporary ID → actor map for this tick
-    std::unordered_map<std::string, UObject*> idToActor;
-    for (auto* item : items) {
-        if (!item) continue;
-
-        uint8_t type = 0, shape = 0;
-        int32_t number = 0;
-        if (!ReadInstanceInfo(item, type, shape, number)) continue;
-
-        std::string tetId = FormatTetrominoId(type, shape, number);
-        if (!tetId.empty()) {
-            idToActor[tetId] = item;
-        }
-    }
-
-    // Get player position for proximity detection
-    float playerX = 0, playerY = 0, playerZ = 0;
-    bool hasPlayerPos = GetPlayerPosition(playerX, playerY, playerZ);
+    // Build a temporary ID → actor map for this tick.
+    TickMap<ItemId, UObject*> idToActor(&TickArena::Get());
+    idToActor.reserve(m_tracked.size());
+    m_tracked.Discover(m_scratchActors, [&](const LocationKindInfo&, UObject* actor, const ItemId& id) {
+        idToActor[id] = actor;
+        return true;
+    });
 
-    // Enforce visibility and detect proximity pickups
-    for (auto& [id, tt] : m_tracked) {
+    // Enforce visibility
+    for (auto& [id, loc] : m_tracked) {
+        const LocationKindInfo& info = Locations::Info(loc.kind);
         auto actorIt = idToActor.find(id);
         if (actorIt == idToActor.end()) continue;
 
@@ -478,60 +413,152 @@ void VisibilityManager::EnforceVisibility(
             // Only enforce visibility while retries remain — once they expire,
             // stop fighting the game so animations and collection work normally.
             // Retries are set at scan/refresh time, NOT reset here.
-            if (tt.visRetries > 0) {
-                if (IsActorHidden(actor)) {
-                    if (!SetActorVisible(actor)) {
-                        Output::send<LogLevel::Warning>(STR("[TalosAP] EnforceVisibility: stale object detected, aborting pass\n"));
-                        return; // World tearing down
-                    }
-                }
-                --tt.visRetries;
+            if (info.forceVisible && loc.visRetries > 0) {
+                if (IsActorHidden(actor)) m_commands.Push(id, VisibilityOp::Show);
+                --loc.visRetries;
             }
+        } else if (state.IsLocationChecked(id) && info.hideWhenChecked) {
+            // Location has been checked — hide the actor regardless of grant state.
+            // If granted to us: we already have it, no need to show the world item.
+            // If granted to another player: same, hide it.
+            // Already hidden needs no calls.
+            if (!IsActorHidden(actor)) m_commands.Push(id, VisibilityOp::Hide);
+        }
+    }
 
-            // Proximity pickup detection — only when item is confirmed visible.
-            // Without this guard, proximity fires on invisible items (e.g. items
-            // the game hid because they're in the CollectedTetrominos TMap).
-            if (hasPlayerPos && tt.hasPosition && !tt.reported && !IsActorHidden(actor)) {
-                float dx = playerX - tt.x;
-                float dy = playerY - tt.y;
-                float dz = playerZ - tt.z;
-                float distSq = dx * dx + dy * dy + dz * dz;
-
-                if (distSq < PICKUP_RADIUS_SQ) {
-                    Output::send<LogLevel::Verbose>(STR("[TalosAP] Proximity pickup: {} (dist={:.0f})\n"),
-                        std::wstring(id.begin(), id.end()), std::sqrt(distSq));
-
-                    tt.reported = true;
-                    if (!SetActorHidden(actor)) {
-                        Output::send<LogLevel::Warning>(STR("[TalosAP] EnforceVisibility: stale object on pickup hide, aborting pass\n"));
-                        return;
-                    }
-
-                    // Mark location as checked in state
-                    state.MarkLocationChecked(id);
+    // Proximity pickup detection — only the locations the spatial index
+    // puts within their kind's radius of the player.
+    float playerX = 0, playerY = 0, playerZ = 0;
+    if (!GetPlayerPosition(playerX, playerY, playerZ)) {
+        ExecuteCommands(idToActor, false, 0, 0, 0);
+        return;
+    }
 
-                    // Notify AP server
-                    if (locationCheckCallback) {
-                        int64_t locId = itemMapping.GetLocationId(id);
-                        if (locId >= 0) {
-                            locationCheckCallback(locId);
-                        }
-                    }
+    struct Nearby { TrackedLocation* loc; UObject* actor; float distSq; };
+    TickVector<Nearby> nearby(&TickArena::Get());
+    m_tracked.ForEachNear(playerX, playerY, playerZ, [&](TrackedLocation& loc, float distSq) {
+        if (loc.reported || !state.ShouldBeCollectable(loc.id)) return;
+        auto actorIt = idToActor.find(loc.id);
+        if (actorIt == idToActor.end()) return;
+        nearby.push_back({ &loc, actorIt->second, distSq });
+    });
+
+    for (const auto& [loc, actor, distSq] : nearby) {
+        const ItemId& id = loc->id;
+        const LocationKindInfo& info = Locations::Info(loc->kind);
+
+        bool hidden = IsActorHidden(actor);
+        if (info.reportWhenHidden) {
+            // The game collects these itself and hides the actor. Proximity
+            // alone is not a pickup: it must have been seen visible here
+            // and then been hidden while the player is still in range. One
+            // already hidden on arrival was collected on an earlier visit.
+            if (!hidden) {
+                loc->seenVisible = true;
+                continue;
+            }
+            if (!loc->seenVisible) continue;
+        } else if (hidden) {
+            // Only when the item is confirmed visible. Without this guard,
+            // proximity fires on invisible items (e.g. items the game hid
+            // because they're in the CollectedTetrominos TMap).
+            continue;
+        }
 
-                    // Open puzzle exit fence if one is mapped
-                    OpenFenceForTetromino(id);
-                }
+        Output::send<LogLevel::Verbose>(STR("[TalosAP] Proximity pickup: {} (dist={:.0f})\n"),
+            Utf::ToWide(id), std::sqrt(distSq));
+
+        loc->reported = true;
+        int64_t pickupNs = MonoNs();
+        TraceRecorder::Get().Instant("Pickup", "location", id.c_str());
+        // Hide now rather than queue behind the budget: the player is
+        // standing on it. Any pending Show for it is void. The calls still
+        // come out of this tick's budget so later passes defer instead.
+        if (info.hideWhenChecked) {
+            m_commands.Cancel(id);
+            if (SetActorHidden(actor)) {
+                ++m_pickupHides;
+                m_budgetLeft -= std::min(m_budgetLeft, static_cast<uint32_t>(CALLS_PER_COMMAND));
             }
-        } else if (state.IsLocationChecked(id)) {
-            // Location has been checked — hide the actor regardless of grant state.
-            // If granted to us: we already have it, no need to show the world item.
-            // If granted to another player: same, hide it.
-            if (!SetActorHidden(actor)) {
-                Output::send<LogLevel::Warning>(STR("[TalosAP] EnforceVisibility: stale object on checked hide, aborting pass\n"));
-                return;
+            else {
+                m_commands.Push(id, VisibilityOp::Hide);
             }
         }
+
+        // Mark location as checked in state
+        state.MarkLocationChecked(id);
+        StateExport::Get().Checked(id);
+
+        // Notify AP server
+        if (locationCheckCallback) {
+            int64_t locId = itemMapping.GetLocationId(id);
+            if (locId >= 0) {
+                LatencyStats::Get().Start(LatencyPath::CheckConfirm, id, pickupNs);
+                locationCheckCallback(locId);
+            }
+        }
+
+        // Open puzzle exit fence if one is mapped
+        if (info.opensFence && m_fenceMap.contains(id)) {
+            LatencyStats::Get().Start(LatencyPath::FenceOpen, id, pickupNs);
+            OpenFenceForTetromino(id);
+        }
+    }
+
+    ExecuteCommands(idToActor, true, playerX, playerY, playerZ);
+}
+
+// ============================================================
+// Visibility commands — run queued show/hide within the tick budget
+// ============================================================
+
+void VisibilityManager::ExecuteCommands(const TickMap<ItemId, UObject*>& actors,
+                                        bool havePlayer, float playerX, float playerY, float playerZ)
+{
+    if (m_commands.Empty()) return;
+    // An earlier pass this tick spent it all; the queue waits for the next
+    if (m_budgetLeft == 0) {
+        TraceRecorder::Get().Counter("VisibilityQueue", static_cast<int64_t>(m_commands.Size()));
+        return;
     }
+    TraceScope trace("VisibilityCommands", "phase");
+
+    uint32_t spent = m_commands.Execute(m_budgetLeft,
+        [&](const ItemId& id) {
+            // Unknown position sorts last
+            const TrackedLocation* loc = m_tracked.Find(id);
+            if (!havePlayer || !loc || !loc->hasPosition) return std::numeric_limits<float>::max();
+            float dx = loc->x - playerX, dy = loc->y - playerY, dz = loc->z - playerZ;
+            return dx * dx + dy * dy + dz * dz;
+        },
+        [&](const ItemId& id, VisibilityOp op) {
+            auto it = actors.find(id);
+            if (it == actors.end()) return 0;
+            bool ok = op == VisibilityOp::Show ? SetActorVisible(it->second) : SetActorHidden(it->second);
+            if (!ok) {
+                Output::send<LogLevel::Warning>(STR("[TalosAP] Visibility: stale object, deferring the rest to the next tick\n"));
+                return -1;
+            }
+            return CALLS_PER_COMMAND;
+        });
+    m_budgetLeft -= std::min(m_budgetLeft, spent);
+
+    TraceRecorder::Get().Counter("VisibilityQueue", static_cast<int64_t>(m_commands.Size()));
+}
+
+// ============================================================
+// ApplyTunables
+// ============================================================
+
+void VisibilityManager::ApplyTunables(const Tunables& t)
+{
+    m_callBudget        = static_cast<uint32_t>(t.visibility_call_budget);
+    m_budgetLeft        = std::min(m_budgetLeft, m_callBudget);
+    m_scanRetries       = t.scan_visibility_retries;
+    m_refreshRetries    = t.refresh_visibility_retries;
+    m_fenceOpenAttempts = t.fence_open_attempts;
+    m_fenceRetryMs      = static_cast<uint64_t>(t.fence_retry_ms);
+    m_tracked.SetPickupScale(t.pickup_radius_scale);
 }
 
 // ============================================================
@@ -540,10 +567,12 @@ void VisibilityManager::EnforceVisibility(
 
 void VisibilityManager::ResetCache()
 {
-    m_tracked.clear();
+    m_tracked.Clear();
+    m_commands.Clear();
     m_fenceMap.clear();
-    m_pendingFenceOpens.clear();
-    m_fnFenceOpen = nullptr;  // UFunction* may be stale after level transition
+    m_fenceActors.clear();
+    m_fenceActorsTick = 0;
+    s_fenceOpen.Reset();  // UFunction* may be stale after level transition
 }
 
 // ============================================================
@@ -552,14 +581,21 @@ void VisibilityManager::ResetCache()
 
 void VisibilityManager::DumpTracked() const
 {
-    Output::send<LogLevel::Verbose>(STR("[TalosAP] === Tracked Tetrominos ({}) ===\n"), m_tracked.size());
-    for (const auto& [id, tt] : m_tracked) {
-        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {} pos=({:.1f},{:.1f},{:.1f}) reported={} retries={}\n"),
-            std::wstring(id.begin(), id.end()),
-            tt.x, tt.y, tt.z,
-            tt.reported ? STR("yes") : STR("no"),
-            tt.visRetries);
-    }
+    Output::send<LogLevel::Verbose>(STR("[TalosAP] === Tracked Locations ({}) ===\n"), m_tracked.size());
+    for (const auto& [id, loc] : m_tracked) {
+        Output::send<LogLevel::Verbose>(STR("[TalosAP]   {} [{}] pos=({:.1f},{:.1f},{:.1f}) reported={} retries={}\n"),
+            Utf::ToWide(id),
+            Widen(Locations::Info(loc.kind).name),
+            loc.x, loc.y, loc.z,
+            loc.reported ? STR("yes") : STR("no"),
+            loc.visRetries);
+    }
+
+    const auto& vs = m_commands.GetStats();
+    Output::send<LogLevel::Verbose>(STR("[TalosAP]   visibility commands: queued={} pushed={} coalesced={} executed={} dropped={} "
+                                        "deferred passes={} calls={} peak={} budget={}/tick pickup hides={}\n"),
+        m_commands.Size(), vs.pushed, vs.coalesced, vs.executed, vs.dropped,
+        vs.deferred, vs.calls, vs.peakDepth, m_callBudget, m_pickupHides);
 }
 
 // ============================================================
@@ -574,16 +610,29 @@ void VisibilityManager::BuildFenceMap()
     int count = 0;
     int skipped = 0;
 
+    // Script classes can first appear with a level; check any offsets
+    // not yet compared against reflection.
+    GameLayoutEntry::VerifyAll();
+
+    using FenceScript   = GameOffsets::LoweringFenceWhenTetrominoIsPickedUpBaseScript;
+    using ScriptVarInfo = GameOffsets::TalosOneScriptVariableInfo;
+    using EntityPointer = GameOffsets::TalosOneEntityPointerInfo;
+    using Eclipse       = GameOffsets::EclipseScript;
+
     // ----------------------------------------------------------------
     // Source 1: LoweringFenceWhenTetrominoIsPickedUp(Base)Script
-    //   Layout: Tetromino @ 0x0330, LoweringFence @ 0x0388
+    //   Layout: Tetromino, LoweringFence (GameOffsets.h)
     // ----------------------------------------------------------------
     {
-        std::vector<UObject*> scripts;
-        try { UObjectGlobals::FindAllOf(STR("LoweringFenceWhenTetrominoIsPickedUpBaseScript"), scripts); } catch (...) {}
+        // All fence actors, fetched on first EntityPointers fallback
+        TickVector<UObject*> allFences(&TickArena::Get());
+        bool allFencesLoaded = false;
+
+        TickVector<UObject*> scripts(&TickArena::Get());
+        try { FindAllOnArena(STR("LoweringFenceWhenTetrominoIsPickedUpBaseScript"), scripts); } catch (...) {}
         try {
-            std::vector<UObject*> derived;
-            UObjectGlobals::FindAllOf(STR("LoweringFenceWhenTetrominoIsPickedUpScript"), derived);
+            TickVector<UObject*> derived(&TickArena::Get());
+            FindAllOnArena(STR("LoweringFenceWhenTetrominoIsPickedUpScript"), derived);
             for (auto* s : derived) {
                 bool dup = false;
                 for (auto* e : scripts) { if (e == s) { dup = true; break; } }
@@ -596,69 +645,65 @@ void VisibilityManager::BuildFenceMap()
         for (auto* script : scripts) {
             if (!script) continue;
             try {
-                uint8_t* base = reinterpret_cast<uint8_t*>(script);
-                UObject* tet   = *reinterpret_cast<UObject**>(base + 0x0330);
-                UObject* fence = *reinterpret_cast<UObject**>(base + 0x0388);
+                UObject* tet   = FenceScript::Tetromino.In(script);
+                UObject* fence = FenceScript::LoweringFence.In(script);
 
                 // Property-name fallback
                 if (!tet || !fence) {
-                    auto* tp = script->GetValuePtrByPropertyNameInChain<UObject*>(STR("Tetromino"));
+                    auto* tp = Engine::GetValuePtr<UObject*>(script, STR("Tetromino"));
                     if (tp && *tp) tet = *tp;
-                    auto* fp = script->GetValuePtrByPropertyNameInChain<UObject*>(STR("LoweringFence"));
+                    auto* fp = Engine::GetValuePtr<UObject*>(script, STR("LoweringFence"));
                     if (fp && *fp) fence = *fp;
                 }
 
                 if (!tet) { ++skipped; continue; }
 
                 // Read tetromino ID early for logging
-                uint8_t type = 0, shape = 0; int32_t number = 0;
-                if (!ReadInstanceInfo(tet, type, shape, number)) { ++skipped; continue; }
-                std::string tetId = FormatTetrominoId(type, shape, number);
+                ItemId tetId = TetrominoTraits::ReadId(tet);
                 if (tetId.empty()) { ++skipped; continue; }
 
                 // ---------------------------------------------------------
-                // EntityPointers fallback: when offset 0x0388 is null,
+                // EntityPointers fallback: when LoweringFence is null,
                 // the AngelScript runtime did not resolve the entity ref.
                 // Read the EntityPointers TArray inside LoweringFenceInfo
-                // to get EntityIDs, then match against fence actors' Tags.
-                //
-                // LoweringFenceInfo starts at 0x0338 (FTalosOneScriptVariableInfo):
-                //   +0x40 = 0x0378: TArray<FTalosOneEntityPointerInfo> EntityPointers
-                //     TArray layout: Data*(8) + Num(4) + Max(4)
-                //   Each FTalosOneEntityPointerInfo (0x28 bytes):
-                //     +0x00: FString ClassName  (0x10)
-                //     +0x10: int32   EntityID   (0x04)
-                //     +0x18: FString EntityName (0x10)
+                // (FTalosOneScriptVariableInfo) to get EntityIDs, then
+                // match against fence actors' Tags.
                 // ---------------------------------------------------------
                 if (!fence) {
-                    uint8_t* epData = *reinterpret_cast<uint8_t**>(base + 0x0378);
-                    int32_t  epNum  = *reinterpret_cast<int32_t*>(base + 0x0380);
+                    const RawArray& entityPointers =
+                        ScriptVarInfo::EntityPointers.In(FenceScript::LoweringFenceInfo.Ptr(script));
+                    uint8_t* epData = entityPointers.Data;
+                    int32_t  epNum  = entityPointers.Num;
+                    const size_t epStride = EntityPointer::SIZE.Get();
 
                     if (epData && epNum > 0 && epNum < 100) {
                         Output::send<LogLevel::Verbose>(
                             STR("[TalosAP] FenceMap: {} — fence null, resolving via {} EntityPointers\n"),
-                            std::wstring(tetId.begin(), tetId.end()), epNum);
+                            Utf::ToWide(tetId), epNum);
 
                         // Collect EntityIDs from the array
-                        std::vector<int32_t> entityIds;
+                        TickVector<int32_t> entityIds(&TickArena::Get());
+                        entityIds.reserve(epNum);
                         for (int32_t i = 0; i < epNum; i++) {
-                            uint8_t* entry = epData + i * 0x28;
-                            int32_t eid = *reinterpret_cast<int32_t*>(entry + 0x10);
+                            uint8_t* entry = epData + i * epStride;
+                            int32_t eid = EntityPointer::EntityID.In(entry);
                             entityIds.push_back(eid);
                             Output::send<LogLevel::Verbose>(
                                 STR("[TalosAP]   EntityPointers[{}]: EntityID={}\n"), i, eid);
                         }
 
                         // Find matching fence by EntityID in Tags
-                        std::vector<UObject*> allFences;
-                        try { UObjectGlobals::FindAllOf(STR("BP_LoweringFence_C"), allFences); } catch (...) {}
+                        if (!allFencesLoaded) {
+                            allFencesLoaded = true;
+                            try { FindAllOnArena(STR("BP_LoweringFence_C"), allFences); } catch (...) {}
+                        }
 
                         for (auto* candidate : allFences) {
                             if (!candidate || fence) continue;
                             try {
                                 // AActor::Tags is TArray<FName>
                                 // With case-preserving names, sizeof(FName) = 12
-                                auto* tagsRaw = candidate->GetValuePtrByPropertyNameInChain<uint8_t>(STR("Tags"));
+                                auto* tagsRaw = Engine::GetValuePtr<uint8_t>(candidate, STR("Tags"));
                                 if (!tagsRaw) continue;
 
                                 uint8_t* tagData = *reinterpret_cast<uint8_t**>(tagsRaw);
@@ -685,8 +730,8 @@ void VisibilityManager::BuildFenceMap()
                                                 fence = candidate;
                                                 Output::send<LogLevel::Verbose>(
                                                     STR("[TalosAP] FenceMap: {} — resolved via EntityID {} tag: {}\n"),
-                                                    std::wstring(tetId.begin(), tetId.end()), feid,
-                                                    candidate->GetFullName());
+                                                    Utf::ToWide(tetId), feid,
+                                                    Engine::GetFullName(candidate));
                                                 break;
                                             }
                                         }
@@ -699,28 +744,28 @@ void VisibilityManager::BuildFenceMap()
                     if (!fence) {
                         Output::send<LogLevel::Warning>(
                             STR("[TalosAP] FenceMap: {} — could not resolve fence, skipped\n"),
-                            std::wstring(tetId.begin(), tetId.end()));
+                            Utf::ToWide(tetId));
                         ++skipped;
                         continue;
                     }
                 }
 
-                m_fenceMap[tetId] = fence->GetFullName();
+                m_fenceMap[tetId] = Engine::GetFullName(fence);
                 ++count;
                 Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: {} -> {}\n"),
-                    std::wstring(tetId.begin(), tetId.end()), fence->GetFullName());
+                    Utf::ToWide(tetId), Engine::GetFullName(fence));
             } catch (...) { ++skipped; }
         }
     }
 
     // ----------------------------------------------------------------
     // Source 2: EclipseScript
-    //   Layout: Tetromino @ 0x02E0, Fence @ 0x02E8
+    //   Layout: Tetromino, Fence (GameOffsets.h)
     //   Some levels use this class instead of LoweringFenceWhenTetromino
     // ----------------------------------------------------------------
     {
-        std::vector<UObject*> eclipses;
-        try { UObjectGlobals::FindAllOf(STR("EclipseScript"), eclipses); } catch (...) {}
+        TickVector<UObject*> eclipses(&TickArena::Get());
+        try { FindAllOnArena(STR("EclipseScript"), eclipses); } catch (...) {}
 
         if (!eclipses.empty()) {
             Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: {} EclipseScript actors\n"), eclipses.size());
@@ -729,41 +774,37 @@ void VisibilityManager::BuildFenceMap()
         for (auto* script : eclipses) {
             if (!script) continue;
             try {
-                uint8_t* base = reinterpret_cast<uint8_t*>(script);
-                UObject* tet   = *reinterpret_cast<UObject**>(base + 0x02E0);
-                UObject* fence = *reinterpret_cast<UObject**>(base + 0x02E8);
+                UObject* tet   = Eclipse::Tetromino.In(script);
+                UObject* fence = Eclipse::Fence.In(script);
 
                 // Property-name fallback
                 if (!tet || !fence) {
-                    auto* tp = script->GetValuePtrByPropertyNameInChain<UObject*>(STR("Tetromino"));
+                    auto* tp = Engine::GetValuePtr<UObject*>(script, STR("Tetromino"));
                     if (tp && *tp) tet = *tp;
-                    auto* fp = script->GetValuePtrByPropertyNameInChain<UObject*>(STR("Fence"));
+                    auto* fp = Engine::GetValuePtr<UObject*>(script, STR("Fence"));
                     if (fp && *fp) fence = *fp;
                 }
 
                 if (!tet) { ++skipped; continue; }
                 if (!fence) {
-                    uint8_t t = 0, s = 0; int32_t n = 0;
-                    std::string id = "(unknown)";
-                    if (ReadInstanceInfo(tet, t, s, n)) id = FormatTetrominoId(t, s, n);
+                    ItemId id = TetrominoTraits::ReadId(tet);
+                    if (id.empty()) id = "(unknown)";
                     Output::send<LogLevel::Warning>(
                         STR("[TalosAP] FenceMap: EclipseScript for {} — fence ptr null, skipped\n"),
-                        std::wstring(id.begin(), id.end()));
+                        Utf::ToWide(id));
                     ++skipped;
                     continue;
                 }
 
-                uint8_t type = 0, shape = 0; int32_t number = 0;
-                if (!ReadInstanceInfo(tet, type, shape, number)) { ++skipped; continue; }
-                std::string tetId = FormatTetrominoId(type, shape, number);
+                ItemId tetId = TetrominoTraits::ReadId(tet);
                 if (tetId.empty()) { ++skipped; continue; }
 
                 // Don't overwrite if LoweringFenceWhenTetromino already found it
                 if (m_fenceMap.find(tetId) == m_fenceMap.end()) {
-                    m_fenceMap[tetId] = fence->GetFullName();
+                    m_fenceMap[tetId] = Engine::GetFullName(fence);
                     ++count;
                     Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: {} -> {} (via EclipseScript)\n"),
-                        std::wstring(tetId.begin(), tetId.end()), fence->GetFullName());
+                        Utf::ToWide(tetId), Engine::GetFullName(fence));
                 }
             } catch (...) { ++skipped; }
         }
@@ -772,101 +813,137 @@ void VisibilityManager::BuildFenceMap()
     Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: {} entries built, {} skipped\n"), count, skipped);
 }
 
+void VisibilityManager::FindAllOnArena(const wchar_t* className, TickVector<UObject*>& out,
+                                       const std::source_location& loc)
+{
+    m_scratchActors.clear();
+    Engine::FindAllOf(className, m_scratchActors, loc);
+    out.assign(m_scratchActors.begin(), m_scratchActors.end());
+}
+
 // ============================================================
-// OpenFenceForTetromino — queue a fence open for the given tetromino
+// OpenFenceForTetromino — start a fence open for the given tetromino
 // ============================================================
 
-void VisibilityManager::OpenFenceForTetromino(const std::string& tetId)
+void VisibilityManager::OpenFenceForTetromino(const ItemId& tetId)
 {
     auto it = m_fenceMap.find(tetId);
     if (it == m_fenceMap.end()) return;
 
-    PendingFenceOpen entry;
-    entry.tetId = tetId;
-    entry.fenceFullName = it->second;
-    entry.attempts = 0;
-    m_pendingFenceOpens.push_back(entry);
+    // Level-scoped: a level transition cancels it along with the map.
+    TaskScheduler::Get().Spawn(OpenFenceTask(tetId, it->second), TaskGroup::Level, "FenceOpen");
 
     Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: queued fence open for {}\n"),
-        std::wstring(tetId.begin(), tetId.end()));
+        Utf::ToWide(tetId));
 }
 
 // ============================================================
-// ProcessPendingFenceOpens — retry loop for fence::Open()
-// Called every ~6 ticks (~100ms at 60fps) from on_update.
+// OpenFenceTask — retry loop for fence::Open()
 // ============================================================
 
-void VisibilityManager::ProcessPendingFenceOpens()
+GameTask VisibilityManager::OpenFenceTask(ItemId tetId, std::wstring fenceFullName)
 {
-    if (m_pendingFenceOpens.empty()) return;
+    // Also drops the pickup stamp if the task ends (gave up, stale world,
+    // level unload) without opening the fence.
+    struct InFlight {
+        size_t& n;
+        const ItemId& id;
+        InFlight(size_t& c, const ItemId& i) : n(c), id(i) { ++n; }
+        ~InFlight()
+        {
+            --n;
+            LatencyStats::Get().Cancel(LatencyPath::FenceOpen, id);
+        }
+    } inFlight{ m_fenceOpensInFlight, tetId };
 
-    // Abort if the world is being torn down.
-    if (!IsWorldValid()) return;
+    int attempts = 0;
+    while (attempts < m_fenceOpenAttempts) {
+        co_await WorldReady();
 
-    // Cache the ALoweringFence::Open UFunction on first use
-    if (!m_fnFenceOpen) {
-        try {
-            m_fnFenceOpen = UObjectGlobals::StaticFindObject<UFunction*>(
-                nullptr, nullptr, STR("/Script/Angelscript.LoweringFence:Open"));
+        FenceOpenResult result;
+        {
+            TraceScope t("FenceOpen", "phase", tetId.c_str());
+            PhaseTimer pt(MetricPhase::FenceOpens);
+            result = TryOpenFence(tetId, fenceFullName);
         }
-        catch (...) {}
 
-        if (!m_fnFenceOpen) {
-            Output::send<LogLevel::Warning>(STR("[TalosAP] FenceMap: could not find LoweringFence::Open UFunction\n"));
-            // Don't clear the queue — we'll retry next tick
-            return;
+        switch (result) {
+            case FenceOpenResult::Opened:
+                LatencyStats::Get().Finish(LatencyPath::FenceOpen, tetId);
+                TraceRecorder::Get().Instant("FenceOpen", "location", tetId.c_str());
+                StateExport::Get().FenceOpened(tetId);
+                Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: opened fence for {} (attempt {})\n"),
+                    Utf::ToWide(tetId), attempts + 1);
+                co_return;
+
+            case FenceOpenResult::Stale:
+                // Don't retry — world is likely tearing down
+                co_return;
+
+            case FenceOpenResult::Unresolved:
+                // No world or no UFunction yet — doesn't count as an attempt
+                break;
+
+            case FenceOpenResult::NotFound:
+                ++attempts;
+                if (attempts < m_fenceOpenAttempts) {
+                    Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: retry {}/{} for {}\n"),
+                        attempts, m_fenceOpenAttempts, Utf::ToWide(tetId));
+                }
+                break;
         }
-    }
 
-    std::deque<PendingFenceOpen> remaining;
+        co_await After(m_fenceRetryMs);
+    }
 
-    for (auto& entry : m_pendingFenceOpens) {
-        bool opened = false;
+    Output::send<LogLevel::Warning>(STR("[TalosAP] FenceMap: gave up opening fence for {} after {} attempts\n"),
+        Utf::ToWide(tetId), attempts);
+}
 
+VisibilityManager::FenceOpenResult VisibilityManager::TryOpenFence(const ItemId& tetId, const std::wstring& fenceFullName)
+{
+    // Not an attempt if the world is being torn down.
+    if (!IsWorldValid()) return FenceOpenResult::Unresolved;
+
+    // Resolve ALoweringFence::Open on first use after each level load
+    if (!s_fenceOpen.Resolve(true)) {
+        Output::send<LogLevel::Warning>(STR("[TalosAP] FenceMap: could not find LoweringFence::Open UFunction\n"));
+        return FenceOpenResult::Unresolved;
+    }
+
+    // Re-discover the fence actors by iterating all LoweringFence instances
+    // and matching by full name. This avoids caching stale UObject*.
+    // One FindAllOf per tick, shared by every fence task resuming in it.
+    uint64_t tick = TaskScheduler::Get().TickCount();
+    if (m_fenceActorsTick != tick) {
+        m_fenceActorsTick = tick;
+        m_fenceActors.clear();
         try {
-            // Re-discover the fence actor by iterating all LoweringFence instances
-            // and matching by full name. This avoids caching stale UObject*.
-            std::vector<UObject*> fences;
-            UObjectGlobals::FindAllOf(STR("LoweringFence"), fences);
-
-            for (auto* fence : fences) {
-                if (!fence) continue;
-                try {
-                    if (fence->GetFullName() == entry.fenceFullName) {
-                        if (!SafeProcessEvent(fence, m_fnFenceOpen, nullptr)) {
-                            Output::send<LogLevel::Warning>(
-                                STR("[TalosAP] FenceMap: ProcessEvent(Open) caught stale object for {}\n"),
-                                std::wstring(entry.tetId.begin(), entry.tetId.end()));
-                            // Don't retry — world is likely tearing down
-                            return;
-                        }
-                        opened = true;
-                        break;
-                    }
-                }
-                catch (...) {}
-            }
+            Engine::FindAllOf(STR("LoweringFence"), m_fenceActors);
         }
         catch (...) {}
+    }
 
-        if (opened) {
-            Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: opened fence for {} (attempt {})\n"),
-                std::wstring(entry.tetId.begin(), entry.tetId.end()),
-                entry.attempts + 1);
-        } else {
-            ++entry.attempts;
-            if (entry.attempts < 10) {
-                remaining.push_back(entry);
-                Output::send<LogLevel::Verbose>(STR("[TalosAP] FenceMap: retry {}/10 for {}\n"),
-                    entry.attempts, std::wstring(entry.tetId.begin(), entry.tetId.end()));
-            } else {
-                Output::send<LogLevel::Warning>(STR("[TalosAP] FenceMap: gave up opening fence for {} after 10 attempts\n"),
-                    std::wstring(entry.tetId.begin(), entry.tetId.end()));
+    try {
+        for (auto* fence : m_fenceActors) {
+            if (!fence) continue;
+            try {
+                if (Engine::GetFullName(fence) == fenceFullName) {
+                    if (!SafeProcessEvent(fence, s_fenceOpen.Function(), nullptr, s_fenceOpen.Label())) {
+                        Output::send<LogLevel::Warning>(
+                            STR("[TalosAP] FenceMap: ProcessEvent(Open) caught stale object for {}\n"),
+                            Utf::ToWide(tetId));
+                        return FenceOpenResult::Stale;
+                    }
+                    return FenceOpenResult::Opened;
+                }
             }
+            catch (...) {}
         }
     }
+    catch (...) {}
 
-    m_pendingFenceOpens = std::move(remaining);
+    return FenceOpenResult::NotFound;
 }
 
 // ============================================================
@@ -878,7 +955,7 @@ void VisibilityManager::DumpFenceMap() const
     Output::send<LogLevel::Verbose>(STR("[TalosAP] === FenceMap ({}) ===\n"), m_fenceMap.size());
     for (const auto& [tetId, fenceName] : m_fenceMap) {
         Output::send<LogLevel::Verbose>(STR("[TalosAP]   {} -> {}\n"),
-            std::wstring(tetId.begin(), tetId.end()), fenceName);
+            Utf::ToWide(tetId), fenceName);
     }
 }
 
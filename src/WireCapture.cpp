@@ -0,0 +1,222 @@
+#include "headers/WireCapture.h"
+
+#include <cstring>
+
+#ifdef TALOSAP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace TalosAP {
+
+namespace {
+
+struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t startUnixMs;
+};
+static_assert(sizeof(FileHeader) == 24);
+
+struct RecordHeader {
+    uint64_t timeUs;
+    uint8_t  direction;
+    uint8_t  reserved[3];
+    uint32_t length;
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+} // namespace
+
+// ============================================================
+// WireCapture
+// ============================================================
+
+WireCapture::~WireCapture()
+{
+    Close();
+}
+
+bool WireCapture::Open(const std::string& path)
+{
+    Close();
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.startUnixMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+#ifdef TALOSAP_HAVE_ZLIB
+    // Level 1: the session thread pays for it, and AP JSON compresses
+    // well even at the fastest setting.
+    gzFile gz = gzopen(path.c_str(), "wb1");
+    if (!gz) return false;
+    gzbuffer(gz, 64 * 1024);
+    m_file = gz;
+    header.flags = FLAG_GZIP;
+#else
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    m_file = f;
+#endif
+
+    m_start   = std::chrono::steady_clock::now();
+    m_records = 0;
+    m_bytes   = 0;
+    if (!Write(&header, sizeof(header))) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void WireCapture::Close()
+{
+    if (!m_file) return;
+#ifdef TALOSAP_HAVE_ZLIB
+    gzclose(static_cast<gzFile>(m_file));
+#else
+    std::fclose(static_cast<FILE*>(m_file));
+#endif
+    m_file = nullptr;
+    m_dirty = false;
+}
+
+bool WireCapture::Write(const void* data, size_t size)
+{
+#ifdef TALOSAP_HAVE_ZLIB
+    return gzwrite(static_cast<gzFile>(m_file), data, static_cast<unsigned>(size)) == static_cast<int>(size);
+#else
+    return std::fwrite(data, 1, size, static_cast<FILE*>(m_file)) == size;
+#endif
+}
+
+void WireCapture::Record(WireDirection direction, std::string_view packet)
+{
+    if (!m_file || packet.size() > MAX_PACKET) return;
+
+    RecordHeader rec{};
+    rec.timeUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+    rec.direction = static_cast<uint8_t>(direction);
+    rec.length = static_cast<uint32_t>(packet.size());
+
+    if (!Write(&rec, sizeof(rec)) || !Write(packet.data(), packet.size())) {
+        // Disk full or the file went away: stop rather than write a
+        // capture with holes in it.
+        Close();
+        return;
+    }
+    ++m_records;
+    m_bytes += packet.size();
+    m_dirty = true;
+}
+
+void WireCapture::Flush()
+{
+    if (!m_file || !m_dirty) return;
+#ifdef TALOSAP_HAVE_ZLIB
+    gzflush(static_cast<gzFile>(m_file), Z_SYNC_FLUSH);
+#else
+    std::fflush(static_cast<FILE*>(m_file));
+#endif
+    m_dirty = false;
+}
+
+// ============================================================
+// WireCaptureReader
+// ============================================================
+
+WireCaptureReader::~WireCaptureReader()
+{
+    Close();
+}
+
+bool WireCaptureReader::Open(const std::string& path)
+{
+    Close();
+    m_error.clear();
+
+#ifdef TALOSAP_HAVE_ZLIB
+    // gzread passes uncompressed files through unchanged.
+    gzFile gz = gzopen(path.c_str(), "rb");
+    if (!gz) { m_error = "cannot open " + path; return false; }
+    gzbuffer(gz, 256 * 1024);
+    m_file = gz;
+#else
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) { m_error = "cannot open " + path; return false; }
+    m_file = f;
+#endif
+
+    FileHeader header{};
+    if (!Read(&header, sizeof(header))) {
+        m_error = "file too short for a capture header";
+        Close();
+        return false;
+    }
+    if (std::memcmp(header.magic, WireCapture::MAGIC, sizeof(header.magic)) != 0) {
+#ifndef TALOSAP_HAVE_ZLIB
+        if (static_cast<uint8_t>(header.magic[0]) == 0x1f && static_cast<uint8_t>(header.magic[1]) == 0x8b) {
+            m_error = "capture is gzip-compressed; this build has no zlib";
+            Close();
+            return false;
+        }
+#endif
+        m_error = "not a wire capture";
+        Close();
+        return false;
+    }
+    if (header.version != WireCapture::VERSION) {
+        m_error = "unsupported capture version " + std::to_string(header.version);
+        Close();
+        return false;
+    }
+    m_flags = header.flags;
+    m_startUnixMs = header.startUnixMs;
+    return true;
+}
+
+void WireCaptureReader::Close()
+{
+    if (!m_file) return;
+#ifdef TALOSAP_HAVE_ZLIB
+    gzclose(static_cast<gzFile>(m_file));
+#else
+    std::fclose(static_cast<FILE*>(m_file));
+#endif
+    m_file = nullptr;
+}
+
+bool WireCaptureReader::Read(void* data, size_t size)
+{
+#ifdef TALOSAP_HAVE_ZLIB
+    return gzread(static_cast<gzFile>(m_file), data, static_cast<unsigned>(size)) == static_cast<int>(size);
+#else
+    return std::fread(data, 1, size, static_cast<FILE*>(m_file)) == size;
+#endif
+}
+
+bool WireCaptureReader::Next(WireRecord& out)
+{
+    if (!m_file) return false;
+
+    RecordHeader rec{};
+    if (!Read(&rec, sizeof(rec))) return false;        // clean end (or a torn header)
+    if (rec.direction > static_cast<uint8_t>(WireDirection::Outbound) || rec.length > WireCapture::MAX_PACKET) {
+        m_error = "corrupt record";
+        return false;
+    }
+
+    out.timeUs = rec.timeUs;
+    out.direction = static_cast<WireDirection>(rec.direction);
+    out.packet.resize(rec.length);
+    if (rec.length && !Read(out.packet.data(), rec.length)) {
+        m_error = "truncated record";
+        return false;
+    }
+    return true;
+}
+
+} // namespace TalosAP
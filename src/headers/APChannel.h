@@ -0,0 +1,292 @@
+#pragma once
+
+#include "SpscRing.h"
+#include "HudTypes.h"
+#include "FixedString.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TalosAP {
+
+/// The link between the AP session (network side) and the mod's game
+/// thread: one shared block holding a control area and two SPSC rings.
+///
+///   Control   connection settings, published AP state, heartbeat, stop flag
+///   ToMod     session -> game thread: pre-resolved events (grants, confirmed
+///             locations, HUD lines, log lines)
+///   ToSession game thread -> session: location checks, goal
+///
+/// The session runs either on a thread inside the game or in the
+/// TalosAPHelper process; the block is a named shared-memory object in
+/// both cases, so the game thread's side is identical. Payloads are
+/// plain little-endian PODs and wchar_t text, so both ends must be the
+/// same build (VERSION and wchar_t size are checked).
+namespace APChannel {
+
+inline constexpr uint32_t MAGIC   = 0x48504154; // 'TAPH'
+inline constexpr uint32_t VERSION = 6;
+
+inline constexpr uint32_t TO_MOD_CAPACITY     = 256 * 1024;
+inline constexpr uint32_t TO_SESSION_CAPACITY = 64 * 1024;
+
+/// Largest encoded record; longer HUD lines are truncated.
+inline constexpr size_t MAX_RECORD = 4096;
+
+/// Mirrors apclientpp's APClient::State.
+enum class LinkState : uint32_t {
+    Disconnected, SocketConnecting, SocketConnected, RoomInfo, SlotConnected,
+};
+
+/// ConnectInfo::flags
+inline constexpr uint32_t CONNECT_WIRE_CAPTURE = 1u << 0;   ///< record AP packets (WireCapture.h)
+
+struct ConnectInfo {
+    char server[256];
+    char slot[128];
+    char password[128];
+    char game[128];
+    uint32_t flags;
+};
+
+struct Control {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t wcharSize;
+    uint32_t modPid;
+    ConnectInfo connect;                      ///< UTF-8, written before the session starts
+
+    std::atomic<uint32_t> sessionPid;         ///< 0 = in-process
+    std::atomic<uint32_t> linkState;          ///< LinkState
+    std::atomic<uint64_t> heartbeat;          ///< bumped every session loop
+    std::atomic<int32_t>  nextItemIndex;      ///< next ReceivedItems index expected
+    std::atomic<uint32_t> stop;               ///< set by the mod on shutdown
+};
+
+inline constexpr size_t CONTROL_BYTES = (sizeof(Control) + 4095) & ~size_t(4095);
+inline constexpr size_t TO_MOD_OFFSET = CONTROL_BYTES;
+inline constexpr size_t TO_SESSION_OFFSET = TO_MOD_OFFSET + SpscRing::BytesFor(TO_MOD_CAPACITY);
+inline constexpr size_t TOTAL_BYTES = TO_SESSION_OFFSET + SpscRing::BytesFor(TO_SESSION_CAPACITY);
+
+/// Shared-memory name for the game process `pid`.
+inline std::wstring NameFor(uint32_t pid)
+{
+    return L"TalosAP.Channel." + std::to_wstring(pid);
+}
+
+/// Typed views over a mapped block.
+struct View {
+    Control* control = nullptr;
+    SpscRing toMod;
+    SpscRing toSession;
+
+    bool Valid() const { return control && toMod.Valid() && toSession.Valid(); }
+};
+
+/// Lay out a fresh block (mod side).
+inline View Create(void* block, uint32_t modPid)
+{
+    auto* bytes = static_cast<uint8_t*>(block);
+    auto* c = new (bytes) Control{};
+    c->magic     = MAGIC;
+    c->version   = VERSION;
+    c->wcharSize = sizeof(wchar_t);
+    c->modPid    = modPid;
+    View v;
+    v.control   = c;
+    v.toMod     = SpscRing::Create(bytes + TO_MOD_OFFSET, TO_MOD_CAPACITY);
+    v.toSession = SpscRing::Create(bytes + TO_SESSION_OFFSET, TO_SESSION_CAPACITY);
+    return v;
+}
+
+/// Attach to a block the mod created (helper side). Invalid on any mismatch.
+inline View Attach(void* block)
+{
+    auto* bytes = static_cast<uint8_t*>(block);
+    auto* c = reinterpret_cast<Control*>(bytes);
+    View v;
+    if (!c || c->magic != MAGIC || c->version != VERSION || c->wcharSize != sizeof(wchar_t)) return v;
+    v.control   = c;
+    v.toMod     = SpscRing::Attach(bytes + TO_MOD_OFFSET);
+    v.toSession = SpscRing::Attach(bytes + TO_SESSION_OFFSET);
+    return v;
+}
+
+// ============================================================
+// Record types
+// ============================================================
+
+/// Session -> game thread.
+enum class Event : uint16_t {
+    Log,                 ///< u8 level, text          (helper only; in-process logs directly)
+    SocketConnected,     ///< i64 monoNs
+    SocketDisconnected,  ///< —
+    SlotConnected,       ///< i32 slot, i32 team, i8 reusable (-1 unset), u8 resumed, i32 keptItems
+    SlotRefused,         ///< text
+    LocationConfirmed,   ///< id, i64 monoNs
+    Grant,               ///< id, i64 monoNs
+    ItemsDone,           ///< i32 granted, i32 other, i32 replayed
+    Notify,              ///< u8 chat, line (see PutLine)
+    Scouted,             ///< id, i32 flags, text item, text player (what a location holds)
+    ServerRtt,           ///< i64 ns (Bounce round trip)
+};
+
+// monoNs fields are MonoNs() (Latency.h) when the session handled the
+// packet; the game thread diffs them against its own clock.
+
+/// Game thread -> session.
+enum class Command : uint16_t {
+    LocationChecks,      ///< u32 count, count x i64
+    Goal,                ///< —
+};
+
+/// Log levels carried by Event::Log.
+enum class LogKind : uint8_t { Verbose, Warning, Error };
+
+// ============================================================
+// Encoding
+// ============================================================
+
+/// Builds one record payload in a fixed buffer. Text is a u16 unit count
+/// followed by wchar_t units; anything past MAX_RECORD is cut off.
+class Writer {
+public:
+    template <typename T>
+    void Put(const T& v)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (m_size + sizeof(T) > MAX_RECORD) { m_truncated = true; return; }
+        std::memcpy(m_buf + m_size, &v, sizeof(T));
+        m_size += sizeof(T);
+    }
+
+    void PutText(std::wstring_view s)
+    {
+        size_t room = (MAX_RECORD - m_size > sizeof(uint16_t)) ? (MAX_RECORD - m_size - sizeof(uint16_t)) / sizeof(wchar_t) : 0;
+        size_t n = s.size() < room ? s.size() : room;
+        if (n > 0xFFFF) n = 0xFFFF;
+        if (n < s.size()) m_truncated = true;
+        Put(static_cast<uint16_t>(n));
+        if (n && m_size + n * sizeof(wchar_t) <= MAX_RECORD) {
+            std::memcpy(m_buf + m_size, s.data(), n * sizeof(wchar_t));
+            m_size += n * sizeof(wchar_t);
+        }
+    }
+
+    /// A HudLine: u16 count, count x (LinearColor, u16 length), then the
+    /// whole line's text once. Segment offsets are implied by the order.
+    void PutLine(const HudLine& line)
+    {
+        const auto& segments = line.Segments();
+        Put(static_cast<uint16_t>(segments.size()));
+        for (const auto& seg : segments) {
+            Put(seg.color);
+            Put(static_cast<uint16_t>(seg.length > 0xFFFF ? 0xFFFF : seg.length));
+        }
+        PutText(line.Text());
+    }
+
+    void PutId(const ItemId& id)
+    {
+        Put(static_cast<uint8_t>(id.size()));
+        if (m_size + id.size() > MAX_RECORD) { m_truncated = true; return; }
+        std::memcpy(m_buf + m_size, id.data(), id.size());
+        m_size += id.size();
+    }
+
+    const uint8_t* Data() const { return m_buf; }
+    uint32_t Size() const { return static_cast<uint32_t>(m_size); }
+    bool Truncated() const { return m_truncated; }
+
+private:
+    alignas(8) uint8_t m_buf[MAX_RECORD];
+    size_t m_size = 0;
+    bool   m_truncated = false;
+};
+
+/// Reads a payload written by Writer. Reads past the end yield zero /
+/// empty values and set Failed().
+class Reader {
+public:
+    Reader(const uint8_t* data, uint32_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    T Get()
+    {
+        T v{};
+        if (m_pos + sizeof(T) > m_size) { m_failed = true; return v; }
+        std::memcpy(&v, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return v;
+    }
+
+    std::wstring GetText()
+    {
+        size_t n = Get<uint16_t>();
+        if (m_pos + n * sizeof(wchar_t) > m_size) { m_failed = true; return {}; }
+        std::wstring s(n, L'\0');
+        if (n) std::memcpy(s.data(), m_data + m_pos, n * sizeof(wchar_t));
+        m_pos += n * sizeof(wchar_t);
+        return s;
+    }
+
+    /// Decode a PutLine record into `line`, reusing its buffers. Text cut
+    /// off by MAX_RECORD shortens or drops the trailing segments.
+    void GetLine(HudLine& line)
+    {
+        line.Clear();
+        size_t count = Get<uint16_t>();
+        auto& segments = line.SegmentBuffer();
+        segments.reserve(count);
+        for (size_t i = 0; i < count && !m_failed; ++i) {
+            TextSegment seg;
+            seg.color  = Get<LinearColor>();
+            seg.length = Get<uint16_t>();
+            segments.push_back(seg);
+        }
+
+        size_t n = Get<uint16_t>();
+        if (m_failed || m_pos + n * sizeof(wchar_t) > m_size) { m_failed = true; line.Clear(); return; }
+        auto& text = line.TextBuffer();
+        text.resize(n);
+        if (n) std::memcpy(text.data(), m_data + m_pos, n * sizeof(wchar_t));
+        m_pos += n * sizeof(wchar_t);
+
+        uint32_t offset = 0;
+        size_t kept = 0;
+        for (auto& seg : segments) {
+            if (offset >= n) break;
+            seg.offset = offset;
+            if (seg.length > n - offset) seg.length = static_cast<uint32_t>(n - offset);
+            offset += seg.length;
+            if (seg.length) segments[kept++] = seg;
+        }
+        segments.resize(kept);
+    }
+
+    ItemId GetId()
+    {
+        size_t n = Get<uint8_t>();
+        if (m_pos + n > m_size) { m_failed = true; return {}; }
+        ItemId id(std::string_view(reinterpret_cast<const char*>(m_data + m_pos), n));
+        m_pos += n;
+        return id;
+    }
+
+    bool Failed() const { return m_failed; }
+
+private:
+    const uint8_t* m_data;
+    uint32_t m_size;
+    size_t   m_pos = 0;
+    bool     m_failed = false;
+};
+
+} // namespace APChannel
+
+} // namespace TalosAP
@@ -4,30 +4,43 @@
 #include "ModState.h"
 #include "ItemMapping.h"
 #include "HudNotification.h"
+#include "APChannel.h"
+#include "MappedRegion.h"
+#include "LiveMetrics.h"
 
+#include <atomic>
 #include <string>
 #include <memory>
-#include <functional>
+#include <thread>
 
 namespace TalosAP {
 
-/// Wraps the apclientpp library to communicate with an Archipelago server.
+class APSession;
+
+/// The game thread's side of the Archipelago connection.
 ///
-/// apclientpp is single-threaded: all callbacks fire from within poll().
-/// Since poll() is called from the game thread (on_update), the callbacks
-/// queue items into ModState for the game thread to process safely.
+/// The connection itself lives in an APSession, which resolves every
+/// callback into a ready-to-apply event and writes it to a shared-memory
+/// ring (see APChannel.h). The session runs in the TalosAPHelper process
+/// when config.json sets "network_helper", otherwise on a thread in the
+/// game. Either way Poll() only drains the ring: it never waits on a lock
+/// or the network. If the helper cannot be started or exits, the session
+/// restarts in-process on the same channel.
 class APClientWrapper {
 public:
     APClientWrapper();
     ~APClientWrapper();
 
-    /// Initialize the AP client with configuration.
-    /// Returns true if the client was created successfully.
-    bool Init(const Config& config, ModState& state, ItemMapping& itemMapping,
-              HudNotification* hud = nullptr);
+    /// Create the channel and start the session. Needs no engine state —
+    /// called from mod construction. Returns true if a session is running.
+    bool Start(const Config& config, ModState& state, ItemMapping& itemMapping,
+               const std::wstring& modDir);
+
+    /// Attach the HUD once UMG is up; events before that are only logged.
+    void SetHud(HudNotification* hud);
 
-    /// Poll the AP client for network events. Must be called regularly
-    /// (e.g. every tick in on_update). All callbacks fire within this call.
+    /// Apply queued AP events on the game thread. Call every tick from
+    /// on_update.
     void Poll();
 
     /// Send a location check to the AP server.
@@ -48,21 +61,40 @@ public:
     /// Get the player's slot number (valid after slot connect).
     int GetPlayerSlot() const { return m_playerSlot; }
 
-    /// Get a player's display name by slot number.
-    std::string GetPlayerName(int slot) const;
+    /// Stage connection state and ring fill for the live metrics page.
+    void PublishMetrics(LiveMetrics& metrics) const;
+
+    /// True while the session runs in TalosAPHelper.
+    bool IsOutOfProcess() const { return m_helperProcess != nullptr; }
 
 private:
-    // Forward declare the impl to keep apclientpp out of the header
-    struct Impl;
-    std::unique_ptr<Impl> m_impl;
+    bool StartHelper(const std::wstring& modDir);
+    bool StartInProcess();
+    void StopSession();
+    bool HelperExited() const;
+    void ApplyEvent(APChannel::Event type, APChannel::Reader& r);
+    void SendCheckedLocations();
+    void LogSaveDiff() const;
+    bool SendCommand(APChannel::Command type, const APChannel::Writer& payload);
+
+    MappedRegion    m_region;
+    APChannel::View m_channel;
+
+    // In-process session
+    std::unique_ptr<APSession> m_session;
+    std::thread                m_sessionThread;
+    std::atomic<bool>          m_stop{false};
+
+    // Out-of-process session
+    void* m_helperProcess = nullptr;   // HANDLE
 
     ModState*    m_state       = nullptr;
     ItemMapping* m_itemMapping = nullptr;
     HudNotification* m_hud    = nullptr;
-    Config       m_config;
 
     bool m_connected     = false;
     bool m_slotConnected = false;
+    bool m_saveDiffDue   = false;   ///< compare the save with the first item batch
     int  m_playerSlot    = -1;
     int  m_teamNumber    = -1;
 };
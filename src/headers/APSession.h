@@ -0,0 +1,100 @@
+#pragma once
+
+#include "APChannel.h"
+#include "ItemMapping.h"
+#include "EndpointWarmer.h"
+#include "ReconnectBackoff.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TalosAP {
+
+/// The network side of the mod: owns the apclientpp client and turns its
+/// callbacks into APChannel events — tetromino ids already resolved, HUD
+/// lines already rendered — so the game thread only applies them.
+///
+/// Engine-free. It runs on a thread inside the game or in TalosAPHelper;
+/// either way it talks to the mod only through the channel block.
+class APSession {
+public:
+    explicit APSession(APChannel::View channel);
+    ~APSession();
+
+    APSession(const APSession&) = delete;
+    APSession& operator=(const APSession&) = delete;
+
+    /// Create the AP client from the channel's ConnectInfo. The UUID and
+    /// data package cache are read from the working directory, which the
+    /// helper inherits from the game. Returns false if the client could
+    /// not be created.
+    bool Start();
+
+    /// Poll until `stop` or the channel's stop flag is set.
+    void Run(const std::atomic<bool>& stop);
+
+    /// Queue a Log event (helper only — in-process sessions log directly).
+    /// Safe from any thread.
+    void EmitLog(APChannel::LogKind kind, std::wstring_view text);
+
+    /// Events waiting for toMod space (tools/soak watches it). Safe from
+    /// any thread.
+    size_t BacklogDepth();
+
+    /// Log/Notify/ServerRtt events dropped because the backlog was full.
+    /// State events are never dropped. Safe from any thread.
+    uint64_t DroppedEvents();
+
+    /// Offline replay (tools/wirereplay): a client that never opens a
+    /// socket, with the data package cache loaded as Start() would. The
+    /// channel's ConnectInfo only needs the game name.
+    bool StartReplay();
+
+    /// Run one captured inbound packet (see WireCapture.h) through the
+    /// handlers the live client uses; its events land in toMod as usual.
+    /// Returns false for packets the session has no handler for.
+    bool Replay(std::string_view packet);
+
+private:
+    void Step();
+    void InstallHandlers();
+    void Emit(APChannel::Event type, const APChannel::Writer& payload);
+    void Emit(APChannel::Event type);
+    void FlushBacklog();
+    void HandleCommands();
+    void SampleRtt();
+    void PublishState();
+    void SampleDeflate();
+    void LogDeflateStats();
+    void EmitNotify(const HudLine& line, bool chat);
+    std::string PlayerName(int slot) const;
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    APChannel::View  m_channel;
+    ItemMapping      m_itemMapping;
+    EndpointWarmer   m_endpoint;
+    ReconnectBackoff m_backoff;
+    bool             m_socketUp = false;   ///< client was past DISCONNECTED last Step
+
+    // toMod has one producer; the lock covers log lines from other threads.
+    std::mutex                        m_emitMutex;
+    std::deque<std::vector<uint8_t>>  m_backlog;   ///< [u16 type][payload], waiting for ring space
+    uint64_t                          m_droppedEvents = 0;
+    uint64_t                          m_droppedReported = 0;   ///< session thread only
+
+    // Session resume: a reconnect to the same seed/team/slot keeps the
+    // granted items and skips the replayed prefix of ReceivedItems.
+    std::string m_sessionSeed;
+    int  m_sessionTeam   = -1;
+    int  m_sessionSlot   = -1;
+    int  m_nextItemIndex = 0;
+};
+
+} // namespace TalosAP
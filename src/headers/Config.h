@@ -1,5 +1,9 @@
 #pragma once
 
+#include "Tunables.h"
+
+#include <cstdint>
+#include <filesystem>
 #include <string>
 
 namespace TalosAP {
@@ -10,6 +14,10 @@ struct Config {
     std::wstring password  = L"";
     std::wstring game      = L"The Talos Principle Reawakened";
     bool offline_mode      = false;
+    bool network_helper    = false;   ///< run the AP connection in TalosAPHelper.exe
+    bool wire_capture      = false;   ///< record AP packets to talos_ap_wire.cap
+    std::wstring save_file = L"";     ///< save to pre-read (file or folder); empty = the game's SaveGames folder
+    Tunables tunables;                ///< "tunables" block; re-read live by PollTunables()
 
     // Narrow-string versions for apclientpp (which uses std::string)
     std::string server_str;
@@ -21,9 +29,21 @@ struct Config {
     /// Falls back to defaults if the file is not found or malformed.
     void Load(const std::wstring& modDir);
 
+    /// Re-read the "tunables" block if the loaded config.json has been
+    /// modified. Checks the file time at most once a second; call every
+    /// tick from the game thread. Returns true if any tunable changed —
+    /// the caller re-applies them. Only tunables are live: connection
+    /// settings still need a restart.
+    bool PollTunables();
+
 private:
     /// Synchronize narrow-string copies from wide-string fields.
     void SyncNarrowStrings();
+
+    // ---- Watched file (PollTunables) ----
+    std::filesystem::path           m_path;
+    std::filesystem::file_time_type m_mtime{};
+    int64_t                         m_lastPollNs = 0;
 };
 
 } // namespace TalosAP
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace TalosAP {
+
+/// Resolves the AP server's host name on a background thread.
+///
+/// websocketpp resolves the host again on every reconnect. Resolving it
+/// here first — at startup, and again as soon as the socket drops — leaves
+/// the answer in the OS resolver cache, so the reconnect's own lookup
+/// returns immediately instead of waiting on the network after a wifi
+/// blip. The last result is kept for the status dump.
+///
+/// The rest of the reconnect path: TlsSessionCache resumes the TLS
+/// session, ReconnectBackoff spaces the attempts, and all of it runs on
+/// the session thread (or in TalosAPHelper), never the game thread.
+///
+/// Warm() is non-blocking and callable from the game thread.
+class EndpointWarmer {
+public:
+    EndpointWarmer() = default;
+    ~EndpointWarmer();
+
+    EndpointWarmer(const EndpointWarmer&) = delete;
+    EndpointWarmer& operator=(const EndpointWarmer&) = delete;
+
+    /// Set the server from config ("host:port", "ws://host:port", "wss://…").
+    void SetServer(const std::string& server);
+
+    /// Queue a lookup. Ignored while one is already running.
+    void Warm();
+
+    /// Host and port parsed from the server string.
+    const std::string& Host() const { return m_host; }
+    const std::string& Port() const { return m_port; }
+
+    /// Last lookup: number of addresses (0 = failed or none yet) and time taken.
+    int    LastAddressCount() const { return m_lastCount.load(std::memory_order_relaxed); }
+    double LastResolveMs() const { return m_lastMs.load(std::memory_order_relaxed); }
+
+private:
+    void Run();
+
+    std::string m_host;
+    std::string m_port;
+
+    std::thread             m_thread;
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    bool                    m_pending = false;
+    bool                    m_stop    = false;
+
+    std::atomic<int>    m_lastCount{0};
+    std::atomic<double> m_lastMs{0.0};
+};
+
+} // namespace TalosAP
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <Unreal/UObjectGlobals.hpp>
+#include <Unreal/UObject.hpp>
+#include <Unreal/UFunction.hpp>
+
+#include <source_location>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+
+namespace TalosAP {
+
+/// The engine calls that dominate the mod's frame cost.
+enum class EngineCallKind : uint8_t {
+    FindAllOf,
+    FindFirstOf,
+    StaticFindObject,
+    GetValuePtr,       ///< GetValuePtrByPropertyNameInChain
+    GetFunction,       ///< GetFunctionByNameInChain
+    ProcessEvent,
+    GetFullName,
+    Count
+};
+
+/// Per-call-site counters for engine calls.
+///
+/// Every wrapper in the Engine namespace below bumps a counter keyed by
+/// (file, function, line, kind, label). Once per second Tick() turns the
+/// deltas into per-second rates and pushes them into the trace stream as
+/// counter tracks; Dump() prints rates and cumulative totals to the log
+/// (F6). A new FindAllOf inside a loop shows up here as a number.
+///
+/// Game thread only — engine calls are never made from anywhere else.
+class EngineCallStats {
+public:
+    struct Site {
+        std::string    name;          ///< "File.cpp:Function FindAllOf(BP_TetrominoItem_C)"
+        EngineCallKind kind;
+        uint64_t       total     = 0; ///< Cumulative calls
+        uint64_t       lastTotal = 0; ///< Total at the previous rate sample
+        double         perSecond = 0; ///< Rate over the last sample window
+    };
+
+    static EngineCallStats& Get();
+
+    /// Count one call. `label` is the class/property/function name the call
+    /// was made with; its address is part of the key, so pass literals.
+    void Count(EngineCallKind kind, const void* label, bool wideLabel,
+               const std::source_location& loc);
+
+    /// Call every tick. Recomputes rates once per second and emits them
+    /// to the trace stream.
+    void Tick();
+
+    /// Log per-site rates and totals, busiest first.
+    void Dump() const;
+
+    /// Cumulative calls of one kind across all sites.
+    uint64_t TotalFor(EngineCallKind kind) const { return m_kindTotals[static_cast<size_t>(kind)]; }
+
+    /// Per-second rate of one kind over the last sample window.
+    double RateFor(EngineCallKind kind) const { return m_kindRates[static_cast<size_t>(kind)]; }
+
+    static const char* KindName(EngineCallKind kind);
+
+private:
+    struct Key {
+        const char*    file;
+        uint32_t       line;
+        EngineCallKind kind;
+        const void*    label;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const;
+    };
+
+    std::deque<Site> m_sites;   // deque: Site::name addresses stay stable for the trace stream
+    std::unordered_map<Key, Site*, KeyHash> m_index;
+
+    static constexpr size_t KIND_COUNT = static_cast<size_t>(EngineCallKind::Count);
+    uint64_t m_kindTotals[KIND_COUNT]     = {};
+    uint64_t m_kindLastTotals[KIND_COUNT] = {};
+    double   m_kindRates[KIND_COUNT]      = {};
+    int64_t  m_lastSampleNs = 0;
+};
+
+// ============================================================
+// Counted engine-call wrappers. Drop-in replacements for the
+// UE4SS calls they wrap; the call site is captured automatically.
+// ============================================================
+namespace Engine {
+
+inline void FindAllOf(const wchar_t* className, std::vector<RC::Unreal::UObject*>& out,
+                      const std::source_location& loc = std::source_location::current())
+{
+    EngineCallStats::Get().Count(EngineCallKind::FindAllOf, className, true, loc);
+    RC::Unreal::UObjectGlobals::FindAllOf(className, out);
+}
+
+inline RC::Unreal::UObject* FindFirstOf(const wchar_t* className,
+                                        const std::source_location& loc = std::source_location::current())
+{
+    EngineCallStats::Get().Count(EngineCallKind::FindFirstOf, className, true, loc);
+    return RC::Unreal::UObjectGlobals::FindFirstOf(className);
+}
+
+template <typename T>
+inline T StaticFindObject(const wchar_t* path,
+                          const std::source_location& loc = std::source_location::current())
+{
+    EngineCallStats::Get().Count(EngineCallKind::StaticFindObject, path, true, loc);
+    return RC::Unreal::UObjectGlobals::StaticFindObject<T>(nullptr, nullptr, path);
+}
+
+template <typename T>
+inline T* GetValuePtr(RC::Unreal::UObject* obj, const wchar_t* property,
+                      const std::source_location& loc = std::source_location::current())
+{
+    EngineCallStats::Get().Count(EngineCallKind::GetValuePtr, property, true, loc);
+    return obj->GetValuePtrByPropertyNameInChain<T>(property);
+}
+
+inline RC::Unreal::UFunction* GetFunction(RC::Unreal::UObject* obj, const wchar_t* name,
+                                          const std::source_location& loc = std::source_location::current())
+{
+    EngineCallStats::Get().Count(EngineCallKind::GetFunction, name, true, loc);
+    return obj->GetFunctionByNameInChain(name);
+}
+
+/// Counted + traced ProcessEvent. `label` names the UFunction for the
+/// trace span and the per-site counter.
+void ProcessEvent(RC::Unreal::UObject* target, RC::Unreal::UFunction* func, void* params,
+                  const char* label,
+                  const std::source_location& loc = std::source_location::current());
+
+inline std::wstring GetFullName(RC::Unreal::UObject* obj,
+                                const std::source_location& loc = std::source_location::current())
+{
+    EngineCallStats::Get().Count(EngineCallKind::GetFullName, nullptr, false, loc);
+    return obj->GetFullName();
+}
+
+} // namespace Engine
+
+} // namespace TalosAP
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "FlatHashMap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace TalosAP {
+
+/// Inline string with a fixed capacity of N chars — no heap, trivially
+/// copyable, always NUL-terminated. Bytes past size() are kept zero so
+/// equality and hashing can treat the buffer as plain memory.
+///
+/// Construction from a literal is implicit; from std::string /
+/// string_view it is explicit, because input longer than N is truncated.
+template <size_t N>
+class FixedString {
+    static_assert(N > 0 && N < 256, "FixedString length is stored in one byte");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    constexpr FixedString() = default;
+
+    constexpr FixedString(const char* s)
+    {
+        if (s) Assign(std::string_view(s));
+    }
+
+    constexpr explicit FixedString(std::string_view s) { Assign(s); }
+
+    explicit FixedString(const std::string& s) { Assign(std::string_view(s)); }
+
+    // ---- Access ----
+
+    constexpr size_t size() const { return m_size; }
+    constexpr size_t length() const { return m_size; }
+    constexpr bool empty() const { return m_size == 0; }
+
+    constexpr const char* c_str() const { return m_data; }
+    constexpr const char* data() const { return m_data; }
+    constexpr const char* begin() const { return m_data; }
+    constexpr const char* end() const { return m_data + m_size; }
+    constexpr char operator[](size_t i) const { return m_data[i]; }
+
+    constexpr std::string_view view() const { return std::string_view(m_data, m_size); }
+    constexpr operator std::string_view() const { return view(); }
+
+    std::string str() const { return std::string(m_data, m_size); }
+
+    // ---- Building ----
+
+    constexpr void clear()
+    {
+        for (size_t i = 0; i < m_size; ++i) m_data[i] = '\0';
+        m_size = 0;
+    }
+
+    /// Append one char. Returns false (and leaves the string unchanged)
+    /// when full.
+    constexpr bool push_back(char c)
+    {
+        if (m_size >= N) return false;
+        m_data[m_size++] = c;
+        return true;
+    }
+
+    constexpr bool append(std::string_view s)
+    {
+        if (m_size + s.size() > N) return false;
+        for (char c : s) m_data[m_size++] = c;
+        return true;
+    }
+
+    /// Append the decimal form of `value` without going through
+    /// std::to_string.
+    constexpr bool AppendNumber(uint32_t value)
+    {
+        char digits[10] = {};
+        size_t n = 0;
+        do { digits[n++] = static_cast<char>('0' + value % 10); value /= 10; } while (value);
+        if (m_size + n > N) return false;
+        while (n) m_data[m_size++] = digits[--n];
+        return true;
+    }
+
+    // ---- Comparison ----
+
+    friend constexpr bool operator==(const FixedString& a, const FixedString& b)
+    {
+        if (a.m_size != b.m_size) return false;
+        for (size_t i = 0; i < a.m_size; ++i) {
+            if (a.m_data[i] != b.m_data[i]) return false;
+        }
+        return true;
+    }
+    friend constexpr bool operator==(const FixedString& a, std::string_view b) { return a.view() == b; }
+    friend constexpr bool operator==(const FixedString& a, const char* b) { return a.view() == std::string_view(b); }
+
+    friend constexpr bool operator<(const FixedString& a, const FixedString& b) { return a.view() < b.view(); }
+
+private:
+    constexpr void Assign(std::string_view s)
+    {
+        size_t n = s.size() < N ? s.size() : N;
+        for (size_t i = 0; i < n; ++i) m_data[i] = s[i];
+        m_size = static_cast<uint8_t>(n);
+    }
+
+    char    m_data[N + 1] = {};
+    uint8_t m_size = 0;
+};
+
+/// Tetromino, star and prefix identifiers ("DJ3", "NT12", "Star30", "DJ").
+/// 14 chars + NUL + length = 16 bytes.
+using ItemId = FixedString<14>;
+static_assert(sizeof(ItemId) == 16);
+
+/// Transparent — tables keyed by FixedString accept string_view and
+/// literal lookups.
+template <size_t N>
+struct FlatHash<FixedString<N>> {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept
+    {
+        return static_cast<size_t>(FlatDetail::HashBytes(s.data(), s.size()));
+    }
+};
+
+/// Widen a static ASCII label (thunk, task and location-kind names) for
+/// logging without allocating. Runtime text — item ids, exception
+/// messages, anything from config or the server — goes through
+/// Utf::ToWide, which decodes UTF-8; this only copies bytes, so anything
+/// outside ASCII shows as '?'. The view points into a small per-thread
+/// ring of buffers and stays valid for the next 7 Widen() calls on this
+/// thread — long enough for every argument of one Output::send. A label
+/// past 63 chars ends in "..." rather than being cut silently.
+inline std::wstring_view Widen(const char* label)
+{
+    constexpr size_t SLOTS = 8;
+    constexpr size_t SLOT_LEN = 63;
+    thread_local wchar_t ring[SLOTS][SLOT_LEN + 1];
+    thread_local size_t next = 0;
+
+    wchar_t* out = ring[next];
+    next = (next + 1) % SLOTS;
+    if (!label) label = "?";
+
+    size_t n = 0;
+    for (; n < SLOT_LEN && label[n]; ++n) {
+        auto c = static_cast<unsigned char>(label[n]);
+        out[n] = c < 0x80 ? static_cast<wchar_t>(c) : L'?';
+    }
+    if (label[n]) {
+        for (size_t i = SLOT_LEN - 3; i < SLOT_LEN; ++i) out[i] = L'.';
+    }
+    out[n] = L'\0';
+    return std::wstring_view(out, n);
+}
+
+/// Runtime strings must use Utf::ToWide.
+std::wstring_view Widen(std::string_view) = delete;
+template <size_t N>
+std::wstring_view Widen(const FixedString<N>&) = delete;
+
+} // namespace TalosAP
@@ -0,0 +1,733 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TALOSAP_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace TalosAP {
+
+// ============================================================
+// Hashing
+// ============================================================
+
+namespace FlatDetail {
+
+/// Final avalanche (murmur3 fmix64). The table splits every hash into
+/// a probe start (high bits) and a 7-bit tag (low bits), so both ends
+/// must be well mixed — identity hashes for integers are not.
+inline uint64_t Mix(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+/// FNV-1a over the bytes, then Mix(). Our string keys are a handful of
+/// characters, where this beats anything block-based.
+inline uint64_t HashBytes(const char* data, size_t len)
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= static_cast<uint8_t>(data[i]);
+        h *= 0x100000001B3ull;
+    }
+    return Mix(h ^ len);
+}
+
+} // namespace FlatDetail
+
+/// Default hasher for FlatHashMap / FlatHashSet.
+template <typename T, typename = void>
+struct FlatHash {
+    size_t operator()(const T& v) const { return static_cast<size_t>(FlatDetail::Mix(std::hash<T>{}(v))); }
+};
+
+template <typename T>
+struct FlatHash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>> {
+    size_t operator()(T v) const noexcept
+    {
+        if constexpr (std::is_pointer_v<T>) {
+            return static_cast<size_t>(FlatDetail::Mix(reinterpret_cast<uintptr_t>(v)));
+        } else {
+            return static_cast<size_t>(FlatDetail::Mix(static_cast<uint64_t>(v)));
+        }
+    }
+};
+
+/// Transparent: a std::string-keyed table can be probed with a
+/// string_view or literal without building a temporary string.
+template <>
+struct FlatHash<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept
+    {
+        return static_cast<size_t>(FlatDetail::HashBytes(s.data(), s.size()));
+    }
+};
+
+template <>
+struct FlatHash<std::string_view> : FlatHash<std::string> {};
+
+// ============================================================
+// Control bytes and 16-wide group matching
+// ============================================================
+
+namespace FlatDetail {
+
+using ctrl_t = int8_t;
+inline constexpr ctrl_t CTRL_EMPTY   = -128;  // 0b10000000
+inline constexpr ctrl_t CTRL_DELETED = -2;    // 0b11111110
+// Full slots hold the 7-bit tag (0..127), so "full" == sign bit clear.
+
+inline constexpr size_t GROUP_WIDTH = 16;
+
+inline int LowestBit(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/// One probe group: 16 control bytes compared in parallel. Each Match*
+/// returns a bitmask with bit i set when byte i qualifies.
+struct Group {
+#ifdef TALOSAP_FLAT_HASH_SSE2
+    explicit Group(const ctrl_t* p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    uint32_t Match(uint8_t tag) const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(tag)))));
+    }
+    uint32_t MatchEmpty() const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(CTRL_EMPTY))));
+    }
+    uint32_t MatchEmptyOrDeleted() const
+    {
+        // Empty (-128) and deleted (-2) are the only values below -1.
+        return static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+    }
+
+    __m128i ctrl;
+#else
+    explicit Group(const ctrl_t* p) { std::memcpy(ctrl, p, GROUP_WIDTH); }
+
+    uint32_t Match(uint8_t tag) const
+    {
+        uint32_t m = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) m |= uint32_t(ctrl[i] == static_cast<ctrl_t>(tag)) << i;
+        return m;
+    }
+    uint32_t MatchEmpty() const
+    {
+        uint32_t m = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) m |= uint32_t(ctrl[i] == CTRL_EMPTY) << i;
+        return m;
+    }
+    uint32_t MatchEmptyOrDeleted() const
+    {
+        uint32_t m = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) m |= uint32_t(ctrl[i] < -1) << i;
+        return m;
+    }
+
+    ctrl_t ctrl[GROUP_WIDTH];
+#endif
+};
+
+template <typename K, typename V>
+struct MapPolicy {
+    using key_type   = K;
+    using value_type = std::pair<const K, V>;
+    static constexpr bool IS_SET = false;
+    static const K& Key(const value_type& v) { return v.first; }
+};
+
+template <typename K>
+struct SetPolicy {
+    using key_type   = K;
+    using value_type = K;
+    static constexpr bool IS_SET = true;
+    static const K& Key(const value_type& v) { return v; }
+};
+
+// ============================================================
+// FlatTable — shared open-addressing core
+// ============================================================
+
+/// Swiss-table style open addressing. Slots live in one flat array with a
+/// parallel array of control bytes; lookups compare a 7-bit tag against
+/// 16 control bytes at once and only touch slots whose tag matches.
+/// Probing walks whole groups (triangular sequence), and stops at the
+/// first group containing an empty byte. Max load is 7/8.
+///
+/// Capacity is 0 (no allocation) or a power of two ≥ 16. Inserting may
+/// rehash and invalidate iterators; erasing never does.
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+class FlatTable {
+public:
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using size_type       = size_t;
+    using hasher          = Hash;
+    using key_equal       = Eq;
+    using allocator_type  = typename std::allocator_traits<Alloc>::template rebind_alloc<value_type>;
+
+    template <bool Const>
+    class Iter {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename Policy::value_type;
+        using difference_type   = ptrdiff_t;
+        using reference  = std::conditional_t<Const || Policy::IS_SET, const value_type&, value_type&>;
+        using pointer    = std::conditional_t<Const || Policy::IS_SET, const value_type*, value_type*>;
+
+        Iter() = default;
+        Iter(const ctrl_t* ctrl, const ctrl_t* end, value_type* slot)
+            : m_ctrl(ctrl), m_end(end), m_slot(slot) { SkipEmpty(); }
+
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iter(const Iter<false>& other) : m_ctrl(other.m_ctrl), m_end(other.m_end), m_slot(other.m_slot) {}
+
+        reference operator*() const { return *m_slot; }
+        pointer operator->() const { return m_slot; }
+
+        Iter& operator++() { ++m_ctrl; ++m_slot; SkipEmpty(); return *this; }
+        Iter operator++(int) { Iter tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const Iter& a, const Iter& b) { return a.m_ctrl == b.m_ctrl; }
+        friend bool operator!=(const Iter& a, const Iter& b) { return a.m_ctrl != b.m_ctrl; }
+
+    private:
+        friend class FlatTable;
+        template <bool> friend class Iter;
+
+        void SkipEmpty()
+        {
+            while (m_ctrl != m_end && *m_ctrl < 0) { ++m_ctrl; ++m_slot; }
+        }
+
+        const ctrl_t* m_ctrl = nullptr;
+        const ctrl_t* m_end  = nullptr;
+        value_type*   m_slot = nullptr;
+    };
+
+    using iterator       = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    // ---- Construction ----
+
+    FlatTable() = default;
+
+    explicit FlatTable(const Alloc& alloc) : m_alloc(alloc) {}
+
+    FlatTable(const FlatTable& other)
+        : m_hash(other.m_hash), m_eq(other.m_eq),
+          m_alloc(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.m_alloc))
+    {
+        CopyFrom(other);
+    }
+
+    FlatTable(FlatTable&& other) noexcept
+        : m_hash(std::move(other.m_hash)), m_eq(std::move(other.m_eq)), m_alloc(other.m_alloc)
+    {
+        Steal(other);
+    }
+
+    ~FlatTable() { Destroy(); }
+
+    FlatTable& operator=(const FlatTable& other)
+    {
+        if (this != &other) {
+            clear();
+            m_hash = other.m_hash;
+            m_eq   = other.m_eq;
+            CopyFrom(other);
+        }
+        return *this;
+    }
+
+    FlatTable& operator=(FlatTable&& other) noexcept
+    {
+        if (this == &other) return *this;
+        if (m_alloc == other.m_alloc) {
+            Destroy();
+            m_hash = std::move(other.m_hash);
+            m_eq   = std::move(other.m_eq);
+            Steal(other);
+        } else {
+            // Different resources (e.g. two pmr arenas) — can't steal the block.
+            clear();
+            CopyFrom(other);
+            other.clear();
+        }
+        return *this;
+    }
+
+    // ---- Capacity ----
+
+    size_t size() const { return m_size; }
+    bool   empty() const { return m_size == 0; }
+    size_t capacity() const { return m_capacity; }
+
+    /// Bytes held by the table's single allocation.
+    size_t MemoryBytes() const { return m_capacity ? AllocSlots(m_capacity) * sizeof(value_type) : 0; }
+
+    /// Make room for `count` elements without further rehashing.
+    void reserve(size_t count)
+    {
+        size_t needed = CapacityFor(count);
+        if (needed > m_capacity) Rehash(needed);
+    }
+
+    // ---- Iteration ----
+
+    iterator begin() { return iterator(m_ctrl, m_ctrl + m_capacity, m_slots); }
+    iterator end()   { return iterator(m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity); }
+    const_iterator begin() const { return const_iterator(m_ctrl, m_ctrl + m_capacity, m_slots); }
+    const_iterator end() const   { return const_iterator(m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const   { return end(); }
+
+    // ---- Lookup ----
+
+    template <typename Q = key_type>
+    iterator find(const Q& key)
+    {
+        size_t idx = FindIndex(key, m_hash(key));
+        return idx == NPOS ? end() : IterAt(idx);
+    }
+
+    template <typename Q = key_type>
+    const_iterator find(const Q& key) const
+    {
+        size_t idx = FindIndex(key, m_hash(key));
+        return idx == NPOS ? end() : const_iterator(m_ctrl + idx, m_ctrl + m_capacity, m_slots + idx);
+    }
+
+    template <typename Q = key_type>
+    bool contains(const Q& key) const { return FindIndex(key, m_hash(key)) != NPOS; }
+
+    template <typename Q = key_type>
+    size_t count(const Q& key) const { return contains(key) ? 1 : 0; }
+
+    // ---- Removal ----
+
+    template <typename Q = key_type>
+    size_t erase(const Q& key)
+    {
+        size_t idx = FindIndex(key, m_hash(key));
+        if (idx == NPOS) return 0;
+        EraseAt(idx);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        size_t idx = static_cast<size_t>(pos.m_ctrl - m_ctrl);
+        EraseAt(idx);
+        return IterAt(idx + 1);
+    }
+
+    iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+    /// Destroy all elements. Keeps the allocation for reuse.
+    void clear()
+    {
+        if (!m_capacity) return;
+        DestroySlots();
+        std::memset(m_ctrl, static_cast<uint8_t>(CTRL_EMPTY), m_capacity);
+        m_size = 0;
+        m_growthLeft = MaxLoad(m_capacity);
+    }
+
+    void swap(FlatTable& other) noexcept
+    {
+        using std::swap;
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_size, other.m_size);
+        swap(m_growthLeft, other.m_growthLeft);
+        swap(m_hash, other.m_hash);
+        swap(m_eq, other.m_eq);
+        swap(m_alloc, other.m_alloc);
+    }
+
+    allocator_type get_allocator() const { return m_alloc; }
+
+protected:
+    static constexpr size_t NPOS = ~size_t(0);
+
+    iterator IterAt(size_t idx)
+    {
+        return iterator(m_ctrl + idx, m_ctrl + m_capacity, m_slots + idx);
+    }
+
+    /// Locate `key`, or pick the slot it should go in. When `.second` is
+    /// true the caller MUST construct the value at that slot and then
+    /// call CommitInsert() with the same hash.
+    template <typename Q>
+    std::pair<size_t, bool> FindOrPrepareInsert(const Q& key, size_t hash)
+    {
+        size_t idx = FindIndex(key, hash);
+        if (idx != NPOS) return { idx, false };
+
+        if (m_capacity == 0) Rehash(GROUP_WIDTH);
+        idx = FindInsertSlot(hash);
+        if (m_ctrl[idx] == CTRL_EMPTY && m_growthLeft == 0) {
+            Grow();
+            idx = FindInsertSlot(hash);
+        }
+        return { idx, true };
+    }
+
+    void CommitInsert(size_t idx, size_t hash)
+    {
+        if (m_ctrl[idx] == CTRL_EMPTY) --m_growthLeft;
+        m_ctrl[idx] = Tag(hash);
+        ++m_size;
+    }
+
+    value_type* SlotAt(size_t idx) { return m_slots + idx; }
+
+    template <typename... Args>
+    void ConstructAt(size_t idx, Args&&... args)
+    {
+        std::allocator_traits<allocator_type>::construct(m_alloc, m_slots + idx, std::forward<Args>(args)...);
+    }
+
+    Hash m_hash{};
+
+private:
+    static size_t H1(size_t hash) { return hash >> 7; }
+    static ctrl_t Tag(size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+    static size_t CapacityFor(size_t count)
+    {
+        if (count == 0) return 0;
+        size_t cap = GROUP_WIDTH;
+        while (MaxLoad(cap) < count) cap *= 2;
+        return cap;
+    }
+
+    /// Slots + control bytes share one allocation; the control bytes
+    /// take up the tail, rounded up to whole slots.
+    static size_t AllocSlots(size_t capacity)
+    {
+        return capacity + (capacity + sizeof(value_type) - 1) / sizeof(value_type);
+    }
+
+    template <typename Q>
+    size_t FindIndex(const Q& key, size_t hash) const
+    {
+        if (m_size == 0) return NPOS;
+
+        const size_t groupMask = m_capacity / GROUP_WIDTH - 1;
+        const uint8_t tag = static_cast<uint8_t>(Tag(hash));
+        size_t group = H1(hash) & groupMask;
+
+        for (size_t step = 0; step <= groupMask; ++step) {
+            const size_t base = group * GROUP_WIDTH;
+            Group g(m_ctrl + base);
+            for (uint32_t m = g.Match(tag); m; m &= m - 1) {
+                size_t idx = base + LowestBit(m);
+                if (m_eq(Policy::Key(m_slots[idx]), key)) return idx;
+            }
+            if (g.MatchEmpty()) return NPOS;
+            group = (group + step + 1) & groupMask;
+        }
+        return NPOS;
+    }
+
+    size_t FindInsertSlot(size_t hash) const
+    {
+        const size_t groupMask = m_capacity / GROUP_WIDTH - 1;
+        size_t group = H1(hash) & groupMask;
+
+        for (size_t step = 0;; ++step) {
+            const size_t base = group * GROUP_WIDTH;
+            uint32_t m = Group(m_ctrl + base).MatchEmptyOrDeleted();
+            if (m) return base + LowestBit(m);
+            group = (group + step + 1) & groupMask;
+        }
+    }
+
+    void EraseAt(size_t idx)
+    {
+        std::allocator_traits<allocator_type>::destroy(m_alloc, m_slots + idx);
+        --m_size;
+        // If this group still has an empty byte, no probe ever ran past it,
+        // so the slot can go straight back to empty instead of a tombstone.
+        if (Group(m_ctrl + (idx & ~(GROUP_WIDTH - 1))).MatchEmpty()) {
+            m_ctrl[idx] = CTRL_EMPTY;
+            ++m_growthLeft;
+        } else {
+            m_ctrl[idx] = CTRL_DELETED;
+        }
+    }
+
+    void Grow()
+    {
+        // Mostly tombstones? Rehash in place; otherwise double.
+        if (m_size < MaxLoad(m_capacity) / 2) Rehash(m_capacity);
+        else Rehash(m_capacity * 2);
+    }
+
+    void Rehash(size_t newCapacity)
+    {
+        value_type* oldSlots = m_slots;
+        ctrl_t*     oldCtrl  = m_ctrl;
+        size_t      oldCap   = m_capacity;
+
+        m_slots    = std::allocator_traits<allocator_type>::allocate(m_alloc, AllocSlots(newCapacity));
+        m_ctrl     = reinterpret_cast<ctrl_t*>(m_slots + newCapacity);
+        m_capacity = newCapacity;
+        std::memset(m_ctrl, static_cast<uint8_t>(CTRL_EMPTY), newCapacity);
+        m_growthLeft = MaxLoad(newCapacity) - m_size;
+
+        for (size_t i = 0; i < oldCap; ++i) {
+            if (oldCtrl[i] < 0) continue;
+            size_t hash = m_hash(Policy::Key(oldSlots[i]));
+            size_t idx  = FindInsertSlot(hash);
+            ConstructAt(idx, std::move(oldSlots[i]));
+            std::allocator_traits<allocator_type>::destroy(m_alloc, oldSlots + i);
+            m_ctrl[idx] = Tag(hash);
+        }
+
+        if (oldSlots) {
+            std::allocator_traits<allocator_type>::deallocate(m_alloc, oldSlots, AllocSlots(oldCap));
+        }
+    }
+
+    void CopyFrom(const FlatTable& other)
+    {
+        if (other.m_size == 0) return;
+        reserve(other.m_size);
+        for (size_t i = 0; i < other.m_capacity; ++i) {
+            if (other.m_ctrl[i] < 0) continue;
+            size_t hash = m_hash(Policy::Key(other.m_slots[i]));
+            size_t idx  = FindInsertSlot(hash);
+            ConstructAt(idx, other.m_slots[i]);
+            CommitInsert(idx, hash);
+        }
+    }
+
+    void Steal(FlatTable& other)
+    {
+        m_ctrl       = std::exchange(other.m_ctrl, nullptr);
+        m_slots      = std::exchange(other.m_slots, nullptr);
+        m_capacity   = std::exchange(other.m_capacity, 0);
+        m_size       = std::exchange(other.m_size, 0);
+        m_growthLeft = std::exchange(other.m_growthLeft, 0);
+    }
+
+    void DestroySlots()
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (m_ctrl[i] >= 0) std::allocator_traits<allocator_type>::destroy(m_alloc, m_slots + i);
+            }
+        }
+    }
+
+    void Destroy()
+    {
+        if (!m_capacity) return;
+        DestroySlots();
+        std::allocator_traits<allocator_type>::deallocate(m_alloc, m_slots, AllocSlots(m_capacity));
+        m_slots = nullptr;
+        m_ctrl = nullptr;
+        m_capacity = m_size = m_growthLeft = 0;
+    }
+
+    ctrl_t*     m_ctrl       = nullptr;
+    value_type* m_slots      = nullptr;
+    size_t      m_capacity   = 0;
+    size_t      m_size       = 0;
+    size_t      m_growthLeft = 0;
+    Eq          m_eq{};
+    allocator_type m_alloc{};
+};
+
+} // namespace FlatDetail
+
+// ============================================================
+// FlatHashMap / FlatHashSet
+// ============================================================
+
+/// Open-addressing hash map. Drop-in for the std::unordered_map subset
+/// the mod uses (find/count/contains/[]/try_emplace/insert/erase/
+/// iteration). Differences from std: elements move on rehash, so
+/// pointers and references into the map are invalidated by inserts;
+/// iteration order is unspecified and changes on rehash.
+template <typename K, typename V, typename Hash = FlatHash<K>, typename Eq = std::equal_to<>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class FlatHashMap
+    : public FlatDetail::FlatTable<FlatDetail::MapPolicy<K, V>, Hash, Eq, Alloc> {
+    using Base = FlatDetail::FlatTable<FlatDetail::MapPolicy<K, V>, Hash, Eq, Alloc>;
+
+public:
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::value_type;
+    using mapped_type = V;
+
+    using Base::Base;
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<value_type> init)
+    {
+        this->reserve(init.size());
+        for (const auto& v : init) insert(v);
+    }
+
+    FlatHashMap& operator=(std::initializer_list<value_type> init)
+    {
+        this->clear();
+        this->reserve(init.size());
+        for (const auto& v : init) insert(v);
+        return *this;
+    }
+
+    template <typename Q, typename... Args>
+    std::pair<iterator, bool> try_emplace(Q&& key, Args&&... args)
+    {
+        size_t hash = this->m_hash(key);
+        auto [idx, inserted] = this->FindOrPrepareInsert(key, hash);
+        if (inserted) {
+            this->ConstructAt(idx, std::piecewise_construct,
+                              std::forward_as_tuple(std::forward<Q>(key)),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+            this->CommitInsert(idx, hash);
+        }
+        return { this->IterAt(idx), inserted };
+    }
+
+    std::pair<iterator, bool> insert(const value_type& v) { return try_emplace(v.first, v.second); }
+    std::pair<iterator, bool> insert(value_type&& v) { return try_emplace(v.first, std::move(v.second)); }
+
+    template <typename Q, typename M>
+    std::pair<iterator, bool> emplace(Q&& key, M&& value)
+    {
+        return try_emplace(std::forward<Q>(key), std::forward<M>(value));
+    }
+
+    template <typename Q, typename M>
+    std::pair<iterator, bool> insert_or_assign(Q&& key, M&& value)
+    {
+        auto result = try_emplace(std::forward<Q>(key), std::forward<M>(value));
+        if (!result.second) result.first->second = std::forward<M>(value);
+        return result;
+    }
+
+    template <typename Q>
+    V& operator[](Q&& key) { return try_emplace(std::forward<Q>(key)).first->second; }
+
+    template <typename Q>
+    V& at(const Q& key)
+    {
+        auto it = this->find(key);
+        if (it == this->end()) throw std::out_of_range("FlatHashMap::at");
+        return it->second;
+    }
+
+    template <typename Q>
+    const V& at(const Q& key) const
+    {
+        auto it = this->find(key);
+        if (it == this->end()) throw std::out_of_range("FlatHashMap::at");
+        return it->second;
+    }
+};
+
+/// Open-addressing hash set. Same caveats as FlatHashMap.
+template <typename K, typename Hash = FlatHash<K>, typename Eq = std::equal_to<>,
+          typename Alloc = std::allocator<K>>
+class FlatHashSet
+    : public FlatDetail::FlatTable<FlatDetail::SetPolicy<K>, Hash, Eq, Alloc> {
+    using Base = FlatDetail::FlatTable<FlatDetail::SetPolicy<K>, Hash, Eq, Alloc>;
+
+public:
+    using typename Base::iterator;
+    using typename Base::value_type;
+
+    using Base::Base;
+    FlatHashSet() = default;
+
+    FlatHashSet(std::initializer_list<K> init)
+    {
+        this->reserve(init.size());
+        for (const auto& k : init) insert(k);
+    }
+
+    template <typename Q>
+    std::pair<iterator, bool> insert(Q&& key)
+    {
+        size_t hash = this->m_hash(key);
+        auto [idx, inserted] = this->FindOrPrepareInsert(key, hash);
+        if (inserted) {
+            this->ConstructAt(idx, std::forward<Q>(key));
+            this->CommitInsert(idx, hash);
+        }
+        return { this->IterAt(idx), inserted };
+    }
+
+    template <typename Q>
+    std::pair<iterator, bool> emplace(Q&& key) { return insert(std::forward<Q>(key)); }
+};
+
+/// Erase every element matching `pred`. Returns the number removed.
+template <typename K, typename V, typename H, typename E, typename A, typename Pred>
+size_t erase_if(FlatHashMap<K, V, H, E, A>& map, Pred pred)
+{
+    size_t removed = 0;
+    for (auto it = map.begin(); it != map.end();) {
+        if (pred(*it)) { it = map.erase(it); ++removed; }
+        else ++it;
+    }
+    return removed;
+}
+
+template <typename K, typename H, typename E, typename A, typename Pred>
+size_t erase_if(FlatHashSet<K, H, E, A>& set, Pred pred)
+{
+    size_t removed = 0;
+    for (auto it = set.begin(); it != set.end();) {
+        if (pred(*it)) { it = set.erase(it); ++removed; }
+        else ++it;
+    }
+    return removed;
+}
+
+} // namespace TalosAP
@@ -0,0 +1,55 @@
+#pragma once
+
+// On-disk layout of the flight recorder ring (talos_ap_flight.bin).
+// Shared by the in-game writer and the tools/flightdump decoder, so it
+// must stay free of UE4SS and Windows dependencies.
+
+#include <cstdint>
+#include <cstddef>
+
+namespace TalosAP {
+
+inline constexpr uint32_t FLIGHT_MAGIC   = 0x544C4654; // "TFLT"
+inline constexpr uint32_t FLIGHT_VERSION = 1;
+
+/// What a record describes. Values are persisted — append only.
+enum class FlightEventKind : uint16_t {
+    SpanBegin       = 1,   ///< Phase / callback / hook / ProcessEvent entered
+    SpanEnd         = 2,   ///< ...and left (a = duration ns)
+    EngineCall      = 3,   ///< FindAllOf etc. (name = call kind, detail = label)
+    Instant         = 4,   ///< Pickup, grant, fence open
+    WorldGeneration = 5,   ///< Level transition (a = generation, b = cooldown ticks)
+    Note            = 6,   ///< Free-form marker (session start, shutdown)
+};
+
+/// File header. Lives at offset 0, records follow at HEADER_SIZE.
+struct FlightHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;        ///< Number of record slots
+    uint64_t writeIndex;      ///< Total records ever claimed (slot = index % capacity)
+    int64_t  startUnixNs;     ///< Wall clock at session start
+    int64_t  startMonoNs;     ///< Monotonic clock at session start (same base as tsNs)
+    uint32_t processId;
+    uint32_t reserved[7];
+};
+static_assert(sizeof(FlightHeader) == 72, "FlightHeader layout is persisted");
+
+inline constexpr size_t FLIGHT_HEADER_SIZE = 128;
+
+/// One event. `seq` is written last; a slot whose seq does not match the
+/// index it was claimed for is torn (crash mid-write) and is skipped.
+struct FlightRecord {
+    uint64_t seq;             ///< Claimed index + 1 (0 = never written)
+    int64_t  tsNs;            ///< Monotonic ns (compare with startMonoNs)
+    int64_t  a;
+    uint32_t b;
+    uint16_t kind;            ///< FlightEventKind
+    uint16_t tid;             ///< Small per-thread ID (1 = first thread seen)
+    char     name[32];
+    char     detail[32];
+};
+static_assert(sizeof(FlightRecord) == 96, "FlightRecord layout is persisted");
+
+} // namespace TalosAP
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "FlightRecord.h"
+#include "MappedRegion.h"
+
+#include <string>
+#include <cstdint>
+
+namespace TalosAP {
+
+/// Crash-surviving event ring in a memory-mapped file.
+///
+/// Records the last CAPACITY mod events (span entries/exits, engine calls,
+/// hook firings, world generations) as fixed 96-byte binary records.
+/// Writes are a relaxed atomic increment plus a small memcpy into the
+/// mapped view — no locks, no syscalls, no formatting. Because the ring
+/// is a file mapping, the OS writes it back even when the game dies of
+/// an SEH access violation we could never catch.
+///
+/// The previous session's file is kept as talos_ap_flight.prev.bin so a
+/// crash is not overwritten by the restart. Decode with tools/flightdump.
+class FlightRecorder {
+public:
+    static constexpr uint32_t CAPACITY = 4096;
+
+    static FlightRecorder& Get();
+
+    /// Map the ring file inside `dir`. Until this succeeds every Record()
+    /// is a cheap no-op.
+    bool Open(const std::wstring& dir);
+
+    /// Flush and unmap (normal shutdown only).
+    void Close();
+
+    bool IsOpen() const { return m_records != nullptr; }
+
+    /// Append one event. name/detail are truncated to 31 chars.
+    void Record(FlightEventKind kind, const char* name, const char* detail = nullptr,
+                int64_t a = 0, uint32_t b = 0);
+
+    /// Same, with a wide detail string (ASCII-narrowed).
+    void RecordWide(FlightEventKind kind, const char* name, const wchar_t* detail,
+                    int64_t a = 0, uint32_t b = 0);
+
+private:
+    FlightRecorder() = default;
+
+    MappedRegion  m_region;
+    FlightHeader* m_header  = nullptr;
+    FlightRecord* m_records = nullptr;
+};
+
+} // namespace TalosAP
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "EngineCalls.h"
+
+#include <Unreal/UObject.hpp>
+#include <Unreal/UFunction.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+#include <type_traits>
+
+namespace TalosAP {
+
+/// One declared member of a ProcessEvent parameter struct. `name` must be
+/// the UFunction parameter name ("InPosition", "ReturnValue").
+struct ThunkField {
+    const wchar_t* name;
+    size_t         offset;
+    size_t         size;
+};
+
+/// Declare a ThunkField for `Params::Member`.
+#define THUNK_FIELD(Params, Member) \
+    ::TalosAP::ThunkField{ STR(#Member), offsetof(Params, Member), sizeof(Params::Member) }
+
+/// Non-template half of FunctionThunk: lookup, layout validation and the
+/// registry that ResolveAll() walks.
+class FunctionThunkBase {
+public:
+    enum class State : uint8_t {
+        Unresolved,   ///< Not looked up yet (or Reset())
+        Ready,        ///< Found and layout verified
+        Missing,      ///< StaticFindObject returned null
+        BadLayout,    ///< Found, but Params does not match — never called
+    };
+
+    static constexpr size_t MAX_FIELDS = 6;
+
+    /// Resolve on first use; afterwards just reports the cached result.
+    /// Returns true when the function can be called. A Missing function
+    /// is looked up again only if `retryMissing` is set (classes that
+    /// load late); a BadLayout is never retried.
+    bool Resolve(bool retryMissing = false);
+
+    /// Forget the cached UFunction* so the next call looks it up again.
+    /// For script-defined functions that are recreated on level load.
+    void Reset() { m_func = nullptr; m_state = State::Unresolved; }
+
+    State GetState() const { return m_state; }
+    const char* Label() const { return m_label; }
+
+    /// The validated UFunction*, or nullptr if not Ready. Resolves lazily.
+    RC::Unreal::UFunction* Function() { return Resolve() ? m_func : nullptr; }
+
+    /// Resolve and validate every thunk in the process. Call once from
+    /// on_unreal_init so layout mistakes are logged at startup, not found
+    /// as memory corruption at the first call.
+    static void ResolveAll();
+
+protected:
+    /// `fieldCount` is at most MAX_FIELDS; FunctionThunk checks it at
+    /// compile time.
+    FunctionThunkBase(const wchar_t* path, const char* label,
+                      size_t paramsSize, size_t paramsAlign, bool noParams,
+                      const ThunkField* fields, size_t fieldCount);
+
+    FunctionThunkBase(const FunctionThunkBase&) = delete;
+    FunctionThunkBase& operator=(const FunctionThunkBase&) = delete;
+
+private:
+    bool Validate(RC::Unreal::UFunction* func);
+
+    const wchar_t* m_path;
+    const char*    m_label;
+    size_t         m_paramsSize;
+    size_t         m_paramsAlign;
+    bool           m_noParams;
+
+    ThunkField m_fields[MAX_FIELDS] = {};
+    size_t     m_fieldCount = 0;
+
+    RC::Unreal::UFunction* m_func = nullptr;
+    State                  m_state = State::Unresolved;
+
+    FunctionThunkBase* m_next = nullptr;   // intrusive registry list
+};
+
+/// Typed, cached ProcessEvent call for one UFunction.
+///
+/// Declared once at file scope next to its parameter struct:
+///
+///     static FunctionThunk<Params_SetPosition> s_setPosition{
+///         STR("/Script/UMG.CanvasPanelSlot:SetPosition"), "SetPosition",
+///         { THUNK_FIELD(Params_SetPosition, InPosition) } };
+///
+/// The UFunction is found by path once. Before the first call sizeof(Params)
+/// is checked against ParmsSize and every declared field against the
+/// matching parameter's offset and size; on mismatch the thunk logs the
+/// difference and refuses to call. Empty Params types call with no buffer.
+template <typename Params>
+class FunctionThunk : public FunctionThunkBase {
+public:
+    static constexpr bool NO_PARAMS = std::is_empty_v<Params>;
+
+    FunctionThunk(const wchar_t* path, const char* label)
+        : FunctionThunkBase(path, label, sizeof(Params), alignof(Params), NO_PARAMS, nullptr, 0)
+    {
+    }
+
+    /// Every declared field is layout-checked, so a list longer than
+    /// MAX_FIELDS is a compile error rather than a silently shorter check.
+    template <size_t N>
+    FunctionThunk(const wchar_t* path, const char* label, const ThunkField (&fields)[N])
+        : FunctionThunkBase(path, label, sizeof(Params), alignof(Params), NO_PARAMS, fields, N)
+    {
+        static_assert(N <= MAX_FIELDS, "FunctionThunk: more fields than MAX_FIELDS; raise it");
+    }
+
+    /// Counted + traced ProcessEvent. Returns false (without calling) if
+    /// the function is missing or its layout did not validate.
+    bool Call(RC::Unreal::UObject* target, Params& params,
+              const std::source_location& loc = std::source_location::current())
+    {
+        auto* func = Function();
+        if (!target || !func) return false;
+        Engine::ProcessEvent(target, func, NO_PARAMS ? nullptr : &params, Label(), loc);
+        return true;
+    }
+
+    bool Call(RC::Unreal::UObject* target,
+              const std::source_location& loc = std::source_location::current())
+        requires NO_PARAMS
+    {
+        Params none{};
+        return Call(target, none, loc);
+    }
+};
+
+/// Params type for functions that take no arguments.
+struct NoParams {};
+
+} // namespace TalosAP
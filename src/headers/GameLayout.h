@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Unreal/UObject.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TalosAP {
+
+/// In-memory header of an engine TArray: Data*, Num, Max.
+struct RawArray {
+    uint8_t* Data;
+    int32_t  Num;
+    int32_t  Max;
+};
+static_assert(sizeof(RawArray) == 0x10);
+
+/// One offset (or struct size) taken from the game's header dump.
+///
+/// Instances are generated into GameOffsets.h by offsets/GenerateOffsets.cmake
+/// and start out with the dumped value. VerifyAll() compares each against
+/// live reflection once its owning class is loaded; if the two disagree
+/// the reflected value replaces the dumped one for that entry only. Reads
+/// stay a plain base + offset either way.
+///
+/// Game thread only.
+class GameLayoutEntry {
+public:
+    enum class Source : uint8_t {
+        Dump,         ///< Not checked yet (owner class not loaded)
+        Verified,     ///< Reflection agrees with the dump
+        Reflection,   ///< Reflection disagreed — using its value
+        Unreflected,  ///< Owner loaded, but the member is not reflected
+    };
+
+    /// The offset (or size) to use.
+    size_t Value() const { return m_value; }
+
+    /// What the header dump said, regardless of any fallback.
+    size_t DumpValue() const { return m_dumpValue; }
+
+    Source GetSource() const { return m_source; }
+
+    /// Check every entry whose owner has not been checked yet. Cheap once
+    /// everything is verified; call at init and again on level load, since
+    /// Angelscript classes may only appear with their first level.
+    static void VerifyAll();
+
+    /// Log every entry with its dumped and live value (F6).
+    static void Dump();
+
+protected:
+    GameLayoutEntry(const wchar_t* ownerPath, const wchar_t* member, size_t value, size_t size);
+
+    GameLayoutEntry(const GameLayoutEntry&) = delete;
+    GameLayoutEntry& operator=(const GameLayoutEntry&) = delete;
+
+private:
+    bool Verify();
+
+    const wchar_t* m_ownerPath;
+    const wchar_t* m_member;      ///< nullptr = struct size entry
+    size_t         m_value;
+    size_t         m_dumpValue;
+    size_t         m_size;
+    Source         m_source = Source::Dump;
+
+    GameLayoutEntry* m_next = nullptr;   // intrusive registry list
+};
+
+/// A typed member at a dumped offset.
+template <typename T>
+class GameField : public GameLayoutEntry {
+public:
+    GameField(const wchar_t* ownerPath, const wchar_t* member, size_t offset, size_t size)
+        : GameLayoutEntry(ownerPath, member, offset, size)
+    {
+    }
+
+    size_t Offset() const { return Value(); }
+
+    T* Ptr(const void* base) const
+    {
+        return reinterpret_cast<T*>(const_cast<uint8_t*>(static_cast<const uint8_t*>(base)) + Value());
+    }
+
+    T& In(const void* base) const { return *Ptr(base); }
+};
+
+/// The size of a dumped struct (array stride, by-value parameter size).
+class GameStructSize : public GameLayoutEntry {
+public:
+    GameStructSize(const wchar_t* ownerPath, size_t size)
+        : GameLayoutEntry(ownerPath, nullptr, size, size)
+    {
+    }
+
+    size_t Get() const { return Value(); }
+};
+
+} // namespace TalosAP
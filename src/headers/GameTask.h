@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace TalosAP {
+
+// ============================================================
+// Game-thread coroutine tasks
+//
+// Retry loops and "do X once the world is back" flows written as
+// straight-line code:
+//
+//   GameTask OpenFence(ItemId id) {
+//       for (int attempt = 0; attempt < 10; ++attempt) {
+//           co_await WorldReady();
+//           if (TryOpen(id)) co_return;
+//           co_await After(100);
+//       }
+//   }
+//   TaskScheduler::Get().Spawn(OpenFence(id), TaskGroup::Level, "FenceOpen");
+//
+// Awaitables:
+//   NextTick()     resume on the next Tick()
+//   After(ms)      resume once `ms` have passed (timer wheel)
+//   WorldReady()   resume on the first Tick() outside a level transition
+//                  cooldown; no suspension if the world is ready now
+//   Until(pred)    resume on the first Tick() where pred() is true
+//
+// A waiting task is touched only when what it waits on comes due:
+// timers sit in a hashed wheel slot, WorldReady waiters in one list
+// released together. Until() predicates are the exception — they are
+// evaluated every Tick(), including during cooldown, so they must be
+// cheap and must not touch UObjects.
+//
+// Tasks never hold a UObject* across a co_await; re-discover after
+// every suspension, as everywhere else in the mod.
+//
+// Game thread only. UE-free — also built into tools/taskbench.
+// ============================================================
+
+/// Cancellation groups. Level tasks are destroyed on every level
+/// transition, at whatever co_await they are suspended in.
+enum class TaskGroup : uint8_t {
+    Session,
+    Level,
+};
+
+/// Coroutine return type. Created suspended; does nothing until handed
+/// to TaskScheduler::Spawn. The frame frees itself when the body returns.
+class GameTask {
+public:
+    static constexpr uint32_t NO_SLOT = ~uint32_t(0);
+
+    struct promise_type {
+        uint32_t slot = NO_SLOT;
+
+        GameTask get_return_object() noexcept { return GameTask(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept;
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept;
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    GameTask(GameTask&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    GameTask(const GameTask&) = delete;
+    GameTask& operator=(const GameTask&) = delete;
+    GameTask& operator=(GameTask&&) = delete;
+    ~GameTask() { if (m_handle) m_handle.destroy(); }
+
+private:
+    friend class TaskScheduler;
+    explicit GameTask(Handle h) noexcept : m_handle(h) {}
+    Handle m_handle;
+};
+
+/// What a live task is suspended on (for the F6 dump).
+enum class TaskWait : uint8_t {
+    Start,
+    NextTick,
+    Timer,
+    WorldReady,
+    Until,
+    Running,
+};
+
+inline const char* TaskWaitName(TaskWait w)
+{
+    static const char* names[] = { "start", "next_tick", "timer", "world_ready", "until", "running" };
+    return names[static_cast<size_t>(w)];
+}
+
+/// Runs GameTasks. Tick() once per game tick; everything else is called
+/// from the awaitables or from task bodies.
+class TaskScheduler {
+public:
+    /// Timer wheel: WHEEL_SLOTS slots of WHEEL_GRANULARITY_MS each (~4 s
+    /// per turn). Longer delays wait out whole turns via a rounds count.
+    static constexpr uint32_t WHEEL_SLOTS          = 256;
+    static constexpr uint32_t WHEEL_GRANULARITY_MS = 16;
+
+    static TaskScheduler& Get();
+
+    /// Start `task` on the next Tick(). `name` must outlive the task
+    /// (a string literal).
+    void Spawn(GameTask task, TaskGroup group, const char* name);
+
+    /// Destroy every task in `group` at its suspension point. A task that
+    /// cancels its own group finishes its current step first. Returns the
+    /// number of tasks cancelled.
+    size_t Cancel(TaskGroup group);
+
+    /// Destroy every task (shutdown).
+    void CancelAll();
+
+    /// Resume everything that has come due. `worldReady` is false during
+    /// a level transition cooldown.
+    void Tick(uint64_t nowMs, bool worldReady);
+
+    uint64_t NowMs() const { return m_nowMs; }
+    uint64_t TickCount() const { return m_ticks; }
+    bool     IsWorldReady() const { return m_worldReady; }
+
+    size_t   LiveCount() const { return m_live; }
+    size_t   TimerCount() const { return m_timers; }
+    size_t   PollerCount() const { return m_pollers.size(); }
+    uint64_t Resumes() const { return m_resumes; }
+    uint64_t Faults() const { return m_faults; }
+
+    /// Name of the last task that ended in an exception, or nullptr.
+    const char* LastFault() const { return m_lastFault; }
+
+    /// fn(name, group, wait) for every live task.
+    template <typename Fn>
+    void ForEachLive(Fn&& fn) const
+    {
+        for (const auto& s : m_slots) {
+            if (s.live) fn(s.name, s.group, s.wait);
+        }
+    }
+
+    // ---- Awaitable back end ----
+    void WaitNextTick(uint32_t slot);
+    void WaitAfter(uint32_t slot, uint64_t ms);
+    void WaitWorldReady(uint32_t slot);
+    void WaitUntil(uint32_t slot, std::function<bool()> pred);
+
+    // ---- promise_type back end ----
+    void OnFinished(uint32_t slot);
+    void OnFault(uint32_t slot);
+
+private:
+    TaskScheduler() = default;
+
+    /// A slot index plus the generation it was issued at; stale once the
+    /// task finishes or is cancelled.
+    struct Ref {
+        uint32_t slot;
+        uint32_t gen;
+    };
+
+    struct Slot {
+        GameTask::Handle handle;
+        const char* name = nullptr;
+        uint32_t    gen = 0;
+        TaskGroup   group = TaskGroup::Session;
+        TaskWait    wait = TaskWait::Start;
+        bool        live = false;
+        bool        cancelPending = false;
+    };
+
+    struct Timer {
+        Ref      ref;
+        uint32_t rounds;
+    };
+
+    struct Poller {
+        Ref                   ref;
+        std::function<bool()> pred;
+    };
+
+    Ref  RefOf(uint32_t slot) const { return { slot, m_slots[slot].gen }; }
+    bool Valid(const Ref& r) const { return r.slot < m_slots.size() && m_slots[r.slot].live && m_slots[r.slot].gen == r.gen; }
+    void Free(uint32_t slot);
+    void Resume(const Ref& r);
+    void AdvanceWheel(uint64_t nowMs);
+
+    std::vector<Slot>     m_slots;
+    std::vector<uint32_t> m_freeSlots;
+
+    std::vector<Ref>    m_nextTick;
+    std::vector<Ref>    m_worldWaiters;
+    std::vector<Poller> m_pollers;
+    std::vector<Ref>    m_run;        ///< this Tick()'s resumptions, reused
+
+    std::array<std::vector<Timer>, WHEEL_SLOTS> m_wheel;
+    uint32_t m_wheelPos = 0;
+    uint64_t m_wheelMs = 0;           ///< time the current wheel slot stands for
+    bool     m_started = false;
+
+    uint64_t m_nowMs = 0;
+    uint64_t m_ticks = 0;
+    bool     m_worldReady = false;
+    uint32_t m_running = GameTask::NO_SLOT;
+
+    size_t      m_live = 0;
+    size_t      m_timers = 0;
+    uint64_t    m_resumes = 0;
+    uint64_t    m_faults = 0;
+    const char* m_lastFault = nullptr;
+};
+
+// ============================================================
+// Awaitables
+// ============================================================
+
+struct NextTickAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(GameTask::Handle h) { TaskScheduler::Get().WaitNextTick(h.promise().slot); }
+    void await_resume() const noexcept {}
+};
+
+struct AfterAwaiter {
+    uint64_t ms;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(GameTask::Handle h) { TaskScheduler::Get().WaitAfter(h.promise().slot, ms); }
+    void await_resume() const noexcept {}
+};
+
+struct WorldReadyAwaiter {
+    bool await_ready() const noexcept { return TaskScheduler::Get().IsWorldReady(); }
+    void await_suspend(GameTask::Handle h) { TaskScheduler::Get().WaitWorldReady(h.promise().slot); }
+    void await_resume() const noexcept {}
+};
+
+struct UntilAwaiter {
+    std::function<bool()> pred;
+    bool await_ready() { return pred(); }
+    void await_suspend(GameTask::Handle h) { TaskScheduler::Get().WaitUntil(h.promise().slot, std::move(pred)); }
+    void await_resume() const noexcept {}
+};
+
+inline NextTickAwaiter   NextTick() { return {}; }
+inline AfterAwaiter      After(uint64_t ms) { return { ms }; }
+inline WorldReadyAwaiter WorldReady() { return {}; }
+
+template <typename Pred>
+UntilAwaiter Until(Pred&& pred) { return { std::function<bool()>(std::forward<Pred>(pred)) }; }
+
+} // namespace TalosAP
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "HudTypes.h"
+#include "Tunables.h"
+
 #include <Unreal/UObject.hpp>
 
 #include <string>
@@ -9,47 +12,6 @@
 
 namespace TalosAP {
 
-// ============================================================
-// FLinearColor (matching UE5 memory layout: 4 floats = 16 bytes)
-// ============================================================
-struct LinearColor {
-    float R = 1.0f, G = 1.0f, B = 1.0f, A = 1.0f;
-};
-
-// ============================================================
-// Color Constants (matching Lua HUD colors)
-// ============================================================
-namespace HudColors {
-    inline constexpr LinearColor WHITE       { 1.0f,  1.0f,  1.0f,  1.0f };
-    inline constexpr LinearColor PLAYER      { 0.4f,  0.9f,  1.0f,  1.0f };  // cyan
-    inline constexpr LinearColor ITEM        { 0.5f,  1.0f,  0.5f,  1.0f };  // green (filler)
-    inline constexpr LinearColor PROGRESSION { 0.75f, 0.53f, 1.0f,  1.0f };  // purple
-    inline constexpr LinearColor USEFUL      { 0.4f,  0.6f,  1.0f,  1.0f };  // blue
-    inline constexpr LinearColor TRAP        { 1.0f,  0.4f,  0.4f,  1.0f };  // red
-    inline constexpr LinearColor LOCATION    { 1.0f,  0.9f,  0.4f,  1.0f };  // gold
-    inline constexpr LinearColor ENTRANCE    { 0.4f,  0.7f,  1.0f,  1.0f };  // steel blue
-    inline constexpr LinearColor SERVER      { 0.93f, 0.93f, 0.82f, 1.0f };  // warm white
-}
-
-/// Returns the HUD color for an AP item flags value.
-/// flags: 0=filler, 1=progression, 2=useful, 4=trap
-inline LinearColor ColorForFlags(int flags) {
-    switch (flags) {
-        case 1:  return HudColors::PROGRESSION;
-        case 2:  return HudColors::USEFUL;
-        case 4:  return HudColors::TRAP;
-        default: return HudColors::ITEM;
-    }
-}
-
-// ============================================================
-// TextSegment — one colored piece of a notification line
-// ============================================================
-struct TextSegment {
-    std::wstring text;
-    LinearColor  color = HudColors::WHITE;
-};
-
 // ============================================================
 // HudNotification — UMG scrolling-log overlay
 //
@@ -62,15 +24,13 @@ struct TextSegment {
 //
 // Public API:
 //   Init()                             — cache UMG UClass pointers
-//   Notify(segments, duration)         — queue a multi-color line
+//   Notify(line, duration)             — queue a multi-color line
 //   NotifySimple(text, color, duration)— queue a single-color line
 //   Tick(deltaTicks)                   — drain queue, expire entries
 //   Clear()                            — remove all entries
 // ============================================================
 class HudNotification {
 public:
-    static constexpr int   MAX_VISIBLE    = 15;
-    static constexpr float DEFAULT_DURATION = 6.0f;   // seconds
     static constexpr float START_X        = 40.0f;
     static constexpr float START_Y        = 400.0f;
     static constexpr float LINE_SPACING   = 34.0f;
@@ -80,14 +40,21 @@ public:
     /// Cache UMG class pointers. Call once from on_unreal_init.
     bool Init();
 
-    /// Queue a notification with multiple colored segments.
-    void Notify(const std::vector<TextSegment>& segments,
-                float duration = DEFAULT_DURATION);
+    /// Line limit and default duration (tunables hud_max_visible,
+    /// hud_duration_s). A lower limit trims the oldest lines on the next
+    /// Tick.
+    void ApplyTunables(const Tunables& t);
+
+    /// Queue a notification with multiple colored segments. The line is
+    /// moved into the queue; pass a temporary or std::move. A duration
+    /// of 0 uses the configured default.
+    void Notify(HudLine line,
+                float duration = 0.0f);
 
     /// Queue a single-color notification.
-    void NotifySimple(const std::wstring& text,
+    void NotifySimple(std::wstring_view text,
                       const LinearColor& color = HudColors::WHITE,
-                      float duration = DEFAULT_DURATION);
+                      float duration = 0.0f);
 
     /// Called every tick from on_update. Manages widget lifecycle,
     /// drains pending queue, and expires old entries.
@@ -97,6 +64,9 @@ public:
     /// Remove all visible entries and clear the pending queue.
     void Clear();
 
+    /// Notifications waiting for a free line.
+    size_t GetPendingCount() const { return m_pendingQueue.size(); }
+
     /// Check if the HUD system is initialized.
     bool IsInitialized() const { return m_classesLoaded; }
 
@@ -109,21 +79,8 @@ private:
     RC::Unreal::UObject* m_hboxClass          = nullptr;
     bool m_classesLoaded = false;
 
-    // ---- UFunction pointers (cached, safe — UFunction objects are persistent) ----
-    RC::Unreal::UFunction* m_fnAddToViewport       = nullptr;
-    RC::Unreal::UFunction* m_fnGetIsVisible        = nullptr;
-    RC::Unreal::UFunction* m_fnRemoveFromParent    = nullptr;
-    RC::Unreal::UFunction* m_fnAddChildToCanvas    = nullptr;
-    RC::Unreal::UFunction* m_fnRemoveChild         = nullptr;
-    RC::Unreal::UFunction* m_fnAddChildToHBox      = nullptr;
-    RC::Unreal::UFunction* m_fnSetText             = nullptr;
-    RC::Unreal::UFunction* m_fnSetColorAndOpacity  = nullptr;
-    RC::Unreal::UFunction* m_fnSetShadowOffset     = nullptr;
-    RC::Unreal::UFunction* m_fnSetShadowColorAndOpacity = nullptr;
-    RC::Unreal::UFunction* m_fnSetPosition         = nullptr;
-    RC::Unreal::UFunction* m_fnSetAutoSize         = nullptr;
-    RC::Unreal::UFunction* m_fnSetFont             = nullptr;
-    RC::Unreal::UFunction* m_fnSetVisibility       = nullptr;
+    // ---- UFunction thunks are file-scope in HudNotification.cpp ----
+    bool m_functionsReady = false;
 
     // ---- Widget state (recreated per session, not cached across ticks) ----
     // We store the FName of the widget so we can look it up each tick.
@@ -142,13 +99,16 @@ private:
     std::deque<Entry> m_entries;
     int m_entryCounter = 0;
     float m_timeAccum  = 0.0f;
+    int   m_maxVisible      = DEFAULT_TUNABLES.hud_max_visible;
+    float m_defaultDuration = DEFAULT_TUNABLES.hud_duration_s;   // seconds
 
     // ---- Pending queue ----
     struct PendingNotification {
-        std::vector<TextSegment> segments;
-        float duration;
+        HudLine line;
+        float   duration;
     };
     std::deque<PendingNotification> m_pendingQueue;
+    std::wstring m_segmentText;   ///< null-terminated copy of one segment for FText
 
     // ---- Internal helpers ----
     bool CacheClasses();
@@ -156,8 +116,9 @@ private:
     bool CreateWidget();
     void DestroyWidget();
     bool EnsureWidgetVisible();
-    void AddEntry(const std::vector<TextSegment>& segments, float duration);
+    void AddEntry(const HudLine& line, float duration);
     void RemoveEntry(const Entry& entry);
+    void TrimEntries();
     void RepositionEntries();
     void ExpireTick();
 };
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Utf.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace TalosAP {
+
+// ============================================================
+// FLinearColor (matching UE5 memory layout: 4 floats = 16 bytes)
+// ============================================================
+struct LinearColor {
+    float R = 1.0f, G = 1.0f, B = 1.0f, A = 1.0f;
+};
+
+// ============================================================
+// Color Constants (matching Lua HUD colors)
+// ============================================================
+namespace HudColors {
+    inline constexpr LinearColor WHITE       { 1.0f,  1.0f,  1.0f,  1.0f };
+    inline constexpr LinearColor PLAYER      { 0.4f,  0.9f,  1.0f,  1.0f };  // cyan
+    inline constexpr LinearColor ITEM        { 0.5f,  1.0f,  0.5f,  1.0f };  // green (filler)
+    inline constexpr LinearColor PROGRESSION { 0.75f, 0.53f, 1.0f,  1.0f };  // purple
+    inline constexpr LinearColor USEFUL      { 0.4f,  0.6f,  1.0f,  1.0f };  // blue
+    inline constexpr LinearColor TRAP        { 1.0f,  0.4f,  0.4f,  1.0f };  // red
+    inline constexpr LinearColor LOCATION    { 1.0f,  0.9f,  0.4f,  1.0f };  // gold
+    inline constexpr LinearColor ENTRANCE    { 0.4f,  0.7f,  1.0f,  1.0f };  // steel blue
+    inline constexpr LinearColor SERVER      { 0.93f, 0.93f, 0.82f, 1.0f };  // warm white
+}
+
+/// Returns the HUD color for an AP item flags value.
+/// flags: 0=filler, 1=progression, 2=useful, 4=trap
+inline LinearColor ColorForFlags(int flags) {
+    switch (flags) {
+        case 1:  return HudColors::PROGRESSION;
+        case 2:  return HudColors::USEFUL;
+        case 4:  return HudColors::TRAP;
+        default: return HudColors::ITEM;
+    }
+}
+
+// ============================================================
+// TextSegment — one colored piece of a notification line
+//
+// A view into its HudLine's text, not a string of its own.
+// ============================================================
+struct TextSegment {
+    uint32_t    offset = 0;     ///< wchar_t units into HudLine::Text()
+    uint32_t    length = 0;
+    LinearColor color = HudColors::WHITE;
+};
+
+// ============================================================
+// HudLine — one notification: all of its text in one buffer, with the
+// colored segments over it
+//
+// The buffer is the message's arena. Network text is widened straight
+// into it (AppendUtf8), and the line is moved, not copied, from the
+// channel to the HUD queue, so a PrintJSON node is converted once
+// between the socket and the TextBlock. Clear() keeps the capacity for
+// the next message.
+// ============================================================
+class HudLine {
+public:
+    HudLine() = default;
+
+    /// Literal lines: HudLine{ { L"You found ", HudColors::WHITE }, { name, color } }
+    HudLine(std::initializer_list<std::pair<std::wstring_view, LinearColor>> parts)
+    {
+        for (const auto& [text, color] : parts) Append(text, color);
+    }
+
+    /// Add a segment. Empty text adds nothing.
+    void Append(std::wstring_view text, const LinearColor& color)
+    {
+        if (text.empty()) return;
+        Push(m_text.size(), color);
+        m_text.append(text);
+        Close();
+    }
+
+    /// Add a segment from UTF-8, widened in place.
+    void AppendUtf8(std::string_view utf8, const LinearColor& color)
+    {
+        if (utf8.empty()) return;
+        Push(m_text.size(), color);
+        Utf::AppendWide(utf8, m_text);
+        Close();
+    }
+
+    /// The whole line, segments back to back (what the log shows).
+    std::wstring_view Text() const { return m_text; }
+    std::wstring_view Text(const TextSegment& seg) const
+    {
+        return std::wstring_view(m_text).substr(seg.offset, seg.length);
+    }
+
+    const std::vector<TextSegment>& Segments() const { return m_segments; }
+    bool Empty() const { return m_segments.empty(); }
+
+    void Clear()
+    {
+        m_text.clear();
+        m_segments.clear();
+    }
+
+    /// Decoding side (APChannel::Reader): the text buffer to fill and
+    /// the segments to rebuild over it.
+    std::wstring& TextBuffer() { return m_text; }
+    std::vector<TextSegment>& SegmentBuffer() { return m_segments; }
+
+private:
+    void Push(size_t offset, const LinearColor& color)
+    {
+        m_segments.push_back({ static_cast<uint32_t>(offset), 0, color });
+    }
+
+    void Close()
+    {
+        auto& seg = m_segments.back();
+        seg.length = static_cast<uint32_t>(m_text.size() - seg.offset);
+        if (seg.length == 0) m_segments.pop_back();
+    }
+
+    std::wstring             m_text;
+    std::vector<TextSegment> m_segments;
+};
+
+} // namespace TalosAP
@@ -22,10 +22,10 @@ public:
     static void FindProgressObject(ModState& state, bool forceRefresh = false);
 
     /// Grant an item — add to GrantedItems and TMap.
-    static void GrantItem(ModState& state, const std::string& tetrominoId);
+    static void GrantItem(ModState& state, const ItemId& tetrominoId);
 
     /// Revoke an item — remove from GrantedItems and TMap.
-    static void RevokeItem(ModState& state, const std::string& tetrominoId);
+    static void RevokeItem(ModState& state, const ItemId& tetrominoId);
 
     /// Enforce collection state: sync TMap with GrantedItems.
     /// Removes non-granted items, ensures granted items are present.
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "FlatHashMap.h"
+#include "FixedString.h"
+
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <cstdint>
 #include <optional>
+#include <string_view>
 
 namespace TalosAP {
 
@@ -24,26 +27,30 @@ public:
 
     /// Resolve the next concrete tetromino for a received AP item.
     /// Increments per-prefix counter. Returns empty if exhausted/unknown.
-    std::optional<std::string> ResolveNextItem(int64_t apItemId);
+    std::optional<ItemId> ResolveNextItem(int64_t apItemId);
 
     /// Reset received-item counters. Must be called on (re)connect before
     /// the AP server replays all received items.
     void ResetItemCounters();
 
     /// Get the AP location ID for a tetromino ID. Returns -1 if unknown.
-    int64_t GetLocationId(const std::string& tetrominoId) const;
+    int64_t GetLocationId(const ItemId& tetrominoId) const;
 
     /// Get the tetromino ID for an AP location ID. Returns empty if unknown.
-    std::string GetLocationName(int64_t locationId) const;
+    ItemId GetLocationName(int64_t locationId) const;
+
+    /// Get the star ID for a puzzle code (e.g. "S015" → "Star1").
+    /// Returns empty if the puzzle has no star.
+    static ItemId StarForPuzzle(std::string_view puzzleCode);
 
     /// Get the human-readable display name for an AP item ID (e.g. "Green J").
     std::string GetDisplayName(int64_t apItemId) const;
 
     /// Get the display name for a tetromino ID string (e.g. "DJ3" → "Green J").
-    std::string GetDisplayNameForTetromino(const std::string& tetrominoId) const;
+    std::string GetDisplayNameForTetromino(const ItemId& tetrominoId) const;
 
     /// Get the shape+color prefix for an AP item ID (e.g. 0x540000 → "DJ").
-    std::string GetItemPrefix(int64_t apItemId) const;
+    ItemId GetItemPrefix(int64_t apItemId) const;
 
     /// Get all location IDs as a sorted vector.
     std::vector<int64_t> GetAllLocationIds() const;
@@ -53,22 +60,22 @@ public:
 
 private:
     /// AP item ID → prefix (e.g. 0x540000 → "DJ")
-    std::unordered_map<int64_t, std::string> m_apItemIdToPrefix;
+    FlatHashMap<int64_t, ItemId> m_apItemIdToPrefix;
 
     /// Prefix → display name (e.g. "DJ" → "Green J")
-    std::unordered_map<std::string, std::string> m_prefixDisplayNames;
+    FlatHashMap<ItemId, std::string> m_prefixDisplayNames;
 
     /// Prefix → ordered sequence of tetromino IDs (e.g. "DJ" → {"DJ1","DJ2","DJ3","DJ4","DJ5"})
-    std::unordered_map<std::string, std::vector<std::string>> m_tetrominoSequences;
+    FlatHashMap<ItemId, std::vector<ItemId>> m_tetrominoSequences;
 
     /// Tetromino/star ID → AP location ID
-    std::unordered_map<std::string, int64_t> m_locationNameToId;
+    FlatHashMap<ItemId, int64_t> m_locationNameToId;
 
     /// AP location ID → tetromino/star ID
-    std::unordered_map<int64_t, std::string> m_locationIdToName;
+    FlatHashMap<int64_t, ItemId> m_locationIdToName;
 
     /// Per-prefix received count (how many of each type AP has sent)
-    std::unordered_map<std::string, int> m_receivedCounts;
+    FlatHashMap<ItemId, int> m_receivedCounts;
 
     void BuildTables();
     void BuildSequences();
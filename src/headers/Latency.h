@@ -0,0 +1,184 @@
+#pragma once
+
+#include "FlatHashMap.h"
+#include "FixedString.h"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace TalosAP {
+
+// ============================================================
+// End-to-end latency of the paths players notice
+//
+// Each path has a start stamp and an end stamp, both from MonoNs(), and
+// every completed pair becomes one histogram sample:
+//
+//   CheckConfirm   proximity pickup → server confirms the location
+//                  (session's location-checked handler)
+//   ItemCollected  session's items-received handler → tetromino added
+//                  to CollectedTetrominos
+//   ConnectSynced  socket connected (session) → APSynced
+//   LevelScan      OpenLevel hook → ScanLevel done
+//   FenceOpen      proximity pickup → fence Open() succeeded
+//   ServerRtt      Bounce to our own slot and back (session-measured)
+//   EventDelivery  session emits an event → game thread applies it
+//
+// Session-side stamps travel in the APChannel events, so a slow stage
+// shows up as the difference between two paths: EventDelivery is the
+// ring and tick wait, CheckConfirm minus ServerRtt is everything on
+// our side of the wire.
+//
+// Game thread only. UE-free.
+// ============================================================
+
+enum class LatencyPath : uint8_t {
+    CheckConfirm,
+    ItemCollected,
+    ConnectSynced,
+    LevelScan,
+    FenceOpen,
+    ServerRtt,
+    EventDelivery,
+    Count
+};
+
+inline constexpr size_t LATENCY_PATH_COUNT = static_cast<size_t>(LatencyPath::Count);
+
+inline const char* LatencyPathName(LatencyPath p)
+{
+    static const char* names[] = {
+        "check_confirm", "item_collected", "connect_synced", "level_scan",
+        "fence_open", "server_rtt", "event_delivery",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == LATENCY_PATH_COUNT);
+    return names[static_cast<size_t>(p)];
+}
+
+/// Steady-clock nanoseconds. The same clock in the game and in
+/// TalosAPHelper (QueryPerformanceCounter / CLOCK_MONOTONIC), so stamps
+/// can cross the channel.
+inline int64_t MonoNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Log-linear histogram of durations: four buckets per power of two of
+/// microseconds, so a percentile reads at most 25% high, from 1 us to over an hour in 128 counters. Count, sum, min and max
+/// are exact.
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKETS = 4;
+    static constexpr size_t BUCKETS     = 128;
+
+    void Add(int64_t ns)
+    {
+        uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        ++m_counts[BucketOf(v / 1000)];
+        ++m_count;
+        m_sumNs += v;
+        if (m_count == 1 || v < m_minNs) m_minNs = v;
+        if (v > m_maxNs) m_maxNs = v;
+    }
+
+    void Clear() { *this = LatencyHistogram{}; }
+
+    uint64_t Count() const { return m_count; }
+    uint64_t MinNs() const { return m_minNs; }
+    uint64_t MaxNs() const { return m_maxNs; }
+    double   MeanNs() const { return m_count ? static_cast<double>(m_sumNs) / m_count : 0.0; }
+
+    /// Upper bound of the bucket holding the q-quantile (0..1), clamped
+    /// to the exact max. 0 when empty.
+    uint64_t PercentileNs(double q) const
+    {
+        if (m_count == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(m_count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += m_counts[i];
+            if (seen >= rank) {
+                uint64_t upper = BucketUpperUs(i) * 1000;
+                return upper < m_maxNs ? upper : m_maxNs;
+            }
+        }
+        return m_maxNs;
+    }
+
+    /// Bucket for a value in microseconds. 0-3 us get a bucket each; above
+    /// that, bucket = 4 * (octave - 1) + the next two bits.
+    static size_t BucketOf(uint64_t us)
+    {
+        if (us < SUB_BUCKETS) return static_cast<size_t>(us);
+        unsigned msb = 63u - static_cast<unsigned>(std::countl_zero(us));
+        size_t sub = static_cast<size_t>((us >> (msb - 2)) & (SUB_BUCKETS - 1));
+        size_t idx = (msb - 1) * SUB_BUCKETS + sub;
+        return idx < BUCKETS ? idx : BUCKETS - 1;
+    }
+
+    /// Largest microsecond value that lands in bucket `i`.
+    static uint64_t BucketUpperUs(size_t i)
+    {
+        if (i < SUB_BUCKETS) return i;
+        unsigned msb = static_cast<unsigned>(i / SUB_BUCKETS) + 1;
+        uint64_t sub = i % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << (msb - 2)) - 1;
+    }
+
+private:
+    std::array<uint32_t, BUCKETS> m_counts{};
+    uint64_t m_count = 0;
+    uint64_t m_sumNs = 0;
+    uint64_t m_minNs = 0;
+    uint64_t m_maxNs = 0;
+};
+
+/// Start/finish bookkeeping and one histogram per path.
+class LatencyStats {
+public:
+    /// Open starts per path; past this the oldest run is abandoned. Only
+    /// reached when finishes go missing (grants with no progress object
+    /// to land in).
+    static constexpr size_t MAX_PENDING = 1024;
+
+    static LatencyStats& Get();
+
+    /// Keyed paths (one run per location): a later Start for the same
+    /// key restarts it.
+    void Start(LatencyPath path, const ItemId& key, int64_t ns = MonoNs());
+    /// Record the sample if `key` was started. Returns true if it was.
+    bool Finish(LatencyPath path, const ItemId& key, int64_t ns = MonoNs());
+    /// Drop a start without recording.
+    void Cancel(LatencyPath path, const ItemId& key);
+    bool HasPending(LatencyPath path) const { return !m_pending[Index(path)].empty(); }
+
+    /// Single-run paths (connect, level load): a later Begin restarts it.
+    void Begin(LatencyPath path, int64_t ns = MonoNs());
+    bool End(LatencyPath path, int64_t ns = MonoNs());
+
+    /// A sample measured elsewhere (server RTT, event delivery).
+    void Record(LatencyPath path, int64_t ns) { m_hist[Index(path)].Add(ns); }
+
+    const LatencyHistogram& Histogram(LatencyPath path) const { return m_hist[Index(path)]; }
+    size_t PendingCount(LatencyPath path) const { return m_pending[Index(path)].size(); }
+
+    /// Forget the open starts of one path, or of every path (session
+    /// reset). Histograms are kept.
+    void ClearPending(LatencyPath path);
+    void ClearPending();
+
+private:
+    LatencyStats() = default;
+
+    static size_t Index(LatencyPath p) { return static_cast<size_t>(p); }
+
+    std::array<LatencyHistogram, LATENCY_PATH_COUNT>           m_hist{};
+    std::array<FlatHashMap<ItemId, int64_t>, LATENCY_PATH_COUNT> m_pending{};
+    std::array<int64_t, LATENCY_PATH_COUNT>                    m_begin{};   ///< 0 = not running
+};
+
+} // namespace TalosAP
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "MetricsPage.h"
+#include "MappedRegion.h"
+
+#include <cstdint>
+
+namespace TalosAP {
+
+/// Publishes the mod's live state to a named shared-memory page
+/// (MetricsPage.h) that overlays and monitoring can sample at any rate —
+/// see tools/metricsdump.
+///
+/// During a tick, phases and gauges are collected into plain staging
+/// fields; Publish() at the end of the tick copies them to the page in
+/// one sequence-counted batch of relaxed stores.
+///
+/// Game thread only.
+class LiveMetrics {
+public:
+    static LiveMetrics& Get();
+
+    /// Create the page for this process. Until this succeeds every call is
+    /// a cheap no-op.
+    bool Open();
+
+    /// Same, under an explicit name (tests and tools).
+    bool Open(const std::wstring& name, uint32_t processId);
+
+    void Close();
+
+    bool IsOpen() const { return m_page != nullptr; }
+
+    void SetGauge(MetricGauge gauge, uint64_t value)
+    {
+        m_staging.gauges[static_cast<size_t>(gauge)] = value;
+    }
+
+    /// Record one run of a phase.
+    void AddPhase(MetricPhase phase, int64_t ns);
+
+    /// Name the engine-call slots once (EngineCallStats::KindName).
+    void SetEngineCallName(size_t slot, const char* name);
+
+    void SetEngineCalls(size_t slot, uint64_t total, double perSecond);
+
+    /// Copy the staged tick to the page.
+    void Publish();
+
+    /// Steady-clock nanoseconds (the page's monoNs base).
+    static int64_t NowNs();
+
+private:
+    LiveMetrics() = default;
+
+    MappedRegion   m_region;
+    MetricsPage*   m_page = nullptr;
+    MetricSnapshot m_staging{};
+    uint64_t       m_windowMax[METRIC_PHASE_COUNT] = {};   ///< max within the current window
+    int64_t        m_windowStartNs = 0;
+};
+
+/// RAII phase timer for LiveMetrics.
+class PhaseTimer {
+public:
+    explicit PhaseTimer(MetricPhase phase)
+        : m_phase(phase), m_startNs(LiveMetrics::NowNs()) {}
+
+    ~PhaseTimer() { LiveMetrics::Get().AddPhase(m_phase, LiveMetrics::NowNs() - m_startNs); }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    MetricPhase m_phase;
+    int64_t     m_startNs;
+};
+
+} // namespace TalosAP
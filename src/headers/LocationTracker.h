@@ -0,0 +1,269 @@
+#pragma once
+
+#include "FixedString.h"
+#include "FlatHashMap.h"
+#include "SpatialGrid.h"
+#include "EngineCalls.h"
+
+#include <Unreal/UObject.hpp>
+
+#include <algorithm>
+#include <source_location>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace TalosAP {
+
+/// Kinds of AP location that exist as actors in the world.
+enum class LocationKind : uint8_t {
+    Tetromino,
+    Star,
+};
+
+// ============================================================
+// Location kind traits
+//
+// One struct per kind. A traits struct says which actor class holds
+// the location, how to read its location ID off an actor, and what
+// a proximity pickup means for it:
+//
+//   KIND               enum tag stored in TrackedLocation
+//   NAME               for logs / the F6 dump
+//   CLASS_NAME         class passed to FindAllOf
+//   PICKUP_RADIUS      proximity pickup distance (UE units)
+//   FORCE_VISIBLE      re-show the actor while the location is unchecked
+//   HIDE_WHEN_CHECKED  hide the actor once the location is checked
+//   OPENS_FENCE        a pickup queues the puzzle exit fence
+//   REPORT_WHEN_HIDDEN the game collects it itself: report once the
+//                      game hides it near the player, not on proximity
+//   ReadId(actor)      location ID, or empty if the actor isn't one
+//
+// Adding a location type is a new traits struct plus an entry in
+// VisibilityManager::Locations.
+// ============================================================
+
+/// Tetromino pickups. ID from FTetrominoInstanceInfo ("DJ1", "MT3").
+struct TetrominoTraits {
+    static constexpr LocationKind   KIND              = LocationKind::Tetromino;
+    static constexpr const char*    NAME              = "tetromino";
+    static constexpr const wchar_t* CLASS_NAME        = STR("BP_TetrominoItem_C");
+    static constexpr float          PICKUP_RADIUS     = 250.0f;
+    static constexpr bool           FORCE_VISIBLE     = true;
+    static constexpr bool           HIDE_WHEN_CHECKED = true;
+    static constexpr bool           OPENS_FENCE       = true;
+    static constexpr bool           REPORT_WHEN_HIDDEN = false;
+
+    static ItemId ReadId(RC::Unreal::UObject* actor);
+};
+
+/// Puzzle stars. ID from the star's puzzle code via ItemMapping
+/// ("S015" → "Star1"). The game owns a star's visibility and collection:
+/// a star counts as picked up only when the game hides one the player
+/// is standing at, after it was seen visible — walking past reports
+/// nothing. CLASS_NAME and the PuzzleCode property are NOT in the
+/// header dump (offsets/CXXHeaderDump has no star type); see ReadId and
+/// the per-level star check in VisibilityManager::ScanLevel.
+struct StarTraits {
+    static constexpr LocationKind   KIND              = LocationKind::Star;
+    static constexpr const char*    NAME              = "star";
+    static constexpr const wchar_t* CLASS_NAME        = STR("BP_Star_C");
+    static constexpr float          PICKUP_RADIUS     = 250.0f;
+    static constexpr bool           FORCE_VISIBLE     = false;
+    static constexpr bool           HIDE_WHEN_CHECKED = false;
+    static constexpr bool           OPENS_FENCE       = false;
+    static constexpr bool           REPORT_WHEN_HIDDEN = true;
+
+    static ItemId ReadId(RC::Unreal::UObject* actor);
+
+    /// What ReadId made of the actors it was given since the last
+    /// ResetProbe(). ScanLevel reports it per level, so a wrong property
+    /// name or an unmapped puzzle code shows up in the log.
+    struct Probe {
+        uint32_t actors      = 0;
+        uint32_t noCode      = 0;   ///< no readable PuzzleCode property
+        uint32_t unknownCode = 0;   ///< code not in ItemMapping's ALL_STARS
+    };
+    static const Probe& LastProbe();
+    static void ResetProbe();
+};
+
+/// Cached state for one location actor. Positions are read at
+/// scan/refresh time; actor pointers are NOT stored (stale pointer risk).
+struct TrackedLocation {
+    ItemId       id;                             ///< e.g. "DJ1", "Star12"
+    LocationKind kind = LocationKind::Tetromino;
+    float x = 0.0f;                              ///< World position X
+    float y = 0.0f;                              ///< World position Y
+    float z = 0.0f;                              ///< World position Z
+    bool  reported = false;                      ///< True if proximity pickup already sent
+    int   visRetries = 0;                        ///< Remaining retries to force visibility
+    bool  hasPosition = false;                   ///< Whether position was successfully read
+    bool  seenVisible = false;                   ///< REPORT_WHEN_HIDDEN: visible near the player since tracked
+};
+
+/// Runtime view of a traits struct, for code that handles every kind
+/// the same way (the per-tick loop, logging).
+struct LocationKindInfo {
+    LocationKind   kind;
+    const char*    name;
+    const wchar_t* className;
+    float          pickupRadius;
+    bool           forceVisible;
+    bool           hideWhenChecked;
+    bool           opensFence;
+    bool           reportWhenHidden;
+
+    template <typename Traits>
+    static constexpr LocationKindInfo Of()
+    {
+        return { Traits::KIND, Traits::NAME, Traits::CLASS_NAME, Traits::PICKUP_RADIUS,
+                 Traits::FORCE_VISIBLE, Traits::HIDE_WHEN_CHECKED, Traits::OPENS_FENCE,
+                 Traits::REPORT_WHEN_HIDDEN };
+    }
+};
+
+/// Location actors of every kind in `Kinds...`, keyed by location ID,
+/// with a spatial index over their cached positions.
+///
+/// Discover() is the single discovery pass: one FindAllOf per kind,
+/// each actor's ID read through its kind's traits. Callers decide what
+/// to do with each (actor, ID) — build the cache, apply visibility —
+/// so scan, refresh and enforcement share one loop instead of three.
+///
+/// Game thread only. Like the cache it replaces, never holds a UObject*
+/// beyond the Discover() call that produced it.
+template <typename... Kinds>
+class LocationTracker {
+public:
+    static_assert(sizeof...(Kinds) > 0, "LocationTracker needs at least one kind");
+
+    /// Largest pickup radius over all kinds — the index query radius.
+    static constexpr float MAX_PICKUP_RADIUS = std::max({ Kinds::PICKUP_RADIUS... });
+
+    LocationTracker() : m_grid(2.0f * MAX_PICKUP_RADIUS) {}
+
+    static const LocationKindInfo& Info(LocationKind kind)
+    {
+        static constexpr LocationKindInfo table[] = { LocationKindInfo::Of<Kinds>()... };
+        for (const auto& info : table) {
+            if (info.kind == kind) return info;
+        }
+        return table[0];
+    }
+
+    /// Discovery pass. For each kind in order, FindAllOf its class into
+    /// `scratch` and call fn(info, actor, id) for every actor with a
+    /// valid ID. fn returns false to abort the whole pass (stale world).
+    /// A kind whose FindAllOf throws is skipped. Returns false if
+    /// aborted.
+    template <typename Fn>
+    bool Discover(std::vector<RC::Unreal::UObject*>& scratch, Fn&& fn,
+                  const std::source_location& loc = std::source_location::current())
+    {
+        return (DiscoverKind<Kinds>(scratch, fn, loc) && ...);
+    }
+
+    /// Entry for `id`, created with `kind` if new.
+    TrackedLocation& Track(const ItemId& id, LocationKind kind)
+    {
+        auto [it, inserted] = m_entries.try_emplace(id);
+        if (inserted) {
+            it->second.id = id;
+            it->second.kind = kind;
+        }
+        return it->second;
+    }
+
+    TrackedLocation* Find(const ItemId& id)
+    {
+        auto it = m_entries.find(id);
+        return it == m_entries.end() ? nullptr : &it->second;
+    }
+
+    /// Drop entries for which pred(entry) is true.
+    template <typename Pred>
+    void EraseIf(Pred&& pred)
+    {
+        erase_if(m_entries, [&pred](const auto& entry) { return pred(entry.second); });
+    }
+
+    void Clear()
+    {
+        m_entries.clear();
+        m_grid.Clear();
+    }
+
+    /// Rebuild the spatial index from the cached positions. Call after
+    /// a scan or refresh has updated them.
+    void RebuildIndex()
+    {
+        m_grid.Clear();
+        for (const auto& [id, loc] : m_entries) {
+            if (loc.hasPosition) m_grid.Insert(id, loc.x, loc.y, loc.z);
+        }
+    }
+
+    /// Multiplier on every kind's pickup radius (tunables). The index
+    /// cell size stays at 2 × MAX_PICKUP_RADIUS; a larger scale only
+    /// makes queries visit more cells.
+    void SetPickupScale(float scale) { m_pickupScale = scale; }
+
+    /// Calls fn(entry, distSq) for every indexed location within its
+    /// own kind's pickup radius of (x, y, z).
+    template <typename Fn>
+    void ForEachNear(float x, float y, float z, Fn&& fn)
+    {
+        m_grid.Query(x, y, z, MAX_PICKUP_RADIUS * m_pickupScale, [&](const ItemId& id, float distSq) {
+            TrackedLocation* loc = Find(id);
+            if (!loc) return;
+            float r = Info(loc->kind).pickupRadius * m_pickupScale;
+            if (distSq < r * r) fn(*loc, distSq);
+        });
+    }
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    size_t CountOf(LocationKind kind) const
+    {
+        size_t n = 0;
+        for (const auto& [id, loc] : m_entries) {
+            if (loc.kind == kind) ++n;
+        }
+        return n;
+    }
+
+    auto begin() { return m_entries.begin(); }
+    auto end() { return m_entries.end(); }
+    auto begin() const { return m_entries.begin(); }
+    auto end() const { return m_entries.end(); }
+
+private:
+    template <typename K, typename Fn>
+    static bool DiscoverKind(std::vector<RC::Unreal::UObject*>& scratch, Fn& fn,
+                             const std::source_location& loc)
+    {
+        static constexpr LocationKindInfo info = LocationKindInfo::Of<K>();
+        scratch.clear();
+        try {
+            Engine::FindAllOf(K::CLASS_NAME, scratch, loc);
+        }
+        catch (...) {
+            return true;
+        }
+        for (auto* actor : scratch) {
+            if (!actor) continue;
+            ItemId id = K::ReadId(actor);
+            if (id.empty()) continue;
+            if (!fn(info, actor, id)) return false;
+        }
+        return true;
+    }
+
+    FlatHashMap<ItemId, TrackedLocation> m_entries;
+    SpatialGrid<ItemId> m_grid;
+    float m_pickupScale = 1.0f;
+};
+
+} // namespace TalosAP
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace TalosAP {
+
+/// A read/write memory mapping, either backed by a file on disk or by a
+/// named shared-memory object. Dirty pages of a file-backed mapping are
+/// written back by the OS even if the process dies, which is what makes
+/// the flight recorder crash-proof.
+///
+/// Windows uses CreateFileMapping/MapViewOfFile; everything else uses
+/// mmap (file) or shm_open (named), so the same code backs the Linux tools.
+class MappedRegion {
+public:
+    MappedRegion() = default;
+    ~MappedRegion();
+
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+
+    /// Map `size` bytes of a file, creating or growing it as needed.
+    bool OpenFile(const std::wstring& path, size_t size);
+
+    /// Map a named shared-memory block. With create=false the block must
+    /// already exist (reader side).
+    bool OpenNamed(const std::wstring& name, size_t size, bool create);
+
+    /// Unmap and close. Safe to call more than once.
+    void Close();
+
+    void*  Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    bool   IsOpen() const { return m_data != nullptr; }
+
+private:
+    void*  m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void*  m_file    = nullptr;   // HANDLE
+    void*  m_mapping = nullptr;   // HANDLE
+#else
+    int    m_fd = -1;
+#endif
+};
+
+} // namespace TalosAP
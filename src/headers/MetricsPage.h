@@ -0,0 +1,153 @@
+#pragma once
+
+// Layout of the live metrics page (shared memory "TalosAP.Metrics.<pid>").
+// Shared by the in-game writer and tools/metricsdump, so it must stay free
+// of UE4SS and Windows dependencies.
+//
+// The mod rewrites the page once per tick. Values are relaxed atomic
+// stores bracketed by a sequence counter: odd while a tick is being
+// published, even once it is complete. Readers copy everything, then
+// re-check the counter (ReadMetrics below) — no locks, no syscalls, no
+// round trips to the game.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace TalosAP {
+
+inline constexpr uint32_t METRICS_MAGIC   = 0x4D504154; // "TAPM"
+inline constexpr uint32_t METRICS_VERSION = 2;
+
+/// Instantaneous values, sampled at the end of each tick. Values are part
+/// of the page layout — append only, and bump METRICS_VERSION.
+enum class MetricGauge : uint16_t {
+    Tick,                ///< on_update calls since start
+    WorldGeneration,     ///< ModState::WorldGeneration
+    CooldownTicks,       ///< remaining level-transition cooldown
+    APSynced,            ///< 0/1
+    LinkState,           ///< APChannel::LinkState
+    SlotConnected,       ///< 0/1
+    SessionPid,          ///< TalosAPHelper pid, 0 = in-process / none
+    SessionHeartbeat,    ///< bumped by every session loop
+    NextItemIndex,       ///< next ReceivedItems index the session expects
+    GrantedItems,
+    CheckedLocations,
+    TrackedTetrominos,
+    HudPending,          ///< notifications waiting for a HUD slot
+    FenceOpensPending,
+    ToModBytes,          ///< session -> game ring fill
+    ToSessionBytes,      ///< game -> session ring fill
+    ArenaBytes,          ///< tick arena high-water
+    HeapAllocsLastTick,  ///< only with TALOSAP_ALLOC_COUNTER
+    ModObjectsHeld,      ///< UObjects the mod created and still references (ObjectTracker)
+    ModObjectsReleased,  ///< dropped by the mod, not yet collected
+    ModObjectsFlagged,   ///< overdue or lost, cumulative
+    ModNameEntries,      ///< distinct FName entries the mod has added
+    Count
+};
+
+/// Timed sections of on_update.
+enum class MetricPhase : uint16_t {
+    Tick,
+    APPoll,
+    HudTick,
+    ProgressRefresh,
+    ScanLevel,
+    EnforceVisibility,
+    RefreshVisibility,
+    FenceOpens,
+    EnforceCollection,
+    Count
+};
+
+/// Slots for EngineCallKind (checked where the mod publishes them).
+inline constexpr size_t METRICS_ENGINE_CALL_SLOTS = 8;
+
+inline constexpr size_t METRIC_GAUGE_COUNT = static_cast<size_t>(MetricGauge::Count);
+inline constexpr size_t METRIC_PHASE_COUNT = static_cast<size_t>(MetricPhase::Count);
+
+inline const char* MetricGaugeName(MetricGauge g)
+{
+    static const char* names[] = {
+        "tick", "world_generation", "cooldown_ticks", "ap_synced", "link_state",
+        "slot_connected", "session_pid", "session_heartbeat", "next_item_index",
+        "granted_items", "checked_locations", "tracked_tetrominos", "hud_pending",
+        "fence_opens_pending", "to_mod_bytes", "to_session_bytes", "arena_bytes",
+        "heap_allocs_last_tick", "mod_objects_held", "mod_objects_released",
+        "mod_objects_flagged", "mod_name_entries",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == METRIC_GAUGE_COUNT);
+    return names[static_cast<size_t>(g)];
+}
+
+inline const char* MetricPhaseName(MetricPhase p)
+{
+    static const char* names[] = {
+        "on_update", "AP.Poll", "HUD.Tick", "ProgressRefresh", "ScanLevel",
+        "EnforceVisibility", "RefreshVisibility", "FenceOpens", "EnforceCollection",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == METRIC_PHASE_COUNT);
+    return names[static_cast<size_t>(p)];
+}
+
+inline std::wstring MetricsNameFor(uint32_t pid)
+{
+    return L"TalosAP.Metrics." + std::to_wstring(pid);
+}
+
+/// One phase's counters. Rates and averages come from diffing two samples.
+template <typename T>
+struct MetricPhaseSlot {
+    T runs;          ///< times the phase ran
+    T totalNs;       ///< summed duration
+    T lastNs;        ///< duration of the latest run
+    T maxNs;         ///< longest run over the last one to two seconds
+};
+
+/// Everything a tick publishes. Page holds it as atomics; readers get a
+/// plain copy.
+template <typename T>
+struct MetricValues {
+    T monoNs;                                         ///< steady clock at publish
+    T gauges[METRIC_GAUGE_COUNT];
+    MetricPhaseSlot<T> phases[METRIC_PHASE_COUNT];
+    T engineCallTotals[METRICS_ENGINE_CALL_SLOTS];
+    T engineCallRates[METRICS_ENGINE_CALL_SLOTS];     ///< per second, last window
+};
+
+struct MetricsPage {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pageBytes;          ///< sizeof(MetricsPage) — readers reject mismatches
+    uint32_t processId;
+    char     engineCallNames[METRICS_ENGINE_CALL_SLOTS][24];
+    alignas(64) std::atomic<uint64_t> seq;
+    alignas(64) MetricValues<std::atomic<uint64_t>> values;
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "metrics must be lock-free across processes");
+
+using MetricSnapshot = MetricValues<uint64_t>;
+
+/// Copy a consistent snapshot of `page`. Returns false if the writer kept
+/// the page busy for every attempt (or never published).
+inline bool ReadMetrics(const MetricsPage& page, MetricSnapshot& out, int attempts = 64)
+{
+    constexpr size_t N = sizeof(MetricSnapshot) / sizeof(uint64_t);
+    static_assert(sizeof(MetricValues<std::atomic<uint64_t>>) == sizeof(MetricSnapshot));
+
+    const auto* src = reinterpret_cast<const std::atomic<uint64_t>*>(&page.values);
+    auto* dst = reinterpret_cast<uint64_t*>(&out);
+
+    for (int i = 0; i < attempts; ++i) {
+        uint64_t s1 = page.seq.load(std::memory_order_acquire);
+        if (s1 == 0 || (s1 & 1)) continue;
+        for (size_t k = 0; k < N; ++k) dst[k] = src[k].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (page.seq.load(std::memory_order_relaxed) == s1) return true;
+    }
+    return false;
+}
+
+} // namespace TalosAP
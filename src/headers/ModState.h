@@ -1,9 +1,13 @@
 #pragma once
 
+#include "FlightRecorder.h"
+#include "FlatHashMap.h"
+#include "FixedString.h"
+#include "Tunables.h"
+
 #include <Unreal/UObject.hpp>
-#include <unordered_map>
-#include <unordered_set>
 #include <string>
+#include <vector>
 #include <mutex>
 #include <atomic>
 
@@ -21,13 +25,30 @@ struct ModState {
     /// and UObject access are skipped to avoid stale pointer crashes.
     int LevelTransitionCooldown = 30;
 
+    /// The tunables in effect (config.json, re-read when it changes).
+    /// Transition hooks take their cooldowns from here. Game thread only.
+    Tunables Tuning;
+
+    /// Incremented on every level transition / save load. Lets logs and the
+    /// flight recorder tell which world a piece of work belonged to. The
+    /// update loop starts the level's entry task (progress refresh, location
+    /// scan) when it sees this change.
+    uint32_t WorldGeneration = 0;
+
     /// Items granted by the AP server (tetromino ID → true).
     /// Source of truth for what should be in the CollectedTetrominos TMap.
-    std::unordered_set<std::string> GrantedItems;
+    FlatHashSet<ItemId> GrantedItems;
 
     /// Locations physically picked up this session (tetromino ID → true).
     /// Items here stay hidden so the player doesn't see respawn spam.
-    std::unordered_set<std::string> CheckedLocations;
+    FlatHashSet<ItemId> CheckedLocations;
+
+    /// CollectedTetrominos as the save file had it at startup (SaveReader).
+    /// Read before any world loads; used to diff against the server.
+    FlatHashSet<ItemId> SavedTetrominos;
+
+    /// Whether SavedTetrominos came from a readable save.
+    bool SaveSeeded = false;
 
     /// Whether Archipelago has synced items at least once this session.
     /// EnforceCollectionState is BLOCKED until this is true.
@@ -37,19 +58,15 @@ struct ModState {
     /// TMap boolean so pieces can be placed into arrangers again.
     bool ReusableTetrominos = false;
 
-    /// Deferred flags — set by hooks, processed by the update loop.
-    bool NeedsProgressRefresh = true;
-
-    /// When true, the VisibilityManager should rescan all tetromino actors.
-    /// Set on level transitions and save loads.
-    bool NeedsTetrominoScan = true;
-
     /// Set by the F6 key handler; cleared after DumpCollectedTetrominos fires.
     std::atomic<bool> PendingInventoryDump = false;
 
     /// Set by the F9 key handler; cleared after test notifications are queued.
     std::atomic<bool> PendingHudTest = false;
 
+    /// Set by the F7 key handler; cleared after the trace ring is written to disk.
+    std::atomic<bool> PendingTraceFlush = false;
+
     /// Mutex to protect state accessed from AP callback thread.
     /// AP callbacks push to pending queues under this lock;
     /// the game-thread update loop drains the queues.
@@ -71,10 +88,11 @@ struct ModState {
 
     /// Reset all cached UObject pointers and state for a level transition.
     void ResetForLevelTransition(int cooldownTicks = 50) {
+        ++WorldGeneration;
+        FlightRecorder::Get().Record(FlightEventKind::WorldGeneration, "world", nullptr,
+                                     WorldGeneration, static_cast<uint32_t>(cooldownTicks));
         CurrentProgress = nullptr;
         LevelTransitionCooldown = cooldownTicks;
-        NeedsProgressRefresh = true;
-        NeedsTetrominoScan = true;
     }
 
     /// Reset checked locations (e.g. on new session or reconnect).
@@ -83,23 +101,23 @@ struct ModState {
     }
 
     /// Mark a location as checked.
-    void MarkLocationChecked(const std::string& tetrominoId) {
+    void MarkLocationChecked(const ItemId& tetrominoId) {
         CheckedLocations.insert(tetrominoId);
     }
 
     /// Check if a location has been checked this session.
-    bool IsLocationChecked(const std::string& tetrominoId) const {
+    bool IsLocationChecked(const ItemId& tetrominoId) const {
         return CheckedLocations.count(tetrominoId) > 0;
     }
 
     /// Check if an item has been granted by AP.
-    bool IsGranted(const std::string& tetrominoId) const {
+    bool IsGranted(const ItemId& tetrominoId) const {
         return GrantedItems.count(tetrominoId) > 0;
     }
 
     /// Whether a tetromino should be collectable in-world.
     /// True if the location has NOT been checked.
-    bool ShouldBeCollectable(const std::string& tetrominoId) const {
+    bool ShouldBeCollectable(const ItemId& tetrominoId) const {
         return !IsLocationChecked(tetrominoId);
     }
 };
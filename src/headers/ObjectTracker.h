@@ -0,0 +1,143 @@
+#pragma once
+
+#include "FlatHashMap.h"
+#include "Latency.h"
+#include "Tunables.h"
+
+#include <Unreal/UObject.hpp>
+#include <Unreal/FWeakObjectPtr.hpp>
+
+#include <array>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TalosAP {
+
+/// What a mod-created engine object is for. Each kind has its own
+/// counts, reclaim histogram and expected lifetime (ObjectTracker.cpp).
+enum class ModObjectKind : uint8_t {
+    HudWidget,       ///< UUserWidget, one per HUD (re)creation
+    HudWidgetTree,
+    HudCanvas,
+    HudLine,         ///< HorizontalBox per notification
+    HudText,         ///< TextBlock per segment
+    HudSlot,         ///< panel slot the engine makes when we add a child
+    Count
+};
+
+inline constexpr size_t MOD_OBJECT_KIND_COUNT = static_cast<size_t>(ModObjectKind::Count);
+
+inline const char* ModObjectKindName(ModObjectKind k)
+{
+    static const char* names[] = {
+        "hud_widget", "hud_widget_tree", "hud_canvas", "hud_line", "hud_text", "hud_slot",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == MOD_OBJECT_KIND_COUNT);
+    return names[static_cast<size_t>(k)];
+}
+
+// ============================================================
+// ObjectTracker — accounting for every UObject the mod creates
+//
+// Track() registers an object with its kind, creation site and owner.
+// Release() marks the point where the mod drops its last reference
+// (RemoveChild, widget teardown); everything it owns is released with
+// it. From then on the object is GC's to take, and Tick() polls a weak
+// pointer to see when it does: the gap is the reclaim latency.
+//
+// Flagged (logged once per object):
+//   - held past its kind's expected lifetime (a HUD line still up well
+//     after hud_duration_s means RemoveEntry never ran)
+//   - released but not reclaimed after LINGER_NS (something else still
+//     references it, or GC is not running)
+//   - destroyed by the engine while the mod still held it (a dangling
+//     pointer in the mod)
+//
+// FName growth: names passed to Track() are reduced to the name-table
+// entry UE keeps ("APNotifHBox_12" → "APNotifHBox"); the number of
+// distinct entries is what the mod has added to the never-freed table.
+//
+// Game thread only. Never dereferences a tracked pointer.
+// ============================================================
+class ObjectTracker {
+public:
+    /// Released objects still alive after this are flagged. UE's default
+    /// purge interval is about a minute; five covers a slow GC.
+    static constexpr int64_t LINGER_NS = 300'000'000'000;
+
+    struct KindStats {
+        uint64_t created   = 0;
+        uint64_t reclaimed = 0;   ///< collected after Release()
+        uint64_t lost      = 0;   ///< collected while still held
+        uint64_t flagged   = 0;
+        uint32_t held      = 0;   ///< alive and referenced by the mod
+        uint32_t released  = 0;   ///< alive, waiting for GC
+        uint32_t peakLive  = 0;   ///< held + released high-water
+        LatencyHistogram reclaim;
+    };
+
+    static ObjectTracker& Get();
+
+    /// Register an object the mod constructed, or one the engine made on
+    /// its behalf. `owner` is released together with (may be null).
+    /// `name` is the FName it was created with (empty for engine names).
+    void Track(RC::Unreal::UObject* obj, ModObjectKind kind, RC::Unreal::UObject* owner,
+               std::wstring_view name,
+               const std::source_location& loc = std::source_location::current());
+
+    /// The mod has dropped `obj` and everything it owns.
+    void Release(RC::Unreal::UObject* obj);
+
+    /// Call every tick; polls for reclaimed objects once a second.
+    void Tick();
+
+    /// Follow the HUD's line duration and tick cadence: the HUD kinds'
+    /// expected hold is derived from them (ObjectTracker.cpp).
+    void ApplyTunables(const Tunables& t);
+
+    /// Log per-kind counts, reclaim latency, flagged objects by site.
+    void Dump() const;
+
+    const KindStats& Stats(ModObjectKind kind) const { return m_stats[static_cast<size_t>(kind)]; }
+    size_t HeldCount() const;
+    size_t ReleasedCount() const;
+    uint64_t FlaggedCount() const;
+    size_t NameEntries() const { return m_names.size(); }
+
+private:
+    ObjectTracker();
+
+    struct Site {
+        const char* file;
+        uint32_t    line;
+        std::string name;       ///< "HudNotification.cpp:AddEntry:441"
+        uint64_t    created = 0;
+        uint64_t    flagged = 0;
+    };
+
+    struct Record {
+        RC::Unreal::FWeakObjectPtr weak;
+        RC::Unreal::UObject* owner = nullptr;
+        ModObjectKind kind = ModObjectKind::HudWidget;
+        uint16_t      site = 0;
+        bool          flagged = false;
+        int64_t       createdNs = 0;
+        int64_t       releasedNs = 0;   ///< 0 = still held
+    };
+
+    uint16_t SiteFor(const std::source_location& loc);
+    void Collected(const Record& rec, int64_t now);
+    void Flag(Record& rec, RC::Unreal::UObject* obj, const wchar_t* why);
+
+    FlatHashMap<RC::Unreal::UObject*, Record> m_records;
+    FlatHashSet<std::wstring>                 m_names;
+    std::vector<Site>                         m_sites;
+    std::array<KindStats, MOD_OBJECT_KIND_COUNT> m_stats{};
+    std::array<int64_t, MOD_OBJECT_KIND_COUNT>   m_expectedHoldNs{};
+    int64_t m_lastPollNs = 0;
+};
+
+} // namespace TalosAP
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace TalosAP {
+
+// ============================================================
+// ReconnectBackoff — when the session may try the socket again
+//
+// apclientpp retries a dropped socket from inside poll(), gated only by
+// its own interval (1.5 s after the last attempt, doubling to 15 s).
+// APSession::Step holds poll() back while the client is disconnected
+// until Ready(), so attempts follow this schedule instead:
+//
+//   - the first retry after a working connection drops waits a random
+//     0-FIRST: a wifi blip costs one round trip, and a room full of
+//     clients dropped by one server restart doesn't return in lockstep;
+//   - each later one waits a random [d, 1.5d] with
+//     d = min(CAP, BASE * 2^failures) — never shorter than apclientpp's
+//     own gate, so the jitter is what decides.
+//
+// Session thread only. UE-free.
+// ============================================================
+class ReconnectBackoff {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto FIRST = std::chrono::milliseconds(250);
+    static constexpr auto BASE  = std::chrono::milliseconds(1500);
+    static constexpr auto CAP   = std::chrono::milliseconds(15000);
+
+    ReconnectBackoff() : m_rng(std::random_device{}()) {}
+
+    /// May a connection attempt start now?
+    bool Ready(Clock::time_point now) const { return now >= m_next; }
+
+    /// The socket closed or an attempt failed: schedule the next one.
+    /// Returns the delay chosen.
+    std::chrono::milliseconds Failed(Clock::time_point now)
+    {
+        int64_t lo = 0, hi = FIRST.count();
+        if (m_failures > 0) {
+            lo = std::min<int64_t>(CAP.count(), BASE.count() << std::min(m_failures, 16));
+            hi = lo + lo / 2;
+        }
+        std::uniform_int_distribution<int64_t> jitter(lo, hi);
+        auto delay = std::chrono::milliseconds(jitter(m_rng));
+        m_next = now + delay;
+        ++m_failures;
+        return delay;
+    }
+
+    /// Slot connected: the next drop starts from FIRST again.
+    void Succeeded() { m_failures = 0; }
+
+    int Failures() const { return m_failures; }
+
+private:
+    std::minstd_rand   m_rng;
+    Clock::time_point  m_next{};
+    int                m_failures = 0;
+};
+
+} // namespace TalosAP
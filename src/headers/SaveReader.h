@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TalosAP {
+
+/// One entry of the save's CollectedTetrominos map.
+struct SavedTetromino {
+    std::string id;     ///< tetromino ID, UTF-8 ("DJ1", "A1-1", ...)
+    bool        used;   ///< map value: placed in an arranger
+};
+
+/// What SaveReader found in a save file.
+struct SaveScan {
+    std::string error;                ///< empty when the file parsed
+    int32_t     saveGameVersion = 0;
+    int32_t     ue4Version = 0;
+    int32_t     ue5Version = 0;       ///< 0 before SaveGameFileVersion 3
+    std::string engineVersion;        ///< "5.3.2-29314046+++UE5+Release-5.3"
+    std::string saveClass;
+    bool        completeTypeNames = false;   ///< UE 5.4+ property tags
+    bool        found = false;        ///< a CollectedTetrominos map was present
+    uint32_t    properties = 0;       ///< tags visited
+    std::vector<SavedTetromino> tetrominos;
+};
+
+/// Reads collected tetrominoes straight from a Talos save file (UE
+/// SaveGame "GVAS" format), without the engine.
+///
+/// The property stream is walked in a single forward pass: every tag's
+/// size is known up front, so anything that is not on the way to
+/// CollectedTetrominos is skipped, and nested structs, struct arrays and
+/// struct-valued maps are searched recursively. Nothing else is kept.
+/// Every read is bounds-checked; a damaged or truncated file yields an
+/// error, never a crash.
+///
+/// UE-free — also built into tools/savedump.
+class SaveReader {
+public:
+    static constexpr const char* COLLECTED_TETROMINOS = "CollectedTetrominos";
+
+    /// Parse a save held in memory.
+    static bool Scan(const uint8_t* data, size_t size, SaveScan& out,
+                     const char* mapName = COLLECTED_TETROMINOS);
+
+    /// Read and parse a save file.
+    static bool ScanFile(const std::wstring& path, SaveScan& out,
+                         const char* mapName = COLLECTED_TETROMINOS);
+
+    /// The most recently written *.sav under `dir` (searched recursively),
+    /// or empty if there is none.
+    static std::wstring FindLatestSave(const std::wstring& dir);
+};
+
+} // namespace TalosAP
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "FlatHashMap.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace TalosAP {
+
+/// Uniform 3D grid over points, for "what is within r of here" queries.
+///
+/// Rebuilt wholesale whenever the point set changes (level scan, periodic
+/// refresh); queried many times in between. Each cell is a singly linked
+/// list threaded through one node array, so a rebuild reuses the previous
+/// rebuild's storage. With a cell size of twice the query radius, a query
+/// touches at most 8 cells.
+///
+/// UE-free.
+template <typename T>
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 500.0f) : m_cellSize(cellSize), m_invCell(1.0f / cellSize) {}
+
+    float CellSize() const { return m_cellSize; }
+
+    void Clear()
+    {
+        m_nodes.clear();
+        m_cells.clear();
+    }
+
+    void Insert(const T& value, float x, float y, float z)
+    {
+        uint64_t key = Key(Cell(x), Cell(y), Cell(z));
+        auto [it, inserted] = m_cells.try_emplace(key, NIL);
+        m_nodes.push_back(Node{value, x, y, z, it->second});
+        it->second = static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    /// Calls fn(value, distSq) for every point within `radius` of (x, y, z).
+    template <typename Fn>
+    void Query(float x, float y, float z, float radius, Fn&& fn) const
+    {
+        if (m_nodes.empty()) return;
+        const float r2 = radius * radius;
+        const int32_t x0 = Cell(x - radius), x1 = Cell(x + radius);
+        const int32_t y0 = Cell(y - radius), y1 = Cell(y + radius);
+        const int32_t z0 = Cell(z - radius), z1 = Cell(z + radius);
+        for (int32_t cx = x0; cx <= x1; ++cx) {
+            for (int32_t cy = y0; cy <= y1; ++cy) {
+                for (int32_t cz = z0; cz <= z1; ++cz) {
+                    auto it = m_cells.find(Key(cx, cy, cz));
+                    if (it == m_cells.end()) continue;
+                    for (uint32_t i = it->second; i != NIL; i = m_nodes[i].next) {
+                        const Node& n = m_nodes[i];
+                        float dx = n.x - x, dy = n.y - y, dz = n.z - z;
+                        float d2 = dx * dx + dy * dy + dz * dz;
+                        if (d2 <= r2) fn(n.value, d2);
+                    }
+                }
+            }
+        }
+    }
+
+    size_t size() const { return m_nodes.size(); }
+    size_t CellCount() const { return m_cells.size(); }
+
+private:
+    static constexpr uint32_t NIL = ~uint32_t(0);
+
+    // 21 bits per axis: +/-1M cells, far beyond any level.
+    static constexpr int32_t CELL_LIMIT = (1 << 20) - 1;
+
+    struct Node {
+        T        value;
+        float    x, y, z;
+        uint32_t next;
+    };
+
+    int32_t Cell(float v) const
+    {
+        float c = std::floor(v * m_invCell);
+        if (!(c > -CELL_LIMIT)) return -CELL_LIMIT;   // also NaN
+        if (c > CELL_LIMIT) return CELL_LIMIT;
+        return static_cast<int32_t>(c);
+    }
+
+    static uint64_t Key(int32_t cx, int32_t cy, int32_t cz)
+    {
+        auto bits = [](int32_t c) { return static_cast<uint64_t>(c + CELL_LIMIT + 1) & 0x1FFFFF; };
+        return (bits(cx) << 42) | (bits(cy) << 21) | bits(cz);
+    }
+
+    float m_cellSize;
+    float m_invCell;
+    std::vector<Node> m_nodes;
+    FlatHashMap<uint64_t, uint32_t> m_cells;
+};
+
+} // namespace TalosAP
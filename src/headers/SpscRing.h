@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace TalosAP {
+
+/// Single-producer / single-consumer ring of variable-length records over
+/// caller-provided memory — a heap block, or a shared-memory mapping seen
+/// by two processes.
+///
+/// The header holds two monotonically increasing byte counters, each on
+/// its own cache line: head (advanced only by the producer) and tail
+/// (advanced only by the consumer). A record is published by the release
+/// store of head, so a reader never sees a half-written one.
+///
+/// Records are [u32 size][u16 type][u16 reserved][payload], padded to 8
+/// bytes, and never wrap: if one does not fit before the end of the
+/// buffer, a pad marker fills the remainder and the record starts at 0.
+///
+/// No locks, no allocation, no syscalls. If several threads produce, the
+/// caller serialises them.
+class SpscRing {
+public:
+    struct Header {
+        uint32_t magic;
+        uint32_t capacity;    ///< data bytes, power of two
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring counters must be lock-free across processes");
+
+    static constexpr uint32_t MAGIC        = 0x474E5253; // 'SRNG'
+    static constexpr uint32_t RECORD_HDR   = 8;
+    static constexpr uint32_t PAD_MARKER   = 0xFFFFFFFFu;
+    static constexpr size_t   HEADER_BYTES = (sizeof(Header) + 63) & ~size_t(63);
+
+    /// Total bytes needed for a ring with `capacity` data bytes.
+    static constexpr size_t BytesFor(uint32_t capacity) { return HEADER_BYTES + capacity; }
+
+    /// Largest payload a single record may carry.
+    uint32_t MaxPayload() const { return m_capacity / 2 - RECORD_HDR; }
+
+    SpscRing() = default;
+
+    /// Initialise a fresh ring in `memory` (BytesFor(capacity) bytes,
+    /// 64-byte aligned). capacity must be a power of two.
+    static SpscRing Create(void* memory, uint32_t capacity)
+    {
+        auto* h = new (memory) Header{};
+        h->magic    = MAGIC;
+        h->capacity = capacity;
+        h->head.store(0, std::memory_order_relaxed);
+        h->tail.store(0, std::memory_order_relaxed);
+        return Attach(memory);
+    }
+
+    /// Attach to a ring another party created. Invalid if the header
+    /// does not check out.
+    static SpscRing Attach(void* memory)
+    {
+        SpscRing r;
+        auto* h = static_cast<Header*>(memory);
+        if (!h || h->magic != MAGIC || h->capacity == 0 || (h->capacity & (h->capacity - 1)) != 0) return r;
+        r.m_header   = h;
+        r.m_data     = static_cast<uint8_t*>(memory) + HEADER_BYTES;
+        r.m_capacity = h->capacity;
+        return r;
+    }
+
+    bool Valid() const { return m_header != nullptr; }
+
+    // ============================================================
+    // Producer
+    // ============================================================
+
+    /// Append one record. Returns false (writing nothing) if the ring is
+    /// full or the payload is larger than MaxPayload().
+    bool TryWrite(uint16_t type, const void* payload, uint32_t size)
+    {
+        if (!m_header || size > MaxPayload()) return false;
+
+        const uint64_t head = m_header->head.load(std::memory_order_relaxed);
+        const uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+        const uint32_t need = Align8(RECORD_HDR + size);
+        const uint32_t off  = static_cast<uint32_t>(head) & (m_capacity - 1);
+        const uint32_t toEnd = m_capacity - off;
+        const uint32_t skip = (need > toEnd) ? toEnd : 0;
+
+        if ((head - tail) + skip + need > m_capacity) return false;
+
+        uint64_t at = head;
+        if (skip) {
+            std::memcpy(m_data + off, &PAD_MARKER, sizeof(uint32_t));
+            at += skip;
+        }
+        uint8_t* rec = m_data + (static_cast<uint32_t>(at) & (m_capacity - 1));
+        const uint32_t reserved = static_cast<uint32_t>(type);
+        std::memcpy(rec, &size, sizeof(uint32_t));
+        std::memcpy(rec + 4, &reserved, sizeof(uint32_t));
+        if (size) std::memcpy(rec + RECORD_HDR, payload, size);
+
+        m_header->head.store(at + need, std::memory_order_release);
+        return true;
+    }
+
+    // ============================================================
+    // Consumer
+    // ============================================================
+
+    /// Hand up to maxRecords records to fn(type, const uint8_t* data,
+    /// uint32_t size) in order, releasing each one's space after fn
+    /// returns. Returns the number consumed.
+    template <typename F>
+    size_t Drain(F&& fn, size_t maxRecords = SIZE_MAX)
+    {
+        if (!m_header) return 0;
+
+        uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+        const uint64_t head = m_header->head.load(std::memory_order_acquire);
+        size_t count = 0;
+
+        while (tail != head && count < maxRecords) {
+            const uint32_t off = static_cast<uint32_t>(tail) & (m_capacity - 1);
+            uint32_t size;
+            std::memcpy(&size, m_data + off, sizeof(uint32_t));
+            if (size == PAD_MARKER) {
+                tail += m_capacity - off;
+                continue;
+            }
+            uint32_t type;
+            std::memcpy(&type, m_data + off + 4, sizeof(uint32_t));
+            fn(static_cast<uint16_t>(type), static_cast<const uint8_t*>(m_data + off + RECORD_HDR), size);
+            tail += Align8(RECORD_HDR + size);
+            m_header->tail.store(tail, std::memory_order_release);
+            ++count;
+        }
+        // A trailing pad with nothing after it is consumed too.
+        m_header->tail.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    /// Bytes currently queued (including padding); safe from either side.
+    size_t UsedBytes() const
+    {
+        if (!m_header) return 0;
+        return static_cast<size_t>(m_header->head.load(std::memory_order_acquire)
+                                 - m_header->tail.load(std::memory_order_acquire));
+    }
+
+    uint32_t Capacity() const { return m_capacity; }
+
+private:
+    static constexpr uint32_t Align8(uint32_t n) { return (n + 7) & ~7u; }
+
+    Header*  m_header   = nullptr;
+    uint8_t* m_data     = nullptr;
+    uint32_t m_capacity = 0;
+};
+
+} // namespace TalosAP
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "FlatHashMap.h"
+#include "FixedString.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace TalosAP {
+
+/// Publishes collection progress for external trackers.
+///
+/// Two files in the mod folder:
+///   talos_ap_events.ndjson  append-only, one JSON object per change, each
+///                           with an increasing "seq". Truncated at startup
+///                           (first line is {"type":"session"}).
+///   talos_ap_state.json     compact snapshot of everything so far, with the
+///                           "seq" of the last event it includes. Rewritten
+///                           atomically (temp file + rename) at most every
+///                           few seconds, and only when something changed.
+///
+/// A tracker that starts late reads the snapshot, then follows the events
+/// file from the first seq after it. Calls that repeat known state write
+/// nothing, so the stream stays small however often they are made.
+///
+/// Game thread only. Lines are buffered and written by Tick().
+class StateExport {
+public:
+    static StateExport& Get();
+
+    /// Start a new session in `dir`. Until this succeeds every call is a
+    /// cheap no-op.
+    bool Open(const std::wstring& dir);
+
+    /// Final flush and snapshot.
+    void Close();
+
+    bool IsOpen() const { return m_events.is_open(); }
+
+    void Granted(const ItemId& tetId);
+    void Checked(const ItemId& tetId);
+    void FenceOpened(const ItemId& tetId);
+    void LevelEntered(uint32_t generation, const std::string& level);
+    void Scouted(const ItemId& tetId, const std::string& item, const std::string& player, int flags);
+
+    /// The server started a fresh session: granted items will be replayed.
+    void GrantsReset();
+
+    /// Write buffered events; refresh the snapshot if it is due.
+    void Tick();
+
+private:
+    StateExport() = default;
+
+    struct Scout {
+        std::string item;
+        std::string player;
+        int flags = 0;
+    };
+
+    void Append(const char* type, const std::string& fields);
+    void WriteSnapshot();
+    int64_t NowMs() const;
+
+    std::ofstream m_events;
+    std::wstring  m_snapshotPath;
+    std::string   m_buffer;
+    uint64_t      m_seq = 0;
+    int64_t       m_startNs = 0;
+    int64_t       m_lastSnapshotMs = 0;
+    bool          m_dirty = false;
+
+    FlatHashSet<ItemId> m_granted;
+    FlatHashSet<ItemId> m_checked;
+    FlatHashSet<ItemId> m_fences;
+    FlatHashMap<ItemId, Scout> m_scouts;
+    uint32_t    m_generation = 0;
+    std::string m_level;
+};
+
+} // namespace TalosAP
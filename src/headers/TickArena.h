@@ -0,0 +1,76 @@
+#pragma once
+
+#include "FlatHashMap.h"
+
+#include <memory_resource>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace TalosAP {
+
+/// Per-tick bump allocator for transient containers.
+///
+/// Everything built during one on_update (ID → actor maps, seen-sets,
+/// per-script scratch vectors) allocates from a fixed block that is
+/// rewound once at the end of the tick. Deallocation is a no-op. If a
+/// tick ever needs more than CAPACITY bytes the overflow goes to the
+/// global heap and is counted, so it shows up in the F6 dump.
+///
+/// Game thread only. Containers built on it MUST NOT outlive the tick.
+class TickArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t CAPACITY = 64 * 1024;
+
+    static TickArena& Get();
+
+    /// Rewind to empty and free any overflow blocks. Called once at the
+    /// end of on_update.
+    void Reset();
+
+    /// Bytes handed out since the last Reset().
+    size_t Used() const { return m_offset; }
+
+    /// Largest Used() seen at any Reset().
+    size_t HighWater() const { return m_highWater; }
+
+    /// Number of allocations that did not fit and went to the heap.
+    uint64_t OverflowCount() const { return m_overflowCount; }
+
+private:
+    TickArena() = default;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void  do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    alignas(std::max_align_t) unsigned char m_buffer[CAPACITY];
+    size_t m_offset    = 0;
+    size_t m_highWater = 0;
+
+    struct Overflow { void* ptr; size_t bytes; size_t alignment; };
+    std::vector<Overflow> m_overflow;
+    uint64_t m_overflowCount = 0;
+};
+
+// ---- Arena-backed container aliases (construct with TickArena::Get()) ----
+template <typename T>
+using TickVector = std::pmr::vector<T>;
+
+template <typename K, typename V, typename Hash = FlatHash<K>>
+using TickMap = FlatHashMap<K, V, Hash, std::equal_to<>, std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+
+template <typename K, typename Hash = FlatHash<K>>
+using TickSet = FlatHashSet<K, Hash, std::equal_to<>, std::pmr::polymorphic_allocator<K>>;
+
+/// Counts global operator new calls made by this DLL, per thread: Count()
+/// is the calling thread's total. Only live when the mod is built with
+/// TALOSAP_ALLOC_COUNTER (see CMakeLists.txt); otherwise Enabled() is
+/// false and Count() stays 0.
+namespace AllocCounter {
+    bool     Enabled();
+    uint64_t Count();
+}
+
+} // namespace TalosAP
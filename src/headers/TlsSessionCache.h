@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+typedef struct ssl_st SSL;
+typedef struct ssl_session_st SSL_SESSION;
+
+namespace TalosAP {
+
+/// Client-side TLS session cache for the AP websocket.
+///
+/// wswrap builds a fresh SSL_CTX for every connection, so OpenSSL's own
+/// client cache never sees a second handshake to the same server. The
+/// websocket's TLS socket (WsConfig.h) hands each new SSL to Prime()
+/// before the handshake: the last session or ticket the server issued
+/// for that host:port is offered, and the context is set up to pass the
+/// next one back here. A reconnect after a wifi blip then resumes with
+/// an abbreviated handshake instead of a full key exchange and
+/// certificate check.
+///
+/// One entry per host:port — the mod talks to one server. Safe from any
+/// thread; in practice only the session thread calls it.
+class TlsSessionCache {
+public:
+    static TlsSessionCache& Get();
+
+    TlsSessionCache(const TlsSessionCache&) = delete;
+    TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+
+    /// Before the handshake on `ssl` to `key` (host:port).
+    void Prime(SSL* ssl, const std::string& key);
+
+    /// After a successful handshake on `ssl`: counts whether it resumed.
+    void Finished(SSL* ssl);
+
+    /// Forget the cached session.
+    void Clear();
+
+    uint64_t Resumed() const;
+    uint64_t FullHandshakes() const;
+
+private:
+    TlsSessionCache() = default;
+
+    /// SSL_CTX new-session callback. Takes ownership (returns 1).
+    static int OnNewSession(SSL* ssl, SSL_SESSION* session);
+
+    mutable std::mutex m_mutex;
+    std::string        m_key;
+    SSL_SESSION*       m_session = nullptr;
+    uint64_t           m_resumed = 0;
+    uint64_t           m_full    = 0;
+};
+
+} // namespace TalosAP
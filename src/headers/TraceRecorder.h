@@ -0,0 +1,118 @@
+#pragma once
+
+#include "FlightRecorder.h"
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+namespace TalosAP {
+
+/// Captures Chrome trace events (spans, instants, counters) into a
+/// fixed-size in-memory ring. Nothing touches the disk until Flush() is
+/// called, which writes the ring out as Chrome JSON — loadable in
+/// chrome://tracing and ui.perfetto.dev.
+///
+/// Event names and categories MUST be string literals (or otherwise live
+/// for the whole process) — only the pointer is stored. Short per-event
+/// details (tetromino IDs, hook names) are copied inline.
+///
+/// Safe to call from any thread; events are stamped with a small
+/// per-thread ID so the game thread and network work land on separate rows.
+class TraceRecorder {
+public:
+    /// Ring size. Oldest events are overwritten once full.
+    static constexpr size_t CAPACITY = 16384;
+
+    /// Max characters kept from an event's detail string.
+    static constexpr size_t DETAIL_LEN = 23;
+
+    enum class Phase : char {
+        Complete = 'X',
+        Instant  = 'i',
+        Counter  = 'C',
+    };
+
+    struct Event {
+        const char* name     = nullptr;
+        const char* category = nullptr;
+        int64_t     tsNs     = 0;       ///< Start time (ns since recorder start)
+        int64_t     durNs    = 0;       ///< Duration (Complete only)
+        int64_t     value    = 0;       ///< Counter value
+        uint32_t    tid      = 0;
+        Phase       phase    = Phase::Instant;
+        char        detail[DETAIL_LEN + 1] = {};
+    };
+
+    /// Process-wide recorder.
+    static TraceRecorder& Get();
+
+    /// Monotonic nanoseconds since the recorder was created.
+    static int64_t NowNs();
+
+    /// Small sequential ID for the calling thread (1 = first thread seen).
+    static uint32_t CurrentTid();
+
+    /// Record a finished span [startNs, endNs).
+    void Complete(const char* name, const char* category, int64_t startNs, int64_t endNs,
+                  const char* detail = nullptr);
+
+    /// Record a point-in-time event (pickup, grant, fence open...).
+    void Instant(const char* name, const char* category, const char* detail = nullptr);
+
+    /// Record a counter sample (shows as a graph track in the viewer).
+    void Counter(const char* name, int64_t value);
+
+    /// Write the ring to a Chrome JSON trace file. Returns false on I/O error.
+    /// The ring is left intact so repeated flushes show overlapping windows.
+    bool Flush(const std::wstring& path);
+
+    /// Number of events currently held (≤ CAPACITY).
+    size_t Size() const;
+
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+private:
+    TraceRecorder();
+
+    void Push(const Event& ev);
+
+    mutable std::mutex m_mutex;
+    std::vector<Event> m_ring;
+    size_t m_head  = 0;     ///< Next write slot
+    size_t m_count = 0;
+    bool   m_enabled = true;
+};
+
+/// RAII span: records a Complete event covering its lifetime. Entry and
+/// exit also go to the flight recorder, so a crash inside the span leaves
+/// an unmatched SpanBegin as the last word.
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category, const char* detail = nullptr)
+        : m_name(name), m_category(category), m_detail(detail),
+          m_startNs(TraceRecorder::NowNs())
+    {
+        FlightRecorder::Get().Record(FlightEventKind::SpanBegin, m_name, m_detail);
+    }
+
+    ~TraceScope()
+    {
+        int64_t endNs = TraceRecorder::NowNs();
+        FlightRecorder::Get().Record(FlightEventKind::SpanEnd, m_name, m_detail, endNs - m_startNs);
+        TraceRecorder::Get().Complete(m_name, m_category, m_startNs, endNs, m_detail);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_category;
+    const char* m_detail;
+    int64_t     m_startNs;
+};
+
+} // namespace TalosAP
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace TalosAP {
+
+// ============================================================
+// Tunables — cost-versus-responsiveness knobs
+//
+// Read from the "tunables" block of config.json (Config.cpp holds the
+// key names and ranges) and re-read whenever the file changes, so they
+// can be adjusted while the game runs. A missing key takes its default;
+// an out-of-range or mistyped value keeps the one in effect.
+//
+// The game thread owns the live copy: dllmain hands it to each
+// component after a (re)load, and components copy what they need.
+// Defaults are the values the mod shipped with as constants.
+// ============================================================
+struct Tunables {
+    // ---- Tick cadence (ticks; ~60 per second) ----
+    int enforce_interval_ticks    = 5;    ///< proximity pickup + visibility enforcement
+    int refresh_interval_ticks    = 60;   ///< full actor re-discovery
+    int collection_interval_ticks = 60;   ///< CollectedTetrominos enforcement
+    int hud_interval_ticks        = 12;   ///< HUD queue drain + expiry
+
+    // ---- Visibility ----
+    int   visibility_call_budget  = 16;   ///< ProcessEvent calls per tick for show/hide, all passes
+    int   scan_visibility_retries = 10;   ///< enforcement passes that re-show an item after a scan
+    int   refresh_visibility_retries = 10;///< same, after a periodic refresh
+    float pickup_radius_scale     = 1.0f; ///< multiplies every location kind's pickup radius
+
+    // ---- Fence opens ----
+    int fence_open_attempts = 10;
+    int fence_retry_ms      = 100;
+
+    // ---- HUD ----
+    int   hud_max_visible  = 15;          ///< lines on screen, and queued
+    float hud_duration_s   = 6.0f;        ///< default time a line stays up
+
+    // ---- Level transition cooldowns (ticks of no UObject work) ----
+    int cooldown_client_restart_ticks = 15;
+    int cooldown_save_loaded_ticks    = 15;
+    int cooldown_save_reload_ticks    = 20;
+    int cooldown_open_level_ticks     = 50;
+};
+
+/// Shipped values, for members that are set before the first load.
+inline constexpr Tunables DEFAULT_TUNABLES{};
+
+} // namespace TalosAP
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace TalosAP {
+
+/// UTF-8 <-> wide (UTF-16 on Windows, UTF-32 where wchar_t is 4 bytes).
+///
+/// Every string crossing between the AP protocol / config.json (UTF-8)
+/// and Unreal / the UE4SS log (wide) goes through here. Malformed input
+/// never throws: invalid UTF-8 sequences, lone surrogates and
+/// out-of-range code points each become U+FFFD. Runs of ASCII are
+/// converted 16 characters at a time with SSE2.
+namespace Utf {
+
+/// Returned by the bounded DecodeTo/EncodeTo when the output buffer is
+/// too small.
+inline constexpr size_t NO_FIT = static_cast<size_t>(-1);
+
+std::wstring ToWide(std::string_view utf8);
+std::string  ToUtf8(std::wstring_view wide);
+
+/// Append to an existing string (reuses its capacity).
+void AppendWide(std::string_view utf8, std::wstring& out);
+void AppendUtf8(std::wstring_view wide, std::string& out);
+
+/// Convert into a caller-owned buffer without allocating. Returns the
+/// number of units written (no terminator) or NO_FIT.
+size_t DecodeTo(std::string_view utf8, wchar_t* out, size_t capacity);
+size_t EncodeTo(std::wstring_view wide, char* out, size_t capacity);
+
+} // namespace Utf
+
+} // namespace TalosAP
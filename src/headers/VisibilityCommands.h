@@ -0,0 +1,113 @@
+#pragma once
+
+#include "FlatHashMap.h"
+#include "FixedString.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace TalosAP {
+
+enum class VisibilityOp : uint8_t { Show, Hide };
+
+// ============================================================
+// VisibilityCommandBuffer — show/hide requests, run on a budget
+//
+// Scans and enforcement record the state each location actor should end
+// up in instead of calling SetVisibility/SetHiddenInGame inline. A
+// location has at most one pending command: a repeat is dropped and an
+// opposing one replaces it, so a Show then Hide in the same tick costs
+// one actor update, not two.
+//
+// Execute() runs pending commands nearest-to-player first until the
+// budget it is given is spent; the rest wait for a later pass. The
+// caller hands each pass what is left of one per-tick budget.
+// Commands are keyed by location ID, never by UObject*, so the caller
+// resolves a fresh actor when each one runs.
+//
+// Game thread only. UE-free.
+// ============================================================
+class VisibilityCommandBuffer {
+public:
+    struct Stats {
+        uint64_t pushed    = 0;
+        uint64_t coalesced = 0;   ///< repeats and reversals absorbed
+        uint64_t executed  = 0;
+        uint64_t dropped   = 0;   ///< actor gone by the time it ran
+        uint64_t deferred  = 0;   ///< passes that ended with work left
+        uint64_t calls     = 0;   ///< engine calls spent
+        size_t   peakDepth = 0;
+    };
+
+    void Push(const ItemId& id, VisibilityOp op)
+    {
+        ++m_stats.pushed;
+        auto [it, inserted] = m_pending.try_emplace(id, op);
+        if (!inserted) {
+            ++m_stats.coalesced;
+            it->second = op;
+        }
+        m_stats.peakDepth = std::max(m_stats.peakDepth, m_pending.size());
+    }
+
+    bool   Empty() const { return m_pending.empty(); }
+    size_t Size() const { return m_pending.size(); }
+    void   Clear() { m_pending.clear(); }
+
+    /// Drop a pending command — the caller has already applied the state
+    /// itself (a pickup hide), so a queued Show must not undo it.
+    void Cancel(const ItemId& id) { m_pending.erase(id); }
+    const Stats& GetStats() const { return m_stats; }
+
+    /// Run commands nearest first. `distSq(id)` is the sort key;
+    /// `exec(id, op)` performs one and returns the engine calls it made,
+    /// 0 if the actor is gone, or -1 to stop this pass (stale world). A
+    /// failed command is dropped either way; the next scan or enforcement
+    /// pass queues it again if it is still needed. At least one command
+    /// runs per call, so a budget below one command's cost still makes
+    /// progress. Returns the calls spent.
+    template <typename DistFn, typename ExecFn>
+    uint32_t Execute(uint32_t callBudget, DistFn&& distSq, ExecFn&& exec)
+    {
+        if (m_pending.empty()) return 0;
+
+        m_order.clear();
+        for (const auto& [id, op] : m_pending) m_order.push_back({ id, op, distSq(id) });
+        std::sort(m_order.begin(), m_order.end(),
+                  [](const Entry& a, const Entry& b) { return a.distSq < b.distSq; });
+
+        uint32_t spent = 0;
+        for (const Entry& e : m_order) {
+            if (spent > 0 && spent >= callBudget) break;
+            int calls = exec(e.id, e.op);
+            m_pending.erase(e.id);
+            if (calls < 0) {
+                ++m_stats.dropped;
+                break;
+            }
+            if (calls == 0) {
+                ++m_stats.dropped;
+                continue;
+            }
+            ++m_stats.executed;
+            spent += static_cast<uint32_t>(calls);
+        }
+        m_stats.calls += spent;
+        if (!m_pending.empty()) ++m_stats.deferred;
+        return spent;
+    }
+
+private:
+    struct Entry {
+        ItemId       id;
+        VisibilityOp op;
+        float        distSq;
+    };
+
+    FlatHashMap<ItemId, VisibilityOp> m_pending;
+    std::vector<Entry>                m_order;    ///< Execute scratch, reused
+    Stats                             m_stats;
+};
+
+} // namespace TalosAP
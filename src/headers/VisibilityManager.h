@@ -3,53 +3,60 @@
 #include "ModState.h"
 #include "ItemMapping.h"
 #include "APClient.h"
+#include "TickArena.h"
+#include "LocationTracker.h"
+#include "GameTask.h"
+#include "VisibilityCommands.h"
+#include "Tunables.h"
 
 #include <Unreal/UObject.hpp>
 
 #include <string>
-#include <unordered_map>
 #include <vector>
-#include <deque>
 #include <functional>
+#include <source_location>
 #include <cstdint>
 
 namespace TalosAP {
 
-/// Manages tetromino actor visibility and proximity-based pickup detection.
+/// Manages location actor visibility and proximity-based pickup detection.
 ///
-/// On level load (NeedsTetrominoScan), discovers all BP_TetrominoItem_C actors
-/// and builds a TrackedTetromino cache keyed by tetromino ID. Each tick, enforces
+/// On level load (the EnterLevel task), discovers every location actor —
+/// tetrominos and stars, see LocationTracker.h — and builds a
+/// TrackedLocation cache keyed by location ID. Each tick, enforces
 /// visibility rules (show collectable, hide non-granted checked) and detects
-/// proximity-based pickups via player distance to cached item positions.
+/// proximity-based pickups via a spatial query around the player.
+///
+/// Show/hide decisions go into a VisibilityCommandBuffer and run under a
+/// per-pass engine-call budget, nearest to the player first, so a level
+/// scan's worth of actor updates spreads over a few passes. Commands only
+/// run at the end of a scan, refresh or enforcement pass, against the
+/// actors that pass already discovered — never from a FindAllOf of their
+/// own.
 ///
 /// CRITICAL: Never caches UObject* across ticks. Every scan/refresh re-discovers
-/// actors via FindAllOf. TrackedTetromino stores positional data but the actor
+/// actors via FindAllOf. TrackedLocation stores positional data but the actor
 /// pointer is only valid during the scan tick.
 class VisibilityManager {
 public:
-    /// Squared radius for proximity pickup detection (250 units ≈ 2.5m).
-    static constexpr float PICKUP_RADIUS_SQ = 250.0f * 250.0f;
-
-    /// Number of ticks to keep retrying SetVisible after game re-hides an item.
-    /// Set at scan/refresh time. NOT reset during enforcement — allows the game's
-    /// animation and collection systems to take over once our retries expire.
-    static constexpr int VISIBILITY_RETRY_COUNT = 10;
-
-    /// Per-tetromino tracking data. Positions are cached at scan time;
-    /// actor pointers are NOT stored (stale pointer risk).
-    struct TrackedTetromino {
-        std::string id;             ///< e.g. "DJ1", "MT3"
-        float x = 0.0f;            ///< World position X
-        float y = 0.0f;            ///< World position Y
-        float z = 0.0f;            ///< World position Z
-        bool  reported = false;     ///< True if proximity pickup already sent
-        int   visRetries = 0;       ///< Remaining retries to force visibility
-        bool  hasPosition = false;  ///< Whether position was successfully read
-    };
-
-    /// Scan the current level for all BP_TetrominoItem_C actors.
-    /// Builds the tracked tetromino cache and applies initial visibility.
-    /// Call when NeedsTetrominoScan is true (after level transitions).
+    /// Location kinds handled, in discovery order.
+    using Locations = LocationTracker<TetrominoTraits, StarTraits>;
+
+    /// ProcessEvent calls one show/hide command makes (SetVisibility +
+    /// SetHiddenInGame).
+    static constexpr int CALLS_PER_COMMAND = 2;
+
+    /// Call budget, show retries (ticks to keep re-showing an item the
+    /// game re-hides; set at scan/refresh time and NOT reset during
+    /// enforcement, so the game's animation and collection systems take
+    /// over once they run out), pickup radius and fence retry limits.
+    /// Takes effect from the next pass; running fence retries pick up
+    /// new limits on their next attempt.
+    void ApplyTunables(const Tunables& t);
+
+    /// Scan the current level for all location actors.
+    /// Builds the tracked location cache and applies initial visibility.
+    /// Call once per level, after the transition cooldown.
     void ScanLevel(ModState& state);
 
     /// Full visibility refresh: re-discovers actors, rebuilds cache,
@@ -58,7 +65,7 @@ public:
     void RefreshVisibility(ModState& state);
 
     /// Per-tick visibility enforcement and proximity pickup detection.
-    /// Uses the cached TrackedTetromino data. Lightweight.
+    /// Uses the cached TrackedLocation data. Lightweight.
     /// locationCheckCallback is called when a proximity pickup is detected,
     /// with the AP location ID as the argument.
     void EnforceVisibility(
@@ -67,37 +74,34 @@ public:
         const std::function<void(int64_t)>& locationCheckCallback
     );
 
+    const VisibilityCommandBuffer::Stats& GetVisibilityStats() const { return m_commands.GetStats(); }
+
+    /// Refill the per-tick visibility call budget. Call once at the end
+    /// of every tick (dllmain's TickEnd guard), cooldown ticks included.
+    void EndTick() { m_budgetLeft = m_callBudget; }
+
     /// Clear all cached data. Call on level transitions.
     void ResetCache();
 
-    /// Get the number of tracked tetrominos.
-    size_t GetTrackedCount() const { return m_tracked.size(); }
+    /// Get the number of tracked locations of one kind.
+    size_t GetTrackedCount(LocationKind kind) const { return m_tracked.CountOf(kind); }
 
-    /// Debug dump of tracked tetrominos to log.
+    /// Debug dump of tracked locations to log.
     void DumpTracked() const;
 
     /// Open the puzzle exit fence for a tetromino (if one exists).
-    /// Queues the open for retry processing.
-    void OpenFenceForTetromino(const std::string& tetId);
+    /// Starts a level-scoped task that tries fence::Open() up to
+    /// fence_open_attempts times, fence_retry_ms apart (tunables): the
+    /// fence actor may not accept Open() for a few frames after the pickup.
+    void OpenFenceForTetromino(const ItemId& tetId);
 
-    /// Process pending fence opens. Call every ~6 ticks from on_update.
-    /// Retries each fence::Open() up to 10 times with ~100ms spacing.
-    void ProcessPendingFenceOpens();
+    /// Fence opens still in progress.
+    size_t GetPendingFenceOpenCount() const { return m_fenceOpensInFlight; }
 
     /// Dump fence map to log.
     void DumpFenceMap() const;
 
 private:
-    /// Build tetromino ID from InstanceInfo property values.
-    /// Returns empty string if invalid.
-    static std::string FormatTetrominoId(uint8_t typeVal, uint8_t shapeVal, int32_t number);
-
-    /// Type enum value → single letter.
-    static char TypeToLetter(uint8_t type);
-
-    /// Shape enum value → single letter.
-    static char ShapeToLetter(uint8_t shape);
-
     /// Set an actor visible (show). Returns false if the UObject is stale
     /// (world tearing down), signalling the caller to abort.
     static bool SetActorVisible(RC::Unreal::UObject* actor);
@@ -112,11 +116,6 @@ private:
     /// Check if an actor is currently hidden.
     static bool IsActorHidden(RC::Unreal::UObject* actor);
 
-    /// Read the InstanceInfo struct from a BP_TetrominoItem_C actor.
-    /// Returns true and fills out type/shape/number on success.
-    static bool ReadInstanceInfo(RC::Unreal::UObject* actor,
-                                 uint8_t& outType, uint8_t& outShape, int32_t& outNumber);
-
     /// Read actor world position. Returns true on success.
     static bool ReadActorPosition(RC::Unreal::UObject* actor,
                                   float& outX, float& outY, float& outZ);
@@ -124,28 +123,63 @@ private:
     /// Get the player's current position. Returns true on success.
     static bool GetPlayerPosition(float& outX, float& outY, float& outZ);
 
+    /// Run queued commands against the calling pass's actors, spending
+    /// from what is left of this tick's budget.
+    void ExecuteCommands(const TickMap<ItemId, RC::Unreal::UObject*>& actors,
+                         bool havePlayer, float playerX, float playerY, float playerZ);
+
+    enum class FenceOpenResult { Opened, NotFound, Unresolved, Stale };
+
+    /// One fence::Open() attempt by full name.
+    FenceOpenResult TryOpenFence(const ItemId& tetId, const std::wstring& fenceFullName);
+
+    /// Retry loop behind OpenFenceForTetromino.
+    GameTask OpenFenceTask(ItemId tetId, std::wstring fenceFullName);
+
     /// Build the fence map from LoweringFenceWhenTetrominoIsPickedUpScript actors.
     /// Maps tetromino ID → index into m_fenceActorNames for re-lookup.
     void BuildFenceMap();
 
-    /// Tracked tetrominos: keyed by tetromino ID (e.g. "DJ1").
-    std::unordered_map<std::string, TrackedTetromino> m_tracked;
+    /// FindAllOf into an arena vector (via m_scratchActors — UE4SS only
+    /// fills std::vector). For call sites that need several result sets
+    /// alive at once.
+    void FindAllOnArena(const wchar_t* className, TickVector<RC::Unreal::UObject*>& out,
+                        const std::source_location& loc = std::source_location::current());
+
+    /// FindAllOf output buffer, reused by every pass. Cleared before each
+    /// use but never shrunk, so steady-state scans don't touch the heap.
+    /// Contents are only meaningful within the call that filled it.
+    std::vector<RC::Unreal::UObject*> m_scratchActors;
+
+    /// Tracked locations: keyed by location ID (e.g. "DJ1", "Star12").
+    Locations m_tracked;
+
+    /// Pending show/hide per location, and what each tick may spend on
+    /// them. Every pass in a tick draws from m_budgetLeft; EndTick()
+    /// refills it. Pickup hides bypass the queue and are counted apart.
+    VisibilityCommandBuffer m_commands;
+    uint32_t                m_callBudget  = DEFAULT_TUNABLES.visibility_call_budget;
+    uint32_t                m_budgetLeft  = DEFAULT_TUNABLES.visibility_call_budget;
+    uint64_t                m_pickupHides = 0;
+
+    // ---- Tunables (ApplyTunables) ----
+    int      m_scanRetries       = DEFAULT_TUNABLES.scan_visibility_retries;
+    int      m_refreshRetries    = DEFAULT_TUNABLES.refresh_visibility_retries;
+    int      m_fenceOpenAttempts = DEFAULT_TUNABLES.fence_open_attempts;
+    uint64_t m_fenceRetryMs      = DEFAULT_TUNABLES.fence_retry_ms;
 
     // ---- Fence map: tetromino ID → fence actor full name ----
     // We store fence actor full-names (not raw UObject*) so we can
     // safely re-discover them each time we need to call Open().
-    std::unordered_map<std::string, std::wstring> m_fenceMap;  // tetId → fence full name
-
-    // ---- Pending fence opens (retry queue) ----
-    struct PendingFenceOpen {
-        std::string tetId;
-        std::wstring fenceFullName;
-        int attempts = 0;
-    };
-    std::deque<PendingFenceOpen> m_pendingFenceOpens;
-
-    // ---- Cached UFunction* for ALoweringFence::Open() ----
-    RC::Unreal::UFunction* m_fnFenceOpen = nullptr;
+    FlatHashMap<ItemId, std::wstring> m_fenceMap;  // tetId → fence full name
+
+    // ---- Fence opens in progress (OpenFenceTask) ----
+    size_t m_fenceOpensInFlight = 0;
+
+    /// LoweringFence actors found this tick, shared by every fence task
+    /// that resumes in it. Only valid while m_fenceActorsTick is current.
+    std::vector<RC::Unreal::UObject*> m_fenceActors;
+    uint64_t m_fenceActorsTick = 0;
 };
 
 } // namespace TalosAP
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace TalosAP {
+
+// ============================================================
+// AP wire capture
+//
+// With "wire_capture": true in config.json the session appends every AP
+// packet it handles or sends to talos_ap_wire.cap, next to the UUID file:
+//
+//   header   "TAPWIRE\0"  u32 version  u32 flags  u64 start (unix ms)
+//   record   u64 t (us since start)  u8 direction  u8[3] 0  u32 length
+//            length bytes of packet JSON ({"cmd":"ReceivedItems",...})
+//
+// Little-endian. The whole stream is gzip-compressed when the build has
+// zlib (TALOSAP_HAVE_ZLIB); WireCaptureReader reads either. Capture
+// files are what tools/wirereplay feeds back through APSession.
+//
+// Session thread only — one writer per session.
+// ============================================================
+
+enum class WireDirection : uint8_t {
+    Inbound  = 0,   ///< server → client
+    Outbound = 1,   ///< client → server
+};
+
+struct WireRecord {
+    uint64_t      timeUs = 0;
+    WireDirection direction = WireDirection::Inbound;
+    std::string   packet;
+};
+
+class WireCapture {
+public:
+    static constexpr char     MAGIC[8] = { 'T', 'A', 'P', 'W', 'I', 'R', 'E', '\0' };
+    static constexpr uint32_t VERSION  = 1;
+    static constexpr uint32_t FLAG_GZIP = 1u << 0;
+
+    /// Default file name, relative to the working directory.
+    static constexpr const char* FILE_NAME = "talos_ap_wire.cap";
+
+    /// Records larger than this are dropped (a DataPackage is the only
+    /// packet that comes close).
+    static constexpr uint32_t MAX_PACKET = 64u << 20;
+
+    WireCapture() = default;
+    ~WireCapture();
+
+    WireCapture(const WireCapture&) = delete;
+    WireCapture& operator=(const WireCapture&) = delete;
+
+    /// Start a new capture at `path`, replacing any previous one. Until
+    /// this succeeds Record() is a no-op.
+    bool Open(const std::string& path);
+
+    /// Flush and close (also done by the destructor).
+    void Close();
+
+    bool Active() const { return m_file != nullptr; }
+
+    /// Append one packet, timestamped now.
+    void Record(WireDirection direction, std::string_view packet);
+
+    /// Push buffered records to disk so a crash loses at most the last
+    /// interval. Cheap when nothing was written since the last flush.
+    void Flush();
+
+    uint64_t Records() const { return m_records; }
+    uint64_t Bytes() const { return m_bytes; }
+
+private:
+    bool Write(const void* data, size_t size);
+
+    void*    m_file = nullptr;        ///< gzFile or FILE*
+    bool     m_dirty = false;
+    uint64_t m_records = 0;
+    uint64_t m_bytes = 0;             ///< uncompressed payload bytes
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/// Reads a capture written by WireCapture, compressed or not.
+class WireCaptureReader {
+public:
+    WireCaptureReader() = default;
+    ~WireCaptureReader();
+
+    WireCaptureReader(const WireCaptureReader&) = delete;
+    WireCaptureReader& operator=(const WireCaptureReader&) = delete;
+
+    /// Open and validate the header. On failure Error() says why.
+    bool Open(const std::string& path);
+    void Close();
+
+    /// Next record; false at end of file or on a truncated/corrupt record
+    /// (Error() is set for the latter — a crash mid-write leaves a short
+    /// tail, everything before it is still good).
+    bool Next(WireRecord& out);
+
+    uint64_t StartUnixMs() const { return m_startUnixMs; }
+    bool Compressed() const { return (m_flags & WireCapture::FLAG_GZIP) != 0; }
+    const std::string& Error() const { return m_error; }
+
+private:
+    bool Read(void* data, size_t size);
+
+    void*       m_file = nullptr;
+    uint32_t    m_flags = 0;
+    uint64_t    m_startUnixMs = 0;
+    std::string m_error;
+};
+
+} // namespace TalosAP
@@ -0,0 +1,152 @@
+#pragma once
+
+// ============================================================
+// WsConfig — websocketpp config wrapper for wswrap's client types
+//
+// wswrap picks its websocketpp config types itself and exposes no hook
+// for them. CmakeLists.txt copies wswrap's headers into the build tree
+// and wraps every websocketpp::client<X> there as
+// websocketpp::client<TalosAP::Ws::Config<X>>; configure fails if no
+// such client type is found. Config<X> inherits everything from X and
+// replaces only two members: the TLS socket policy (session resumption)
+// and, when X enables permessage-deflate, the extension type (bounded
+// offer, byte counts). Everything else wswrap chose is untouched.
+//
+// Header-only; included (first) by the generated wswrap headers.
+// ============================================================
+
+#include <websocketpp/config/asio_client.hpp>
+
+#include "TlsSessionCache.h"
+#include "WsStats.h"
+
+#if defined(TALOSAP_WS_DEFLATE_WINDOW_BITS) && !defined(WSWRAP_NO_COMPRESSION)
+#include <websocketpp/extensions/permessage_deflate/enabled.hpp>
+#define TALOSAP_WS_BOUNDED_DEFLATE 1
+#endif
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace TalosAP::Ws {
+
+namespace wspp_tls = websocketpp::transport::asio::tls_socket;
+
+/// websocketpp's TLS socket connection, with the handshake bracketed by
+/// TlsSessionCache: Prime() before it, Finished() after a good one.
+/// websocketpp calls these through the socket policy's static type, so
+/// hiding the base members is enough.
+class ResumingTlsConnection : public wspp_tls::connection {
+public:
+    typedef ResumingTlsConnection type;
+
+protected:
+    void set_uri(websocketpp::uri_ptr u)
+    {
+        m_key = u ? u->get_host() + ":" + u->get_port_str() : std::string();
+        wspp_tls::connection::set_uri(u);
+    }
+
+    void pre_init(websocketpp::transport::init_handler callback)
+    {
+        TlsSessionCache::Get().Prime(get_socket().native_handle(), m_key);
+        wspp_tls::connection::pre_init(callback);
+    }
+
+    void post_init(websocketpp::transport::init_handler callback)
+    {
+        // The base binds its own shared_ptr for the handshake; this one
+        // keeps the object alive for the wrapper as well.
+        auto self = std::static_pointer_cast<type>(get_shared());
+        wspp_tls::connection::post_init([self, callback](const websocketpp::lib::error_code& ec) {
+            if (!ec) TlsSessionCache::Get().Finished(self->get_socket().native_handle());
+            callback(ec);
+        });
+    }
+
+private:
+    std::string m_key;   ///< host:port
+};
+
+/// Socket policy handing out ResumingTlsConnection.
+class ResumingTlsSocket : public wspp_tls::endpoint {
+public:
+    typedef ResumingTlsSocket       type;
+    typedef ResumingTlsConnection   socket_con_type;
+    typedef socket_con_type::ptr    socket_con_ptr;
+};
+
+#ifdef TALOSAP_WS_BOUNDED_DEFLATE
+/// websocketpp's permessage-deflate extension with an offer that also
+/// asks for server_max_window_bits, and byte counts in WsDeflateStats.
+/// The hybi13 processor calls these through the config's extension
+/// type, so hiding the base members is enough. CmakeLists.txt fails the
+/// configure if websocketpp's generate_offer() goes away.
+template <typename Ext>
+class BoundedDeflate : public Ext {
+public:
+    std::string generate_offer() const
+    {
+        return "permessage-deflate; client_no_context_takeover; client_max_window_bits; server_max_window_bits="
+            + std::to_string(TALOSAP_WS_DEFLATE_WINDOW_BITS);
+    }
+
+    template <typename Offer>
+    auto negotiate(const Offer& offer)
+    {
+        auto result = Ext::negotiate(offer);
+        WsDeflateStats::Get().negotiated.store(Ext::is_enabled(), std::memory_order_relaxed);
+        return result;
+    }
+
+    websocketpp::lib::error_code compress(const std::string& in, std::string& out)
+    {
+        size_t before = out.size();
+        auto ec = Ext::compress(in, out);
+        auto& stats = WsDeflateStats::Get();
+        stats.payloadOut.fetch_add(in.size(), std::memory_order_relaxed);
+        stats.wireOut.fetch_add(out.size() - before, std::memory_order_relaxed);
+        return ec;
+    }
+
+    websocketpp::lib::error_code decompress(const uint8_t* buf, size_t len, std::string& out)
+    {
+        size_t before = out.size();
+        auto ec = Ext::decompress(buf, len, out);
+        auto& stats = WsDeflateStats::Get();
+        stats.wireIn.fetch_add(len, std::memory_order_relaxed);
+        stats.payloadIn.fetch_add(out.size() - before, std::memory_order_relaxed);
+        return ec;
+    }
+};
+
+template <typename T>
+struct DeflateFor { typedef T type; };
+
+template <typename C>
+struct DeflateFor<websocketpp::extensions::permessage_deflate::enabled<C>> {
+    typedef BoundedDeflate<websocketpp::extensions::permessage_deflate::enabled<C>> type;
+};
+#endif
+
+/// X with the TLS socket policy swapped for ResumingTlsSocket and, when
+/// X enables it, the deflate extension for BoundedDeflate.
+template <typename X>
+struct Config : X {
+    typedef Config type;
+
+#ifdef TALOSAP_WS_BOUNDED_DEFLATE
+    typedef typename DeflateFor<typename X::permessage_deflate_type>::type permessage_deflate_type;
+#endif
+
+    struct transport_config : X::transport_config {
+        typedef std::conditional_t<
+            std::is_same_v<typename X::transport_config::socket_type, wspp_tls::endpoint>,
+            ResumingTlsSocket,
+            typename X::transport_config::socket_type> socket_type;
+    };
+    typedef websocketpp::transport::asio::endpoint<transport_config> transport_type;
+};
+
+} // namespace TalosAP::Ws
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace TalosAP {
+
+/// permessage-deflate byte counts for the current websocket connection.
+///
+/// Filled by the deflate wrapper in WsConfig.h as messages are inflated
+/// and deflated; APSession resets it when a socket connects, logs it
+/// when the socket drops and samples it into the trace counters. Wire
+/// bytes are the compressed payloads on the socket, payload bytes the
+/// JSON they inflate to (or were deflated from). Messages the server
+/// sends uncompressed are not counted.
+struct WsDeflateStats {
+    std::atomic<bool>     negotiated{false};
+    std::atomic<uint64_t> wireIn{0};
+    std::atomic<uint64_t> payloadIn{0};
+    std::atomic<uint64_t> wireOut{0};
+    std::atomic<uint64_t> payloadOut{0};
+
+    static WsDeflateStats& Get()
+    {
+        static WsDeflateStats s_instance;
+        return s_instance;
+    }
+
+    void Reset()
+    {
+        negotiated.store(false, std::memory_order_relaxed);
+        wireIn.store(0, std::memory_order_relaxed);
+        payloadIn.store(0, std::memory_order_relaxed);
+        wireOut.store(0, std::memory_order_relaxed);
+        payloadOut.store(0, std::memory_order_relaxed);
+    }
+
+    /// payload / wire, ×100 so it fits a trace counter. 0 before any
+    /// compressed message.
+    static int64_t RatioX100(uint64_t payload, uint64_t wire)
+    {
+        return wire ? static_cast<int64_t>(payload * 100 / wire) : 0;
+    }
+};
+
+} // namespace TalosAP
@@ -0,0 +1,725 @@
+#!/usr/bin/env python3
+"""apstandin — local stand-in AP server for connection testing.
+
+Speaks just enough of the Archipelago protocol to take the mod from
+connect to synced: RoomInfo, a large DataPackage, Connected, a full
+ReceivedItems replay and a PrintJSON storm. Each connection reports the
+TLS handshake (full or resumed), the time from accept to Connected,
+whether permessage-deflate was negotiated, and payload and wire bytes
+in both directions with the resulting compression ratio.
+
+  apstandin.py [--port 38281] [--no-deflate] [--rate KBPS]
+               [--tls CERT KEY] [--drop-after SECONDS]
+               [--flood-every SECONDS] [--flood-size N]
+      Serve the mod. Point config.json "server" at ws://localhost:38281
+      (or wss:// with --tls).
+      --no-deflate declines the extension (fallback path).
+      --rate throttles outgoing bytes to emulate a slow link.
+      --drop-after cuts every connection that long after Connected,
+      without a close frame, to time the mod's reconnect.
+      --flood-every sends --flood-size new items of the mod's own item
+      ids (and a PrintJSON each) that often, for tools/soak.
+
+  Each slot name keeps its checked locations and flooded items across
+  reconnects, as a real room does: LocationChecks are answered with a
+  RoomUpdate, and Connected replays everything the slot was sent.
+
+  apstandin.py --check
+      Self-test: deflate negotiated and fallback paths against a client
+      that sends the same offer as the mod, plus TLS session resumption
+      when the openssl command is available. Exit 1 on failure.
+
+Standard library only.
+"""
+
+import argparse
+import asyncio
+import base64
+import hashlib
+import json
+import os
+import random
+import ssl
+import socket
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+import zlib
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+DEFLATE_TAIL = b"\x00\x00\xff\xff"
+GAME = "The Talos Principle Reawakened"
+
+# ItemMapping::BASE_ITEM_ID and the number of tetromino types.
+MOD_ITEM_BASE = 0x540000
+MOD_ITEM_TYPES = 19
+
+# ============================================================
+# permessage-deflate (RFC 7692)
+# ============================================================
+
+
+def parse_extensions(header):
+    """'a; x=1, b' -> [('a', {'x': '1'}), ('b', {})]"""
+    offers = []
+    for ext in header.split(","):
+        parts = [p.strip() for p in ext.split(";") if p.strip()]
+        if not parts:
+            continue
+        params = {}
+        for p in parts[1:]:
+            key, _, value = p.partition("=")
+            params[key.strip()] = value.strip().strip('"') or None
+        offers.append((parts[0], params))
+    return offers
+
+
+class Deflate:
+    """One side of a negotiated permessage-deflate connection."""
+
+    def __init__(self, send_bits, recv_bits, send_reset, recv_reset):
+        self.send_bits = send_bits      # window this side compresses with
+        self.recv_bits = recv_bits      # window the peer compresses with
+        self.send_reset = send_reset    # *_no_context_takeover for our direction
+        self.recv_reset = recv_reset
+        self._compress = None
+        self._decompress = None
+
+    @staticmethod
+    def server_accepts(params):
+        bits = params.get("server_max_window_bits")
+        return bits is None or (bits.isdigit() and 9 <= int(bits) <= 15)
+
+    @classmethod
+    def for_server(cls, params):
+        """Accept a client offer. The client bounds its inflate memory by
+        asking for server_max_window_bits."""
+        d = cls(int(params.get("server_max_window_bits") or 15), 15,
+                "server_no_context_takeover" in params, "client_no_context_takeover" in params)
+        d.response = "permessage-deflate"
+        if d.recv_reset:
+            d.response += "; client_no_context_takeover"
+        if "server_max_window_bits" in params:
+            d.response += "; server_max_window_bits=%d" % d.send_bits
+        if d.send_reset:
+            d.response += "; server_no_context_takeover"
+        return d
+
+    @classmethod
+    def for_client(cls, params):
+        """Apply a server response."""
+        return cls(15, int(params.get("server_max_window_bits") or 15),
+                   "client_no_context_takeover" in params, "server_no_context_takeover" in params)
+
+    def compress(self, payload):
+        if self._compress is None or self.send_reset:
+            # memLevel 4 matches websocketpp's own deflater.
+            self._compress = zlib.compressobj(zlib.Z_DEFAULT_COMPRESSION, zlib.DEFLATED,
+                                              -self.send_bits, 4)
+        data = self._compress.compress(payload) + self._compress.flush(zlib.Z_SYNC_FLUSH)
+        return data[:-4] if data.endswith(DEFLATE_TAIL) else data
+
+    def decompress(self, data):
+        if self._decompress is None or self.recv_reset:
+            self._decompress = zlib.decompressobj(-self.recv_bits)
+        return self._decompress.decompress(data + DEFLATE_TAIL)
+
+
+# ============================================================
+# Framing
+# ============================================================
+
+
+class Stats:
+    def __init__(self):
+        self.payload_in = self.wire_in = 0
+        self.payload_out = self.wire_out = 0
+        self.messages_in = self.messages_out = 0
+
+    @staticmethod
+    def ratio(payload, wire):
+        return payload / wire if wire else 0.0
+
+    def line(self):
+        return ("in %d msgs %d -> %d bytes (%.2fx), out %d msgs %d -> %d bytes (%.2fx)" % (
+            self.messages_in, self.payload_in, self.wire_in, self.ratio(self.payload_in, self.wire_in),
+            self.messages_out, self.payload_out, self.wire_out, self.ratio(self.payload_out, self.wire_out)))
+
+
+class Connection:
+    def __init__(self, reader, writer, deflate, masked, rate=0):
+        self.reader = reader
+        self.writer = writer
+        self.deflate = deflate
+        self.masked = masked          # client side masks its frames
+        self.rate = rate              # bytes/second, 0 = unthrottled
+        self.stats = Stats()
+
+    async def send_text(self, text):
+        payload = text.encode("utf-8")
+        data, rsv1 = payload, 0
+        if self.deflate:
+            data, rsv1 = self.deflate.compress(payload), 0x40
+        frame = self._frame(0x80 | rsv1 | 0x1, data)
+        self.stats.payload_out += len(payload)
+        self.stats.wire_out += len(frame)
+        self.stats.messages_out += 1
+        self.writer.write(frame)
+        await self.writer.drain()
+        if self.rate:
+            await asyncio.sleep(len(frame) / self.rate)
+
+    async def recv_text(self):
+        """Next text message, or None once the peer closes."""
+        parts, compressed, wire = [], False, 0
+        while True:
+            head = await self.reader.readexactly(2)
+            fin, rsv1, opcode = head[0] & 0x80, head[0] & 0x40, head[0] & 0x0F
+            length = head[1] & 0x7F
+            wire += 2
+            if length == 126:
+                length = struct.unpack(">H", await self.reader.readexactly(2))[0]
+                wire += 2
+            elif length == 127:
+                length = struct.unpack(">Q", await self.reader.readexactly(8))[0]
+                wire += 8
+            mask = b""
+            if head[1] & 0x80:
+                mask = await self.reader.readexactly(4)
+                wire += 4
+            data = await self.reader.readexactly(length)
+            wire += length
+            if mask:
+                data = bytes(b ^ mask[i & 3] for i, b in enumerate(data))
+
+            if opcode == 0x8:
+                self.writer.write(self._frame(0x88, data[:2]))
+                return None
+            if opcode == 0x9:
+                self.writer.write(self._frame(0x8A, data))
+                continue
+            if opcode == 0xA:
+                continue
+            if opcode in (0x1, 0x2):
+                compressed = bool(rsv1)
+                if compressed and not self.deflate:
+                    raise ConnectionError("RSV1 set without negotiated permessage-deflate")
+            parts.append(data)
+            if fin:
+                break
+
+        payload = b"".join(parts)
+        if compressed:
+            payload = self.deflate.decompress(payload)
+        self.stats.payload_in += len(payload)
+        self.stats.wire_in += wire
+        self.stats.messages_in += 1
+        return payload.decode("utf-8")
+
+    def _frame(self, first, data):
+        n = len(data)
+        mask_bit = 0x80 if self.masked else 0
+        if n < 126:
+            head = struct.pack(">BB", first, mask_bit | n)
+        elif n < 1 << 16:
+            head = struct.pack(">BBH", first, mask_bit | 126, n)
+        else:
+            head = struct.pack(">BBQ", first, mask_bit | 127, n)
+        if not self.masked:
+            return head + data
+        mask = os.urandom(4)
+        return head + mask + bytes(b ^ mask[i & 3] for i, b in enumerate(data))
+
+
+async def read_http_head(reader):
+    head = (await reader.readuntil(b"\r\n\r\n")).decode("latin-1")
+    lines = head.split("\r\n")
+    headers = {}
+    for line in lines[1:]:
+        key, sep, value = line.partition(":")
+        if sep:
+            headers[key.strip().lower()] = value.strip()
+    return lines[0], headers
+
+
+# ============================================================
+# Fake room
+# ============================================================
+
+
+class Room:
+    """Deterministic multiworld shaped like a large async: a full data
+    package for the mod's game, a long item replay and chatty PrintJSON."""
+
+    def __init__(self, items=1500, prints=400, seed=7):
+        rng = random.Random(seed)
+        self.items = {"Golden %s (%s%d)" % (s, z, n): 0x5A0000 + i
+                      for i, (s, z, n) in enumerate((rng.choice("TLZSJOI"), rng.choice(["A", "B", "C", "DJ", "NZ"]), k)
+                                                    for k in range(2000))}
+        self.locations = {"World %d Puzzle %d Star" % (w, p): 0x5B0000 + w * 100 + p
+                          for w in range(1, 16) for p in range(60)}
+        item_ids, location_ids = list(self.items.values()), list(self.locations.values())
+        self.location_ids = location_ids
+        self.replay = [{"item": rng.choice(item_ids), "location": rng.choice(location_ids),
+                        "player": rng.randint(1, 8), "flags": rng.choice([0, 1, 2, 4]),
+                        "class": "NetworkItem"} for _ in range(items)]
+        self.prints = prints
+        self.rng = rng
+        self.slots = {}
+
+    def slot(self, name):
+        """Per-slot state that outlives a connection."""
+        return self.slots.setdefault(name, {"items": [], "checked": set()})
+
+    def room_info(self):
+        return {"cmd": "RoomInfo", "version": {"major": 0, "minor": 5, "build": 1, "class": "Version"},
+                "generator_version": {"major": 0, "minor": 5, "build": 1, "class": "Version"},
+                "tags": ["AP"], "password": False,
+                "permissions": {"release": 2, "collect": 2, "remaining": 2},
+                "hint_cost": 10, "location_check_points": 1, "games": [GAME, "Archipelago"],
+                "datapackage_checksums": {GAME: "local-test"}, "seed_name": "apstandin", "time": time.time()}
+
+    def data_package(self):
+        return {"cmd": "DataPackage", "data": {"games": {GAME: {
+            "item_name_to_id": self.items, "location_name_to_id": self.locations, "checksum": "local-test"}}}}
+
+    def connected(self, slot_name):
+        checked = self.slot(slot_name)["checked"]
+        players = [{"team": 0, "slot": s, "alias": slot_name if s == 1 else "Player%d" % s,
+                    "name": slot_name if s == 1 else "Player%d" % s, "class": "NetworkPlayer"}
+                   for s in range(1, 9)]
+        return {"cmd": "Connected", "team": 0, "slot": 1, "players": players,
+                "missing_locations": sorted(set(self.locations.values()) - checked),
+                "checked_locations": sorted(checked),
+                "slot_data": {"reusable_tetrominos": 0}, "hint_points": 0,
+                "slot_info": {str(p["slot"]): {"name": p["name"], "game": GAME, "type": 1,
+                                                "group_members": [], "class": "NetworkSlot"}
+                              for p in players}}
+
+    def received_items(self, slot_name):
+        return {"cmd": "ReceivedItems", "index": 0, "items": self.replay + self.slot(slot_name)["items"]}
+
+    def flood(self, slot_name, count):
+        """`count` new items for the slot, as one ReceivedItems and a
+        PrintJSON each."""
+        items = self.slot(slot_name)["items"]
+        index = len(self.replay) + len(items)
+        new = [{"item": MOD_ITEM_BASE + self.rng.randrange(MOD_ITEM_TYPES),
+                "location": self.rng.choice(self.location_ids),
+                "player": self.rng.randint(2, 8), "flags": self.rng.choice([0, 1]), "class": "NetworkItem"}
+               for _ in range(count)]
+        items += new
+        return [{"cmd": "ReceivedItems", "index": index, "items": new}] + [self.print_json(i) for i in new]
+
+    def check(self, slot_name, locations):
+        """RoomUpdate for newly checked locations, or None."""
+        checked = self.slot(slot_name)["checked"]
+        new = [loc for loc in locations if loc not in checked]
+        checked.update(new)
+        return {"cmd": "RoomUpdate", "checked_locations": new} if new else None
+
+    def print_json(self, item=None):
+        item = item or self.rng.choice(self.replay)
+        return {"cmd": "PrintJSON", "type": "ItemSend", "receiving": self.rng.randint(1, 8), "item": item,
+                "data": [{"type": "player_id", "text": str(item["player"])}, {"text": " sent "},
+                         {"type": "item_id", "text": str(item["item"]), "player": 1, "flags": item["flags"]},
+                         {"text": " to "}, {"type": "player_id", "text": "2"}, {"text": " ("},
+                         {"type": "location_id", "text": str(item["location"]), "player": item["player"]},
+                         {"text": ")"}]}
+
+
+# ============================================================
+# Server
+# ============================================================
+
+
+class ServerOptions:
+    def __init__(self, deflate=True, rate=0, tls=None, drop_after=0, flood_every=0, flood_size=20, log=print):
+        self.deflate = deflate          # accept permessage-deflate offers
+        self.rate = rate                # outgoing bytes/second, 0 = unthrottled
+        self.tls = tls                  # ssl.SSLContext, reused so tickets stay valid
+        self.drop_after = drop_after    # seconds after Connected, 0 = never
+        self.flood_every = flood_every  # seconds between item floods, 0 = never
+        self.flood_size = flood_size
+        self.log = log
+
+
+class ConnectionReport:
+    def __init__(self):
+        self.deflate = None
+        self.stats = None
+        self.tls_ms = None
+        self.tls_resumed = None
+        self.connected_ms = None
+
+
+async def serve_connection(reader, writer, room, opts, results=None):
+    accepted = time.monotonic()
+    peer = writer.get_extra_info("peername")
+    report = ConnectionReport()
+
+    if opts.tls:
+        try:
+            await writer.start_tls(opts.tls)
+        except (ssl.SSLError, ConnectionError) as e:
+            opts.log("%s: TLS handshake failed: %s" % (peer, e))
+            writer.close()
+            return
+        report.tls_ms = (time.monotonic() - accepted) * 1000
+        report.tls_resumed = writer.get_extra_info("ssl_object").session_reused
+
+    _, headers = await read_http_head(reader)
+    key = headers.get("sec-websocket-key", "")
+    offer = headers.get("sec-websocket-extensions", "")
+
+    deflate = None
+    if opts.deflate:
+        for name, params in parse_extensions(offer):
+            if name == "permessage-deflate" and Deflate.server_accepts(params):
+                deflate = Deflate.for_server(params)
+                break
+    report.deflate = deflate
+
+    accept = base64.b64encode(hashlib.sha1((key + WS_GUID).encode()).digest()).decode()
+    response = ("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                "Sec-WebSocket-Accept: %s\r\n" % accept)
+    if deflate:
+        response += "Sec-WebSocket-Extensions: %s\r\n" % deflate.response
+    writer.write((response + "\r\n").encode())
+
+    tls = "-"
+    if report.tls_ms is not None:
+        tls = "%s %.1f ms" % ("resumed" if report.tls_resumed else "full", report.tls_ms)
+    opts.log("%s: tls %s; offer '%s' -> %s" % (
+        peer, tls, offer or "(none)", "negotiated '%s'" % deflate.response if deflate else "uncompressed"))
+
+    conn = Connection(reader, writer, deflate, masked=False, rate=opts.rate)
+    drop = None
+    flood = None
+    slot_name = None
+
+    async def flood_loop():
+        try:
+            while True:
+                await asyncio.sleep(opts.flood_every)
+                await conn.send_text(json.dumps(room.flood(slot_name, opts.flood_size)))
+        except (ConnectionError, RuntimeError):
+            pass    # the main loop sees the close too
+
+    try:
+        await conn.send_text(json.dumps([room.room_info()]))
+        while True:
+            text = await conn.recv_text()
+            if text is None:
+                break
+            for packet in json.loads(text):
+                cmd = packet.get("cmd")
+                if cmd == "GetDataPackage":
+                    await conn.send_text(json.dumps([room.data_package()]))
+                elif cmd == "Connect":
+                    slot_name = packet.get("name", "Player1")
+                    await conn.send_text(json.dumps([room.connected(slot_name), room.received_items(slot_name)]))
+                    report.connected_ms = (time.monotonic() - accepted) * 1000
+                    if opts.drop_after:
+                        drop = asyncio.get_running_loop().call_later(opts.drop_after, writer.transport.abort)
+                    for _ in range(room.prints):
+                        await conn.send_text(json.dumps([room.print_json()]))
+                    if opts.flood_every and not flood:
+                        flood = asyncio.ensure_future(flood_loop())
+                elif cmd == "Sync" and slot_name:
+                    await conn.send_text(json.dumps([room.received_items(slot_name)]))
+                elif cmd == "LocationChecks" and slot_name:
+                    update = room.check(slot_name, packet.get("locations", []))
+                    if update:
+                        await conn.send_text(json.dumps([update]))
+                elif cmd == "Bounce":
+                    await conn.send_text(json.dumps([dict(packet, cmd="Bounced")]))
+    except (asyncio.IncompleteReadError, ConnectionError) as e:
+        if not isinstance(e, (asyncio.IncompleteReadError, ConnectionResetError)):
+            opts.log("%s: %s" % (peer, e))
+    finally:
+        if drop:
+            drop.cancel()
+        if flood:
+            flood.cancel()
+        writer.close()
+
+    report.stats = conn.stats
+    opts.log("%s: closed after %.2fs, Connected at %s; %s" % (
+        peer, time.monotonic() - accepted,
+        "%.0f ms" % report.connected_ms if report.connected_ms is not None else "-", conn.stats.line()))
+    if results is not None:
+        results.append(report)
+
+
+# ============================================================
+# --check
+# ============================================================
+
+# What the mod's websocketpp sends; window bits as in TALOSAP_WS_DEFLATE_WINDOW_BITS.
+MOD_OFFER = "permessage-deflate; client_no_context_takeover; client_max_window_bits; server_max_window_bits=12"
+
+
+async def client_session(port, offer, expect_prints):
+    reader, writer = await asyncio.open_connection("127.0.0.1", port)
+    key = base64.b64encode(os.urandom(16)).decode()
+    request = ("GET / HTTP/1.1\r\nHost: localhost:%d\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+               "Sec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n" % (port, key))
+    if offer:
+        request += "Sec-WebSocket-Extensions: %s\r\n" % offer
+    writer.write((request + "\r\n").encode())
+    status, headers = await read_http_head(reader)
+    if " 101 " not in status:
+        raise ConnectionError("handshake failed: " + status)
+
+    deflate = None
+    for name, params in parse_extensions(headers.get("sec-websocket-extensions", "")):
+        if name == "permessage-deflate":
+            deflate = Deflate.for_client(params)
+
+    conn = Connection(reader, writer, deflate, masked=True)
+    seen = []
+    room_info = json.loads(await conn.recv_text())
+    seen += [p["cmd"] for p in room_info]
+    await conn.send_text(json.dumps([{"cmd": "GetDataPackage", "games": [GAME]}]))
+    seen += [p["cmd"] for p in json.loads(await conn.recv_text())]
+    await conn.send_text(json.dumps([{"cmd": "Connect", "name": "Player1", "game": GAME,
+                                      "password": "", "uuid": "check", "items_handling": 7,
+                                      "tags": ["AP"], "slot_data": False,
+                                      "version": {"major": 0, "minor": 5, "build": 1, "class": "Version"}}]))
+    seen += [p["cmd"] for p in json.loads(await conn.recv_text())]
+    prints = 0
+    while prints < expect_prints:
+        prints += len(json.loads(await conn.recv_text()))
+    writer.write(conn._frame(0x88, struct.pack(">H", 1000)))
+    await writer.drain()
+    try:
+        await conn.recv_text()
+    except asyncio.IncompleteReadError:
+        pass
+    writer.close()
+    return headers.get("sec-websocket-extensions"), seen, prints
+
+
+async def soak_session(port, name, locations):
+    """Connect as `name`, check `locations`, collect one flood. Returns
+    (Connected, first ReceivedItems, RoomUpdate, flood ReceivedItems)."""
+    reader, writer = await asyncio.open_connection("127.0.0.1", port)
+    key = base64.b64encode(os.urandom(16)).decode()
+    writer.write(("GET / HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                  "Sec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n" % key).encode())
+    await read_http_head(reader)
+    conn = Connection(reader, writer, None, masked=True)
+    await conn.recv_text()
+    await conn.send_text(json.dumps([{"cmd": "Connect", "name": name, "game": GAME, "password": "",
+                                      "uuid": "check", "items_handling": 7, "tags": ["AP"]}]))
+    connected, replay = json.loads(await conn.recv_text())
+    await conn.send_text(json.dumps([{"cmd": "LocationChecks", "locations": locations}]))
+    update = flood = None
+    while update is None or flood is None:
+        for p in json.loads(await conn.recv_text()):
+            if p["cmd"] == "RoomUpdate":
+                update = p
+            elif p["cmd"] == "ReceivedItems":
+                flood = p
+    writer.close()
+    return connected, replay, update, flood
+
+
+async def check_soak_script(expect):
+    room = Room(items=5, prints=0)
+    opts = ServerOptions(flood_every=0.05, flood_size=3, log=lambda _: None)
+    server = await asyncio.start_server(lambda r, w: serve_connection(r, w, room, opts), "127.0.0.1", 0)
+    port = server.sockets[0].getsockname()[1]
+    locs = room.location_ids[:2]
+    try:
+        _, replay1, update1, flood1 = await asyncio.wait_for(soak_session(port, "Soak", locs), 10)
+        connected2, replay2, update2, _ = await asyncio.wait_for(soak_session(port, "Soak", locs + [room.location_ids[2]]), 10)
+    except Exception as e:  # noqa: BLE001
+        expect(False, "soak script: session failed: %r" % e)
+        server.close()
+        return
+    server.close()
+    await server.wait_closed()
+
+    expect(len(replay1["items"]) == 5, "soak script: first replay is the room's 5 items")
+    expect(update1["checked_locations"] == locs, "soak script: RoomUpdate echoes new checks")
+    expect(flood1["index"] == 5 and len(flood1["items"]) == 3, "soak script: flood continues the index")
+    expect(all(MOD_ITEM_BASE <= i["item"] < MOD_ITEM_BASE + MOD_ITEM_TYPES for i in flood1["items"]),
+           "soak script: flood uses the mod's item ids")
+    expect(sorted(connected2["checked_locations"]) == sorted(locs), "soak script: checks survive a reconnect")
+    expect(len(replay2["items"]) >= 8, "soak script: reconnect replays flooded items")
+    expect(update2["checked_locations"] == [room.location_ids[2]], "soak script: only new checks reported")
+    print("soak script          %d items replayed after reconnect" % len(replay2["items"]))
+
+
+def tls_probe(port, ctx, session):
+    """Blocking: TLS + websocket upgrade + RoomInfo, then close. Returns the
+    TLS session for the next probe and whether this one was resumed."""
+    with socket.create_connection(("127.0.0.1", port)) as raw:
+        with ctx.wrap_socket(raw, server_hostname="localhost", session=session) as tls:
+            key = base64.b64encode(os.urandom(16)).decode()
+            tls.sendall(("GET / HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                         "Sec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n" % key).encode())
+            data = b""
+            while b"RoomInfo" not in data:
+                chunk = tls.recv(65536)
+                if not chunk:
+                    break
+                data += chunk
+            # TLS 1.3 tickets arrive after the handshake; reading RoomInfo
+            # picks them up, so the returned session can be resumed.
+            return tls.session, tls.session_reused, b"RoomInfo" in data
+
+
+async def check_tls_resumption(expect):
+    try:
+        tmp = tempfile.TemporaryDirectory()
+        cert, key = os.path.join(tmp.name, "cert.pem"), os.path.join(tmp.name, "key.pem")
+        subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "1",
+                        "-subj", "/CN=localhost", "-keyout", key, "-out", cert],
+                       check=True, capture_output=True)
+    except (OSError, subprocess.CalledProcessError):
+        print("tls resumption       skipped (no openssl command)")
+        return
+
+    server_ctx = ssl.create_default_context(ssl.Purpose.CLIENT_AUTH)
+    server_ctx.load_cert_chain(cert, key)
+    client_ctx = ssl.create_default_context(cafile=cert)
+
+    results = []
+    opts = ServerOptions(tls=server_ctx, log=lambda _: None)
+    server = await asyncio.start_server(
+        lambda r, w: serve_connection(r, w, Room(items=10, prints=0), opts, results), "127.0.0.1", 0)
+    port = server.sockets[0].getsockname()[1]
+    try:
+        session, first_reused, ok1 = await asyncio.to_thread(tls_probe, port, client_ctx, None)
+        _, second_reused, ok2 = await asyncio.to_thread(tls_probe, port, client_ctx, session)
+    except (OSError, ssl.SSLError) as e:
+        expect(False, "tls resumption: probe failed: %r" % e)
+        server.close()
+        return
+    for _ in range(50):
+        if len(results) >= 2:
+            break
+        await asyncio.sleep(0.05)
+    server.close()
+    await server.wait_closed()
+    tmp.cleanup()
+
+    expect(ok1 and ok2, "tls resumption: RoomInfo over TLS")
+    expect(not first_reused and second_reused, "tls resumption: client sees full then resumed")
+    expect(len(results) == 2 and [r.tls_resumed for r in results] == [False, True],
+           "tls resumption: server sees full then resumed")
+    if len(results) == 2:
+        print("tls resumption       full %.1f ms, resumed %.1f ms" % (results[0].tls_ms, results[1].tls_ms))
+
+
+async def run_check():
+    failures = []
+
+    def expect(ok, what):
+        if not ok:
+            failures.append(what)
+            print("FAIL: " + what)
+
+    cases = [
+        ("negotiated",          True,  MOD_OFFER, True),
+        ("server declines",     False, MOD_OFFER, False),
+        ("client offers none",  True,  None,      False),
+        ("bad window offer",    True,  "permessage-deflate; server_max_window_bits=8", False),
+    ]
+    for label, allow, offer, want_deflate in cases:
+        results = []
+        room = Room()
+        opts = ServerOptions(deflate=allow, log=lambda _: None)
+        server = await asyncio.start_server(
+            lambda r, w: serve_connection(r, w, room, opts, results), "127.0.0.1", 0)
+        port = server.sockets[0].getsockname()[1]
+        try:
+            ext, seen, prints = await asyncio.wait_for(client_session(port, offer, room.prints), 30)
+        except Exception as e:  # noqa: BLE001 — report and keep going
+            expect(False, "%s: session failed: %r" % (label, e))
+            server.close()
+            continue
+        for _ in range(50):
+            if results:
+                break
+            await asyncio.sleep(0.05)
+        server.close()
+        await server.wait_closed()
+
+        expect(seen == ["RoomInfo", "DataPackage", "Connected", "ReceivedItems"], "%s: packet sequence %s" % (label, seen))
+        expect(prints == room.prints, "%s: %d PrintJSON" % (label, prints))
+        expect(bool(ext) == want_deflate, "%s: extension header %r" % (label, ext))
+        if not results:
+            expect(False, "%s: server did not report stats" % label)
+            continue
+        deflate, stats = results[0].deflate, results[0].stats
+        ratio = Stats.ratio(stats.payload_out, stats.wire_out)
+        if want_deflate:
+            expect(deflate is not None and deflate.send_bits == 12, "%s: server window 12 bits" % label)
+            expect(ratio > 3.0, "%s: compression ratio %.2f > 3" % (label, ratio))
+        else:
+            expect(ratio <= 1.0, "%s: uncompressed ratio %.2f <= 1" % (label, ratio))
+        print("%-20s %s" % (label, stats.line()))
+
+    await check_soak_script(expect)
+    await check_tls_resumption(expect)
+
+    print("apstandin check: %s" % ("FAILED" if failures else "ok"))
+    return 1 if failures else 0
+
+
+# ============================================================
+# main
+# ============================================================
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--port", type=int, default=38281)
+    parser.add_argument("--no-deflate", action="store_true", help="decline permessage-deflate (fallback path)")
+    parser.add_argument("--rate", type=float, default=0, help="throttle outgoing traffic to KBPS kilobytes/second")
+    parser.add_argument("--tls", nargs=2, metavar=("CERT", "KEY"), help="serve wss:// with this certificate")
+    parser.add_argument("--drop-after", type=float, default=0,
+                        help="abort each connection SECONDS after Connected (reconnect timing)")
+    parser.add_argument("--flood-every", type=float, default=0,
+                        help="send --flood-size new items every SECONDS after Connected (soak)")
+    parser.add_argument("--flood-size", type=int, default=20, help="items per flood")
+    parser.add_argument("--items", type=int, default=1500, help="ReceivedItems replay length")
+    parser.add_argument("--prints", type=int, default=400, help="PrintJSON messages after Connected")
+    parser.add_argument("--check", action="store_true", help="run the self-test and exit")
+    args = parser.parse_args()
+
+    if args.check:
+        return asyncio.run(run_check())
+
+    room = Room(args.items, args.prints)
+    tls = None
+    if args.tls:
+        tls = ssl.create_default_context(ssl.Purpose.CLIENT_AUTH)
+        tls.load_cert_chain(*args.tls)
+    opts = ServerOptions(deflate=not args.no_deflate, rate=args.rate * 1024, tls=tls, drop_after=args.drop_after,
+                         flood_every=args.flood_every, flood_size=args.flood_size)
+
+    async def run():
+        server = await asyncio.start_server(
+            lambda r, w: serve_connection(r, w, room, opts, None), "0.0.0.0", args.port)
+        print("apstandin on %s://localhost:%d (%s)" % (
+            "wss" if tls else "ws", args.port,
+            "permessage-deflate declined" if args.no_deflate else "permessage-deflate accepted"))
+        async with server:
+            await server.serve_forever()
+
+    try:
+        asyncio.run(run())
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,173 @@
+// flightdump — decode a talos_ap_flight.bin ring written by the mod.
+//
+// Usage: flightdump <talos_ap_flight.bin> [--last N]
+//
+// Prints the surviving records oldest-first, then the spans that were
+// still open when recording stopped. After a crash, the innermost open
+// span on the game thread is where the game died.
+
+#include "FlightRecord.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace TalosAP;
+
+static const char* KindName(uint16_t kind)
+{
+    switch (static_cast<FlightEventKind>(kind)) {
+        case FlightEventKind::SpanBegin:       return "begin";
+        case FlightEventKind::SpanEnd:         return "end";
+        case FlightEventKind::EngineCall:      return "engine";
+        case FlightEventKind::Instant:         return "instant";
+        case FlightEventKind::WorldGeneration: return "world";
+        case FlightEventKind::Note:            return "note";
+        default:                               return "?";
+    }
+}
+
+static std::string FormatWallClock(int64_t unixNs)
+{
+    std::time_t secs = static_cast<std::time_t>(unixNs / 1'000'000'000);
+    int millis = static_cast<int>((unixNs / 1'000'000) % 1000);
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &secs);
+#else
+    gmtime_r(&secs, &tm);
+#endif
+    char buf[64];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+    char out[80];
+    std::snprintf(out, sizeof(out), "%s.%03d UTC", buf, millis);
+    return out;
+}
+
+static std::string Field(const char (&f)[32])
+{
+    return std::string(f, strnlen(f, sizeof(f)));
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <talos_ap_flight.bin> [--last N]\n", argv[0]);
+        return 2;
+    }
+
+    size_t lastN = 0;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--last") == 0 && i + 1 < argc) {
+            lastN = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (data.size() < FLIGHT_HEADER_SIZE) {
+        std::fprintf(stderr, "file too small for a flight header\n");
+        return 1;
+    }
+
+    FlightHeader hdr;
+    std::memcpy(&hdr, data.data(), sizeof(hdr));
+    if (hdr.magic != FLIGHT_MAGIC) {
+        std::fprintf(stderr, "not a flight recorder file (bad magic)\n");
+        return 1;
+    }
+    if (hdr.version != FLIGHT_VERSION || hdr.recordSize != sizeof(FlightRecord)) {
+        std::fprintf(stderr, "unsupported version %u / record size %u\n", hdr.version, hdr.recordSize);
+        return 1;
+    }
+
+    size_t available = (data.size() - FLIGHT_HEADER_SIZE) / sizeof(FlightRecord);
+    size_t capacity  = std::min<size_t>(hdr.capacity, available);
+
+    // Collect slots whose seq matches the lap they claim to be from.
+    std::vector<FlightRecord> records;
+    records.reserve(capacity);
+    size_t torn = 0;
+    for (size_t slot = 0; slot < capacity; ++slot) {
+        FlightRecord rec;
+        std::memcpy(&rec, data.data() + FLIGHT_HEADER_SIZE + slot * sizeof(FlightRecord), sizeof(rec));
+        if (rec.seq == 0) continue;
+        if ((rec.seq - 1) % hdr.capacity != slot || rec.seq > hdr.writeIndex) { ++torn; continue; }
+        records.push_back(rec);
+    }
+    std::sort(records.begin(), records.end(),
+              [](const FlightRecord& a, const FlightRecord& b) { return a.seq < b.seq; });
+
+    std::printf("TalosAP flight recorder — pid %u, session started %s\n",
+                hdr.processId, FormatWallClock(hdr.startUnixNs).c_str());
+    std::printf("%u slots, %" PRIu64 " events written, %zu valid, %zu torn\n\n",
+                hdr.capacity, hdr.writeIndex, records.size(), torn);
+
+    size_t first = (lastN && lastN < records.size()) ? records.size() - lastN : 0;
+
+    std::printf("%10s %12s %4s %-8s %-24s %-20s %s\n",
+                "seq", "+ms", "tid", "kind", "name", "detail", "a / b");
+    for (size_t i = first; i < records.size(); ++i) {
+        const auto& r = records[i];
+        double relMs = (r.tsNs - hdr.startMonoNs) / 1e6;
+        std::printf("%10" PRIu64 " %12.3f %4u %-8s %-24s %-20s",
+                    r.seq, relMs, r.tid, KindName(r.kind),
+                    Field(r.name).c_str(), Field(r.detail).c_str());
+        switch (static_cast<FlightEventKind>(r.kind)) {
+            case FlightEventKind::SpanEnd:
+                std::printf(" %.3f us", r.a / 1e3);
+                break;
+            case FlightEventKind::WorldGeneration:
+                std::printf(" gen=%" PRId64 " cooldown=%u", r.a, r.b);
+                break;
+            default:
+                if (r.a || r.b) std::printf(" %" PRId64 " / %u", r.a, r.b);
+                break;
+        }
+        std::printf("\n");
+    }
+
+    // Replay begin/end pairs per thread to find spans that never closed.
+    std::map<uint16_t, std::vector<std::string>> open;
+    for (const auto& r : records) {
+        auto kind = static_cast<FlightEventKind>(r.kind);
+        std::string label = Field(r.name);
+        if (r.detail[0]) label += "(" + Field(r.detail) + ")";
+        auto& stack = open[r.tid];
+        if (kind == FlightEventKind::SpanBegin) {
+            stack.push_back(label);
+        } else if (kind == FlightEventKind::SpanEnd) {
+            // The ring may start mid-span; an unmatched end just means we
+            // never saw the begin.
+            auto it = std::find(stack.rbegin(), stack.rend(), label);
+            if (it != stack.rend()) stack.erase(std::next(it).base(), stack.end());
+        }
+    }
+
+    std::printf("\nOpen spans at end of recording (outermost > innermost):\n");
+    bool any = false;
+    for (const auto& [tid, stack] : open) {
+        if (stack.empty()) continue;
+        any = true;
+        std::printf("  tid %u: ", tid);
+        for (size_t i = 0; i < stack.size(); ++i) {
+            std::printf("%s%s", i ? " > " : "", stack[i].c_str());
+        }
+        std::printf("\n");
+    }
+    if (!any) std::printf("  (none — session ended cleanly between spans)\n");
+
+    return 0;
+}
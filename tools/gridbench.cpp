@@ -0,0 +1,197 @@
+// gridbench — SpatialGrid (the location tracker's proximity index)
+// against the linear distance scan it replaced.
+//
+//   gridbench [iterations]   ns per player-position query, grid vs scan
+//   gridbench --check        grid query == brute force on random and
+//                            edge-case layouts, exit 1 on mismatch
+//
+// Layouts are level-shaped: a few dozen to a few hundred locations
+// spread over ~20k units, queried at the 250-unit pickup radius.
+
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace TalosAP;
+
+struct Point { float x, y, z; };
+
+static constexpr float RADIUS = 250.0f;
+
+static std::vector<Point> RandomLevel(std::mt19937& rng, size_t count, float extent)
+{
+    std::uniform_real_distribution<float> pos(-extent, extent);
+    std::uniform_real_distribution<float> height(-500.0f, 3000.0f);
+    std::vector<Point> pts;
+    for (size_t i = 0; i < count; ++i) pts.push_back({ pos(rng), pos(rng), height(rng) });
+    return pts;
+}
+
+static std::vector<uint32_t> Brute(const std::vector<Point>& pts, const Point& q, float r)
+{
+    std::vector<uint32_t> out;
+    for (uint32_t i = 0; i < pts.size(); ++i) {
+        float dx = pts[i].x - q.x, dy = pts[i].y - q.y, dz = pts[i].z - q.z;
+        if (dx * dx + dy * dy + dz * dz <= r * r) out.push_back(i);
+    }
+    return out;
+}
+
+static std::vector<uint32_t> Grid(const SpatialGrid<uint32_t>& grid, const Point& q, float r)
+{
+    std::vector<uint32_t> out;
+    grid.Query(q.x, q.y, q.z, r, [&](uint32_t i, float) { out.push_back(i); });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+static void Build(SpatialGrid<uint32_t>& grid, const std::vector<Point>& pts)
+{
+    grid.Clear();
+    for (uint32_t i = 0; i < pts.size(); ++i) grid.Insert(i, pts[i].x, pts[i].y, pts[i].z);
+}
+
+// ============================================================
+// --check
+// ============================================================
+
+static int RunCheck()
+{
+    std::mt19937 rng(67);
+    int failures = 0;
+    size_t queries = 0, hits = 0;
+
+    auto compare = [&](const char* what, const SpatialGrid<uint32_t>& grid,
+                       const std::vector<Point>& pts, const Point& q, float r) {
+        auto a = Grid(grid, q, r);
+        auto b = Brute(pts, q, r);
+        ++queries;
+        hits += b.size();
+        if (a != b) {
+            if (failures < 10) {
+                std::printf("FAIL %s: query (%.1f, %.1f, %.1f) r=%.0f grid %zu brute %zu\n",
+                            what, q.x, q.y, q.z, r, a.size(), b.size());
+            }
+            ++failures;
+        }
+    };
+
+    SpatialGrid<uint32_t> grid(2.0f * RADIUS);
+
+    // Random levels; queries near existing points so most return something.
+    for (int level = 0; level < 200; ++level) {
+        auto pts = RandomLevel(rng, 20 + level % 300, 2000.0f + 100.0f * level);
+        Build(grid, pts);
+        std::normal_distribution<float> jitter(0.0f, RADIUS);
+        for (int i = 0; i < 200; ++i) {
+            const Point& p = pts[rng() % pts.size()];
+            compare("random", grid, pts, { p.x + jitter(rng), p.y + jitter(rng), p.z + jitter(rng) }, RADIUS);
+        }
+    }
+
+    // Cell boundaries, negative coordinates, exact-radius distances,
+    // radii larger than a cell, stacked duplicates.
+    {
+        std::vector<Point> pts;
+        for (int i = -4; i <= 4; ++i) {
+            float c = i * RADIUS;
+            pts.push_back({ c, c, c });
+            pts.push_back({ c - 0.001f, c, -c });
+            pts.push_back({ c, 0.0f, 0.0f });
+            pts.push_back({ c, 0.0f, 0.0f });
+        }
+        Build(grid, pts);
+        for (const auto& p : pts) {
+            compare("edge", grid, pts, p, RADIUS);
+            compare("edge-wide", grid, pts, p, RADIUS * 3.5f);
+            compare("edge-tiny", grid, pts, { p.x + RADIUS, p.y, p.z }, 0.0f);
+        }
+    }
+
+    // Far-away and non-finite coordinates are clamped, never UB.
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+        std::vector<Point> pts = { { 1e30f, 0, 0 }, { -1e30f, 0, 0 }, { 0, 0, 0 }, { inf, inf, inf } };
+        Build(grid, pts);
+        compare("far", grid, pts, { 0, 0, 0 }, RADIUS);
+        compare("far", grid, pts, { 1e30f, 0, 0 }, RADIUS);
+        std::vector<uint32_t> nanHits;
+        grid.Query(std::nanf(""), 0, 0, RADIUS, [&](uint32_t i, float) { nanHits.push_back(i); });
+        if (!nanHits.empty()) { std::printf("FAIL nan query returned %zu\n", nanHits.size()); ++failures; }
+    }
+
+    // Empty grid and rebuild reuse.
+    grid.Clear();
+    size_t emptyHits = 0;
+    grid.Query(0, 0, 0, RADIUS, [&](uint32_t, float) { ++emptyHits; });
+    if (emptyHits || grid.size() || grid.CellCount()) { std::printf("FAIL clear\n"); ++failures; }
+
+    std::printf("%zu queries, %zu hits, %d failures\n", queries, hits, failures);
+    std::printf("gridbench check: %s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
+
+// ============================================================
+// Benchmark
+// ============================================================
+
+static volatile size_t g_sink = 0;
+
+template <typename F>
+static double NsPerOp(size_t ops, F&& body)
+{
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) return RunCheck();
+
+    size_t iters = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    std::mt19937 rng(1);
+    std::printf("%8s %10s %10s %10s %8s\n", "points", "scan ns", "grid ns", "build us", "cells");
+    for (size_t count : { 10, 40, 120, 400, 1500 }) {
+        auto pts = RandomLevel(rng, count, 10000.0f);
+        SpatialGrid<uint32_t> grid(2.0f * RADIUS);
+
+        double buildUs = NsPerOp(100, [&] { for (int i = 0; i < 100; ++i) Build(grid, pts); }) / 1000.0;
+
+        // A player walking through the level.
+        std::vector<Point> path;
+        for (size_t i = 0; i < 1024; ++i) {
+            float t = static_cast<float>(i) / 1024.0f;
+            path.push_back({ -10000.0f + 20000.0f * t, 3000.0f * std::sin(t * 6.28f), 100.0f });
+        }
+
+        double scan = NsPerOp(iters, [&] {
+            for (size_t i = 0; i < iters; ++i) {
+                const Point& q = path[i & 1023];
+                for (const auto& p : pts) {
+                    float dx = p.x - q.x, dy = p.y - q.y, dz = p.z - q.z;
+                    if (dx * dx + dy * dy + dz * dz < RADIUS * RADIUS) g_sink = g_sink + 1;
+                }
+            }
+        });
+        double query = NsPerOp(iters, [&] {
+            for (size_t i = 0; i < iters; ++i) {
+                const Point& q = path[i & 1023];
+                grid.Query(q.x, q.y, q.z, RADIUS, [](uint32_t, float) { g_sink = g_sink + 1; });
+            }
+        });
+
+        std::printf("%8zu %10.1f %10.1f %10.1f %8zu\n", count, scan, query, buildUs, grid.CellCount());
+    }
+    return 0;
+}
@@ -0,0 +1,396 @@
+// hashbench — compare FlatHashMap/FlatHashSet against the std:: node
+// containers they replaced, on the shapes the mod actually uses:
+//
+//   GrantedItems / CheckedLocations   set of ~200 short string IDs
+//   m_locationIdToName                int64 → string, ~280 entries
+//   m_tracked                         string → small struct, ~40 entries
+//
+// Reports ns per lookup (hit and miss) and bytes held by each container.
+//
+//   hashbench [iterations]
+//   hashbench --check        randomized insert/erase/find against
+//                            std::unordered_map (tombstone reuse, the 7/8
+//                            load rehash, colliding hashes), exit 1 on
+//                            mismatch
+
+#include "FlatHashMap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace TalosAP;
+
+// ============================================================
+// Byte-counting allocator (memory comparison)
+// ============================================================
+
+static size_t g_liveBytes = 0;
+
+template <typename T>
+struct CountingAlloc {
+    using value_type = T;
+    CountingAlloc() = default;
+    template <typename U> CountingAlloc(const CountingAlloc<U>&) {}
+
+    T* allocate(size_t n)
+    {
+        g_liveBytes += n * sizeof(T);
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* p, size_t n)
+    {
+        g_liveBytes -= n * sizeof(T);
+        std::allocator<T>{}.deallocate(p, n);
+    }
+    template <typename U> bool operator==(const CountingAlloc<U>&) const { return true; }
+    template <typename U> bool operator!=(const CountingAlloc<U>&) const { return false; }
+};
+
+// ============================================================
+// Workload keys
+// ============================================================
+
+static std::vector<std::string> TetrominoIds(size_t count)
+{
+    static const char* prefixes[] = { "DJ", "DZ", "DI", "DL", "DT", "MT", "ML", "MZ", "MS", "MJ",
+                                      "MO", "MI", "NL", "NZ", "NT", "NI", "NJ", "NO", "NS" };
+    std::vector<std::string> ids;
+    for (size_t n = 1; ids.size() < count; ++n) {
+        for (const char* p : prefixes) {
+            if (ids.size() == count) break;
+            ids.push_back(std::string(p) + std::to_string(n));
+        }
+    }
+    return ids;
+}
+
+struct Tracked {
+    float x = 0, y = 0, z = 0;
+    bool  reported = false;
+    int   visRetries = 0;
+};
+
+// ============================================================
+// --check
+// ============================================================
+
+/// Three home groups for every key, so probe chains run across groups,
+/// wrap around the table and leave tombstones mid-chain. The low 7 bits
+/// (the control tag) still vary.
+struct CollidingHash {
+    size_t operator()(int64_t k) const { return (static_cast<size_t>(k % 3) << 7) | (static_cast<size_t>(k) & 0x7F); }
+};
+
+static int g_failures = 0;
+
+static void Fail(const char* what, size_t step)
+{
+    if (g_failures < 10) std::printf("FAIL %s (step %zu)\n", what, step);
+    ++g_failures;
+}
+
+/// Same contents, both ways, and iteration visits each element once.
+template <typename Flat, typename Ref>
+static void CompareContents(const char* what, const Flat& flat, const Ref& ref, size_t step)
+{
+    if (flat.size() != ref.size()) { Fail(what, step); return; }
+    size_t visited = 0;
+    for (const auto& [k, v] : flat) {
+        auto it = ref.find(k);
+        if (it == ref.end() || it->second != v) { Fail(what, step); return; }
+        ++visited;
+    }
+    if (visited != ref.size()) { Fail(what, step); return; }
+    for (const auto& [k, v] : ref) {
+        auto it = flat.find(k);
+        if (it == flat.end() || it->second != v) { Fail(what, step); return; }
+    }
+}
+
+/// Random operations over a small key space, so keys are erased and
+/// re-inserted constantly and tombstones build up between rehashes.
+template <typename Flat>
+static void RandomOps(const char* what, uint32_t seed, int64_t keySpace, size_t steps)
+{
+    std::mt19937_64 rng(seed);
+    Flat flat;
+    std::unordered_map<int64_t, int64_t> ref;
+
+    for (size_t step = 0; step < steps; ++step) {
+        int64_t k = static_cast<int64_t>(rng() % static_cast<uint64_t>(keySpace));
+        int64_t v = static_cast<int64_t>(rng());
+        switch (rng() % 8) {
+            case 0: case 1: {
+                bool a = flat.try_emplace(k, v).second;
+                bool b = ref.try_emplace(k, v).second;
+                if (a != b) Fail(what, step);
+                break;
+            }
+            case 2:
+                flat[k] = v;
+                ref[k] = v;
+                break;
+            case 3: case 4:
+                if (flat.erase(k) != ref.erase(k)) Fail(what, step);
+                break;
+            case 5: {
+                auto it = flat.find(k);
+                auto rt = ref.find(k);
+                if ((it == flat.end()) != (rt == ref.end())) Fail(what, step);
+                else if (it != flat.end() && it->second != rt->second) Fail(what, step);
+                // Erase through the iterator now and then
+                if (it != flat.end() && (v & 1)) { flat.erase(it); ref.erase(rt); }
+                break;
+            }
+            case 6:
+                if (flat.contains(k) != (ref.count(k) != 0)) Fail(what, step);
+                break;
+            case 7:
+                if (step % 4096 == 7) {
+                    // Drop about a third, through erase_if / iterator erase
+                    erase_if(flat, [](const auto& e) { return e.first % 3 == 0; });
+                    std::erase_if(ref, [](const auto& e) { return e.first % 3 == 0; });
+                }
+                break;
+        }
+        if (step % 1024 == 0) CompareContents(what, flat, ref, step);
+    }
+    CompareContents(what, flat, ref, steps);
+
+    // Copies and moves keep the contents
+    Flat copy = flat;
+    CompareContents(what, copy, ref, steps);
+    Flat moved = std::move(copy);
+    CompareContents(what, moved, ref, steps);
+    moved.clear();
+    if (!moved.empty() || moved.begin() != moved.end()) Fail(what, steps);
+}
+
+/// Growth happens exactly when an insert would pass 7/8 of capacity.
+static void CheckLoadBoundary()
+{
+    FlatHashMap<int64_t, int64_t> map;
+    size_t cap = 0;
+    for (int64_t k = 0; k < 5000; ++k) {
+        size_t before = map.capacity();
+        map.try_emplace(k, k);
+        size_t after = map.capacity();
+        if (after != before) {
+            // Grew: the previous table was at its limit (or empty)
+            if (before != 0 && map.size() - 1 != before - before / 8) Fail("load boundary", static_cast<size_t>(k));
+            cap = after;
+        }
+        if (map.size() > cap - cap / 8) Fail("over 7/8 load", static_cast<size_t>(k));
+    }
+    for (int64_t k = 0; k < 5000; ++k) {
+        if (!map.contains(k)) { Fail("lost across growth", static_cast<size_t>(k)); break; }
+    }
+}
+
+/// Hash = key: bits 7.. choose the home group, the low 7 bits the tag.
+struct IdentityHash {
+    size_t operator()(int64_t k) const { return static_cast<size_t>(k); }
+};
+
+static int64_t KeyInGroup(int64_t home, int64_t n) { return (n << 9) | (home << 7) | (n & 0x7F); }
+
+/// Tombstone handling on a 64-slot table (4 groups, 56 fit):
+///  - 56 keys homed on group 0 fill groups 0, 1, 3 and half of 2 (the
+///    probe order), using up every bit of growth
+///  - erasing 40 of them from the full groups leaves tombstones, which
+///    re-inserts on the same chain must reuse without growing
+///  - a key homed on group 2 then needs an empty byte with no growth
+///    left: with 16 live, the table must rehash in place, not double
+static void CheckTombstoneReuse()
+{
+    FlatHashMap<int64_t, int64_t, IdentityHash> map;
+    std::unordered_map<int64_t, int64_t> ref;
+    map.reserve(56);
+    const size_t startCap = map.capacity();
+    if (startCap != 64) { Fail("reserve(56) capacity", startCap); return; }
+
+    for (int64_t n = 0; n < 56; ++n) { map.try_emplace(KeyInGroup(0, n), n); ref.try_emplace(KeyInGroup(0, n), n); }
+    if (map.capacity() != startCap) Fail("grew before 7/8", 0);
+    for (int64_t n = 0; n < 40; ++n) { map.erase(KeyInGroup(0, n)); ref.erase(KeyInGroup(0, n)); }
+
+    // Same chain: tombstones are reused
+    for (int64_t round = 0; round < 1000; ++round) {
+        int64_t n = 1000 + round;
+        map.try_emplace(KeyInGroup(0, n), n);
+        ref.try_emplace(KeyInGroup(0, n), n);
+        map.erase(KeyInGroup(0, n));
+        ref.erase(KeyInGroup(0, n));
+    }
+    if (map.capacity() != startCap) Fail("tombstone reuse grew the table", 1);
+
+    // Other chain, no growth left: in-place rehash
+    map.try_emplace(KeyInGroup(2, 5000), 5000);
+    ref.try_emplace(KeyInGroup(2, 5000), 5000);
+    if (map.capacity() != startCap) Fail("tombstones doubled the table instead of an in-place rehash", 2);
+    CompareContents("tombstone rehash", map, ref, 2);
+
+    // And it keeps working afterwards
+    for (int64_t n = 0; n < 40; ++n) { map.try_emplace(KeyInGroup(n % 4, 6000 + n), n); ref.try_emplace(KeyInGroup(n % 4, 6000 + n), n); }
+    CompareContents("after rehash", map, ref, 3);
+}
+
+/// Transparent lookup: string_view and const char* find the std::string keys.
+static void CheckTransparent()
+{
+    FlatHashSet<std::string> set;
+    for (const auto& id : TetrominoIds(300)) set.insert(id);
+    for (const auto& id : TetrominoIds(300)) {
+        std::string_view sv = id;
+        if (!set.contains(sv) || !set.contains(id.c_str())) { Fail("transparent lookup", 0); return; }
+    }
+    if (set.contains(std::string_view("XX1"))) Fail("transparent miss", 0);
+}
+
+static int RunCheck()
+{
+    RandomOps<FlatHashMap<int64_t, int64_t>>("random small", 1, 64, 200000);
+    RandomOps<FlatHashMap<int64_t, int64_t>>("random wide", 2, 5000, 400000);
+    RandomOps<FlatHashMap<int64_t, int64_t, CollidingHash>>("random colliding", 3, 300, 300000);
+    CheckLoadBoundary();
+    CheckTombstoneReuse();
+    CheckTransparent();
+
+    std::printf("%d failures\n", g_failures);
+    std::printf("hashbench check: %s\n", g_failures ? "FAILED" : "ok");
+    return g_failures ? 1 : 0;
+}
+
+// ============================================================
+// Timing
+// ============================================================
+
+template <typename F>
+static double NsPerOp(size_t ops, F&& body)
+{
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+}
+
+static volatile size_t g_sink = 0;
+
+template <typename Set>
+static void BenchStringSet(const char* label, const std::vector<std::string>& keys,
+                           const std::vector<std::string>& probes, size_t iters)
+{
+    size_t before = g_liveBytes;
+    Set set;
+    for (size_t i = 0; i < keys.size(); i += 2) set.insert(keys[i]);   // half present
+    size_t bytes = g_liveBytes - before;
+
+    double ns = NsPerOp(iters * probes.size(), [&] {
+        size_t hits = 0;
+        for (size_t it = 0; it < iters; ++it) {
+            for (const auto& p : probes) hits += set.count(p);
+        }
+        g_sink = g_sink + hits;
+    });
+
+    std::printf("  %-34s %7.2f ns/lookup  %7zu bytes\n", label, ns, bytes);
+}
+
+template <typename Map>
+static void BenchIntMap(const char* label, const std::vector<std::string>& names,
+                        size_t iters)
+{
+    const int64_t base = 0x540000;
+    size_t before = g_liveBytes;
+    Map map;
+    for (size_t i = 0; i < names.size(); ++i) map[base + static_cast<int64_t>(i)] = names[i];
+    size_t bytes = g_liveBytes - before;
+
+    std::vector<int64_t> probes;
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < 1024; ++i) probes.push_back(base + static_cast<int64_t>(rng() % (names.size() * 2)));
+
+    double ns = NsPerOp(iters * probes.size(), [&] {
+        size_t found = 0;
+        for (size_t it = 0; it < iters; ++it) {
+            for (int64_t p : probes) {
+                auto f = map.find(p);
+                if (f != map.end()) found += f->second.size();
+            }
+        }
+        g_sink = g_sink + found;
+    });
+
+    std::printf("  %-34s %7.2f ns/lookup  %7zu bytes\n", label, ns, bytes);
+}
+
+template <typename Map>
+static void BenchTrackedIterate(const char* label, const std::vector<std::string>& ids, size_t iters)
+{
+    size_t before = g_liveBytes;
+    Map map;
+    for (const auto& id : ids) map[id] = Tracked{};
+    size_t bytes = g_liveBytes - before;
+
+    // EnforceVisibility shape: walk every entry, then one keyed lookup each.
+    double ns = NsPerOp(iters * ids.size(), [&] {
+        size_t acc = 0;
+        for (size_t it = 0; it < iters; ++it) {
+            for (auto& [id, tt] : map) {
+                tt.visRetries += 1;
+                acc += map.count(id);
+            }
+        }
+        g_sink = g_sink + acc;
+    });
+
+    std::printf("  %-34s %7.2f ns/entry   %7zu bytes\n", label, ns, bytes);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) return RunCheck();
+
+    size_t iters = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+    std::vector<std::string> ids = TetrominoIds(200);
+    std::vector<std::string> probes;
+    std::mt19937_64 rng(7);
+    for (size_t i = 0; i < 1024; ++i) probes.push_back(ids[rng() % ids.size()]);
+
+    using StrAlloc = CountingAlloc<std::string>;
+    std::printf("GrantedItems-style set (100 of 200 IDs present, 50%% hit):\n");
+    BenchStringSet<std::unordered_set<std::string, std::hash<std::string>, std::equal_to<std::string>, StrAlloc>>(
+        "std::unordered_set<std::string>", ids, probes, iters);
+    BenchStringSet<FlatHashSet<std::string, FlatHash<std::string>, std::equal_to<>, StrAlloc>>(
+        "FlatHashSet<std::string>", ids, probes, iters);
+
+    std::vector<std::string> names = TetrominoIds(280);
+    using IntPair = std::pair<const int64_t, std::string>;
+    std::printf("\nLocation ID -> name (280 entries, 50%% hit):\n");
+    BenchIntMap<std::unordered_map<int64_t, std::string, std::hash<int64_t>, std::equal_to<int64_t>, CountingAlloc<IntPair>>>(
+        "std::unordered_map<int64, string>", names, iters);
+    BenchIntMap<FlatHashMap<int64_t, std::string, FlatHash<int64_t>, std::equal_to<>, CountingAlloc<IntPair>>>(
+        "FlatHashMap<int64, string>", names, iters);
+
+    std::vector<std::string> tracked = TetrominoIds(40);
+    using TrackedPair = std::pair<const std::string, Tracked>;
+    std::printf("\nTracked tetrominos (40 entries, iterate + lookup):\n");
+    BenchTrackedIterate<std::unordered_map<std::string, Tracked, std::hash<std::string>, std::equal_to<std::string>, CountingAlloc<TrackedPair>>>(
+        "std::unordered_map<string, Tracked>", tracked, iters * 20);
+    BenchTrackedIterate<FlatHashMap<std::string, Tracked, FlatHash<std::string>, std::equal_to<>, CountingAlloc<TrackedPair>>>(
+        "FlatHashMap<string, Tracked>", tracked, iters * 20);
+
+#ifdef TALOSAP_FLAT_HASH_SSE2
+    std::printf("\n(group probing: SSE2)\n");
+#else
+    std::printf("\n(group probing: scalar fallback)\n");
+#endif
+    return 0;
+}
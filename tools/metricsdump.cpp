@@ -0,0 +1,176 @@
+// metricsdump — sample the mod's live metrics page.
+//
+//   metricsdump <pid> [--interval MS] [--count N]   print a sample every MS
+//                                                   (default 1000) N times
+//                                                   (default: until killed)
+//   metricsdump <pid> --once                        one raw snapshot
+//   metricsdump --check                             writer/reader consistency
+//                                                   self-test, exit 1 on failure
+//
+// The page is "TalosAP.Metrics.<pid>" (MetricsPage.h). On Linux, run
+// metricsfake to get a page to look at.
+
+#include "LiveMetrics.h"
+#include "MappedRegion.h"
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace TalosAP;
+
+static const char* LINK_STATES[] = { "disconnected", "connecting", "socket", "room info", "slot" };
+
+static void PrintRaw(const MetricsPage& page, const MetricSnapshot& s)
+{
+    for (size_t g = 0; g < METRIC_GAUGE_COUNT; ++g) {
+        std::printf("%-24s %" PRIu64 "\n", MetricGaugeName(static_cast<MetricGauge>(g)), s.gauges[g]);
+    }
+    for (size_t p = 0; p < METRIC_PHASE_COUNT; ++p) {
+        const auto& ph = s.phases[p];
+        std::printf("phase %-18s runs=%" PRIu64 " total_ns=%" PRIu64 " last_ns=%" PRIu64 " max_ns=%" PRIu64 "\n",
+                    MetricPhaseName(static_cast<MetricPhase>(p)), ph.runs, ph.totalNs, ph.lastNs, ph.maxNs);
+    }
+    for (size_t k = 0; k < METRICS_ENGINE_CALL_SLOTS; ++k) {
+        if (!page.engineCallNames[k][0]) continue;
+        std::printf("calls %-18s total=%" PRIu64 " per_s=%" PRIu64 "\n",
+                    page.engineCallNames[k], s.engineCallTotals[k], s.engineCallRates[k]);
+    }
+}
+
+/// One line per interval: tick rate, connection, counts, then per-phase
+/// average cost over the interval.
+static void PrintDelta(const MetricSnapshot& a, const MetricSnapshot& b)
+{
+    auto g = [&](MetricGauge x) { return b.gauges[static_cast<size_t>(x)]; };
+    double secs = (b.monoNs - a.monoNs) / 1e9;
+    double tps  = secs > 0 ? (g(MetricGauge::Tick) - a.gauges[static_cast<size_t>(MetricGauge::Tick)]) / secs : 0;
+    uint64_t link = g(MetricGauge::LinkState);
+
+    std::printf("tick %" PRIu64 " (%.1f/s) world %" PRIu64 " | %s%s item#%" PRIu64 " | granted %" PRIu64
+                " checked %" PRIu64 " tracked %" PRIu64 " | hud %" PRIu64 " fences %" PRIu64
+                " rings %" PRIu64 "/%" PRIu64 " B\n",
+                g(MetricGauge::Tick), tps, g(MetricGauge::WorldGeneration),
+                link < 5 ? LINK_STATES[link] : "?", g(MetricGauge::SessionPid) ? " (helper)" : "",
+                g(MetricGauge::NextItemIndex), g(MetricGauge::GrantedItems),
+                g(MetricGauge::CheckedLocations), g(MetricGauge::TrackedTetrominos),
+                g(MetricGauge::HudPending), g(MetricGauge::FenceOpensPending),
+                g(MetricGauge::ToModBytes), g(MetricGauge::ToSessionBytes));
+
+    for (size_t p = 0; p < METRIC_PHASE_COUNT; ++p) {
+        uint64_t runs = b.phases[p].runs - a.phases[p].runs;
+        if (runs == 0) continue;
+        double avgUs = (b.phases[p].totalNs - a.phases[p].totalNs) / 1e3 / runs;
+        std::printf("    %-18s %6" PRIu64 " runs  avg %8.1f us  max %8.1f us\n",
+                    MetricPhaseName(static_cast<MetricPhase>(p)), runs, avgUs, b.phases[p].maxNs / 1e3);
+    }
+}
+
+// ============================================================
+// --check: a writer thread publishes ticks whose every value is derived
+// from the tick number; the reader must never see a mix of two ticks.
+// ============================================================
+static int RunCheck()
+{
+    const std::wstring name = L"TalosAP.Metrics.check";
+    auto& writer = LiveMetrics::Get();
+    if (!writer.Open(name, 1)) {
+        std::fprintf(stderr, "could not create %ls\n", name.c_str());
+        return 1;
+    }
+
+    MappedRegion region;
+    if (!region.OpenNamed(name, sizeof(MetricsPage), false)) {
+        std::fprintf(stderr, "could not open %ls\n", name.c_str());
+        return 1;
+    }
+    const auto& page = *static_cast<const MetricsPage*>(region.Data());
+
+    constexpr uint64_t TICKS = 300000;
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (uint64_t t = 1; t <= TICKS; ++t) {
+            for (size_t g = 0; g < METRIC_GAUGE_COUNT; ++g) {
+                writer.SetGauge(static_cast<MetricGauge>(g), t * 1000 + g);
+            }
+            writer.AddPhase(MetricPhase::Tick, 100);
+            writer.SetEngineCalls(0, t, 0);
+            writer.Publish();
+        }
+        done = true;
+    });
+
+    uint64_t samples = 0, torn = 0, busy = 0, lastTick = 0, backwards = 0;
+    MetricSnapshot s{};
+    while (!done.load()) {
+        if (!ReadMetrics(page, s)) { ++busy; continue; }
+        ++samples;
+        uint64_t t = s.gauges[0] / 1000;
+        bool ok = s.engineCallTotals[0] == t && s.phases[0].runs == t && s.phases[0].totalNs == t * 100;
+        for (size_t g = 0; g < METRIC_GAUGE_COUNT; ++g) ok &= s.gauges[g] == t * 1000 + g;
+        if (!ok) ++torn;
+        if (t < lastTick) ++backwards;
+        lastTick = t;
+    }
+    producer.join();
+
+    bool ok = ReadMetrics(page, s) && s.gauges[0] == TICKS * 1000 && torn == 0 && backwards == 0 && samples > 0
+        && page.magic == METRICS_MAGIC && page.pageBytes == sizeof(MetricsPage);
+    std::printf("  %" PRIu64 " ticks, %" PRIu64 " samples, %" PRIu64 " torn, %" PRIu64 " out of order, %" PRIu64 " busy retries\n",
+                TICKS, samples, torn, backwards, busy);
+    std::printf("metricsdump check: %s\n", ok ? "ok" : "FAILED");
+    writer.Close();
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) return RunCheck();
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: metricsdump <pid> [--interval MS] [--count N] [--once]\n"
+                             "       metricsdump --check\n");
+        return 2;
+    }
+
+    uint32_t pid = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    int intervalMs = 1000;
+    long count = -1;
+    bool once = false;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) intervalMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) count = std::atol(argv[++i]);
+        else if (std::strcmp(argv[i], "--once") == 0) once = true;
+    }
+
+    MappedRegion region;
+    if (!region.OpenNamed(MetricsNameFor(pid), sizeof(MetricsPage), false)) {
+        std::fprintf(stderr, "no metrics page for pid %u\n", pid);
+        return 1;
+    }
+    const auto& page = *static_cast<const MetricsPage*>(region.Data());
+    if (page.magic != METRICS_MAGIC || page.version != METRICS_VERSION || page.pageBytes != sizeof(MetricsPage)) {
+        std::fprintf(stderr, "metrics page for pid %u is from a different build (version %u)\n", pid, page.version);
+        return 1;
+    }
+
+    MetricSnapshot prev{}, cur{};
+    if (!ReadMetrics(page, prev)) {
+        std::fprintf(stderr, "no complete sample yet\n");
+        return 1;
+    }
+    if (once) {
+        PrintRaw(page, prev);
+        return 0;
+    }
+    for (long n = 0; count < 0 || n < count; ++n) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        if (!ReadMetrics(page, cur)) continue;
+        PrintDelta(prev, cur);
+        prev = cur;
+    }
+    return 0;
+}
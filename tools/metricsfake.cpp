@@ -0,0 +1,88 @@
+// metricsfake — a stand-in for the mod that publishes a live metrics page,
+// so metricsdump and overlays can be developed without the game.
+//
+//   metricsfake [seconds]     tick at ~60 Hz with plausible values (default 60)
+//
+// Prints its pid; run `metricsdump <pid>` next to it.
+
+#include "LiveMetrics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace TalosAP;
+
+static const char* ENGINE_CALLS[] = {
+    "FindAllOf", "FindFirstOf", "StaticFindObject", "GetValuePtr", "GetFunction", "ProcessEvent", "GetFullName",
+};
+
+int main(int argc, char** argv)
+{
+    int seconds = (argc > 1) ? std::atoi(argv[1]) : 60;
+
+    auto& m = LiveMetrics::Get();
+    if (!m.Open()) {
+        std::fprintf(stderr, "could not create the metrics page\n");
+        return 1;
+    }
+    for (size_t k = 0; k < sizeof(ENGINE_CALLS) / sizeof(ENGINE_CALLS[0]); ++k) {
+        m.SetEngineCallName(k, ENGINE_CALLS[k]);
+    }
+#ifdef _WIN32
+    std::printf("metricsfake pid %d — publishing for %d s\n", _getpid(), seconds);
+#else
+    std::printf("metricsfake pid %d — publishing for %d s\n", static_cast<int>(getpid()), seconds);
+#endif
+    std::fflush(stdout);
+
+    std::mt19937 rng(1);
+    auto jitter = [&](int64_t base) { return base + static_cast<int64_t>(rng() % (base / 2 + 1)); };
+
+    uint64_t granted = 0, checked = 0, world = 1, processEvents = 0, findAllOf = 0;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    for (uint64_t tick = 1; std::chrono::steady_clock::now() < end; ++tick) {
+        auto start = std::chrono::steady_clock::now();
+
+        // Same cadence as on_update
+        m.AddPhase(MetricPhase::APPoll, jitter(3'000));
+        if (tick % 12 == 0) m.AddPhase(MetricPhase::HudTick, jitter(20'000));
+        if (tick % 5 == 0)  { m.AddPhase(MetricPhase::EnforceVisibility, jitter(90'000)); ++findAllOf; processEvents += 2; }
+        if (tick % 60 == 0) { m.AddPhase(MetricPhase::RefreshVisibility, jitter(400'000)); ++findAllOf; }
+        if (tick % 6 == 0)  m.AddPhase(MetricPhase::FenceOpens, jitter(1'000));
+        if (tick % 60 == 0) m.AddPhase(MetricPhase::EnforceCollection, jitter(150'000));
+        if (tick % 1800 == 0) { ++world; m.AddPhase(MetricPhase::ScanLevel, jitter(2'000'000)); }
+        if (tick % 90 == 0)  ++granted;
+        if (tick % 240 == 0) ++checked;
+        m.AddPhase(MetricPhase::Tick, jitter(150'000));
+
+        m.SetGauge(MetricGauge::Tick, tick);
+        m.SetGauge(MetricGauge::WorldGeneration, world);
+        m.SetGauge(MetricGauge::APSynced, 1);
+        m.SetGauge(MetricGauge::LinkState, 4);
+        m.SetGauge(MetricGauge::SlotConnected, 1);
+        m.SetGauge(MetricGauge::SessionHeartbeat, tick * 3);
+        m.SetGauge(MetricGauge::NextItemIndex, granted);
+        m.SetGauge(MetricGauge::GrantedItems, granted);
+        m.SetGauge(MetricGauge::CheckedLocations, checked);
+        m.SetGauge(MetricGauge::TrackedTetrominos, 12 + world % 7);
+        m.SetGauge(MetricGauge::HudPending, rng() % 3);
+        m.SetGauge(MetricGauge::ToModBytes, (rng() % 4) * 48);
+        m.SetGauge(MetricGauge::ArenaBytes, 2048 + rng() % 1024);
+        m.SetEngineCalls(0, findAllOf, 12.0);
+        m.SetEngineCalls(5, processEvents, 24.0);
+        m.Publish();
+
+        std::this_thread::sleep_until(start + std::chrono::microseconds(16'667));
+    }
+    m.Close();
+    return 0;
+}
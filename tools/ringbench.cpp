@@ -0,0 +1,192 @@
+// ringbench — throughput and correctness of SpscRing, the shared-memory
+// ring the AP session uses to hand events to the game thread.
+//
+//   ringbench [records]     producer/consumer threads, mixed record sizes
+//   ringbench --check       ordering/contents under wrap-around, threaded
+//                           and (POSIX) across two processes; exit 1 on failure
+
+#include "SpscRing.h"
+#include "APChannel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace TalosAP;
+
+// Record i carries a size picked from i alone, filled with bytes derived
+// from i, so the consumer can verify without shared state.
+static uint32_t SizeFor(uint64_t i)
+{
+    static const uint32_t sizes[] = { 0, 8, 13, 40, 64, 120, 300, 1000, 4000 };
+    return sizes[(i * 2654435761u) % (sizeof(sizes) / sizeof(sizes[0]))];
+}
+
+static void Fill(uint64_t i, uint8_t* buf, uint32_t size)
+{
+    for (uint32_t k = 0; k < size; ++k) buf[k] = static_cast<uint8_t>(i * 31 + k);
+}
+
+static bool Verify(uint64_t i, uint16_t type, const uint8_t* data, uint32_t size)
+{
+    if (type != static_cast<uint16_t>(i & 0xFFFF) || size != SizeFor(i)) return false;
+    for (uint32_t k = 0; k < size; ++k) {
+        if (data[k] != static_cast<uint8_t>(i * 31 + k)) return false;
+    }
+    return true;
+}
+
+static void Produce(SpscRing ring, uint64_t count)
+{
+    std::vector<uint8_t> buf(4096);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint32_t size = SizeFor(i);
+        Fill(i, buf.data(), size);
+        while (!ring.TryWrite(static_cast<uint16_t>(i & 0xFFFF), buf.data(), size)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/// Returns the number of records that failed verification.
+static uint64_t Consume(SpscRing ring, uint64_t count, uint64_t& bytes)
+{
+    uint64_t next = 0, bad = 0;
+    bytes = 0;
+    while (next < count) {
+        size_t n = ring.Drain([&](uint16_t type, const uint8_t* data, uint32_t size) {
+            if (!Verify(next, type, data, size)) ++bad;
+            bytes += size;
+            ++next;
+        });
+        if (n == 0) std::this_thread::yield();
+    }
+    return bad;
+}
+
+static bool CheckThreaded(uint32_t capacity, uint64_t count)
+{
+    std::unique_ptr<uint8_t[]> mem(new uint8_t[SpscRing::BytesFor(capacity) + 64]);
+    void* aligned = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(mem.get()) + 63) & ~uintptr_t(63));
+    SpscRing ring = SpscRing::Create(aligned, capacity);
+
+    std::thread producer(Produce, ring, count);
+    uint64_t bytes = 0;
+    uint64_t bad = Consume(ring, count, bytes);
+    producer.join();
+
+    bool ok = bad == 0 && ring.UsedBytes() == 0;
+    std::printf("  threaded  cap=%-7u records=%-8llu bad=%llu %s\n", capacity,
+                static_cast<unsigned long long>(count), static_cast<unsigned long long>(bad), ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static bool CheckEdges()
+{
+    alignas(64) static uint8_t mem[SpscRing::BytesFor(256)];
+    SpscRing ring = SpscRing::Create(mem, 256);
+    uint8_t buf[256] = {};
+    bool ok = true;
+
+    ok &= !ring.TryWrite(1, buf, ring.MaxPayload() + 1);          // too large
+    ok &= ring.TryWrite(1, buf, ring.MaxPayload());               // largest fits, twice
+    ok &= ring.TryWrite(2, buf, ring.MaxPayload());
+    ok &= !ring.TryWrite(3, buf, 0);                              // full
+    ok &= ring.Drain([](uint16_t, const uint8_t*, uint32_t) {}) == 2;
+    ok &= ring.TryWrite(1, buf, 100) && ring.TryWrite(2, buf, 100);   // head now at offset 224
+    ok &= ring.Drain([](uint16_t, const uint8_t*, uint32_t) {}) == 2;
+    ok &= ring.TryWrite(3, buf, 100);                             // pads the last 32 bytes, wraps
+    ok &= ring.UsedBytes() == 32 + 112;
+    uint16_t seen = 0;
+    ok &= ring.Drain([&](uint16_t type, const uint8_t*, uint32_t) { seen = type; }) == 1;
+    ok &= seen == 3 && ring.UsedBytes() == 0;
+    ok &= !SpscRing::Attach(buf).Valid();                         // no magic
+
+    // APChannel round trip
+    APChannel::Writer w;
+    w.Put(int32_t{-7});
+    w.PutText(L"You found ");
+    w.PutId(ItemId("DJ3"));
+    APChannel::Reader r(w.Data(), w.Size());
+    ok &= r.Get<int32_t>() == -7;
+    ok &= r.GetText() == L"You found ";
+    ok &= r.GetId() == ItemId("DJ3");
+    ok &= !r.Failed();
+    r.Get<int64_t>();
+    ok &= r.Failed();                                            // past the end
+
+    std::printf("  edges                                     %s\n", ok ? "ok" : "FAIL");
+    return ok;
+}
+
+#ifndef _WIN32
+static bool CheckCrossProcess(uint32_t capacity, uint64_t count)
+{
+    size_t bytes = SpscRing::BytesFor(capacity);
+    void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return false;
+    SpscRing ring = SpscRing::Create(mem, capacity);
+
+    pid_t child = fork();
+    if (child == 0) {
+        Produce(SpscRing::Attach(mem), count);
+        _exit(0);
+    }
+    uint64_t got = 0;
+    uint64_t bad = Consume(ring, count, got);
+    int status = 0;
+    waitpid(child, &status, 0);
+    munmap(mem, bytes);
+
+    bool ok = bad == 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    std::printf("  processes cap=%-7u records=%-8llu bad=%llu %s\n", capacity,
+                static_cast<unsigned long long>(count), static_cast<unsigned long long>(bad), ok ? "ok" : "FAIL");
+    return ok;
+}
+#endif
+
+static int RunCheck()
+{
+    bool ok = CheckEdges();
+    ok &= CheckThreaded(16 * 1024, 200000);     // constant wrap-around
+    ok &= CheckThreaded(APChannel::TO_MOD_CAPACITY, 200000);
+#ifndef _WIN32
+    ok &= CheckCrossProcess(16 * 1024, 200000);
+#endif
+    std::printf("ringbench check: %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) return RunCheck();
+
+    uint64_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::unique_ptr<uint8_t[]> mem(new uint8_t[SpscRing::BytesFor(APChannel::TO_MOD_CAPACITY) + 64]);
+    void* aligned = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(mem.get()) + 63) & ~uintptr_t(63));
+    SpscRing ring = SpscRing::Create(aligned, APChannel::TO_MOD_CAPACITY);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread producer(Produce, ring, count);
+    uint64_t bytes = 0;
+    uint64_t bad = Consume(ring, count, bytes);
+    producer.join();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::printf("%llu records, %.1f MB payload in %.3f s: %.1f M records/s, %.0f MB/s, %.1f ns/record%s\n",
+                static_cast<unsigned long long>(count), bytes / 1e6, s, count / s / 1e6, bytes / s / 1e6,
+                s * 1e9 / count, bad ? " (VERIFY FAILED)" : "");
+    return bad ? 1 : 0;
+}
@@ -0,0 +1,419 @@
+// savedump — read collected tetrominoes from a Talos save without the game.
+//
+//   savedump <file.sav | directory>        header and CollectedTetrominos
+//                                          (a directory: its newest .sav)
+//   savedump --write-sample <out.sav> [--ue54 | --ue4]
+//                                          write a synthetic save of the
+//                                          same shape (tag layout to test)
+//   savedump --check                       parser self-test on synthetic
+//                                          saves, plus truncation and
+//                                          corruption sweeps; exit 1 on
+//                                          failure
+//
+// Uses the mod's own reader (src/SaveReader.cpp).
+
+#include "SaveReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace TalosAP;
+namespace fs = std::filesystem;
+
+// ============================================================
+// Synthetic GVAS writer
+// ============================================================
+
+enum class Layout { UE4, UE53, UE54 };
+
+struct TypeNode {
+    std::string name;
+    std::vector<TypeNode> inner;
+};
+
+class GvasWriter {
+public:
+    explicit GvasWriter(Layout layout) : m_layout(layout) {}
+
+    std::vector<uint8_t>& Bytes() { return m_buf; }
+
+    template <typename T>
+    void Put(T v)
+    {
+        auto* p = reinterpret_cast<const uint8_t*>(&v);
+        m_buf.insert(m_buf.end(), p, p + sizeof(T));
+    }
+
+    void String(const std::string& s, bool utf16 = false)
+    {
+        if (s.empty()) { Put<int32_t>(0); return; }
+        if (!utf16) {
+            Put<int32_t>(static_cast<int32_t>(s.size() + 1));
+            m_buf.insert(m_buf.end(), s.begin(), s.end());
+            m_buf.push_back(0);
+            return;
+        }
+        // Tests only feed BMP text
+        std::vector<uint16_t> units;
+        for (size_t i = 0; i < s.size();) {
+            unsigned char c = static_cast<unsigned char>(s[i]);
+            uint32_t cp = c;
+            size_t n = 1;
+            if (c >= 0xE0)      { cp = c & 0x0F; n = 3; }
+            else if (c >= 0xC0) { cp = c & 0x1F; n = 2; }
+            for (size_t k = 1; k < n && i + k < s.size(); ++k) cp = (cp << 6) | (s[i + k] & 0x3F);
+            units.push_back(static_cast<uint16_t>(cp));
+            i += n;
+        }
+        Put<int32_t>(-static_cast<int32_t>(units.size() + 1));
+        for (uint16_t u : units) Put(u);
+        Put<uint16_t>(0);
+    }
+
+    void Header()
+    {
+        Put<uint32_t>(0x53415647);
+        Put<int32_t>(m_layout == Layout::UE4 ? 2 : 3);
+        Put<int32_t>(522);
+        if (m_layout != Layout::UE4) Put<int32_t>(m_layout == Layout::UE54 ? 1012 : 1009);
+        Put<uint16_t>(m_layout == Layout::UE4 ? 4 : 5);
+        Put<uint16_t>(m_layout == Layout::UE54 ? 4 : 3);
+        Put<uint16_t>(2);
+        Put<uint32_t>(29314046);
+        String(m_layout == Layout::UE4 ? "++UE4+Release-4.27"
+             : m_layout == Layout::UE54 ? "++UE5+Release-5.4" : "++UE5+Release-5.3");
+        Put<int32_t>(3);
+        Put<int32_t>(2);
+        for (int i = 0; i < 2; ++i) {
+            for (int k = 0; k < 16; ++k) m_buf.push_back(static_cast<uint8_t>(i * 16 + k));
+            Put<int32_t>(7 + i);
+        }
+        String("/Script/Talos.TalosSaveGame");
+    }
+
+    /// Tag header; returns the mark EndTag() needs.
+    size_t BeginTag(const std::string& name, const TypeNode& type, bool boolValue = false, bool native = false)
+    {
+        String(name);
+        size_t sizeAt;
+        if (m_layout == Layout::UE54) {
+            WriteNode(type);
+            sizeAt = m_buf.size();
+            Put<int32_t>(0);
+            uint8_t flags = 0;
+            if (boolValue) flags |= 0x10;
+            if (native)    flags |= 0x08;
+            Put<uint8_t>(flags);
+        } else {
+            String(type.name);
+            sizeAt = m_buf.size();
+            Put<int32_t>(0);
+            Put<int32_t>(0);   // array index
+            const std::string& t = type.name;
+            if (t == "StructProperty") {
+                String(type.inner[0].name);
+                for (int k = 0; k < 16; ++k) m_buf.push_back(0);
+            } else if (t == "BoolProperty") {
+                Put<uint8_t>(boolValue ? 1 : 0);
+            } else if (t == "ByteProperty" || t == "EnumProperty" || t == "ArrayProperty" || t == "SetProperty") {
+                String(type.inner[0].name);
+            } else if (t == "MapProperty") {
+                String(type.inner[0].name);
+                String(type.inner[1].name);
+            }
+            Put<uint8_t>(0);   // no property guid
+        }
+        m_valueStart = m_buf.size();
+        return sizeAt;
+    }
+
+    void EndTag(size_t sizeAt, size_t valueStart)
+    {
+        int32_t size = static_cast<int32_t>(m_buf.size() - valueStart);
+        std::memcpy(m_buf.data() + sizeAt, &size, sizeof(size));
+    }
+
+    size_t ValueStart() const { return m_valueStart; }
+
+    void None() { String("None"); }
+
+private:
+    void WriteNode(const TypeNode& n)
+    {
+        String(n.name);
+        Put<int32_t>(static_cast<int32_t>(n.inner.size()));
+        for (const auto& c : n.inner) WriteNode(c);
+    }
+
+    Layout m_layout;
+    std::vector<uint8_t> m_buf;
+    size_t m_valueStart = 0;
+};
+
+static TypeNode Simple(const char* name) { return TypeNode{name, {}}; }
+static TypeNode Struct(const char* structName)
+{
+    return TypeNode{"StructProperty", {TypeNode{structName, {Simple("/Script/Talos")}}}};
+}
+
+struct Expected {
+    std::string id;
+    bool used;
+};
+
+static const std::vector<Expected> SAMPLE_TETROMINOS = {
+    { "DJ1", false }, { "A1-1", true }, { "NL5", false }, { "Ω-7", true },
+};
+
+/// A save shaped like the game's: unrelated properties around, and
+/// CollectedTetrominos nested in a struct inside an array of structs.
+static std::vector<uint8_t> BuildSample(Layout layout, bool withMap = true)
+{
+    GvasWriter w(layout);
+    w.Header();
+
+    size_t m = w.BeginTag("SaveVersion", Simple("IntProperty")); size_t v = w.ValueStart();
+    w.Put<int32_t>(7);
+    w.EndTag(m, v);
+
+    m = w.BeginTag("PlayerName", Simple("StrProperty")); v = w.ValueStart();
+    w.String("Tälös", true);
+    w.EndTag(m, v);
+
+    // Same name as the target, wrong type: must be skipped
+    m = w.BeginTag("CollectedTetrominos", Simple("IntProperty")); v = w.ValueStart();
+    w.Put<int32_t>(-1);
+    w.EndTag(m, v);
+
+    // Native struct: raw bytes, no tags
+    m = w.BeginTag("PlayerPosition", Struct("Vector"), false, true); v = w.ValueStart();
+    for (int k = 0; k < 3; ++k) w.Put<double>(k * 100.0);
+    w.EndTag(m, v);
+
+    m = w.BeginTag("Checkpoints", TypeNode{"ArrayProperty", {Simple("StrProperty")}}); v = w.ValueStart();
+    w.Put<int32_t>(2);
+    w.String("Cloud_1_01");
+    w.String("Cloud_1_02");
+    w.EndTag(m, v);
+
+    // Map with struct values (searched, nothing inside)
+    m = w.BeginTag("WorldStates", TypeNode{"MapProperty", {Simple("StrProperty"), Struct("WorldState")}});
+    v = w.ValueStart();
+    w.Put<int32_t>(0);
+    w.Put<int32_t>(1);
+    w.String("A1");
+    {
+        size_t bm = w.BeginTag("bSolved", Simple("BoolProperty"), true); size_t bv = w.ValueStart();
+        w.EndTag(bm, bv);
+        w.None();
+    }
+    w.EndTag(m, v);
+
+    // Array of structs: the second slot holds the progress
+    m = w.BeginTag("Slots", TypeNode{"ArrayProperty", {Struct("SlotInfo")}}); v = w.ValueStart();
+    w.Put<int32_t>(2);
+    size_t innerSize = 0, innerStart = 0;
+    if (layout != Layout::UE54) {
+        innerSize = w.BeginTag("Slots", Struct("SlotInfo"));
+        innerStart = w.ValueStart();
+    }
+    {
+        size_t im = w.BeginTag("Index", Simple("IntProperty")); size_t iv = w.ValueStart();
+        w.Put<int32_t>(0);
+        w.EndTag(im, iv);
+        w.None();
+    }
+    {
+        size_t im = w.BeginTag("Index", Simple("IntProperty")); size_t iv = w.ValueStart();
+        w.Put<int32_t>(1);
+        w.EndTag(im, iv);
+
+        size_t pm = w.BeginTag("Progress", Struct("TalosProgressData")); size_t pv = w.ValueStart();
+        if (withMap) {
+            size_t mm = w.BeginTag("CollectedTetrominos",
+                                   TypeNode{"MapProperty", {Simple("StrProperty"), Simple("BoolProperty")}});
+            size_t mv = w.ValueStart();
+            w.Put<int32_t>(0);
+            w.Put<int32_t>(static_cast<int32_t>(SAMPLE_TETROMINOS.size()));
+            for (const auto& t : SAMPLE_TETROMINOS) {
+                bool ascii = true;
+                for (unsigned char c : t.id) ascii &= c < 0x80;
+                w.String(t.id, !ascii);
+                w.Put<uint8_t>(t.used ? 1 : 0);
+            }
+            w.EndTag(mm, mv);
+        }
+        w.None();
+        w.EndTag(pm, pv);
+        w.None();
+    }
+    if (layout != Layout::UE54) w.EndTag(innerSize, innerStart);
+    w.EndTag(m, v);
+
+    m = w.BeginTag("bCompleted", Simple("BoolProperty"), false); v = w.ValueStart();
+    w.EndTag(m, v);
+
+    w.None();
+    w.Put<int32_t>(0);
+    return w.Bytes();
+}
+
+// ============================================================
+// --check
+// ============================================================
+
+static bool Matches(const SaveScan& scan)
+{
+    if (!scan.found || scan.tetrominos.size() != SAMPLE_TETROMINOS.size()) return false;
+    for (size_t i = 0; i < SAMPLE_TETROMINOS.size(); ++i) {
+        if (scan.tetrominos[i].id != SAMPLE_TETROMINOS[i].id || scan.tetrominos[i].used != SAMPLE_TETROMINOS[i].used) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int RunCheck()
+{
+    int failures = 0;
+    auto expect = [&](bool ok, const char* what) {
+        std::printf("  %-52s %s\n", what, ok ? "ok" : "FAILED");
+        if (!ok) ++failures;
+    };
+
+    const Layout layouts[] = { Layout::UE4, Layout::UE53, Layout::UE54 };
+    const char* names[] = { "UE4 tags", "UE5.3 tags", "UE5.4 complete type names" };
+
+    for (int l = 0; l < 3; ++l) {
+        auto bytes = BuildSample(layouts[l]);
+        SaveScan scan;
+        bool ok = SaveReader::Scan(bytes.data(), bytes.size(), scan);
+        std::string what = std::string(names[l]) + ": entries";
+        expect(ok && Matches(scan) && scan.completeTypeNames == (layouts[l] == Layout::UE54), what.c_str());
+
+        // Every prefix: must not crash, and must never report a wrong map
+        size_t wrong = 0, foundPrefixes = 0;
+        for (size_t n = 0; n < bytes.size(); ++n) {
+            SaveScan s;
+            if (SaveReader::Scan(bytes.data(), n, s)) {
+                ++foundPrefixes;
+                if (!Matches(s)) ++wrong;
+            }
+        }
+        what = std::string(names[l]) + ": " + std::to_string(bytes.size()) + " truncations";
+        expect(wrong == 0, what.c_str());
+
+        // Random corruption: only has to stay in bounds (run under ASan)
+        std::mt19937 rng(1234 + l);
+        for (int k = 0; k < 20000; ++k) {
+            auto copy = bytes;
+            int flips = 1 + rng() % 4;
+            for (int f = 0; f < flips; ++f) copy[rng() % copy.size()] = static_cast<uint8_t>(rng());
+            SaveScan s;
+            SaveReader::Scan(copy.data(), copy.size(), s);
+        }
+        what = std::string(names[l]) + ": 20000 corruptions";
+        expect(true, what.c_str());
+    }
+
+    {
+        auto bytes = BuildSample(Layout::UE53, false);
+        SaveScan scan;
+        bool ok = SaveReader::Scan(bytes.data(), bytes.size(), scan);
+        expect(!ok && !scan.found && scan.error.find("no CollectedTetrominos") != std::string::npos,
+               "save without the map reports it");
+    }
+    {
+        const uint8_t zlib[] = { 0x78, 0x9C, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+        SaveScan scan;
+        bool ok = SaveReader::Scan(zlib, sizeof(zlib), scan);
+        expect(!ok && scan.error.find("not a GVAS") != std::string::npos, "non-GVAS input is rejected");
+    }
+    {
+        std::error_code ec;
+        fs::path dir = fs::temp_directory_path(ec) / "talosap-savedump-check";
+        fs::remove_all(dir, ec);
+        fs::create_directories(dir / "7656119", ec);
+        auto older = BuildSample(Layout::UE53, false);
+        auto newer = BuildSample(Layout::UE53);
+        std::ofstream(dir / "Old.sav", std::ios::binary).write(reinterpret_cast<const char*>(older.data()), older.size());
+        fs::last_write_time(dir / "Old.sav", fs::file_time_type::clock::now() - std::chrono::hours(1), ec);
+        std::ofstream(dir / "7656119" / "Slot0.sav", std::ios::binary)
+            .write(reinterpret_cast<const char*>(newer.data()), newer.size());
+
+        std::wstring latest = SaveReader::FindLatestSave(dir.wstring());
+        SaveScan scan;
+        bool ok = !latest.empty() && fs::path(latest).filename() == "Slot0.sav"
+               && SaveReader::ScanFile(latest, scan) && Matches(scan);
+        expect(ok, "newest .sav found recursively and read from disk");
+        fs::remove_all(dir, ec);
+    }
+
+    std::printf("savedump check: %s\n", failures == 0 ? "ok" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
+
+// ============================================================
+// main
+// ============================================================
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) return RunCheck();
+
+    if (argc > 2 && std::strcmp(argv[1], "--write-sample") == 0) {
+        Layout layout = Layout::UE53;
+        if (argc > 3 && std::strcmp(argv[3], "--ue54") == 0) layout = Layout::UE54;
+        if (argc > 3 && std::strcmp(argv[3], "--ue4") == 0)  layout = Layout::UE4;
+        auto bytes = BuildSample(layout);
+        std::ofstream out(argv[2], std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        std::printf("wrote %zu bytes to %s\n", bytes.size(), argv[2]);
+        return out ? 0 : 1;
+    }
+
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: savedump <file.sav | directory>\n"
+                             "       savedump --write-sample <out.sav> [--ue54 | --ue4]\n"
+                             "       savedump --check\n");
+        return 2;
+    }
+
+    fs::path path(argv[1]);
+    std::error_code ec;
+    if (fs::is_directory(path, ec)) {
+        std::wstring latest = SaveReader::FindLatestSave(path.wstring());
+        if (latest.empty()) {
+            std::fprintf(stderr, "no .sav under %s\n", argv[1]);
+            return 1;
+        }
+        path = latest;
+    }
+
+    SaveScan scan;
+    bool ok = SaveReader::ScanFile(path.wstring(), scan);
+    std::printf("file          %s\n", path.string().c_str());
+    std::printf("save version  %d (UE4 %d, UE5 %d)%s\n", scan.saveGameVersion, scan.ue4Version, scan.ue5Version,
+                scan.completeTypeNames ? ", complete type names" : "");
+    std::printf("engine        %s\n", scan.engineVersion.c_str());
+    std::printf("save class    %s\n", scan.saveClass.c_str());
+    std::printf("properties    %u visited\n", scan.properties);
+    if (!ok) {
+        std::printf("error         %s\n", scan.error.c_str());
+        return 1;
+    }
+
+    size_t used = 0;
+    for (const auto& t : scan.tetrominos) used += t.used ? 1 : 0;
+    std::printf("collected     %zu tetrominoes (%zu placed)\n", scan.tetrominos.size(), used);
+    for (const auto& t : scan.tetrominos) {
+        std::printf("  %-16s%s\n", t.id.c_str(), t.used ? "  placed" : "");
+    }
+    return 0;
+}
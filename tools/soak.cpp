@@ -0,0 +1,836 @@
+// soak — many headless copies of the mod's AP client against a stand-in
+// server for hours, watching for anything that keeps growing.
+//
+//   soak [--server ws://localhost:38281] [--clients 8] [--minutes 60]
+//        [--sample SECONDS] [--csv FILE] [--pickup-ms 1500]
+//        [--level-every SECONDS] [--verbose]
+//        run against tools/apstandin.py; print a sample line every
+//        --sample seconds (RSS, live heap allocations, queue depths,
+//        per-event cost) and a growth verdict at the end. Exit 1 if a
+//        tracked series grows past its limit after warm-up.
+//   soak --check
+//        the trend detector on synthetic series, then an offline soak
+//        through APSession's replay path (no server); exit 1 on failure
+//
+// Pair it with scripted floods and disconnects, e.g.
+//   python3 tools/apstandin.py --items 200 --prints 20 --flood-every 20 --drop-after 300
+//
+// Each client is a channel and an APSession on its own thread, as in the
+// game, plus a model of the game thread driven from one 60 fps loop: it
+// applies events the way APClientWrapper::ApplyEvent does, picks up
+// locations, re-sends its checks after every slot connect, queues HUD
+// lines under HudNotification's cap and runs level-group tasks that each
+// level transition cancels. A client that has checked every location
+// starts a new game (new slot, new channel, new session), so teardown
+// is soaked too.
+//
+// RSS is read from /proc/self/statm (Linux; 0 elsewhere). Heap counts
+// cover every operator new in the process.
+
+#include "APChannel.h"
+#include "APSession.h"
+#include "FlatHashMap.h"
+#include "GameTask.h"
+#include "ItemMapping.h"
+#include "Latency.h"
+#include "Tunables.h"
+
+#include <DynamicOutput/DynamicOutput.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace TalosAP;
+using APChannel::Event;
+
+static const char* GAME = "The Talos Principle Reawakened";
+
+// Same limits as the mod: APClient.cpp's per-poll cap and the default
+// HUD tunables for its pending queue and drain cadence.
+static constexpr size_t MAX_EVENTS_PER_POLL = 256;
+static constexpr size_t HUD_MAX_PENDING     = DEFAULT_TUNABLES.hud_max_visible;
+static constexpr uint64_t HUD_EVERY_FRAMES  = DEFAULT_TUNABLES.hud_interval_ticks;
+
+static constexpr auto     FRAME             = std::chrono::microseconds(16667);
+static constexpr uint64_t LEVEL_COOLDOWN_MS = 800;    // ResetForLevelTransition(50)
+static constexpr uint64_t FENCE_TASK_MS     = 500;
+static constexpr uint32_t CHECKS_PER_RECORD = (APChannel::MAX_RECORD - sizeof(uint32_t)) / sizeof(int64_t);
+static constexpr size_t   EVENT_TYPES       = static_cast<size_t>(Event::ServerRtt) + 1;   // last event
+
+// ============================================================
+// Heap allocation counter — every operator new in the process
+// ============================================================
+
+static std::atomic<uint64_t> g_allocs{0};
+static std::atomic<uint64_t> g_frees{0};
+
+void* operator new(size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    size_t a = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    void* p = _aligned_malloc(size ? size : 1, a);
+#else
+    void* p = std::aligned_alloc(a, (size + a - 1) / a * a + (size ? 0 : a));
+#endif
+    if (p) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    if (!p) return;
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    if (!p) return;
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete(void* p, size_t, std::align_val_t a) noexcept { operator delete(p, a); }
+
+static int64_t LiveAllocs()
+{
+    return static_cast<int64_t>(g_allocs.load(std::memory_order_relaxed))
+         - static_cast<int64_t>(g_frees.load(std::memory_order_relaxed));
+}
+
+static uint64_t ResidentBytes()
+{
+#ifdef __linux__
+    unsigned long long pages = 0, resident = 0;
+    if (std::FILE* f = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(f, "%llu %llu", &pages, &resident) != 2) resident = 0;
+        std::fclose(f);
+    }
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+// ============================================================
+// Channel
+// ============================================================
+
+struct Channel {
+    struct Free { void operator()(void* p) const { ::operator delete(p, std::align_val_t(64)); } };
+    std::unique_ptr<void, Free> block;
+    APChannel::View view;
+
+    Channel(const std::string& server, const std::string& slot)
+        : block(::operator new(APChannel::TOTAL_BYTES, std::align_val_t(64)))
+    {
+        std::memset(block.get(), 0, APChannel::TOTAL_BYTES);
+        view = APChannel::Create(block.get(), 0);
+        auto& info = view.control->connect;
+        std::strncpy(info.server, server.c_str(), sizeof(info.server) - 1);
+        std::strncpy(info.slot,   slot.c_str(),   sizeof(info.slot) - 1);
+        std::strncpy(info.game,   GAME,           sizeof(info.game) - 1);
+    }
+};
+
+// ============================================================
+// One client: session + game-thread model
+// ============================================================
+
+struct Client {
+    explicit Client(int i) : index(i) {}
+
+    int index;
+    int game = 0;                              ///< bumped by each new game; part of the slot name
+    std::unique_ptr<Channel>   channel;
+    std::unique_ptr<APSession> session;
+    std::thread                thread;
+    std::atomic<bool>          stop{false};
+
+    // Game-thread model
+    bool slotConnected = false;
+    FlatHashSet<ItemId>          granted;
+    FlatHashSet<ItemId>          checked;
+    FlatHashMap<ItemId, int64_t> awaiting;     ///< picked up, not yet confirmed -> pickup MonoNs
+    std::deque<uint16_t>         hudPending;   ///< segment count per queued line
+    uint64_t nextPickupMs = 0;
+    int64_t  socketNs = 0;                     ///< SocketConnected stamp until ItemsDone
+
+    std::string SlotName() const
+    {
+        return "Soak" + std::to_string(index) + (game ? "g" + std::to_string(game) : "");
+    }
+};
+
+struct Totals {
+    std::array<uint64_t, EVENT_TYPES>         events{};
+    std::array<LatencyHistogram, EVENT_TYPES> cost{};    ///< apply cost, this sample interval
+    LatencyHistogram confirm;                            ///< pickup -> LocationConfirmed
+    LatencyHistogram sync;                               ///< SocketConnected -> ItemsDone, this interval
+    LatencyHistogram rtt;
+    uint64_t pickups = 0, confirmed = 0, grants = 0, disconnects = 0, newGames = 0;
+    uint64_t commandsDropped = 0, hudDropped = 0, hudShown = 0, refused = 0;
+};
+
+struct Options {
+    std::string server = "ws://localhost:38281";
+    int      clients = 8;
+    double   minutes = 60;
+    double   sampleSeconds = 10;
+    uint64_t pickupMs = 1500;
+    double   levelEverySeconds = 90;
+    std::string csv;
+    bool     verbose = false;
+};
+
+static ItemMapping          g_mapping;
+static std::vector<int64_t> g_locations;
+static std::mt19937         g_rng(1234);
+static Totals               g_totals;
+static std::atomic<bool>    g_interrupted{false};
+
+static GameTask FenceOpenTask()
+{
+    co_await After(FENCE_TASK_MS);
+}
+
+static GameTask EnterLevelTask()
+{
+    co_await WorldReady();
+    co_await After(LEVEL_COOLDOWN_MS);
+}
+
+static void QueueHud(Client& c, uint16_t segments)
+{
+    c.hudPending.push_back(segments);
+    while (c.hudPending.size() > HUD_MAX_PENDING) {
+        c.hudPending.pop_front();
+        ++g_totals.hudDropped;
+    }
+}
+
+static bool SendChecks(Client& c, const std::vector<int64_t>& ids)
+{
+    for (size_t i = 0; i < ids.size(); i += CHECKS_PER_RECORD) {
+        uint32_t n = static_cast<uint32_t>(std::min<size_t>(CHECKS_PER_RECORD, ids.size() - i));
+        APChannel::Writer w;
+        w.Put(n);
+        for (uint32_t k = 0; k < n; ++k) w.Put(ids[i + k]);
+        if (!c.channel->view.toSession.TryWrite(static_cast<uint16_t>(APChannel::Command::LocationChecks),
+                                                w.Data(), w.Size())) {
+            ++g_totals.commandsDropped;
+            return false;
+        }
+    }
+    return true;
+}
+
+/// APClientWrapper::ApplyEvent, minus the engine.
+static void Apply(Client& c, Event type, APChannel::Reader& r, bool verbose)
+{
+    switch (type) {
+        case Event::Log: {
+            r.Get<uint8_t>();
+            std::wstring text = r.GetText();
+            if (verbose) std::fwprintf(stderr, L"[%d] %ls", c.index, text.c_str());
+            break;
+        }
+        case Event::SocketConnected:
+            c.socketNs = r.Get<int64_t>();
+            QueueHud(c, 1);
+            break;
+        case Event::SocketDisconnected:
+            c.slotConnected = false;
+            ++g_totals.disconnects;
+            QueueHud(c, 1);
+            break;
+        case Event::SlotConnected: {
+            r.Get<int32_t>();
+            r.Get<int32_t>();
+            r.Get<int8_t>();
+            uint8_t resumed = r.Get<uint8_t>();
+            r.Get<int32_t>();
+            c.slotConnected = true;
+            if (!resumed) c.granted.clear();
+            // Locally checked locations the server may not know about
+            std::vector<int64_t> ids;
+            ids.reserve(c.checked.size());
+            for (const auto& id : c.checked) {
+                int64_t loc = g_mapping.GetLocationId(id);
+                if (loc >= 0) ids.push_back(loc);
+            }
+            SendChecks(c, ids);
+            QueueHud(c, 1);
+            break;
+        }
+        case Event::SlotRefused: {
+            std::wstring msg = r.GetText();
+            c.slotConnected = false;
+            ++g_totals.refused;
+            std::fwprintf(stderr, L"soak: client %d refused: %ls\n", c.index, msg.c_str());
+            QueueHud(c, 2);
+            break;
+        }
+        case Event::LocationConfirmed: {
+            ItemId id = r.GetId();
+            int64_t ns = r.Get<int64_t>();
+            if (r.Failed() || id.empty()) break;
+            auto it = c.awaiting.find(id);
+            if (it != c.awaiting.end()) {
+                g_totals.confirm.Add(ns - it->second);
+                c.awaiting.erase(it);
+            }
+            c.checked.insert(id);
+            ++g_totals.confirmed;
+            break;
+        }
+        case Event::Grant: {
+            ItemId id = r.GetId();
+            r.Get<int64_t>();
+            if (r.Failed() || id.empty()) break;
+            c.granted.insert(id);
+            ++g_totals.grants;
+            break;
+        }
+        case Event::ItemsDone:
+            if (c.socketNs) {
+                g_totals.sync.Add(MonoNs() - c.socketNs);
+                c.socketNs = 0;
+            }
+            break;
+        case Event::Notify: {
+            r.Get<uint8_t>();
+            HudLine line;
+            r.GetLine(line);
+            if (!line.Empty()) QueueHud(c, static_cast<uint16_t>(line.Segments().size()));
+            break;
+        }
+        case Event::Scouted:
+            r.GetId();
+            r.Get<int32_t>();
+            r.GetText();
+            r.GetText();
+            break;
+        case Event::ServerRtt: {
+            int64_t ns = r.Get<int64_t>();
+            if (!r.Failed()) g_totals.rtt.Add(ns);
+            break;
+        }
+    }
+}
+
+static void Drain(Client& c, bool verbose)
+{
+    c.channel->view.toMod.Drain([&](uint16_t type, const uint8_t* data, uint32_t size) {
+        APChannel::Reader r(data, size);
+        int64_t t0 = MonoNs();
+        Apply(c, static_cast<Event>(type), r, verbose);
+        if (type < EVENT_TYPES) {
+            ++g_totals.events[type];
+            g_totals.cost[type].Add(MonoNs() - t0);
+        }
+    }, MAX_EVENTS_PER_POLL);
+}
+
+static void ResetModel(Client& c)
+{
+    c.slotConnected = false;
+    c.granted.clear();
+    c.checked.clear();
+    c.awaiting.clear();
+    c.hudPending.clear();
+    c.socketNs = 0;
+}
+
+static bool StartLive(Client& c, const std::string& server)
+{
+    c.channel = std::make_unique<Channel>(server, c.SlotName());
+    c.session = std::make_unique<APSession>(c.channel->view);
+    if (!c.session->Start()) {
+        c.session.reset();
+        return false;
+    }
+    c.stop = false;
+    c.thread = std::thread([&c] { c.session->Run(c.stop); });
+    return true;
+}
+
+static void StopLive(Client& c)
+{
+    c.stop = true;
+    if (c.thread.joinable()) c.thread.join();
+    c.session.reset();
+    c.channel.reset();
+}
+
+/// Every location checked: a new save on a new slot.
+static bool NewGame(Client& c, const std::string& server)
+{
+    StopLive(c);
+    ResetModel(c);
+    ++c.game;
+    ++g_totals.newGames;
+    return StartLive(c, server);
+}
+
+/// A random location this client has not checked, or -1.
+static int64_t PickLocation(const Client& c)
+{
+    auto usable = [&](int64_t loc) {
+        ItemId id = g_mapping.GetLocationName(loc);
+        return !id.empty() && !c.checked.contains(id) && !c.awaiting.contains(id);
+    };
+    std::uniform_int_distribution<size_t> pick(0, g_locations.size() - 1);
+    for (int tries = 0; tries < 8; ++tries) {
+        int64_t loc = g_locations[pick(g_rng)];
+        if (usable(loc)) return loc;
+    }
+    size_t start = pick(g_rng);
+    for (size_t i = 0; i < g_locations.size(); ++i) {
+        int64_t loc = g_locations[(start + i) % g_locations.size()];
+        if (usable(loc)) return loc;
+    }
+    return -1;
+}
+
+/// Proximity pickup: checked locally, check command sent, fence task.
+static bool Pickup(Client& c)
+{
+    int64_t loc = PickLocation(c);
+    if (loc < 0) return false;
+    ItemId id = g_mapping.GetLocationName(loc);
+    if (!SendChecks(c, { loc })) return true;
+    c.awaiting[id] = MonoNs();
+    ++g_totals.pickups;
+    TaskScheduler::Get().Spawn(FenceOpenTask(), TaskGroup::Level, "FenceOpen");
+    return true;
+}
+
+// ============================================================
+// Samples and growth verdict
+// ============================================================
+
+struct Sample {
+    double   minutes = 0;
+    double   rssMiB = 0;
+    double   liveAllocs = 0;
+    double   allocsPerSec = 0;
+    double   toModKiB = 0;          ///< max over clients
+    double   toSessionKiB = 0;
+    double   backlog = 0;           ///< summed over clients
+    double   awaiting = 0;
+    double   hudPending = 0;        ///< max over clients
+    double   tasks = 0;
+    double   eventsPerSec = 0;
+    double   applyMeanUs = 0;
+    double   applyP99Us = 0;
+    double   syncMs = 0;            ///< median reconnect-to-synced this interval
+};
+
+/// Least-squares slope of `value` over the samples after warm-up (the
+/// first quarter), in units per hour. NaN when there are too few.
+static double SlopePerHour(const std::vector<Sample>& samples, double Sample::* value)
+{
+    size_t first = samples.size() / 4;
+    size_t n = samples.size() - first;
+    if (n < 8) return NAN;
+    double mx = 0, my = 0;
+    for (size_t i = first; i < samples.size(); ++i) { mx += samples[i].minutes; my += samples[i].*value; }
+    mx /= n;
+    my /= n;
+    double sxy = 0, sxx = 0;
+    for (size_t i = first; i < samples.size(); ++i) {
+        double dx = samples[i].minutes - mx;
+        sxy += dx * (samples[i].*value - my);
+        sxx += dx * dx;
+    }
+    return sxx > 0 ? sxy / sxx * 60.0 : 0.0;
+}
+
+struct Tracked {
+    const char*         name;
+    double Sample::*    value;
+    double              limitPerHour;   ///< 0 = report only
+};
+
+// Limits are per hour after warm-up, summed over all clients where the
+// series is a sum. Generous enough for noise on a loaded box, small next
+// to what a per-item or per-notification leak adds over an hour.
+static const Tracked TRACKED[] = {
+    { "rss MiB",          &Sample::rssMiB,       4.0 },
+    { "live allocations", &Sample::liveAllocs,   5000.0 },
+    { "session backlog",  &Sample::backlog,      100.0 },
+    { "awaiting confirm", &Sample::awaiting,     50.0 },
+    { "hud pending",      &Sample::hudPending,   5.0 },
+    { "live tasks",       &Sample::tasks,        50.0 },
+    { "apply p99 us",     &Sample::applyP99Us,   0.0 },
+    { "sync ms",          &Sample::syncMs,       0.0 },   // grows with the slot's item history
+};
+
+/// Print the trend of every tracked series; returns how many exceed
+/// their limit.
+static int Verdict(const std::vector<Sample>& samples)
+{
+    int leaks = 0;
+    std::printf("\n%-18s %14s %12s  %s\n", "series", "per hour", "limit", "verdict");
+    for (const auto& t : TRACKED) {
+        double slope = SlopePerHour(samples, t.value);
+        const char* verdict = "ok";
+        if (std::isnan(slope))                           verdict = "too short to judge";
+        else if (t.limitPerHour == 0)                    verdict = "report only";
+        else if (slope > t.limitPerHour) { verdict = "GROWING"; ++leaks; }
+        if (t.limitPerHour > 0) std::printf("%-18s %14.2f %12.1f  %s\n", t.name, slope, t.limitPerHour, verdict);
+        else                    std::printf("%-18s %14.2f %12s  %s\n", t.name, slope, "-", verdict);
+    }
+    return leaks;
+}
+
+static const char* SAMPLE_HEADER =
+    "minutes,rss_mib,live_allocs,allocs_per_s,tomod_kib,tosession_kib,backlog,awaiting,hud_pending,tasks,"
+    "events_per_s,apply_mean_us,apply_p99_us,sync_ms\n";
+
+static void WriteCsv(std::FILE* f, const Sample& s)
+{
+    std::fprintf(f, "%.2f,%.2f,%.0f,%.0f,%.1f,%.1f,%.0f,%.0f,%.0f,%.0f,%.1f,%.3f,%.3f,%.1f\n",
+                 s.minutes, s.rssMiB, s.liveAllocs, s.allocsPerSec, s.toModKiB, s.toSessionKiB, s.backlog,
+                 s.awaiting, s.hudPending, s.tasks, s.eventsPerSec, s.applyMeanUs, s.applyP99Us, s.syncMs);
+    std::fflush(f);
+}
+
+// ============================================================
+// Live soak
+// ============================================================
+
+static int RunSoak(const Options& opt)
+{
+    std::vector<std::unique_ptr<Client>> clients;
+    for (int i = 0; i < opt.clients; ++i) clients.push_back(std::make_unique<Client>(i));
+
+    std::FILE* csv = nullptr;
+    if (!opt.csv.empty()) {
+        csv = std::fopen(opt.csv.c_str(), "w");
+        if (!csv) { std::fprintf(stderr, "soak: cannot write %s\n", opt.csv.c_str()); return 2; }
+        std::fputs(SAMPLE_HEADER, csv);
+    }
+
+    auto& tasks = TaskScheduler::Get();
+    const auto start = std::chrono::steady_clock::now();
+    auto nowMs = [&] {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    };
+    uint64_t frame = 0;
+    auto runFrame = [&] {
+        uint64_t now = nowMs();
+        tasks.Tick(now, true);
+        for (auto& c : clients) {
+            if (!c->session) continue;
+            Drain(*c, opt.verbose);
+            if (frame % HUD_EVERY_FRAMES == 0) {
+                g_totals.hudShown += c->hudPending.size();
+                c->hudPending.clear();
+            }
+            if (c->slotConnected && now >= c->nextPickupMs) {
+                if (!Pickup(*c) && c->awaiting.empty()) NewGame(*c, opt.server);
+                c->nextPickupMs = now + opt.pickupMs / 2 + g_rng() % (opt.pickupMs + 1);
+            }
+        }
+        ++frame;
+        std::this_thread::sleep_until(start + frame * FRAME);
+    };
+
+    // The first client fetches the data package alone; the rest start
+    // from its cache, as relaunches do, instead of all writing it at once.
+    if (!StartLive(*clients[0], opt.server)) {
+        std::fprintf(stderr, "soak: could not start a session for %s\n", opt.server.c_str());
+        return 1;
+    }
+    while (!clients[0]->slotConnected && nowMs() < 30000 && !g_interrupted) runFrame();
+    if (!clients[0]->slotConnected) {
+        std::fprintf(stderr, "soak: no slot connect from %s in 30 s — is apstandin running?\n", opt.server.c_str());
+        StopLive(*clients[0]);
+        return 1;
+    }
+    for (size_t i = 1; i < clients.size(); ++i) StartLive(*clients[i], opt.server);
+
+    std::printf("soak: %d clients on %s for %.0f min\n\n", opt.clients, opt.server.c_str(), opt.minutes);
+    std::printf("%7s %8s %11s %9s %8s %8s %7s %8s %4s %6s %9s %17s %8s\n",
+                "min", "rss MiB", "live allocs", "allocs/s", "toMod KiB", "toSess", "backlog", "awaiting",
+                "hud", "tasks", "events/s", "apply us mean/p99", "sync ms");
+
+    std::vector<Sample> samples;
+    const uint64_t endMs = static_cast<uint64_t>(opt.minutes * 60000);
+    const uint64_t sampleMs = static_cast<uint64_t>(opt.sampleSeconds * 1000);
+    const uint64_t levelMs = static_cast<uint64_t>(opt.levelEverySeconds * 1000);
+    uint64_t nextSample = nowMs() + sampleMs;
+    uint64_t nextLevel = levelMs ? nowMs() + levelMs : ~0ull;
+    uint64_t lastAllocs = g_allocs.load();
+    uint64_t lastEvents = 0;
+    uint64_t lastSampleMs = nowMs();
+
+    while (nowMs() < endMs && !g_interrupted) {
+        runFrame();
+        uint64_t now = nowMs();
+
+        if (now >= nextLevel) {
+            // Level transition: the level group goes, EnterLevel starts
+            tasks.Cancel(TaskGroup::Level);
+            tasks.Spawn(EnterLevelTask(), TaskGroup::Level, "EnterLevel");
+            nextLevel = now + levelMs;
+        }
+
+        if (now < nextSample) continue;
+        nextSample = now + sampleMs;
+
+        Sample s;
+        double dt = std::max<uint64_t>(now - lastSampleMs, 1) / 1000.0;
+        lastSampleMs = now;
+        s.minutes = now / 60000.0;
+        s.rssMiB = ResidentBytes() / (1024.0 * 1024.0);
+        s.liveAllocs = static_cast<double>(LiveAllocs());
+        uint64_t allocs = g_allocs.load();
+        s.allocsPerSec = (allocs - lastAllocs) / dt;
+        lastAllocs = allocs;
+        for (auto& c : clients) {
+            if (!c->session) continue;
+            s.toModKiB = std::max(s.toModKiB, c->channel->view.toMod.UsedBytes() / 1024.0);
+            s.toSessionKiB = std::max(s.toSessionKiB, c->channel->view.toSession.UsedBytes() / 1024.0);
+            s.backlog += static_cast<double>(c->session->BacklogDepth());
+            s.awaiting += static_cast<double>(c->awaiting.size());
+            s.hudPending = std::max(s.hudPending, static_cast<double>(c->hudPending.size()));
+        }
+        s.tasks = static_cast<double>(tasks.LiveCount());
+
+        uint64_t events = 0;
+        double applyNs = 0;
+        for (size_t t = 0; t < EVENT_TYPES; ++t) {
+            events += g_totals.events[t];
+            applyNs += g_totals.cost[t].MeanNs() * static_cast<double>(g_totals.cost[t].Count());
+        }
+        uint64_t intervalEvents = events - lastEvents;
+        lastEvents = events;
+        s.eventsPerSec = intervalEvents / dt;
+        s.applyMeanUs = intervalEvents ? applyNs / intervalEvents / 1000.0 : 0.0;
+        for (size_t t = 0; t < EVENT_TYPES; ++t) {
+            s.applyP99Us = std::max(s.applyP99Us, g_totals.cost[t].PercentileNs(0.99) / 1000.0);
+            g_totals.cost[t].Clear();
+        }
+        s.syncMs = g_totals.sync.PercentileNs(0.5) / 1e6;
+        g_totals.sync.Clear();
+
+        samples.push_back(s);
+        std::printf("%7.1f %8.1f %11.0f %9.0f %9.1f %8.1f %7.0f %8.0f %4.0f %6.0f %9.0f %8.2f/%-8.2f %8.1f\n",
+                    s.minutes, s.rssMiB, s.liveAllocs, s.allocsPerSec, s.toModKiB, s.toSessionKiB, s.backlog,
+                    s.awaiting, s.hudPending, s.tasks, s.eventsPerSec, s.applyMeanUs, s.applyP99Us, s.syncMs);
+        std::fflush(stdout);
+        if (csv) WriteCsv(csv, s);
+    }
+
+    for (auto& c : clients) StopLive(*c);
+    tasks.CancelAll();
+    if (csv) std::fclose(csv);
+
+    std::printf("\npickups %llu, confirmed %llu (p50 %.1f ms, p99 %.1f ms), grants %llu, disconnects %llu, "
+                "new games %llu, refused %llu\n",
+                (unsigned long long)g_totals.pickups, (unsigned long long)g_totals.confirmed,
+                g_totals.confirm.PercentileNs(0.5) / 1e6, g_totals.confirm.PercentileNs(0.99) / 1e6,
+                (unsigned long long)g_totals.grants, (unsigned long long)g_totals.disconnects,
+                (unsigned long long)g_totals.newGames, (unsigned long long)g_totals.refused);
+    std::printf("hud lines shown %llu, dropped at the cap %llu; commands dropped (ring full) %llu; "
+                "server rtt p50 %.1f ms\n",
+                (unsigned long long)g_totals.hudShown, (unsigned long long)g_totals.hudDropped,
+                (unsigned long long)g_totals.commandsDropped, g_totals.rtt.PercentileNs(0.5) / 1e6);
+
+    int leaks = Verdict(samples);
+    std::printf("\nsoak: %s\n", leaks ? "GROWTH DETECTED" : "no growth past the limits");
+    return leaks ? 1 : 0;
+}
+
+// ============================================================
+// --check
+// ============================================================
+
+static int g_failures = 0;
+
+#define EXPECT(cond)                                                        \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            ++g_failures;                                                   \
+        }                                                                   \
+    } while (0)
+
+/// One offline game: a replay session fed floods, checks and chat the
+/// way apstandin scripts them, drained through the same model.
+static void OfflineGame(Client& c, int floods)
+{
+    c.channel = std::make_unique<Channel>("", c.SlotName());
+    c.session = std::make_unique<APSession>(c.channel->view);
+    EXPECT(c.session->StartReplay());
+    ResetModel(c);
+
+    auto drain = [&] { Drain(c, false); };
+    c.session->Replay(R"({"cmd":"Connected","slot":1,"team":0,"slot_data":{"reusable_tetrominos":0}})");
+    drain();
+
+    std::uniform_int_distribution<int> type(0, 18);
+    int index = 0;
+    for (int f = 0; f < floods; ++f) {
+        std::string items = R"({"cmd":"ReceivedItems","index":)" + std::to_string(index) + R"(,"items":[)";
+        for (int k = 0; k < 20; ++k) {
+            items += (k ? "," : "") + std::string(R"({"item":)")
+                   + std::to_string(ItemMapping::BASE_ITEM_ID + type(g_rng)) + R"(,"location":1,"player":2,"flags":1})";
+        }
+        items += "]}";
+        index += 20;
+        c.session->Replay(items);
+        drain();
+
+        if (Pickup(c)) {
+            // What the server answers to the pickup's LocationChecks
+            int64_t loc = -1;
+            c.channel->view.toSession.Drain([&](uint16_t, const uint8_t* data, uint32_t size) {
+                APChannel::Reader r(data, size);
+                if (r.Get<uint32_t>() >= 1) loc = r.Get<int64_t>();
+            });
+            if (loc >= 0) {
+                c.session->Replay(R"({"cmd":"RoomUpdate","checked_locations":[)" + std::to_string(loc) + "]}");
+            }
+        }
+        c.session->Replay(
+            R"({"cmd":"PrintJSON","type":"ItemSend","data":[{"type":"player_id","text":"2"},{"type":"text","text":" sent "},)"
+            R"({"type":"item_name","text":"Green J","flags":1}],"receiving":1,"item":{"item":5505024,"location":9,"player":2,"flags":1}})");
+        drain();
+        if (f % 10 == 0) {
+            g_totals.hudShown += c.hudPending.size();
+            c.hudPending.clear();
+        }
+    }
+    EXPECT(c.awaiting.empty());
+    EXPECT(c.hudPending.size() <= HUD_MAX_PENDING);
+    EXPECT(c.session->BacklogDepth() == 0);
+
+    // Level transition: the pickups' fence tasks go with the level
+    TaskScheduler::Get().Cancel(TaskGroup::Level);
+    c.session.reset();
+    c.channel.reset();
+}
+
+static int RunCheck()
+{
+    // The detector: flat noise passes, a slow climb does not.
+    {
+        std::vector<Sample> flat, climbing;
+        std::mt19937 rng(7);
+        std::normal_distribution<double> noise(0.0, 200.0);
+        for (int i = 0; i < 120; ++i) {
+            Sample s;
+            s.minutes = i * 0.5;
+            s.liveAllocs = 50000 + noise(rng);
+            flat.push_back(s);
+            s.liveAllocs += i * 0.5 * 200;    // 12000 per hour
+            climbing.push_back(s);
+        }
+        double flatSlope = SlopePerHour(flat, &Sample::liveAllocs);
+        double climbSlope = SlopePerHour(climbing, &Sample::liveAllocs);
+        EXPECT(std::fabs(flatSlope) < 5000);
+        EXPECT(climbSlope > 5000 && std::fabs(climbSlope - 12000) < 2000);
+        std::vector<Sample> tooShort(flat.begin(), flat.begin() + 6);
+        EXPECT(std::isnan(SlopePerHour(tooShort, &Sample::liveAllocs)));
+    }
+
+    // Offline soak: games of floods, pickups and chat, each a fresh
+    // session. Live allocations between games must not creep.
+    {
+        Client c(0);
+        std::vector<int64_t> live;
+        const int games = 40;
+        for (int g = 0; g < games; ++g) {
+            c.game = g;
+            OfflineGame(c, 60);
+            ResetModel(c);
+            live.push_back(LiveAllocs());
+        }
+        int64_t settled = live[games / 4];
+        int64_t last = live.back();
+        EXPECT(last - settled < 64);
+        EXPECT(g_totals.grants > 0);
+        EXPECT(g_totals.confirmed == g_totals.pickups);
+        EXPECT(g_totals.hudDropped > 0);     // floods outrun the HUD cap
+        std::printf("offline soak: %d games, %llu grants, %llu confirmed, live allocations %lld -> %lld\n",
+                    games, (unsigned long long)g_totals.grants, (unsigned long long)g_totals.confirmed,
+                    (long long)settled, (long long)last);
+    }
+
+    TaskScheduler::Get().CancelAll();
+    std::printf("soak check: %s\n", g_failures ? "FAILED" : "ok");
+    return g_failures ? 1 : 0;
+}
+
+// ============================================================
+// main
+// ============================================================
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        auto next = [&](double& v) { if (i + 1 < argc) v = std::atof(argv[++i]); };
+        if (std::strcmp(argv[i], "--check") == 0) {
+            RC::Output::SetEcho(false);
+            g_locations = g_mapping.GetAllLocationIds();
+            return RunCheck();
+        }
+        if (std::strcmp(argv[i], "--server") == 0 && i + 1 < argc) opt.server = argv[++i];
+        else if (std::strcmp(argv[i], "--clients") == 0 && i + 1 < argc) opt.clients = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--minutes") == 0) next(opt.minutes);
+        else if (std::strcmp(argv[i], "--sample") == 0) next(opt.sampleSeconds);
+        else if (std::strcmp(argv[i], "--level-every") == 0) next(opt.levelEverySeconds);
+        else if (std::strcmp(argv[i], "--pickup-ms") == 0 && i + 1 < argc) opt.pickupMs = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) opt.csv = argv[++i];
+        else if (std::strcmp(argv[i], "--verbose") == 0) opt.verbose = true;
+        else {
+            std::fprintf(stderr,
+                "usage: soak [--server URI] [--clients N] [--minutes M] [--sample S] [--csv FILE]\n"
+                "            [--pickup-ms MS] [--level-every S] [--verbose] | --check\n");
+            return 2;
+        }
+    }
+
+    RC::Output::SetEcho(opt.verbose);
+    g_locations = g_mapping.GetAllLocationIds();
+    std::signal(SIGINT, [](int) { g_interrupted = true; });
+    return RunSoak(opt);
+}
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""statetail — reference consumer of the mod's tracker export.
+
+The mod writes two files next to config.json (src/StateExport.cpp):
+
+  talos_ap_state.json      snapshot, with the "seq" of the last event in it
+  talos_ap_events.ndjson   one JSON object per change, "seq" increasing;
+                           truncated when the game starts
+
+A tracker loads the snapshot, applies events with a higher seq, then keeps
+following the events file. A new {"type":"session"} line, or the file
+getting shorter, means the game restarted: start over from the snapshot.
+
+  statetail.py MODDIR [--interval SECONDS]
+      Follow the export and print each change and a running summary.
+
+  statetail.py --check MODDIR
+      Replay the events file from the start and compare the result with
+      the snapshot at the snapshot's seq. Exit 1 on mismatch.
+
+Standard library only.
+"""
+
+import argparse
+import json
+import os
+import sys
+import time
+
+EVENTS = "talos_ap_events.ndjson"
+SNAPSHOT = "talos_ap_state.json"
+
+
+def empty_state():
+    return {"seq": 0, "generation": 0, "level": "", "granted": set(), "checked": set(),
+            "fences_opened": set(), "scouted": {}}
+
+
+def load_snapshot(path):
+    with open(path, encoding="utf-8") as f:
+        snap = json.load(f)
+    state = empty_state()
+    state["seq"] = snap["seq"]
+    state["generation"] = snap["generation"]
+    state["level"] = snap["level"]
+    for key in ("granted", "checked", "fences_opened"):
+        state[key] = set(snap[key])
+    state["scouted"] = dict(snap["scouted"])
+    return state
+
+
+def apply(state, ev):
+    """Apply one event. Returns False for a session line (restart)."""
+    kind = ev["type"]
+    if kind == "session":
+        return False
+    if kind == "granted":
+        state["granted"].add(ev["id"])
+    elif kind == "granted_reset":
+        state["granted"].clear()
+    elif kind == "checked":
+        state["checked"].add(ev["id"])
+    elif kind == "fence_opened":
+        state["fences_opened"].add(ev["id"])
+    elif kind == "level_entered":
+        state["generation"] = ev["generation"]
+        state["level"] = ev["level"]
+    elif kind == "scouted":
+        state["scouted"][ev["id"]] = {"item": ev["item"], "player": ev["player"], "flags": ev["flags"]}
+    state["seq"] = ev["seq"]
+    return True
+
+
+def summary(state):
+    return "seq %d  level %s (gen %d)  granted %d  checked %d  fences %d  scouted %d" % (
+        state["seq"], state["level"] or "?", state["generation"], len(state["granted"]),
+        len(state["checked"]), len(state["fences_opened"]), len(state["scouted"]))
+
+
+def check(moddir):
+    snap = load_snapshot(os.path.join(moddir, SNAPSHOT))
+    state = empty_state()
+    last = 0
+    with open(os.path.join(moddir, EVENTS), encoding="utf-8") as f:
+        for n, line in enumerate(f, 1):
+            if not line.endswith("\n"):
+                break                       # partial last line: still being written
+            ev = json.loads(line)
+            if ev["seq"] != last + 1:
+                print("line %d: seq %d after %d" % (n, ev["seq"], last))
+                return 1
+            last = ev["seq"]
+            if ev["seq"] > snap["seq"]:
+                break
+            if not apply(state, ev) and n != 1:
+                print("line %d: session line in the middle of the file" % n)
+                return 1
+            state["seq"] = ev["seq"]
+
+    ok = True
+    for key in ("seq", "generation", "level", "granted", "checked", "fences_opened", "scouted"):
+        if state[key] != snap[key]:
+            print("%s: replay %r, snapshot %r" % (key, state[key], snap[key]))
+            ok = False
+    print("replayed to seq %d: %s" % (state["seq"], summary(state)))
+    print("statetail check: %s" % ("ok" if ok else "FAILED"))
+    return 0 if ok else 1
+
+
+def follow(moddir, interval):
+    events_path = os.path.join(moddir, EVENTS)
+    snapshot_path = os.path.join(moddir, SNAPSHOT)
+    while True:
+        try:
+            state = load_snapshot(snapshot_path)
+            f = open(events_path, encoding="utf-8")
+        except (OSError, ValueError):
+            time.sleep(interval)
+            continue
+        print("snapshot: " + summary(state))
+        pending = ""
+        restart = False
+        with f:
+            while not restart:
+                chunk = f.read()
+                if not chunk:
+                    if os.path.getsize(events_path) < f.tell():
+                        restart = True      # truncated: the game restarted
+                        break
+                    time.sleep(interval)
+                    continue
+                pending += chunk
+                *lines, pending = pending.split("\n")
+                for line in lines:
+                    if not line:
+                        continue
+                    ev = json.loads(line)
+                    if ev["seq"] <= state["seq"]:
+                        continue            # already in the snapshot
+                    if not apply(state, ev):
+                        restart = True
+                        break
+                    print("%-14s %s" % (ev["type"], ev.get("id", ev.get("level", ""))))
+                    print("    " + summary(state))
+        print("session restarted")
+
+
+def main():
+    p = argparse.ArgumentParser(description="Follow the mod's tracker export.")
+    p.add_argument("moddir")
+    p.add_argument("--check", action="store_true")
+    p.add_argument("--interval", type=float, default=0.25)
+    args = p.parse_args()
+    if args.check:
+        return check(args.moddir)
+    try:
+        follow(args.moddir, args.interval)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
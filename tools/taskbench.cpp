@@ -0,0 +1,351 @@
+// taskbench — the mod's game-thread coroutine runtime (GameTask.h).
+//
+//   taskbench [ticks]   cost of Tick() with thousands of idle tasks
+//                       parked on timers, vs the per-tick queue polling
+//                       it replaces
+//   taskbench --check   timing, ordering, WorldReady, Until, cancellation
+//                       and fault handling on a simulated 60 fps clock;
+//                       exit 1 on failure
+//
+// Everything runs on a synthetic clock: Tick(nowMs, worldReady) is the
+// only input the scheduler has.
+
+#include "GameTask.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace TalosAP;
+
+static int g_failures = 0;
+
+#define EXPECT(cond)                                                        \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            ++g_failures;                                                   \
+        }                                                                   \
+    } while (0)
+
+// ============================================================
+// Simulated game clock
+// ============================================================
+
+struct Clock {
+    uint64_t ms = 1000;
+    bool     ready = true;
+
+    /// One frame of ~16.7 ms, jittered like a real frame time.
+    void Frame(std::mt19937* rng = nullptr)
+    {
+        ms += rng ? 12 + (*rng)() % 10 : 17;
+        TaskScheduler::Get().Tick(ms, ready);
+    }
+    void Run(int frames, std::mt19937* rng = nullptr) { for (int i = 0; i < frames; ++i) Frame(rng); }
+};
+
+// ============================================================
+// Tasks under test
+// ============================================================
+
+static GameTask Sleeper(uint64_t delay, uint64_t& startedAt, uint64_t& wokeAt)
+{
+    startedAt = TaskScheduler::Get().NowMs();
+    co_await After(delay);
+    wokeAt = TaskScheduler::Get().NowMs();
+}
+
+static GameTask Stepper(std::vector<int>& log, int id, int steps)
+{
+    for (int i = 0; i < steps; ++i) {
+        log.push_back(id * 100 + i);
+        co_await NextTick();
+    }
+}
+
+static GameTask WaitWorld(int& stage)
+{
+    stage = 1;
+    co_await WorldReady();
+    stage = 2;
+}
+
+static GameTask WaitFlag(const bool& flag, uint64_t& tickSeen)
+{
+    co_await Until([&flag] { return flag; });
+    tickSeen = TaskScheduler::Get().TickCount();
+}
+
+struct Guard {
+    int& n;
+    explicit Guard(int& c) : n(c) { ++n; }
+    ~Guard() { --n; }
+};
+
+static GameTask Holder(int& alive, uint64_t delay)
+{
+    Guard g(alive);
+    co_await After(delay);
+    co_await NextTick();
+}
+
+static GameTask SelfCanceller(int& alive, int& afterCancel)
+{
+    Guard g(alive);
+    co_await NextTick();
+    TaskScheduler::Get().Cancel(TaskGroup::Level);
+    ++afterCancel;      // still runs: the step finishes
+    co_await NextTick();
+    ++afterCancel;      // never reached
+}
+
+static GameTask Thrower()
+{
+    co_await NextTick();
+    throw std::runtime_error("boom");
+}
+
+static GameTask Retrier(int& attempts, int succeedOn, bool& done)
+{
+    // The fence-open shape: try, wait 100 ms, give up after 10.
+    for (int i = 0; i < 10; ++i) {
+        co_await WorldReady();
+        if (++attempts == succeedOn) { done = true; co_return; }
+        co_await After(100);
+    }
+}
+
+// ============================================================
+// --check
+// ============================================================
+
+static int RunCheck()
+{
+    auto& sched = TaskScheduler::Get();
+    Clock clock;
+    clock.Frame();
+    std::mt19937 rng(68);
+
+    // Timers: never early, at most one granule + one frame late, any length.
+    {
+        const uint64_t delays[] = { 1, 15, 16, 17, 100, 250, 4095, 4096, 4097, 9000, 30000 };
+        std::vector<uint64_t> started(std::size(delays)), woke(std::size(delays));
+        for (size_t i = 0; i < std::size(delays); ++i) {
+            sched.Spawn(Sleeper(delays[i], started[i], woke[i]), TaskGroup::Session, "sleeper");
+        }
+        clock.Run(2400, &rng);
+        for (size_t i = 0; i < std::size(delays); ++i) {
+            uint64_t late = woke[i] - started[i] - delays[i];
+            if (woke[i] < started[i] + delays[i] || late > TaskScheduler::WHEEL_GRANULARITY_MS + 22) {
+                std::printf("  timer %llu ms: started %llu woke %llu\n", (unsigned long long)delays[i],
+                            (unsigned long long)started[i], (unsigned long long)woke[i]);
+                ++g_failures;
+            }
+        }
+        EXPECT(sched.TimerCount() == 0);
+        EXPECT(sched.LiveCount() == 0);
+    }
+
+    // Random delays across many wheel turns.
+    {
+        std::vector<uint64_t> started(500), woke(500), delay(500);
+        for (size_t i = 0; i < delay.size(); ++i) {
+            delay[i] = rng() % 20000;
+            sched.Spawn(Sleeper(delay[i], started[i], woke[i]), TaskGroup::Session, "sleeper");
+        }
+        clock.Run(1500, &rng);
+        int bad = 0;
+        for (size_t i = 0; i < delay.size(); ++i) {
+            if (woke[i] < started[i] + delay[i] ||
+                woke[i] - started[i] - delay[i] > TaskScheduler::WHEEL_GRANULARITY_MS + 22) ++bad;
+        }
+        EXPECT(bad == 0);
+        EXPECT(sched.LiveCount() == 0);
+    }
+
+    // NextTick: one step per tick, spawn order preserved.
+    {
+        std::vector<int> log;
+        sched.Spawn(Stepper(log, 1, 3), TaskGroup::Session, "a");
+        sched.Spawn(Stepper(log, 2, 3), TaskGroup::Session, "b");
+        EXPECT(log.empty());                    // nothing runs until Tick
+        clock.Frame();
+        EXPECT((log == std::vector<int>{ 100, 200 }));
+        clock.Frame();
+        clock.Frame();
+        EXPECT((log == std::vector<int>{ 100, 200, 101, 201, 102, 202 }));
+        clock.Frame();
+        EXPECT(sched.LiveCount() == 0);
+    }
+
+    // WorldReady: no suspension when ready; parked through a cooldown.
+    {
+        int stage = 0;
+        sched.Spawn(WaitWorld(stage), TaskGroup::Session, "world");
+        clock.Frame();
+        EXPECT(stage == 2);
+
+        clock.ready = false;
+        clock.Frame();
+        stage = 0;
+        sched.Spawn(WaitWorld(stage), TaskGroup::Session, "world");
+        clock.Run(30);
+        EXPECT(stage == 1);
+        clock.ready = true;
+        clock.Frame();
+        EXPECT(stage == 2);
+    }
+
+    // Until: resumes on the first tick the predicate holds.
+    {
+        bool flag = false;
+        uint64_t seen = 0;
+        sched.Spawn(WaitFlag(flag, seen), TaskGroup::Session, "until");
+        clock.Run(10);
+        EXPECT(seen == 0);
+        EXPECT(sched.PollerCount() == 1);
+        flag = true;
+        clock.Frame();
+        EXPECT(seen == sched.TickCount());
+        EXPECT(sched.PollerCount() == 0);
+    }
+
+    // Cancel: frames destroyed wherever they are parked; other group untouched.
+    {
+        int alive = 0;
+        for (int i = 0; i < 50; ++i) sched.Spawn(Holder(alive, 100 + i * 97), TaskGroup::Level, "holder");
+        sched.Spawn(Holder(alive, 50000), TaskGroup::Session, "keeper");
+        EXPECT(alive == 0);                     // not started yet
+        clock.Run(20);
+        EXPECT(alive > 40);
+        size_t cancelled = sched.Cancel(TaskGroup::Level);
+        EXPECT(alive == 1);
+        EXPECT(cancelled > 40);
+        clock.Run(400);                         // stale wheel entries are dropped, not resumed
+        EXPECT(sched.TimerCount() == 1);
+        sched.Cancel(TaskGroup::Session);
+        EXPECT(alive == 0);
+        EXPECT(sched.LiveCount() == 0);
+        EXPECT(sched.TimerCount() == 1);        // counted until its slot comes round
+        clock.Run(3200);
+        EXPECT(sched.TimerCount() == 0);
+    }
+
+    // Cancelling the running task's own group.
+    {
+        int alive = 0, afterCancel = 0;
+        sched.Spawn(SelfCanceller(alive, afterCancel), TaskGroup::Level, "self");
+        clock.Run(3);
+        EXPECT(afterCancel == 1);
+        EXPECT(alive == 0);
+        EXPECT(sched.LiveCount() == 0);
+    }
+
+    // Unspawned tasks free themselves.
+    {
+        int alive = 0;
+        { GameTask t = Holder(alive, 10); }
+        EXPECT(alive == 0);
+    }
+
+    // Exceptions end the task and are counted.
+    {
+        uint64_t before = sched.Faults();
+        sched.Spawn(Thrower(), TaskGroup::Session, "thrower");
+        clock.Run(3);
+        EXPECT(sched.Faults() == before + 1);
+        EXPECT(sched.LastFault() && std::strcmp(sched.LastFault(), "thrower") == 0);
+        EXPECT(sched.LiveCount() == 0);
+    }
+
+    // Retry loop: succeeds on attempt 4, ~300 ms later; gives up after 10.
+    {
+        int attempts = 0;
+        bool done = false;
+        uint64_t start = clock.ms;
+        sched.Spawn(Retrier(attempts, 4, done), TaskGroup::Level, "retry");
+        while (!done && clock.ms < start + 5000) clock.Frame();
+        EXPECT(done && attempts == 4);
+        EXPECT(clock.ms - start >= 300 && clock.ms - start < 400);
+
+        attempts = 0;
+        done = false;
+        sched.Spawn(Retrier(attempts, -1, done), TaskGroup::Level, "retry");
+        clock.Run(200);
+        EXPECT(!done && attempts == 10);
+        EXPECT(sched.LiveCount() == 0);
+    }
+
+    // Slot reuse does not resurrect stale references.
+    {
+        int alive = 0;
+        sched.Spawn(Holder(alive, 500), TaskGroup::Level, "old");
+        clock.Frame();
+        sched.Cancel(TaskGroup::Level);
+        std::vector<int> log;
+        sched.Spawn(Stepper(log, 7, 100), TaskGroup::Level, "new");   // reuses the slot
+        clock.Run(60);
+        EXPECT(log.size() == 60);               // one step per tick, no extra wake from the old timer
+        sched.Cancel(TaskGroup::Level);
+    }
+
+    std::printf("%llu resumes, %d failures\n", (unsigned long long)sched.Resumes(), g_failures);
+    std::printf("taskbench check: %s\n", g_failures ? "FAILED" : "ok");
+    return g_failures ? 1 : 0;
+}
+
+// ============================================================
+// Benchmark
+// ============================================================
+
+static GameTask Idle(uint64_t delay)
+{
+    co_await After(delay);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) return RunCheck();
+
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    auto& sched = TaskScheduler::Get();
+    Clock clock;
+    clock.Frame();
+
+    std::printf("%8s %14s %14s\n", "parked", "wheel ns/tick", "poll ns/tick");
+    for (int parked : { 0, 10, 100, 1000, 10000 }) {
+        for (int i = 0; i < parked; ++i) sched.Spawn(Idle(3'600'000), TaskGroup::Session, "idle");
+        clock.Frame();
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i) clock.Frame();
+        auto t1 = std::chrono::steady_clock::now();
+
+        // The hand-rolled equivalent: every pending entry visited each tick.
+        struct Pending { uint64_t dueMs; int attempts; };
+        std::deque<Pending> queue(parked, Pending{ ~0ull, 0 });
+        volatile uint64_t sink = 0;
+        auto t2 = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i) {
+            uint64_t now = 1000 + static_cast<uint64_t>(i) * 17;
+            for (auto& p : queue) {
+                if (p.dueMs <= now) ++p.attempts;
+                sink = sink + p.attempts;
+            }
+        }
+        auto t3 = std::chrono::steady_clock::now();
+
+        double wheel = std::chrono::duration<double, std::nano>(t1 - t0).count() / ticks;
+        double poll  = std::chrono::duration<double, std::nano>(t3 - t2).count() / ticks;
+        std::printf("%8d %14.1f %14.1f\n", parked, wheel, poll);
+        sched.CancelAll();
+    }
+    return 0;
+}
@@ -0,0 +1,247 @@
+// utfbench — throughput and correctness of the Utf conversion layer.
+//
+//   utfbench [iterations]   benchmark against the old per-char loops
+//   utfbench --check        round-trip / malformed-input check, exit 1 on failure
+//
+// wchar_t is UTF-16 on Windows and UTF-32 on Linux/macOS; the check runs
+// whichever one the host compiler has.
+
+#include "Utf.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace TalosAP;
+
+// ============================================================
+// Reference encoder (obviously-correct, one code point at a time)
+// ============================================================
+
+static void RefAppendUtf8(uint32_t cp, std::string& out)
+{
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+static void RefAppendWide(uint32_t cp, std::wstring& out)
+{
+    if (sizeof(wchar_t) == 2 && cp >= 0x10000) {
+        cp -= 0x10000;
+        out += static_cast<wchar_t>(0xD800 + (cp >> 10));
+        out += static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+    } else {
+        out += static_cast<wchar_t>(cp);
+    }
+}
+
+// Random scalar value, weighted towards ASCII runs like real chat text.
+static uint32_t RandomCodePoint(std::mt19937& rng)
+{
+    switch (rng() % 8) {
+        case 0:  return 0x80 + rng() % (0x800 - 0x80);                 // 2-byte
+        case 1: {                                                      // 3-byte, no surrogates
+            uint32_t cp;
+            do { cp = 0x800 + rng() % (0x10000 - 0x800); } while (cp >= 0xD800 && cp <= 0xDFFF);
+            return cp;
+        }
+        case 2:  return 0x10000 + rng() % (0x110000 - 0x10000);        // 4-byte
+        default: return 0x20 + rng() % 0x5F;                           // printable ASCII
+    }
+}
+
+// ============================================================
+// --check
+// ============================================================
+
+static int g_failures = 0;
+
+static void Expect(bool ok, const char* what)
+{
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++g_failures;
+    }
+}
+
+static std::wstring W(std::initializer_list<uint32_t> cps)
+{
+    std::wstring w;
+    for (uint32_t cp : cps) RefAppendWide(cp, w);
+    return w;
+}
+
+static int RunCheck()
+{
+    // ---- Random round trips against the reference ----
+    std::mt19937 rng(1234);
+    for (int iter = 0; iter < 20000; ++iter) {
+        size_t len = rng() % 80;
+        std::string utf8;
+        std::wstring wide;
+        for (size_t i = 0; i < len; ++i) {
+            // Long ASCII stretches exercise the 16-wide blocks and their edges.
+            uint32_t cp = (rng() % 4 == 0) ? RandomCodePoint(rng) : 0x20 + rng() % 0x5F;
+            RefAppendUtf8(cp, utf8);
+            RefAppendWide(cp, wide);
+        }
+        if (Utf::ToWide(utf8) != wide) { Expect(false, "ToWide matches reference"); break; }
+        if (Utf::ToUtf8(wide) != utf8) { Expect(false, "ToUtf8 matches reference"); break; }
+    }
+
+    // ---- Every scalar value individually ----
+    for (uint32_t cp = 1; cp < 0x110000; ++cp) {
+        if (cp >= 0xD800 && cp <= 0xDFFF) continue;
+        std::string u; RefAppendUtf8(cp, u);
+        std::wstring w; RefAppendWide(cp, w);
+        if (Utf::ToWide(u) != w || Utf::ToUtf8(w) != u) {
+            std::printf("FAIL: code point U+%04X\n", cp);
+            ++g_failures;
+            break;
+        }
+    }
+
+    // ---- Malformed UTF-8 -> U+FFFD (maximal subpart) ----
+    const uint32_t R = 0xFFFD;
+    Expect(Utf::ToWide("\xC0\x80") == W({ R, R }),                "overlong 2-byte NUL");
+    Expect(Utf::ToWide("\xE0\x80\xAF") == W({ R, R, R }),         "overlong 3-byte");
+    Expect(Utf::ToWide("\xED\xA0\x80") == W({ R, R, R }),         "encoded surrogate");
+    Expect(Utf::ToWide("\xF4\x90\x80\x80") == W({ R, R, R, R }),  "above U+10FFFF");
+    Expect(Utf::ToWide("\xE2\x82") == W({ R }),                   "truncated at end");
+    Expect(Utf::ToWide("\xE2\x82" "A") == W({ R, 'A' }),          "truncated before ASCII");
+    Expect(Utf::ToWide("\x80" "abc") == W({ R, 'a', 'b', 'c' }),  "stray continuation");
+    Expect(Utf::ToWide("\xFF") == W({ R }),                       "invalid lead byte");
+
+    // ---- Lone surrogates in wide input ----
+    {
+        std::wstring lone;
+        lone += static_cast<wchar_t>(0xD800);
+        lone += L'x';
+        Expect(Utf::ToUtf8(lone) == "\xEF\xBF\xBD" "x", "lone high surrogate");
+        std::wstring low;
+        low += static_cast<wchar_t>(0xDC00);
+        Expect(Utf::ToUtf8(low) == "\xEF\xBF\xBD", "lone low surrogate");
+    }
+
+    // ---- Bounded variants ----
+    {
+        wchar_t wbuf[4];
+        Expect(Utf::DecodeTo("abcd", wbuf, 4) == 4, "DecodeTo exact fit");
+        Expect(Utf::DecodeTo("abcde", wbuf, 4) == Utf::NO_FIT, "DecodeTo overflow");
+        char cbuf[3];
+        Expect(Utf::EncodeTo(W({ 0x20AC }), cbuf, 3) == 3, "EncodeTo exact fit");
+        Expect(Utf::EncodeTo(W({ 0x20AC }), cbuf, 2) == Utf::NO_FIT, "EncodeTo overflow");
+    }
+
+    // ---- Append keeps existing content ----
+    {
+        std::wstring w = L"pre:";
+        Utf::AppendWide("\xC3\xA9t\xC3\xA9", w);
+        Expect(w == W({ 'p', 'r', 'e', ':', 0xE9, 't', 0xE9 }), "AppendWide");
+    }
+
+    std::printf("utf check (%zu-byte wchar_t): %s\n", sizeof(wchar_t), g_failures ? "FAILED" : "ok");
+    return g_failures ? 1 : 0;
+}
+
+// ============================================================
+// Benchmark
+// ============================================================
+
+// The loops Config.cpp and APClient.cpp used before the Utf module.
+static std::wstring LegacyWiden(const std::string& s) { return std::wstring(s.begin(), s.end()); }
+
+static std::string LegacyWideToNarrow(const std::wstring& wide)
+{
+    std::string result;
+    result.reserve(wide.size());
+    for (wchar_t ch : wide) {
+        if (ch < 0x80) {
+            result.push_back(static_cast<char>(ch));
+        } else if (ch < 0x800) {
+            result.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+            result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+        } else {
+            result.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+        }
+    }
+    return result;
+}
+
+static volatile size_t g_sink = 0;
+
+template <typename F>
+static double MBPerSec(size_t bytes, size_t iters, F&& body)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; ++i) body();
+    auto end = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(bytes) * static_cast<double>(iters) / secs / (1024.0 * 1024.0);
+}
+
+static void BenchCorpus(const char* label, const std::vector<std::string>& lines, size_t iters)
+{
+    size_t bytes = 0;
+    std::vector<std::wstring> wide;
+    for (const auto& l : lines) { bytes += l.size(); wide.push_back(Utf::ToWide(l)); }
+
+    double legacyWiden = MBPerSec(bytes, iters, [&] { for (const auto& l : lines) g_sink = g_sink + LegacyWiden(l).size(); });
+    double utfWiden    = MBPerSec(bytes, iters, [&] { for (const auto& l : lines) g_sink = g_sink + Utf::ToWide(l).size(); });
+    double legacyNarrow = MBPerSec(bytes, iters, [&] { for (const auto& w : wide) g_sink = g_sink + LegacyWideToNarrow(w).size(); });
+    double utfNarrow    = MBPerSec(bytes, iters, [&] { for (const auto& w : wide) g_sink = g_sink + Utf::ToUtf8(w).size(); });
+
+    std::printf("%s (%zu lines, %zu bytes):\n", label, lines.size(), bytes);
+    std::printf("  widen   legacy %8.1f MB/s   Utf %8.1f MB/s\n", legacyWiden, utfWiden);
+    std::printf("  narrow  legacy %8.1f MB/s   Utf %8.1f MB/s\n", legacyNarrow, utfNarrow);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) return RunCheck();
+
+    size_t iters = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+    // AP chat / item-send lines: mostly ASCII with the odd accented name.
+    std::vector<std::string> ascii = {
+        "Player1 sent Golden T (DJ3) to Player2 (Found at A1 Star)",
+        "[Hint]: Player3's Progressive Sigil is at Eastern Temple in Player4's World (found)",
+        "Player5 (Team #1) has joined. Client(0.5.1), ['AP'].",
+        "Now that you are connected, you can use !help to list commands to run via the server.",
+    };
+    std::vector<std::string> mixed = {
+        "J\xC3\xB6rmungandr sent Red Z (NZ7) to Ch\xC3\xA2teau (Found at C5 Star)",
+        "\xE3\x83\x97\xE3\x83\xAC\xE3\x82\xA4\xE3\x83\xA4\xE3\x83\xBC found their Golden L (ML2)",
+        "Emoji check \xF0\x9F\x8E\xAE\xF0\x9F\xA7\xA9 from Zo\xC3\xAB",
+        "Se\xC3\xB1or sent Progressive Grab to \xCE\x91\xCE\xBB\xCE\xAD\xCE\xBE\xCE\xB7\xCF\x82",
+    };
+
+    BenchCorpus("ASCII chat lines", ascii, iters);
+    BenchCorpus("Non-ASCII names", mixed, iters);
+
+#ifdef __SSE2__
+    std::printf("\n(ASCII blocks: SSE2, %zu-byte wchar_t)\n", sizeof(wchar_t));
+#else
+    std::printf("\n(ASCII blocks: scalar, %zu-byte wchar_t)\n", sizeof(wchar_t));
+#endif
+    return 0;
+}
@@ -0,0 +1,474 @@
+// wirereplay — feed a wire capture (talos_ap_wire.cap, see WireCapture.h)
+// back through APSession's packet handlers, with no server and no socket.
+//
+//   wirereplay <capture> [--realtime] [--repeat N] [--verbose]
+//              replay every inbound packet; print per-packet-type handler
+//              cost and heap allocations, the events the game thread
+//              would have received, and what decoding the Notify lines
+//              into the HUD queue costs on the game thread.
+//              --realtime keeps the capture's original pacing, otherwise
+//              packets are replayed back to back.
+//   wirereplay --check
+//              write a synthetic capture, read it back and replay it;
+//              exit 1 on failure
+//
+// Item and location names resolve through talos_ap_datapackage.json in
+// the working directory, as in the game; run from the game folder (or
+// copy the cache next to the capture) for realistic PrintJSON cost.
+// Outbound records are counted, not replayed.
+//
+// A capture taken against tools/apstandin.py with --flood-every is a
+// message storm: the PrintJSON row plus the Notify line are the whole
+// network-bytes-to-HUD text path.
+
+#include "APChannel.h"
+#include "APSession.h"
+#include "ItemMapping.h"
+#include "Tunables.h"
+#include "WireCapture.h"
+
+#include <DynamicOutput/DynamicOutput.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TalosAP;
+
+static const char* DEFAULT_GAME = "The Talos Principle Reawakened";
+
+/// HudNotification's pending cap (HudNotification.h needs the engine).
+static constexpr size_t HUD_MAX_PENDING = DEFAULT_TUNABLES.hud_max_visible;
+
+// ============================================================
+// Heap allocation counter — every operator new in the process
+// ============================================================
+
+static std::atomic<uint64_t> g_allocs{0};
+
+void* operator new(size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    size_t a = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    void* p = _aligned_malloc(size ? size : 1, a);
+#else
+    void* p = std::aligned_alloc(a, (size + a - 1) / a * a + (size ? 0 : a));
+#endif
+    if (p) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete(void* p, size_t, std::align_val_t a) noexcept { operator delete(p, a); }
+
+static uint64_t Allocs() { return g_allocs.load(std::memory_order_relaxed); }
+
+// ============================================================
+// In-memory channel — the replayed session's toMod ring, drained here
+// the way the game thread would
+// ============================================================
+
+struct Channel {
+    struct Free { void operator()(void* p) const { ::operator delete(p, std::align_val_t(64)); } };
+    std::unique_ptr<void, Free> block;
+    APChannel::View view;
+
+    explicit Channel(const char* game)
+        : block(::operator new(APChannel::TOTAL_BYTES, std::align_val_t(64)))
+    {
+        std::memset(block.get(), 0, APChannel::TOTAL_BYTES);
+        view = APChannel::Create(block.get(), 0);
+        std::strncpy(view.control->connect.game, game, sizeof(view.control->connect.game) - 1);
+    }
+
+    /// Game-thread side of Notify: decode and queue, as APClient and
+    /// HudNotification::Notify do.
+    struct NotifyStats {
+        uint64_t lines = 0;
+        uint64_t segments = 0;
+        uint64_t textUnits = 0;
+        uint64_t allocs = 0;
+        double   totalNs = 0;
+    };
+
+    std::deque<HudLine> hud;
+    HudLine             lastChat;
+
+    /// Drain toMod, counting events by type.
+    void Drain(std::map<uint16_t, uint64_t>& counts, NotifyStats& notify)
+    {
+        view.toMod.Drain([&](uint16_t type, const uint8_t* data, uint32_t size) {
+            ++counts[type];
+            if (type != static_cast<uint16_t>(APChannel::Event::Notify)) return;
+
+            uint64_t a0 = Allocs();
+            auto t0 = std::chrono::steady_clock::now();
+            APChannel::Reader r(data, size);
+            bool chat = r.Get<uint8_t>() != 0;
+            HudLine line;
+            r.GetLine(line);
+            if (!line.Empty()) {
+                ++notify.lines;
+                notify.segments += line.Segments().size();
+                notify.textUnits += line.Text().size();
+                if (chat) lastChat = line;
+                hud.push_back(std::move(line));
+                while (hud.size() > HUD_MAX_PENDING) hud.pop_front();
+            }
+            notify.totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            notify.allocs += Allocs() - a0;
+        });
+    }
+};
+
+static const char* EventName(uint16_t type)
+{
+    static const char* names[] = {
+        "Log", "SocketConnected", "SocketDisconnected", "SlotConnected", "SlotRefused",
+        "LocationConfirmed", "Grant", "ItemsDone", "Notify", "Scouted", "ServerRtt",
+    };
+    return type < std::size(names) ? names[type] : "?";
+}
+
+static std::string CmdOf(const std::string& packet)
+{
+    // Cheap: captures always write "cmd" first
+    auto at = packet.find("\"cmd\":\"");
+    if (at == std::string::npos) return "?";
+    at += 7;
+    auto end = packet.find('"', at);
+    return end == std::string::npos ? "?" : packet.substr(at, end - at);
+}
+
+// ============================================================
+// Replay
+// ============================================================
+
+struct CmdStats {
+    uint64_t count = 0;
+    uint64_t rejected = 0;
+    uint64_t bytes = 0;
+    uint64_t allocs = 0;
+    double   totalNs = 0;
+    double   maxNs = 0;
+    std::vector<double> samples;
+};
+
+struct ReplayResult {
+    std::map<std::string, CmdStats> inbound;
+    std::map<std::string, uint64_t> outbound;
+    std::map<uint16_t, uint64_t>    events;
+    Channel::NotifyStats            notify;
+    HudLine lastChat;
+    double wallMs = 0;
+    bool   ok = true;
+};
+
+static bool ReplayOnce(const std::string& path, bool realtime, ReplayResult& result)
+{
+    WireCaptureReader reader;
+    if (!reader.Open(path)) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), reader.Error().c_str());
+        return false;
+    }
+
+    Channel channel(DEFAULT_GAME);
+    APSession session(channel.view);
+    if (!session.StartReplay()) {
+        std::fprintf(stderr, "could not start the replay session\n");
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    WireRecord rec;
+    while (reader.Next(rec)) {
+        std::string cmd = CmdOf(rec.packet);
+        if (rec.direction == WireDirection::Outbound) {
+            ++result.outbound[cmd];
+            continue;
+        }
+        if (realtime) std::this_thread::sleep_until(start + std::chrono::microseconds(rec.timeUs));
+
+        uint64_t a0 = Allocs();
+        auto t0 = std::chrono::steady_clock::now();
+        bool handled = session.Replay(rec.packet);
+        auto t1 = std::chrono::steady_clock::now();
+        uint64_t a1 = Allocs();
+        channel.Drain(result.events, result.notify);
+
+        auto& s = result.inbound[cmd];
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        ++s.count;
+        if (!handled) ++s.rejected;
+        s.bytes += rec.packet.size();
+        s.allocs += a1 - a0;
+        s.totalNs += ns;
+        s.maxNs = std::max(s.maxNs, ns);
+        s.samples.push_back(ns);
+    }
+    result.wallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.lastChat = channel.lastChat;
+
+    if (!reader.Error().empty()) {
+        std::fprintf(stderr, "%s: %s (replayed up to it)\n", path.c_str(), reader.Error().c_str());
+    }
+    return true;
+}
+
+static void Report(const ReplayResult& r)
+{
+    std::printf("%-14s %8s %8s %10s %10s %10s %10s %12s %11s\n",
+                "inbound", "packets", "skipped", "KiB", "mean us", "p99 us", "max us", "total ms", "allocs/pkt");
+    for (const auto& [cmd, s] : r.inbound) {
+        auto sorted = s.samples;
+        std::sort(sorted.begin(), sorted.end());
+        double p99 = sorted.empty() ? 0 : sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)];
+        std::printf("%-14s %8llu %8llu %10.1f %10.2f %10.2f %10.2f %12.3f %11.1f\n",
+                    cmd.c_str(), (unsigned long long)s.count, (unsigned long long)s.rejected,
+                    s.bytes / 1024.0, s.totalNs / 1000.0 / std::max<uint64_t>(s.count, 1),
+                    p99 / 1000.0, s.maxNs / 1000.0, s.totalNs / 1e6,
+                    static_cast<double>(s.allocs) / std::max<uint64_t>(s.count, 1));
+    }
+    if (r.notify.lines) {
+        double n = static_cast<double>(r.notify.lines);
+        std::printf("\ngame thread, Notify -> HUD queue: %llu lines, %.1f segments and %.0f chars each, "
+                    "%.2f us and %.1f allocs per line\n",
+                    (unsigned long long)r.notify.lines, r.notify.segments / n, r.notify.textUnits / n,
+                    r.notify.totalNs / 1000.0 / n, r.notify.allocs / n);
+    }
+    if (!r.outbound.empty()) {
+        std::printf("\noutbound (not replayed):");
+        for (const auto& [cmd, n] : r.outbound) std::printf(" %s=%llu", cmd.c_str(), (unsigned long long)n);
+        std::printf("\n");
+    }
+    std::printf("\nevents to the game thread:");
+    for (const auto& [type, n] : r.events) std::printf(" %s=%llu", EventName(type), (unsigned long long)n);
+    std::printf("\nwall %.1f ms\n", r.wallMs);
+}
+
+// ============================================================
+// --check
+// ============================================================
+
+static int g_failures = 0;
+
+#define EXPECT(cond)                                                        \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            ++g_failures;                                                   \
+        }                                                                   \
+    } while (0)
+
+static int RunCheck()
+{
+    const std::string path = "wirereplay_check.cap";
+    const int64_t item = ItemMapping::BASE_ITEM_ID;
+    const int64_t loc  = ItemMapping::BASE_LOCATION_ID;
+
+    // Slot 1 receives one tetromino of each of the 19 types plus one
+    // unknown item, ten locations are confirmed, one PrintJSON line.
+    std::vector<std::pair<WireDirection, std::string>> packets;
+    packets.push_back({ WireDirection::Outbound, R"({"cmd":"Connect","name":"Player1","items_handling":7})" });
+    packets.push_back({ WireDirection::Inbound, R"({"cmd":"Connected","team":0,"slot":1,"slot_data":{"reusable_tetrominos":0}})" });
+    std::string items = R"({"cmd":"ReceivedItems","index":0,"items":[)";
+    int tetrominoes = 0;
+    for (int type = 0; type < 19; ++type, ++tetrominoes) {
+        items += "{\"item\":" + std::to_string(item + type) + ",\"location\":" + std::to_string(loc + type)
+              + ",\"player\":2,\"flags\":1},";
+    }
+    items += R"({"item":12345,"location":1,"player":1,"flags":0}]})";
+    packets.push_back({ WireDirection::Inbound, items });
+    std::string checked = R"({"cmd":"RoomUpdate","checked_locations":[)";
+    for (int i = 0; i < 10; ++i) checked += (i ? "," : "") + std::to_string(loc + i);
+    checked += "]}";
+    packets.push_back({ WireDirection::Outbound, R"({"cmd":"LocationChecks","locations":[5505024]})" });
+    packets.push_back({ WireDirection::Inbound, checked });
+    packets.push_back({ WireDirection::Inbound,
+        R"({"cmd":"PrintJSON","type":"ItemSend","data":[{"type":"player_id","text":"2"},{"type":"text","text":" sent "},)"
+        R"({"type":"item_name","text":"Green J","flags":1},{"type":"text","text":" to "},{"type":"player_id","text":"3"}],)"
+        R"("receiving":3,"item":{"item":5505024,"location":9,"player":2,"flags":1}})" });
+    packets.push_back({ WireDirection::Inbound, R"({"cmd":"Bounced","data":{}})" });
+
+    // Write, then read back byte for byte.
+    {
+        WireCapture cap;
+        EXPECT(cap.Open(path));
+        for (const auto& [dir, p] : packets) cap.Record(dir, p);
+        EXPECT(cap.Records() == packets.size());
+        cap.Close();
+
+        WireCaptureReader reader;
+        EXPECT(reader.Open(path));
+        WireRecord rec;
+        size_t n = 0;
+        uint64_t lastUs = 0;
+        while (reader.Next(rec)) {
+            if (n < packets.size()) {
+                EXPECT(rec.direction == packets[n].first);
+                EXPECT(rec.packet == packets[n].second);
+            }
+            EXPECT(rec.timeUs >= lastUs);
+            lastUs = rec.timeUs;
+            ++n;
+        }
+        EXPECT(n == packets.size());
+        EXPECT(reader.Error().empty());
+    }
+
+    // Replay: the handlers see what the live client would have given them.
+    {
+        ReplayResult r;
+        EXPECT(ReplayOnce(path, false, r));
+        auto ev = [&](APChannel::Event e) { return r.events[static_cast<uint16_t>(e)]; };
+        EXPECT(ev(APChannel::Event::SlotConnected) == 1);
+        EXPECT(ev(APChannel::Event::Grant) == static_cast<uint64_t>(tetrominoes));
+        EXPECT(ev(APChannel::Event::ItemsDone) == 1);
+        EXPECT(ev(APChannel::Event::LocationConfirmed) == 10);
+        EXPECT(ev(APChannel::Event::Notify) == static_cast<uint64_t>(tetrominoes) + 2);  // +unknown item, +PrintJSON
+        EXPECT(r.notify.lines == static_cast<uint64_t>(tetrominoes) + 2);
+        // The PrintJSON line arrives as one text buffer with five views into it
+        const auto& chat = r.lastChat.Segments();
+        EXPECT(chat.size() == 5);
+        EXPECT(r.lastChat.Text().find(L" sent Green J to ") != std::wstring_view::npos);
+        if (chat.size() == 5) {
+            EXPECT(r.lastChat.Text(chat[2]) == L"Green J");
+            EXPECT(chat[4].offset + chat[4].length == r.lastChat.Text().size());
+        }
+        EXPECT(r.inbound["Bounced"].rejected == 1);
+        EXPECT(r.outbound["Connect"] == 1 && r.outbound["LocationChecks"] == 1);
+    }
+
+    // A line longer than one record loses its tail, and the segment views
+    // are cut to match.
+    {
+        HudLine line;
+        line.AppendUtf8("short ", HudColors::WHITE);
+        line.AppendUtf8(std::string(APChannel::MAX_RECORD, 'x'), HudColors::ITEM);
+        line.AppendUtf8(" never arrives", HudColors::PLAYER);
+        line.AppendUtf8("", HudColors::TRAP);
+        EXPECT(line.Segments().size() == 3);
+
+        APChannel::Writer w;
+        w.PutLine(line);
+        EXPECT(w.Truncated());
+
+        HudLine back;
+        APChannel::Reader r(w.Data(), w.Size());
+        r.GetLine(back);
+        EXPECT(!r.Failed());
+        EXPECT(back.Segments().size() == 2);
+        EXPECT(back.Text(back.Segments()[0]) == L"short ");
+        EXPECT(back.Segments()[1].offset + back.Segments()[1].length == back.Text().size());
+
+        // And a record that ends early decodes to nothing
+        APChannel::Reader cut(w.Data(), 8);
+        cut.GetLine(back);
+        EXPECT(cut.Failed() && back.Empty());
+    }
+
+    // A capture cut short by a crash replays up to the torn record.
+    {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        std::vector<char> bytes;
+        if (f) {
+            char buf[4096];
+            size_t got;
+            while ((got = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + got);
+            std::fclose(f);
+        }
+        EXPECT(bytes.size() > 64);
+        f = std::fopen(path.c_str(), "wb");
+        if (f) {
+            std::fwrite(bytes.data(), 1, bytes.size() - 20, f);
+            std::fclose(f);
+        }
+        WireCaptureReader reader;
+        EXPECT(reader.Open(path));
+        WireRecord rec;
+        size_t n = 0;
+        while (reader.Next(rec)) ++n;
+        EXPECT(n > 0 && n < packets.size());
+    }
+
+    // Not a capture at all.
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (f) {
+            std::fputs("{\"cmd\":\"RoomInfo\"} and some more bytes to pass the header", f);
+            std::fclose(f);
+        }
+        WireCaptureReader reader;
+        EXPECT(!reader.Open(path));
+        EXPECT(!reader.Error().empty());
+    }
+
+    std::remove(path.c_str());
+    std::printf("wirereplay check: %s\n", g_failures ? "FAILED" : "ok");
+    return g_failures ? 1 : 0;
+}
+
+// ============================================================
+// main
+// ============================================================
+
+int main(int argc, char** argv)
+{
+    bool verbose = false;
+    bool realtime = false;
+    int repeat = 1;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--check") == 0) {
+            RC::Output::SetEcho(false);
+            return RunCheck();
+        }
+        if (std::strcmp(argv[i], "--realtime") == 0) realtime = true;
+        else if (std::strcmp(argv[i], "--verbose") == 0) verbose = true;
+        else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeat = std::max(1, std::atoi(argv[++i]));
+        else path = argv[i];
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "usage: wirereplay <capture> [--realtime] [--repeat N] [--verbose] | --check\n");
+        return 2;
+    }
+
+    RC::Output::SetEcho(verbose);
+
+    // Each pass is a fresh session, as after a game restart.
+    ReplayResult result;
+    for (int pass = 0; pass < repeat; ++pass) {
+        if (!ReplayOnce(path, realtime, result)) return 1;
+    }
+    Report(result);
+    return 0;
+}